@@ -3,6 +3,7 @@
 #include "controllers/accounts/AccountController.hpp"
 #include "controllers/highlights/HighlightController.hpp"
 #include "controllers/highlights/HighlightPhrase.hpp"
+#include "controllers/highlights/HighlightPhraseMatcher.hpp"
 #include "messages/Message.hpp"
 #include "messages/SharedMessageBuilder.hpp"
 #include "mocks/EmptyApplication.hpp"
@@ -14,6 +15,8 @@
 #include <QString>
 #include <QTemporaryDir>
 
+#include <vector>
+
 using namespace chatterino;
 
 class BenchmarkMessageBuilder : public SharedMessageBuilder
@@ -91,3 +94,61 @@ static void BM_HighlightTest(benchmark::State &state)
 }
 
 BENCHMARK(BM_HighlightTest);
+
+namespace {
+
+/// Highlight phrases like a heavy user would have: mostly plain words and
+/// names, some of them case sensitive, with a regex every 20 phrases
+std::vector<HighlightPhrase> makeHighlightPhrases(int count)
+{
+    std::vector<HighlightPhrase> phrases;
+    phrases.reserve(count);
+    for (int i = 0; i < count; ++i)
+    {
+        bool isRegex = i % 20 == 19;
+        QString pattern = isRegex ? QString(R"(\bword%1\w*)").arg(i)
+                                  : QString("phrase%1").arg(i);
+        phrases.emplace_back(pattern, false, false, false, isRegex, i % 7 == 0,
+                             "", QColor());
+    }
+    return phrases;
+}
+
+const QString HIGHLIGHT_SUBJECT =
+    "-tags Kreygasm,Kreygasm (no space) this is a fairly ordinary chat "
+    "message mentioning phrase250 and phrase499 somewhere in the middle";
+
+}  // namespace
+
+static void BM_HighlightPhrasesIndividual(benchmark::State &state)
+{
+    auto phrases = makeHighlightPhrases(static_cast<int>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        size_t matches = 0;
+        for (const auto &phrase : phrases)
+        {
+            if (phrase.isMatch(HIGHLIGHT_SUBJECT))
+            {
+                ++matches;
+            }
+        }
+        benchmark::DoNotOptimize(matches);
+    }
+}
+
+static void BM_HighlightPhrasesCombined(benchmark::State &state)
+{
+    HighlightPhraseMatcher matcher(
+        makeHighlightPhrases(static_cast<int>(state.range(0))));
+
+    for (auto _ : state)
+    {
+        auto matches = matcher.match(HIGHLIGHT_SUBJECT);
+        benchmark::DoNotOptimize(matches);
+    }
+}
+
+BENCHMARK(BM_HighlightPhrasesIndividual)->Arg(50)->Arg(500);
+BENCHMARK(BM_HighlightPhrasesCombined)->Arg(50)->Arg(500);
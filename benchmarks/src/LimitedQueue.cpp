@@ -107,6 +107,36 @@ void BM_LimitedQueue_Find(benchmark::State &state)
     }
 }
 
+// Thread 0 is the writer, all other threads continuously take snapshots,
+// similar to the IRC thread appending while views read their channels.
+void BM_LimitedQueue_Contention(benchmark::State &state)
+{
+    static LimitedQueue<std::shared_ptr<int>> queue(1000);
+
+    if (state.thread_index() == 0)
+    {
+        queue.clear();
+        for (int i = 0; i < 1000; ++i)
+        {
+            queue.pushBack(std::make_shared<int>(i));
+        }
+    }
+
+    auto item = std::make_shared<int>(0);
+    for (auto _ : state)
+    {
+        if (state.thread_index() == 0)
+        {
+            queue.pushBack(item);
+        }
+        else
+        {
+            auto snapshot = queue.getSnapshot();
+            benchmark::DoNotOptimize(snapshot[snapshot.size() - 1]);
+        }
+    }
+}
+
 BENCHMARK(BM_LimitedQueue_PushBack);
 BENCHMARK(BM_LimitedQueue_PushFront_One);
 BENCHMARK(BM_LimitedQueue_PushFront_Many);
@@ -114,3 +144,4 @@ BENCHMARK(BM_LimitedQueue_Replace);
 BENCHMARK(BM_LimitedQueue_Snapshot);
 BENCHMARK(BM_LimitedQueue_Snapshot_ExpensiveCopy);
 BENCHMARK(BM_LimitedQueue_Find);
+BENCHMARK(BM_LimitedQueue_Contention)->ThreadRange(2, 16)->UseRealTime();
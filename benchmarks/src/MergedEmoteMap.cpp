@@ -0,0 +1,160 @@
+#include "common/Atomic.hpp"
+#include "messages/Emote.hpp"
+#include "messages/MergedEmoteMap.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <vector>
+
+using namespace chatterino;
+
+namespace {
+
+// A channel with 5000 emotes and the usual amount of global emotes
+constexpr std::array<std::pair<EmoteLayer, int>, 6> LAYER_SIZES{{
+    {EmoteLayer::FfzChannel, 1500},
+    {EmoteLayer::BttvChannel, 1500},
+    {EmoteLayer::SeventvChannel, 2000},
+    {EmoteLayer::FfzGlobal, 20},
+    {EmoteLayer::BttvGlobal, 60},
+    {EmoteLayer::SeventvGlobal, 50},
+}};
+
+std::shared_ptr<const EmoteMap> makeLayer(EmoteLayer layer, int size)
+{
+    auto map = std::make_shared<EmoteMap>();
+    for (int i = 0; i < size; i++)
+    {
+        // Every tenth emote is shadowed by the previous layer
+        auto name = (i % 10 == 0)
+                        ? QString("shared%1").arg(i)
+                        : QString("emote%1_%2").arg(int(layer)).arg(i);
+        map->emplace(EmoteName{name}, std::make_shared<const Emote>(Emote{
+                                          .name = {name},
+                                      }));
+    }
+    return map;
+}
+
+std::vector<EmoteName> makeWords()
+{
+    // Most words in chat aren't emotes, those have to go through all layers
+    std::vector<EmoteName> words;
+    for (int i = 0; i < 1000; i++)
+    {
+        switch (i % 4)
+        {
+            case 0:
+                words.push_back({QString("emote%1_%2").arg(i % 6).arg(i % 20)});
+                break;
+            default:
+                words.push_back({QString("word%1").arg(i)});
+                break;
+        }
+    }
+    return words;
+}
+
+struct Layers {
+    std::array<Atomic<std::shared_ptr<const EmoteMap>>, LAYER_SIZES.size()>
+        maps;
+
+    Layers()
+    {
+        for (const auto &[layer, size] : LAYER_SIZES)
+        {
+            this->maps[size_t(layer)].set(makeLayer(layer, size));
+        }
+    }
+};
+
+}  // namespace
+
+// Probing every emote map in order, like TwitchMessageBuilder::tryAppendEmote
+// used to
+static void BM_EmoteLookup_Probes(benchmark::State &state)
+{
+    Layers layers;
+    auto words = makeWords();
+
+    for (auto _ : state)
+    {
+        for (const auto &word : words)
+        {
+            std::optional<EmotePtr> emote;
+            for (const auto &layer : layers.maps)
+            {
+                auto map = layer.get();
+                auto it = map->find(word);
+                if (it != map->end())
+                {
+                    emote = it->second;
+                    break;
+                }
+            }
+            benchmark::DoNotOptimize(emote);
+        }
+    }
+}
+
+static void BM_EmoteLookup_Merged(benchmark::State &state)
+{
+    Layers layers;
+    auto words = makeWords();
+
+    Atomic<std::shared_ptr<const MergedEmoteMap>> merged(
+        std::make_shared<const MergedEmoteMap>()->withLayers({
+            {EmoteLayer::FfzChannel, layers.maps[0].get()},
+            {EmoteLayer::BttvChannel, layers.maps[1].get()},
+            {EmoteLayer::SeventvChannel, layers.maps[2].get()},
+            {EmoteLayer::FfzGlobal, layers.maps[3].get()},
+            {EmoteLayer::BttvGlobal, layers.maps[4].get()},
+            {EmoteLayer::SeventvGlobal, layers.maps[5].get()},
+        }));
+
+    for (auto _ : state)
+    {
+        for (const auto &word : words)
+        {
+            auto table = merged.get();
+            std::optional<EmotePtr> emote;
+            if (const auto *entry = table->find(word))
+            {
+                emote = entry->emote;
+            }
+            benchmark::DoNotOptimize(emote);
+        }
+    }
+}
+
+// A 7TV live update adding a single emote to the channel
+static void BM_MergedEmoteMap_AddEmote(benchmark::State &state)
+{
+    Layers layers;
+    auto base = std::make_shared<const MergedEmoteMap>()->withLayers({
+        {EmoteLayer::FfzChannel, layers.maps[0].get()},
+        {EmoteLayer::BttvChannel, layers.maps[1].get()},
+        {EmoteLayer::SeventvChannel, layers.maps[2].get()},
+        {EmoteLayer::FfzGlobal, layers.maps[3].get()},
+        {EmoteLayer::BttvGlobal, layers.maps[4].get()},
+        {EmoteLayer::SeventvGlobal, layers.maps[5].get()},
+    });
+
+    auto added = std::make_shared<EmoteMap>(*layers.maps[2].get());
+    added->emplace(EmoteName{"NewEmote"}, std::make_shared<const Emote>(Emote{
+                                              .name = {"NewEmote"},
+                                          }));
+    std::shared_ptr<const EmoteMap> addedMap = std::move(added);
+
+    for (auto _ : state)
+    {
+        auto merged =
+            base->withLayers({{EmoteLayer::SeventvChannel, addedMap}});
+        benchmark::DoNotOptimize(merged);
+    }
+}
+
+BENCHMARK(BM_EmoteLookup_Probes);
+BENCHMARK(BM_EmoteLookup_Merged);
+BENCHMARK(BM_MergedEmoteMap_AddEmote);
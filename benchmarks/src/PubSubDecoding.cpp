@@ -0,0 +1,82 @@
+#include "providers/seventv/eventapi/Message.hpp"
+#include "providers/twitch/pubsubmessages/Base.hpp"
+#include "util/SampleData.hpp"
+
+#include <benchmark/benchmark.h>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QString>
+
+#include <string>
+
+using namespace chatterino;
+
+namespace {
+
+const std::string SEVENTV_EMOTE_SET_UPDATE =
+    R"({"op":0,"t":1700000000000,"d":{"type":"emote_set.update","body":{"id":"60b39e943e203cc169dfc106","kind":3,"actor":{"id":"60b39e943e203cc169dfc106","type":"","username":"nerixyz","display_name":"nerixyz","avatar_url":"","style":{"color":0,"paint_id":null,"badge_id":null},"roles":["62b48deb791a15a25c2a0354"],"connections":[]},"pushed":[{"key":"emotes","index":14,"type":"","value":{"id":"61f463a74f8c353cf9fbd9d6","name":"ALERT","flags":0,"timestamp":1700000000000,"actor_id":"60b39e943e203cc169dfc106","data":{"id":"61f463a74f8c353cf9fbd9d6","name":"ALERT","flags":0,"lifecycle":3,"state":["LISTED","PERSONAL"],"listed":true,"animated":true,"owner":{"id":"60ae3e98b2ecb0150535c6b7","username":"disabled","display_name":"disabled","avatar_url":"","style":{"color":0},"roles":["62b48deb791a15a25c2a0354"]},"host":{"url":"//cdn.7tv.app/emote/61f463a74f8c353cf9fbd9d6","files":[{"name":"1x.webp","static_name":"1x_static.webp","width":32,"height":32,"frame_count":4,"size":2810,"format":"WEBP"},{"name":"2x.webp","static_name":"2x_static.webp","width":64,"height":64,"frame_count":4,"size":5836,"format":"WEBP"},{"name":"3x.webp","static_name":"3x_static.webp","width":96,"height":96,"frame_count":4,"size":9338,"format":"WEBP"},{"name":"4x.webp","static_name":"4x_static.webp","width":128,"height":128,"frame_count":4,"size":12952,"format":"WEBP"}]}}}}]}}})";
+
+/// The decoding path before messages were decoded from UTF-8:
+/// the payload is converted to UTF-16 and parsed twice with QJsonDocument
+void decodePubSubWithQJson(const std::string &payload)
+{
+    auto blob = QString::fromStdString(payload);
+    auto outer = QJsonDocument::fromJson(blob.toUtf8()).object();
+    auto data = outer.value("data").toObject();
+    auto inner =
+        QJsonDocument::fromJson(data.value("message").toString().toUtf8());
+    benchmark::DoNotOptimize(outer.value("type").toString());
+    benchmark::DoNotOptimize(data.value("topic").toString());
+    benchmark::DoNotOptimize(inner.object());
+}
+
+void decodeSeventvWithQJson(const std::string &payload)
+{
+    auto blob = QString::fromStdString(payload);
+    auto outer = QJsonDocument::fromJson(blob.toUtf8()).object();
+    auto d = outer["d"].toObject();
+    benchmark::DoNotOptimize(d["type"].toString());
+    benchmark::DoNotOptimize(d["body"].toObject());
+}
+
+}  // namespace
+
+static void BM_PubSubDecodeQJson(benchmark::State &state)
+{
+    auto payload = getSampleChannelRewardMessage().toStdString();
+    for (auto _ : state)
+    {
+        decodePubSubWithQJson(payload);
+    }
+}
+
+static void BM_PubSubDecode(benchmark::State &state)
+{
+    auto payload = getSampleChannelRewardMessage().toStdString();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(parsePubSubBaseMessage(payload));
+    }
+}
+
+static void BM_SeventvDispatchDecodeQJson(benchmark::State &state)
+{
+    for (auto _ : state)
+    {
+        decodeSeventvWithQJson(SEVENTV_EMOTE_SET_UPDATE);
+    }
+}
+
+static void BM_SeventvDispatchDecode(benchmark::State &state)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(
+            seventv::eventapi::parseBaseMessage(SEVENTV_EMOTE_SET_UPDATE));
+    }
+}
+
+BENCHMARK(BM_PubSubDecodeQJson);
+BENCHMARK(BM_PubSubDecode);
+BENCHMARK(BM_SeventvDispatchDecodeQJson);
+BENCHMARK(BM_SeventvDispatchDecode);
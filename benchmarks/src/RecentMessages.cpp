@@ -1,7 +1,9 @@
 #include "common/Literals.hpp"
 #include "controllers/accounts/AccountController.hpp"
+#include "controllers/filters/lang/Filter.hpp"
 #include "controllers/highlights/HighlightController.hpp"
 #include "messages/Emote.hpp"
+#include "messages/MessageElement.hpp"
 #include "mocks/DisabledStreamerMode.hpp"
 #include "mocks/EmptyApplication.hpp"
 #include "mocks/TwitchIrcServer.hpp"
@@ -17,15 +19,25 @@
 #include "providers/twitch/TwitchChannel.hpp"
 #include "singletons/Emotes.hpp"
 #include "singletons/Resources.hpp"
+#include "util/SlabAllocator.hpp"
 
 #include <benchmark/benchmark.h>
+#include <IrcMessage>
 #include <QFile>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QString>
 
+#include <memory>
 #include <optional>
 
+#ifdef __GLIBC__
+#    include <malloc.h>
+#    if __GLIBC_PREREQ(2, 33)
+#        define CHATTERINO_HAS_MALLINFO2
+#    endif
+#endif
+
 using namespace chatterino;
 using namespace literals;
 
@@ -216,6 +228,36 @@ public:
     }
 };
 
+/// Parses the messages the way it was done before IrcLine, for comparison
+class ParseRecentMessagesCommuni : public RecentMessages
+{
+public:
+    explicit ParseRecentMessagesCommuni(const QString &name_)
+        : RecentMessages(name_)
+    {
+    }
+
+    void run(benchmark::State &state)
+    {
+        const auto jsonMessages =
+            this->messages.object().value("messages").toArray();
+        for (auto _ : state)
+        {
+            std::vector<std::unique_ptr<Communi::IrcMessage>> parsed;
+            for (const auto &jsonMessage : jsonMessages)
+            {
+                auto content = jsonMessage.toString();
+                content.replace(COMBINED_FIXER, ZERO_WIDTH_JOINER);
+                parsed.emplace_back(
+                    Communi::IrcMessage::fromData(content.toUtf8(), nullptr));
+                // Reading the tags is what the builder does first
+                benchmark::DoNotOptimize(parsed.back()->tags());
+            }
+            benchmark::DoNotOptimize(parsed);
+        }
+    }
+};
+
 class BuildRecentMessages : public RecentMessages
 {
 public:
@@ -237,19 +279,174 @@ public:
     }
 };
 
+/// Measures the heap usage of built messages that are kept alive
+class RecentMessagesMemory : public RecentMessages
+{
+public:
+    explicit RecentMessagesMemory(const QString &name_)
+        : RecentMessages(name_)
+    {
+    }
+
+    void run(benchmark::State &state)
+    {
+#ifdef CHATTERINO_HAS_MALLINFO2
+        auto parsed = recentmessages::detail::parseRecentMessages(
+            this->messages.object());
+        const auto &slabs = MessageElement::allocator();
+
+        double bytesPerMessage = 0;
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            auto heapBefore = mallinfo2().uordblks;
+            auto slabFreeBefore =
+                slabs.reservedBytes() - slabs.allocatedBytes();
+            state.ResumeTiming();
+
+            auto built = recentmessages::detail::buildRecentMessages(
+                parsed, &this->chan);
+
+            state.PauseTiming();
+            // Elements reusing free slab blocks from earlier iterations
+            // don't show up in the heap delta
+            auto slabFreeAfter =
+                slabs.reservedBytes() - slabs.allocatedBytes();
+            auto bytes = static_cast<double>(mallinfo2().uordblks) -
+                         static_cast<double>(heapBefore) +
+                         static_cast<double>(slabFreeBefore) -
+                         static_cast<double>(slabFreeAfter);
+            bytesPerMessage = bytes / static_cast<double>(built.size());
+            built.clear();
+            state.ResumeTiming();
+        }
+        state.counters["bytes/message"] = bytesPerMessage;
+#else
+        state.SkipWithError("mallinfo2 is not available");
+#endif
+    }
+};
+
+/// Runs a set of filters against the built messages, either through the
+/// compiled closures or by interpreting the tree with a full ContextMap
+class FilterRecentMessages : public RecentMessages
+{
+public:
+    explicit FilterRecentMessages(const QString &name_, bool compiled_)
+        : RecentMessages(name_)
+        , compiled(compiled_)
+    {
+        // clang-format off
+        const QStringList filterTexts{
+            R".(!flags.system_message && !flags.sub_message).",
+            R".(author.badges contains "moderator" || author.badges contains "vip").",
+            R".(author.subbed && author.sub_length >= 12).",
+            R".(!(message.content match ri"^!\w+")).",
+            R".(message.length > 5 && !(author.name == "streamelements" || author.name == "nightbot")).",
+            R".(channel.name == "nymn" && !channel.live || flags.highlighted).",
+            R".(message.content contains "forsen" || flags.first_message).",
+        };
+        // clang-format on
+
+        for (const auto &text : filterTexts)
+        {
+            auto result = filters::Filter::fromString(text);
+            if (!std::holds_alternative<filters::Filter>(result))
+            {
+                _exit(1);
+            }
+            this->filters.emplace_back(
+                std::move(std::get<filters::Filter>(result)));
+        }
+    }
+
+    void run(benchmark::State &state)
+    {
+        auto parsed = recentmessages::detail::parseRecentMessages(
+            this->messages.object());
+        auto built =
+            recentmessages::detail::buildRecentMessages(parsed, &this->chan);
+
+        for (auto _ : state)
+        {
+            size_t passed = 0;
+            for (const auto &message : built)
+            {
+                bool pass = true;
+                if (this->compiled)
+                {
+                    filters::MessageContext context{*message, &this->chan};
+                    for (const auto &filter : this->filters)
+                    {
+                        pass = pass && filter.matches(context);
+                    }
+                }
+                else
+                {
+                    auto context =
+                        filters::buildContextMap(message, &this->chan);
+                    for (const auto &filter : this->filters)
+                    {
+                        pass = pass && filter.execute(context).toBool();
+                    }
+                }
+                passed += pass ? 1 : 0;
+            }
+            benchmark::DoNotOptimize(passed);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                                static_cast<int64_t>(built.size()));
+    }
+
+private:
+    bool compiled;
+    std::vector<filters::Filter> filters;
+};
+
 void BM_ParseRecentMessages(benchmark::State &state, const QString &name)
 {
     ParseRecentMessages bench(name);
     bench.run(state);
 }
 
+void BM_ParseRecentMessagesCommuni(benchmark::State &state,
+                                   const QString &name)
+{
+    ParseRecentMessagesCommuni bench(name);
+    bench.run(state);
+}
+
 void BM_BuildRecentMessages(benchmark::State &state, const QString &name)
 {
     BuildRecentMessages bench(name);
     bench.run(state);
 }
 
+void BM_RecentMessagesMemory(benchmark::State &state, const QString &name)
+{
+    RecentMessagesMemory bench(name);
+    bench.run(state);
+}
+
+void BM_FilterRecentMessagesInterpreted(benchmark::State &state,
+                                        const QString &name)
+{
+    FilterRecentMessages bench(name, false);
+    bench.run(state);
+}
+
+void BM_FilterRecentMessagesCompiled(benchmark::State &state,
+                                     const QString &name)
+{
+    FilterRecentMessages bench(name, true);
+    bench.run(state);
+}
+
 }  // namespace
 
 BENCHMARK_CAPTURE(BM_ParseRecentMessages, nymn, u"nymn"_s);
+BENCHMARK_CAPTURE(BM_ParseRecentMessagesCommuni, nymn, u"nymn"_s);
 BENCHMARK_CAPTURE(BM_BuildRecentMessages, nymn, u"nymn"_s);
+BENCHMARK_CAPTURE(BM_RecentMessagesMemory, nymn, u"nymn"_s);
+BENCHMARK_CAPTURE(BM_FilterRecentMessagesInterpreted, nymn, u"nymn"_s);
+BENCHMARK_CAPTURE(BM_FilterRecentMessagesCompiled, nymn, u"nymn"_s);
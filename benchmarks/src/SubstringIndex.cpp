@@ -0,0 +1,85 @@
+#include "controllers/completion/sources/SubstringIndex.hpp"
+
+#include <benchmark/benchmark.h>
+#include <QString>
+#include <QStringList>
+
+#include <random>
+#include <vector>
+
+using namespace chatterino::completion;
+
+namespace {
+
+// 50k emote-like names, e.g. "pepeLaugh123"
+std::vector<QString> makeNames()
+{
+    const QStringList parts{"pepe", "Kappa", "Pog", "monka", "LUL", "Laugh",
+                            "Hop",  "Sit",   "W",   "Clap",  "Dance"};
+
+    std::mt19937 rng(42);  // NOLINT(cert-msc51-cpp)
+    std::uniform_int_distribution<qsizetype> part(0, parts.size() - 1);
+
+    std::vector<QString> names;
+    names.reserve(50000);
+    for (int i = 0; i < 50000; i++)
+    {
+        names.push_back(parts[part(rng)] + parts[part(rng)] +
+                        QString::number(i % 1000));
+    }
+    return names;
+}
+
+const QStringList QUERIES{"p", "pe", "pep", "pepe", "pepeL", "pepeLa",
+                          "pepeLau", "pepeLaug", "pepeLaugh", "pepeLaugh1"};
+
+}  // namespace
+
+// The previous approach: a case insensitive contains() over every name
+static void BM_Completion_LinearScan(benchmark::State &state)
+{
+    auto names = makeNames();
+    for (auto _ : state)
+    {
+        for (const auto &query : QUERIES)
+        {
+            std::vector<size_t> matches;
+            for (size_t i = 0; i < names.size(); i++)
+            {
+                if (names[i].contains(query, Qt::CaseInsensitive))
+                {
+                    matches.push_back(i);
+                }
+            }
+            benchmark::DoNotOptimize(matches);
+        }
+    }
+}
+
+// Typing "pepeLaugh1" one keystroke at a time
+static void BM_Completion_SubstringIndex(benchmark::State &state)
+{
+    SubstringIndex index(makeNames());
+    for (auto _ : state)
+    {
+        for (const auto &query : QUERIES)
+        {
+            auto matches = index.find(query);
+            benchmark::DoNotOptimize(matches);
+        }
+    }
+}
+
+static void BM_Completion_BuildSubstringIndex(benchmark::State &state)
+{
+    auto names = makeNames();
+    for (auto _ : state)
+    {
+        SubstringIndex index(names);
+        benchmark::DoNotOptimize(index);
+    }
+}
+
+BENCHMARK(BM_Completion_LinearScan);
+BENCHMARK(BM_Completion_SubstringIndex);
+BENCHMARK(BM_Completion_BuildSubstringIndex);
@@ -400,6 +400,8 @@ public:
          (FailureCallback<HelixSendMessageError, QString> failureCallback)),
         (override));
 
+    MOCK_METHOD(HelixRatelimit, ratelimit, (), (const, override));
+
     MOCK_METHOD(void, update, (QString clientId, QString oauthToken),
                 (override));
 
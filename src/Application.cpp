@@ -171,6 +171,10 @@ Application::~Application() = default;
 
 void Application::fakeDtor()
 {
+    // The process exits without destroying the Application, so queued log
+    // lines have to be written now
+    this->logging->flushAll();
+
     this->twitchPubSub.reset();
     this->twitchBadges.reset();
     this->chatterinoBadges.reset();
@@ -283,7 +283,8 @@ void runGui(QApplication &a, const Paths &paths, Settings &settings,
 
     if (!args.dontSaveSettings)
     {
-        pajlada::Settings::SettingManager::gSave();
+        // Also waits for the window layout queued by app.save()
+        settings.save();
     }
 
     chatterino::NetworkManager::deinit();
@@ -6,7 +6,6 @@
 #include "providers/irc/IrcChannel2.hpp"
 #include "providers/irc/IrcServer.hpp"
 #include "providers/twitch/IrcMessageHandler.hpp"
-#include "providers/pronoundb/PronounDbApi.hpp"
 #include "singletons/Emotes.hpp"
 #include "singletons/Logging.hpp"
 #include "singletons/Settings.hpp"
@@ -80,51 +79,80 @@ LimitedQueueSnapshot<MessagePtr> Channel::getMessageSnapshot()
     return this->messages_.getSnapshot();
 }
 
+const MessageIndex &Channel::messageIndex() const
+{
+    return this->messageIndex_;
+}
+
 void Channel::addMessage(MessagePtr message,
                          std::optional<MessageFlags> overridingFlags)
 {
-    MessagePtr deleted;
+    const AppendedMessage appended{std::move(message), overridingFlags};
+    this->addMessages({&appended, 1});
+}
+
+void Channel::addMessages(std::span<const AppendedMessage> messages)
+{
+    if (messages.empty())
+    {
+        return;
+    }
 
-    if (!overridingFlags || !overridingFlags->has(MessageFlag::DoNotLog))
+    for (const auto &appended : messages)
     {
-        QString channelPlatform("other");
-        if (this->type_ == Type::Irc)
+        auto message = appended.message;
+        auto overridingFlags = appended.overridingFlags;
+        MessagePtr deleted;
+
+        if (!overridingFlags || !overridingFlags->has(MessageFlag::DoNotLog))
         {
-            auto *irc = dynamic_cast<IrcChannel *>(this);
-            if (irc != nullptr)
+            QString channelPlatform("other");
+            if (this->type_ == Type::Irc)
             {
-                channelPlatform = QString("irc-%1").arg(
-                    irc->server()->userFriendlyIdentifier());
+                auto *irc = dynamic_cast<IrcChannel *>(this);
+                if (irc != nullptr)
+                {
+                    channelPlatform = QString("irc-%1").arg(
+                        irc->server()->userFriendlyIdentifier());
+                }
             }
+            else if (this->isTwitchChannel())
+            {
+                channelPlatform = "twitch";
+            }
+            getIApp()->getChatLogger()->addMessage(this->name_, message,
+                                                   channelPlatform);
         }
-        else if (this->isTwitchChannel())
+
+        this->messageIndex_.add(message);
+        if (this->messages_.pushBack(message, deleted))
         {
-            channelPlatform = "twitch";
-            getIApp()->getPronounDb()->getPronounsForUsername(message->loginName.toStdString());
+            this->messageIndex_.remove(deleted);
+            this->messageRemovedFromStart(deleted);
         }
-        getIApp()->getChatLogger()->addMessage(this->name_, message,
-                                               channelPlatform);
-    }
 
-    if (this->messages_.pushBack(message, deleted))
-    {
-        this->messageRemovedFromStart(deleted);
+        this->messageAppended.invoke(message, overridingFlags);
     }
 
-    this->messageAppended.invoke(message, overridingFlags);
+    this->messagesAppended.invoke(messages);
 }
 
 void Channel::addOrReplaceTimeout(MessagePtr message)
 {
+    auto timeoutUser = message->timeoutUser;
+
     addOrReplaceChannelTimeout(
         this->getMessageSnapshot(), std::move(message), QTime::currentTime(),
-        [this](auto /*idx*/, auto msg, auto replacement) {
-            this->replaceMessage(msg, replacement);
+        [this](auto idx, auto /*msg*/, auto replacement) {
+            // The snapshot was just taken and only this thread modifies the
+            // buffer, so the index is still valid
+            this->replaceMessage(static_cast<size_t>(idx), replacement);
         },
         [this](auto msg) {
             this->addMessage(msg);
-        },
-        true);
+        });
+
+    this->disableMessagesFrom(timeoutUser);
 
     // XXX: Might need the following line
     // WindowManager::instance().repaintVisibleChatWidgets(this);
@@ -153,6 +181,12 @@ void Channel::addMessagesAtStart(const std::vector<MessagePtr> &_messages)
     std::vector<MessagePtr> addedMessages =
         this->messages_.pushFront(_messages);
 
+    // Added in reverse so the oldest message ends up first in the index
+    for (auto it = addedMessages.rbegin(); it != addedMessages.rend(); ++it)
+    {
+        this->messageIndex_.addAtStart(*it);
+    }
+
     if (addedMessages.size() != 0)
     {
         this->messagesAddedAtStart.invoke(addedMessages);
@@ -171,7 +205,12 @@ void Channel::fillInMissingMessages(const std::vector<MessagePtr> &messages)
     {
         // There are no messages in this channel yet so we can just insert them
         // at the front in order
-        this->messages_.pushFront(messages);
+        auto addedMessages = this->messages_.pushFront(messages);
+        for (auto it = addedMessages.rbegin(); it != addedMessages.rend();
+             ++it)
+        {
+            this->messageIndex_.addAtStart(*it);
+        }
         this->filledInMessages.invoke(messages);
         return;
     }
@@ -222,7 +261,15 @@ void Channel::fillInMissingMessages(const std::vector<MessagePtr> &messages)
                 // Therefore, we can put the current message directly before. We
                 // assume that the messages we are filling in are in ascending
                 // order by serverReceivedTime.
-                this->messages_.insertBefore(snapshotMsg, msg);
+                std::optional<MessagePtr> deleted;
+                if (this->messages_.insertBefore(snapshotMsg, msg, deleted))
+                {
+                    this->messageIndex_.addInserted(msg);
+                }
+                if (deleted)
+                {
+                    this->messageIndex_.remove(*deleted);
+                }
                 insertedFlag = true;
                 break;
             }
@@ -233,8 +280,16 @@ void Channel::fillInMissingMessages(const std::vector<MessagePtr> &messages)
             // We never found a message already in the channel that came after
             // the current message. Put it at the end and make sure to update
             // which message is considered "the end".
-            this->messages_.insertAfter(lastMsg, msg);
-            lastMsg = msg;
+            std::optional<MessagePtr> deleted;
+            if (this->messages_.insertAfter(lastMsg, msg, deleted))
+            {
+                this->messageIndex_.addInserted(msg);
+                lastMsg = msg;
+            }
+            if (deleted)
+            {
+                this->messageIndex_.remove(*deleted);
+            }
         }
     }
 
@@ -252,14 +307,17 @@ void Channel::replaceMessage(MessagePtr message, MessagePtr replacement)
 
     if (index >= 0)
     {
+        this->messageIndex_.replace(message, replacement);
         this->messageReplaced.invoke((size_t)index, replacement);
     }
 }
 
 void Channel::replaceMessage(size_t index, MessagePtr replacement)
 {
+    auto message = this->messages_.get(index);
     if (this->messages_.replaceItem(index, replacement))
     {
+        this->messageIndex_.replace(*message, replacement);
         this->messageReplaced.invoke(index, replacement);
     }
 }
@@ -275,17 +333,22 @@ void Channel::deleteMessage(QString messageID)
 
 MessagePtr Channel::findMessage(QString messageID)
 {
-    MessagePtr res;
+    return this->messageIndex_.findByID(messageID);
+}
 
-    if (auto msg = this->messages_.rfind([&messageID](const MessagePtr &msg) {
-            return msg->id == messageID;
-        });
-        msg)
+void Channel::disableMessagesFrom(const QString &login)
+{
+    for (const auto &message : this->messageIndex_.findByAuthor(login))
     {
-        res = *msg;
+        if (message->flags.hasNone({MessageFlag::Timeout,
+                                    MessageFlag::Untimeout,
+                                    MessageFlag::Whisper}))
+        {
+            // FOURTF: disabled for now
+            // PAJLADA: Shitty solution described in Message.hpp
+            message->flags.set(MessageFlag::Disabled);
+        }
     }
-
-    return res;
 }
 
 bool Channel::canSendMessage() const
@@ -3,6 +3,7 @@
 #include "common/FlagsEnum.hpp"
 #include "controllers/completion/TabCompletionModel.hpp"
 #include "messages/LimitedQueue.hpp"
+#include "messages/MessageIndex.hpp"
 
 #include <pajlada/signals/signal.hpp>
 #include <QDate>
@@ -11,6 +12,7 @@
 
 #include <memory>
 #include <optional>
+#include <span>
 
 namespace chatterino {
 
@@ -19,6 +21,12 @@ using MessagePtr = std::shared_ptr<const Message>;
 enum class MessageFlag : int64_t;
 using MessageFlags = FlagsEnum<MessageFlag>;
 
+/// A message added to a channel, see Channel::addMessage
+struct AppendedMessage {
+    MessagePtr message;
+    std::optional<MessageFlags> overridingFlags;
+};
+
 enum class TimeoutStackStyle : int {
     StackHard = 0,
     DontStackBeyondUserMessage = 1,
@@ -59,6 +67,10 @@ public:
         sendReplySignal;
     pajlada::Signals::Signal<MessagePtr &, std::optional<MessageFlags>>
         messageAppended;
+    /// Invoked once per call to addMessage(s), after messageAppended was
+    /// invoked for each of the messages
+    pajlada::Signals::Signal<std::span<const AppendedMessage>>
+        messagesAppended;
     pajlada::Signals::Signal<std::vector<MessagePtr> &> messagesAddedAtStart;
     pajlada::Signals::Signal<size_t, MessagePtr &> messageReplaced;
     /// Invoked when some number of messages were filled in using time received
@@ -73,6 +85,8 @@ public:
     bool isTwitchChannel() const;
     virtual bool isEmpty() const;
     LimitedQueueSnapshot<MessagePtr> getMessageSnapshot();
+    /// Index of the messages currently in this channel
+    const MessageIndex &messageIndex() const;
 
     // MESSAGES
     // overridingFlags can be filled in with flags that should be used instead
@@ -80,6 +94,8 @@ public:
     // type of split
     void addMessage(MessagePtr message,
                     std::optional<MessageFlags> overridingFlags = std::nullopt);
+    /// Adds all messages in order and invokes messagesAppended once
+    void addMessages(std::span<const AppendedMessage> messages);
     void addMessagesAtStart(const std::vector<MessagePtr> &messages_);
 
     /// Inserts the given messages in order by Message::serverReceivedTime.
@@ -91,7 +107,11 @@ public:
     void replaceMessage(size_t index, MessagePtr replacement);
     void deleteMessage(QString messageID);
 
+    /// Returns the most recent message with the given ID or nullptr
     MessagePtr findMessage(QString messageID);
+    /// Disables all messages sent by `login` except for moderation messages
+    /// and whispers
+    void disableMessagesFrom(const QString &login);
 
     bool hasMessages() const;
 
@@ -121,6 +141,7 @@ protected:
 private:
     const QString name_;
     LimitedQueue<MessagePtr> messages_;
+    MessageIndex messageIndex_;
     Type type_;
     QTimer clearCompletionModelTimer_;
 };
@@ -1,6 +1,7 @@
 #include "common/WindowDescriptors.hpp"
 
 #include "common/QLogging.hpp"
+#include "util/BinarySnapshot.hpp"
 #include "widgets/Window.hpp"
 
 #include <QFile>
@@ -13,6 +14,13 @@ namespace {
 
     QJsonArray loadWindowArray(const QString &settingsPath)
     {
+        QJsonValue snapshot;
+        if (readBinarySnapshot(WindowLayout::binaryPathOf(settingsPath),
+                               SnapshotSource::of(settingsPath), snapshot))
+        {
+            return snapshot.toObject().value("windows").toArray();
+        }
+
         QFile file(settingsPath);
         file.open(QIODevice::ReadOnly);
         QByteArray data = file.readAll();
@@ -146,6 +154,16 @@ TabDescriptor TabDescriptor::loadFromJSON(const QJsonObject &tabObj)
     return tab;
 }
 
+QString WindowLayout::binaryPathOf(const QString &path)
+{
+    auto base = path;
+    if (base.endsWith(".json"))
+    {
+        base.chop(5);
+    }
+    return base + ".bin";
+}
+
 WindowLayout WindowLayout::loadFromFile(const QString &path)
 {
     WindowLayout layout;
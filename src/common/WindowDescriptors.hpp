@@ -113,6 +113,9 @@ public:
     /// If no window exists, a new one is added.
     void activateOrAddChannel(ProviderId provider, const QString &name);
     static WindowLayout loadFromFile(const QString &path);
+
+    /// Path of the binary copy of the window layout saved at @a path
+    static QString binaryPathOf(const QString &path);
 };
 
 }  // namespace chatterino
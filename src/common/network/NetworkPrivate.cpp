@@ -16,8 +16,12 @@
 #include <QElapsedTimer>
 #include <QFile>
 #include <QNetworkReply>
+#include <QThreadPool>
 #include <QtConcurrent>
 
+#include <mutex>
+#include <unordered_map>
+
 #ifdef NDEBUG
 constexpr qsizetype SLOW_HTTP_THRESHOLD = 30;
 #else
@@ -42,6 +46,37 @@ void runCallback(bool concurrent, auto &&fn)
     }
 }
 
+/// GET requests that are currently loading, by their coalescing key
+struct InFlightRequests {
+    std::mutex mutex;
+    std::unordered_map<QString, std::shared_ptr<NetworkData>> requests;
+};
+
+InFlightRequests &inFlightRequests()
+{
+    static auto *requests = new InFlightRequests;
+    return *requests;
+}
+
+/// Reading and writing the cache happens on its own pool, so cache reads
+/// don't queue up behind other work on the global thread pool
+QThreadPool &cachePool()
+{
+    static auto *pool = [] {
+        auto *threads = new QThreadPool;
+        threads->setMaxThreadCount(2);
+        return threads;
+    }();
+    return *pool;
+}
+
+/// Maps the request's priority to a QThreadPool priority
+/// (QNetworkRequest uses lower numbers for higher priorities)
+int cachePriority(const QNetworkRequest &request)
+{
+    return QNetworkRequest::LowPriority - request.priority();
+}
+
 void loadUncached(std::shared_ptr<NetworkData> &&data)
 {
     DebugCount::increase("http request started");
@@ -93,6 +128,29 @@ NetworkData::~NetworkData()
     DebugCount::decrease("NetworkData");
 }
 
+bool joinInFlightRequest(std::shared_ptr<NetworkData> &data)
+{
+    auto key = data->getCoalescingKey();
+    if (key.isEmpty())
+    {
+        return false;
+    }
+
+    auto &inFlight = inFlightRequests();
+    std::lock_guard lock(inFlight.mutex);
+
+    auto [it, inserted] = inFlight.requests.try_emplace(key, data);
+    if (inserted)
+    {
+        data->coalescingKey_ = std::move(key);
+        return false;
+    }
+
+    DebugCount::increase("http request coalesced");
+    it->second->followers.push_back(std::move(data));
+    return true;
+}
+
 QString NetworkData::getHash()
 {
     if (this->hash_.isEmpty())
@@ -115,8 +173,63 @@ QString NetworkData::getHash()
     return this->hash_;
 }
 
+QString NetworkData::getCoalescingKey() const
+{
+    if (this->requestType != NetworkRequestType::Get ||
+        !this->payload.isEmpty() || this->multiPartPayload)
+    {
+        return {};
+    }
+
+    QString key = this->request.url().toString();
+    for (const auto &header : this->request.rawHeaderList())
+    {
+        key += '\n' + QString::fromUtf8(header) + ':' +
+               QString::fromUtf8(this->request.rawHeader(header));
+    }
+    // requests differing in these would get different results
+    auto redirectPolicy =
+        this->request.attribute(QNetworkRequest::RedirectPolicyAttribute);
+    key += '\n' + QString::number(this->cache) + ':' +
+           QString::number(
+               this->timeout.value_or(std::chrono::milliseconds(0)).count()) +
+           ':' + redirectPolicy.toString();
+    return key;
+}
+
+void NetworkData::releaseFollowers()
+{
+    if (this->coalescingKey_.isEmpty())
+    {
+        return;
+    }
+
+    auto &inFlight = inFlightRequests();
+    std::lock_guard lock(inFlight.mutex);
+    inFlight.requests.erase(this->coalescingKey_);
+    this->coalescingKey_.clear();
+}
+
+void NetworkData::reloadFollowers()
+{
+    this->releaseFollowers();
+
+    auto followers = std::move(this->followers);
+    this->followers.clear();
+    for (auto &follower : followers)
+    {
+        load(std::move(follower));
+    }
+}
+
 void NetworkData::emitSuccess(NetworkResult &&result)
 {
+    this->releaseFollowers();
+    for (const auto &follower : this->followers)
+    {
+        follower->emitSuccess(NetworkResult(result));
+    }
+
     if (!this->onSuccess)
     {
         return;
@@ -146,6 +259,12 @@ void NetworkData::emitSuccess(NetworkResult &&result)
 
 void NetworkData::emitError(NetworkResult &&result)
 {
+    this->releaseFollowers();
+    for (const auto &follower : this->followers)
+    {
+        follower->emitError(NetworkResult(result));
+    }
+
     if (!this->onError)
     {
         return;
@@ -165,6 +284,12 @@ void NetworkData::emitError(NetworkResult &&result)
 
 void NetworkData::emitFinally()
 {
+    this->releaseFollowers();
+    for (const auto &follower : this->followers)
+    {
+        follower->emitFinally();
+    }
+
     if (!this->finally)
     {
         return;
@@ -189,11 +314,19 @@ QString NetworkData::typeString() const
 
 void load(std::shared_ptr<NetworkData> &&data)
 {
+    if (joinInFlightRequest(data))
+    {
+        return;
+    }
+
     if (data->cache)
     {
-        std::ignore = QtConcurrent::run([data = std::move(data)]() mutable {
-            loadCached(std::move(data));
-        });
+        auto priority = cachePriority(data->request);
+        cachePool().start(
+            [data = std::move(data)]() mutable {
+                loadCached(std::move(data));
+            },
+            priority);
     }
     else
     {
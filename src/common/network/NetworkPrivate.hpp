@@ -10,6 +10,7 @@
 
 #include <memory>
 #include <optional>
+#include <vector>
 
 class QNetworkReply;
 
@@ -54,8 +55,26 @@ public:
     /// To set a timeout, use NetworkRequest's timeout method
     std::optional<std::chrono::milliseconds> timeout{};
 
+    /// Identical requests that were executed while this one was loading.
+    /// They receive the results of this request instead of loading again.
+    std::vector<std::shared_ptr<NetworkData>> followers;
+
     QString getHash();
 
+    /// Identifies requests that can share one load, empty if this request
+    /// can't be shared (anything but plain GET requests).
+    /// Unlike getHash(), this includes the values of the headers.
+    QString getCoalescingKey() const;
+
+    /// Stops identical requests from joining this one.
+    /// Called before the results are emitted.
+    void releaseFollowers();
+
+    /// Stops identical requests from joining this one and loads the ones
+    /// that already joined on their own.
+    /// Called if this request is dropped without results.
+    void reloadFollowers();
+
     void emitSuccess(NetworkResult &&result);
     void emitError(NetworkResult &&result);
     void emitFinally();
@@ -64,8 +83,16 @@ public:
 
 private:
     QString hash_;
+    /// Set while identical requests may join this one
+    QString coalescingKey_;
+
+    friend bool joinInFlightRequest(std::shared_ptr<NetworkData> &data);
 };
 
+/// @returns true if an identical request is loading, which now also
+///          delivers its results to @a data
+bool joinInFlightRequest(std::shared_ptr<NetworkData> &data);
+
 void load(std::shared_ptr<NetworkData> &&data);
 
 }  // namespace chatterino
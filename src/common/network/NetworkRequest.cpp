@@ -120,6 +120,12 @@ NetworkRequest NetworkRequest::concurrent() &&
     return std::move(*this);
 }
 
+NetworkRequest NetworkRequest::priority(QNetworkRequest::Priority priority) &&
+{
+    this->data->request.setPriority(priority);
+    return std::move(*this);
+}
+
 NetworkRequest NetworkRequest::multiPart(QHttpMultiPart *payload) &&
 {
     this->data->multiPartPayload = {payload, {}};
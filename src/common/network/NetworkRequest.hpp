@@ -63,6 +63,10 @@ public:
         const std::vector<std::pair<QByteArray, QByteArray>> &headers) &&;
     NetworkRequest timeout(int ms) &&;
     NetworkRequest concurrent() &&;
+    /// Requests with a higher priority are sent and read from the cache
+    /// first. Use a high priority for things the user is waiting for and a
+    /// low priority for background fetches.
+    NetworkRequest priority(QNetworkRequest::Priority priority) &&;
     NetworkRequest multiPart(QHttpMultiPart *payload) &&;
     /**
      * This will change `RedirectPolicyAttribute`.
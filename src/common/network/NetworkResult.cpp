@@ -10,8 +10,9 @@
 namespace chatterino {
 
 NetworkResult::NetworkResult(NetworkError error, const QVariant &httpStatusCode,
-                             QByteArray data)
+                             QByteArray data, Headers headers)
     : data_(std::move(data))
+    , headers_(std::move(headers))
     , error_(error)
 {
     if (httpStatusCode.isValid())
@@ -20,6 +21,18 @@ NetworkResult::NetworkResult(NetworkError error, const QVariant &httpStatusCode,
     }
 }
 
+QByteArray NetworkResult::rawHeader(const QByteArray &name) const
+{
+    for (const auto &header : this->headers_)
+    {
+        if (header.first.compare(name, Qt::CaseInsensitive) == 0)
+        {
+            return header.second;
+        }
+    }
+    return {};
+}
+
 QJsonObject NetworkResult::parseJson() const
 {
     QJsonDocument jsonDoc(QJsonDocument::fromJson(this->data_));
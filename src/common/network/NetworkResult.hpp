@@ -13,9 +13,10 @@ class NetworkResult
 {
 public:
     using NetworkError = QNetworkReply::NetworkError;
+    using Headers = QList<QNetworkReply::RawHeaderPair>;
 
     NetworkResult(NetworkError error, const QVariant &httpStatusCode,
-                  QByteArray data);
+                  QByteArray data, Headers headers = {});
 
     /// Parses the result as json and returns the root as an object.
     /// Returns empty object if parsing failed.
@@ -40,12 +41,17 @@ public:
         return this->status_;
     }
 
+    /// Returns the value of the response header @a name or an empty array if
+    /// the response didn't contain it. The name is compared case insensitively.
+    QByteArray rawHeader(const QByteArray &name) const;
+
     /// Formats the error.
     /// If a reply is received, returns the HTTP status otherwise, the network error.
     QString formatError() const;
 
 private:
     QByteArray data_;
+    Headers headers_;
 
     NetworkError error_;
     std::optional<int> status_;
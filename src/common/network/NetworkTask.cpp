@@ -43,6 +43,7 @@ void NetworkTask::run()
     this->reply_ = this->createReply();
     if (!this->reply_)
     {
+        this->data_->reloadFollowers();
         this->deleteLater();
         return;
     }
@@ -163,13 +164,15 @@ void NetworkTask::finished()
         qCDebug(chatterinoHTTP).noquote()
             << this->data_->typeString() << "[cancelled]"
             << this->data_->request.url().toString();
+        this->data_->reloadFollowers();
         return;
     }
 
     if (reply->error() != QNetworkReply::NoError)
     {
         this->logReply();
-        this->data_->emitError({reply->error(), status, reply->readAll()});
+        this->data_->emitError({reply->error(), status, reply->readAll(),
+                                reply->rawHeaderPairs()});
         this->data_->emitFinally();
 
         return;
@@ -184,7 +187,8 @@ void NetworkTask::finished()
 
     DebugCount::increase("http request success");
     this->logReply();
-    this->data_->emitSuccess({reply->error(), status, bytes});
+    this->data_->emitSuccess(
+        {reply->error(), status, bytes, reply->rawHeaderPairs()});
     this->data_->emitFinally();
 }
 
@@ -395,6 +395,7 @@ void CommandController::initialize(Settings &, const Paths &paths)
     this->registerCommand("/clear", &commands::deleteAllMessages);
 
     this->registerCommand("/delete", &commands::deleteOneMessage);
+    this->registerCommand("/massdelete", &commands::deleteUserMessages);
 
     this->registerCommand("/mod", &commands::addModerator);
 
@@ -412,6 +413,7 @@ void CommandController::initialize(Settings &, const Paths &paths)
 
     this->registerCommand("/unban", &commands::unbanUser);
     this->registerCommand("/untimeout", &commands::unbanUser);
+    this->registerCommand("/massunban", &commands::massUnbanUsers);
 
     this->registerCommand("/raid", &commands::startRaid);
 
@@ -438,6 +440,8 @@ void CommandController::initialize(Settings &, const Paths &paths)
 
     this->registerCommand("/ban", &commands::sendBan);
     this->registerCommand("/banid", &commands::sendBanById);
+    this->registerCommand("/massban", &commands::sendMassBan);
+    this->registerCommand("/masstimeout", &commands::sendMassTimeout);
 
     for (const auto &cmd : TWITCH_WHISPER_COMMANDS)
     {
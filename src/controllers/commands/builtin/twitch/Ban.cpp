@@ -5,6 +5,7 @@
 #include "controllers/commands/CommandContext.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "providers/twitch/api/Helix.hpp"
+#include "providers/twitch/ModerationQueue.hpp"
 #include "providers/twitch/TwitchAccount.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
 #include "util/Twitch.hpp"
@@ -115,6 +116,40 @@ void timeoutUserByID(const ChannelPtr &channel,
         });
 }
 
+void massBanOrTimeout(const ChannelPtr &channel,
+                      const TwitchChannel *twitchChannel,
+                      const QString &sourceUserID, const QStringList &targets,
+                      std::optional<int> duration)
+{
+    resolveModerationTargets(
+        targets, [channel, broadcasterID{twitchChannel->roomId()},
+                  sourceUserID, duration](auto users, auto unknown) {
+            if (!unknown.isEmpty())
+            {
+                channel->addMessage(makeSystemMessage(
+                    QString("Skipping unknown users: %1")
+                        .arg(unknown.join(", "))));
+            }
+
+            std::vector<ModerationRequest> requests;
+            requests.reserve(users.size());
+            for (const auto &user : users)
+            {
+                requests.push_back({
+                    .type = duration ? ModerationRequest::Type::Timeout
+                                     : ModerationRequest::Type::Ban,
+                    .broadcasterID = broadcasterID,
+                    .moderatorID = sourceUserID,
+                    .targetID = user.id,
+                    .targetName = user.name,
+                    .duration = duration.value_or(0),
+                });
+            }
+            ModerationQueue::instance().enqueue(std::move(requests),
+                                                reportToChannel(channel));
+        });
+}
+
 }  // namespace
 
 namespace chatterino::commands {
@@ -307,4 +342,100 @@ QString sendTimeout(const CommandContext &ctx)
     return "";
 }
 
+QString sendMassBan(const CommandContext &ctx)
+{
+    const auto &words = ctx.words;
+    const auto &channel = ctx.channel;
+    const auto *twitchChannel = ctx.twitchChannel;
+
+    if (channel == nullptr)
+    {
+        return "";
+    }
+
+    if (twitchChannel == nullptr)
+    {
+        channel->addMessage(makeSystemMessage(
+            QString("The /massban command only works in Twitch channels.")));
+        return "";
+    }
+
+    const auto *usageStr =
+        "Usage: \"/massban <username> [username...]\" - Permanently prevent "
+        "a list of users from chatting. Users can be separated by spaces or "
+        "commas, user IDs are written as id:<user id>. The bans are queued to "
+        "stay within Twitch's rate limit.";
+    if (words.size() < 2)
+    {
+        channel->addMessage(makeSystemMessage(usageStr));
+        return "";
+    }
+
+    auto currentUser = getIApp()->getAccounts()->twitch.getCurrent();
+    if (currentUser->isAnon())
+    {
+        channel->addMessage(
+            makeSystemMessage("You must be logged in to ban someone!"));
+        return "";
+    }
+
+    massBanOrTimeout(channel, twitchChannel, currentUser->getUserId(),
+                     splitModerationTargets(words.mid(1)), std::nullopt);
+
+    return "";
+}
+
+QString sendMassTimeout(const CommandContext &ctx)
+{
+    const auto &words = ctx.words;
+    const auto &channel = ctx.channel;
+    const auto *twitchChannel = ctx.twitchChannel;
+
+    if (channel == nullptr)
+    {
+        return "";
+    }
+
+    if (twitchChannel == nullptr)
+    {
+        channel->addMessage(makeSystemMessage(QString(
+            "The /masstimeout command only works in Twitch channels.")));
+        return "";
+    }
+
+    const auto *usageStr =
+        "Usage: \"/masstimeout <duration>[time unit] <username> "
+        "[username...]\" - Temporarily prevent a list of users from "
+        "chatting. Duration must be a positive integer; time unit (optional, "
+        "default=s) must be one of s, m, h, d, w; maximum duration is 2 "
+        "weeks. Users can be separated by spaces or commas, user IDs are "
+        "written as id:<user id>. The timeouts are queued to stay within "
+        "Twitch's rate limit.";
+    if (words.size() < 3)
+    {
+        channel->addMessage(makeSystemMessage(usageStr));
+        return "";
+    }
+
+    auto currentUser = getIApp()->getAccounts()->twitch.getCurrent();
+    if (currentUser->isAnon())
+    {
+        channel->addMessage(
+            makeSystemMessage("You must be logged in to timeout someone!"));
+        return "";
+    }
+
+    auto duration = (int)parseDurationToSeconds(words.at(1));
+    if (duration <= 0)
+    {
+        channel->addMessage(makeSystemMessage(usageStr));
+        return "";
+    }
+
+    massBanOrTimeout(channel, twitchChannel, currentUser->getUserId(),
+                     splitModerationTargets(words.mid(2)), duration);
+
+    return "";
+}
+
 }  // namespace chatterino::commands
@@ -18,4 +18,9 @@ QString sendBanById(const CommandContext &ctx);
 /// /timeout
 QString sendTimeout(const CommandContext &ctx);
 
+/// /massban
+QString sendMassBan(const CommandContext &ctx);
+/// /masstimeout
+QString sendMassTimeout(const CommandContext &ctx);
+
 }  // namespace chatterino::commands
@@ -8,9 +8,12 @@
 #include "messages/Message.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "providers/twitch/api/Helix.hpp"
+#include "providers/twitch/ModerationQueue.hpp"
 #include "providers/twitch/TwitchAccount.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
+#include "util/Twitch.hpp"
 
+#include <QSet>
 #include <QUuid>
 
 namespace {
@@ -70,6 +73,12 @@ QString deleteMessages(TwitchChannel *twitchChannel, const QString &messageID)
                 }
                 break;
 
+                case HelixDeleteChatMessagesError::Ratelimited: {
+                    errorMessage += "You are being ratelimited by Twitch. Try "
+                                    "again in a few seconds.";
+                }
+                break;
+
                 case HelixDeleteChatMessagesError::Forwarded: {
                     errorMessage += message;
                 }
@@ -159,4 +168,84 @@ QString deleteOneMessage(const CommandContext &ctx)
     return deleteMessages(ctx.twitchChannel, messageID);
 }
 
+QString deleteUserMessages(const CommandContext &ctx)
+{
+    if (ctx.channel == nullptr)
+    {
+        return "";
+    }
+
+    if (ctx.twitchChannel == nullptr)
+    {
+        ctx.channel->addMessage(makeSystemMessage(
+            "The /massdelete command only works in Twitch channels."));
+        return "";
+    }
+
+    if (ctx.words.size() < 2)
+    {
+        ctx.channel->addMessage(makeSystemMessage(
+            "Usage: /massdelete <username> [username...] - Deletes all loaded "
+            "messages of a list of users. Users can be separated by spaces or "
+            "commas."));
+        return "";
+    }
+
+    auto user = getIApp()->getAccounts()->twitch.getCurrent();
+    if (user->isAnon())
+    {
+        ctx.channel->addMessage(makeSystemMessage(
+            "You must be logged in to use the /massdelete command."));
+        return "";
+    }
+
+    QSet<QString> logins;
+    for (const auto &target : splitModerationTargets(ctx.words.mid(1)))
+    {
+        auto [userName, userID] = parseUserNameOrID(target);
+        if (!userName.isEmpty())
+        {
+            logins.insert(userName.toLower());
+        }
+    }
+
+    // Same restriction as /delete
+    if (!ctx.channel->isBroadcaster())
+    {
+        logins.remove(ctx.channel->getName().toLower());
+    }
+
+    std::vector<ModerationRequest> requests;
+    auto snapshot = ctx.channel->getMessageSnapshot();
+    for (const auto &message : snapshot)
+    {
+        if (message->id.isEmpty() ||
+            message->flags.has(MessageFlag::Disabled) ||
+            !logins.contains(message->loginName.toLower()))
+        {
+            continue;
+        }
+
+        requests.push_back({
+            .type = ModerationRequest::Type::DeleteMessage,
+            .broadcasterID = ctx.twitchChannel->roomId(),
+            .moderatorID = user->getUserId(),
+            .targetID = message->id,
+            .targetName = message->loginName,
+        });
+    }
+
+    if (requests.empty())
+    {
+        ctx.channel->addMessage(
+            makeSystemMessage("There are no loaded messages of these users."));
+        return "";
+    }
+
+    ModerationQueue::instance().enqueue(std::move(requests),
+                                        reportToChannel(ctx.channel));
+
+    return "";
+}
+
 }  // namespace chatterino::commands
@@ -16,4 +16,7 @@ QString deleteAllMessages(const CommandContext &ctx);
 /// /delete
 QString deleteOneMessage(const CommandContext &ctx);
 
+/// /massdelete
+QString deleteUserMessages(const CommandContext &ctx);
+
 }  // namespace chatterino::commands
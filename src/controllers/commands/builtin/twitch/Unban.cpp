@@ -4,6 +4,7 @@
 #include "controllers/commands/CommandContext.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "providers/twitch/api/Helix.hpp"
+#include "providers/twitch/ModerationQueue.hpp"
 #include "providers/twitch/TwitchAccount.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
 #include "util/Twitch.hpp"
@@ -142,4 +143,64 @@ QString unbanUser(const CommandContext &ctx)
     return "";
 }
 
+QString massUnbanUsers(const CommandContext &ctx)
+{
+    if (ctx.channel == nullptr)
+    {
+        return "";
+    }
+
+    if (ctx.twitchChannel == nullptr)
+    {
+        ctx.channel->addMessage(makeSystemMessage(
+            "The /massunban command only works in Twitch channels."));
+        return "";
+    }
+    if (ctx.words.size() < 2)
+    {
+        ctx.channel->addMessage(makeSystemMessage(
+            "Usage: \"/massunban <username> [username...]\" - Removes the "
+            "bans and timeouts of a list of users. Users can be separated by "
+            "spaces or commas, user IDs are written as id:<user id>."));
+        return "";
+    }
+
+    auto currentUser = getIApp()->getAccounts()->twitch.getCurrent();
+    if (currentUser->isAnon())
+    {
+        ctx.channel->addMessage(
+            makeSystemMessage("You must be logged in to unban someone!"));
+        return "";
+    }
+
+    resolveModerationTargets(
+        splitModerationTargets(ctx.words.mid(1)),
+        [channel{ctx.channel}, broadcasterID{ctx.twitchChannel->roomId()},
+         moderatorID{currentUser->getUserId()}](auto users, auto unknown) {
+            if (!unknown.isEmpty())
+            {
+                channel->addMessage(makeSystemMessage(
+                    QString("Skipping unknown users: %1")
+                        .arg(unknown.join(", "))));
+            }
+
+            std::vector<ModerationRequest> requests;
+            requests.reserve(users.size());
+            for (const auto &user : users)
+            {
+                requests.push_back({
+                    .type = ModerationRequest::Type::Unban,
+                    .broadcasterID = broadcasterID,
+                    .moderatorID = moderatorID,
+                    .targetID = user.id,
+                    .targetName = user.name,
+                });
+            }
+            ModerationQueue::instance().enqueue(std::move(requests),
+                                                reportToChannel(channel));
+        });
+
+    return "";
+}
+
 }  // namespace chatterino::commands
@@ -13,4 +13,7 @@ namespace chatterino::commands {
 /// /unban
 QString unbanUser(const CommandContext &ctx);
 
+/// /massunban
+QString massUnbanUsers(const CommandContext &ctx);
+
 }  // namespace chatterino::commands
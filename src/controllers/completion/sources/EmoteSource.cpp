@@ -13,6 +13,8 @@
 #include "providers/twitch/TwitchIrcServer.hpp"
 #include "singletons/Emotes.hpp"
 
+#include <map>
+
 namespace chatterino::completion {
 
 namespace {
@@ -49,8 +51,105 @@ namespace {
         };
     }
 
+    std::shared_ptr<const EmoteItemSegment> makeSegment(
+        const EmoteMap &map, const QString &providerName, bool indexed)
+    {
+        std::vector<EmoteItem> items;
+        addEmotes(items, map, providerName);
+        return std::make_shared<const EmoteItemSegment>(std::move(items),
+                                                        indexed);
+    }
+
+    /// Returns the segment for a shared emote map, building it only if the
+    /// map wasn't indexed before. Only used from the GUI thread.
+    std::shared_ptr<const EmoteItemSegment> cachedSegment(
+        const std::shared_ptr<const EmoteMap> &map, const QString &providerName)
+    {
+        struct Cached {
+            std::weak_ptr<const EmoteMap> map;
+            std::shared_ptr<const EmoteItemSegment> segment;
+        };
+        static std::map<std::pair<const EmoteMap *, QString>, Cached> cache;
+
+        auto key = std::make_pair(map.get(), providerName);
+        auto it = cache.find(key);
+        // The address of an expired map might have been reused
+        if (it != cache.end() && it->second.map.lock() == map)
+        {
+            return it->second.segment;
+        }
+
+        std::erase_if(cache, [](const auto &entry) {
+            return entry.second.map.expired();
+        });
+
+        auto segment = makeSegment(*map, providerName, true);
+        cache[key] = {map, segment};
+        return segment;
+    }
+
+    std::shared_ptr<const EmoteItemSegment> emojiSegment(
+        const std::vector<EmojiPtr> &emojis)
+    {
+        // Emojis are loaded once, they only need to be indexed again if the
+        // list was replaced (e.g. in tests)
+        static const std::vector<EmojiPtr> *indexed = nullptr;
+        static size_t indexedSize = 0;
+        static std::shared_ptr<const EmoteItemSegment> segment;
+
+        if (!segment || indexed != &emojis || indexedSize != emojis.size())
+        {
+            std::vector<EmoteItem> items;
+            addEmojis(items, emojis);
+            segment =
+                std::make_shared<const EmoteItemSegment>(std::move(items), true);
+            indexed = &emojis;
+            indexedSize = emojis.size();
+        }
+
+        return segment;
+    }
+
+    std::vector<QString> searchNames(const std::vector<EmoteItem> &items)
+    {
+        std::vector<QString> names;
+        names.reserve(items.size());
+        for (const auto &item : items)
+        {
+            names.push_back(item.searchName);
+        }
+        return names;
+    }
+
 }  // namespace
 
+EmoteItemSegment::EmoteItemSegment(std::vector<EmoteItem> items, bool indexed)
+    : items(std::move(items))
+{
+    if (indexed)
+    {
+        this->index.emplace(searchNames(this->items));
+    }
+}
+
+std::vector<size_t> EmoteItemSegment::find(const QString &query) const
+{
+    if (this->index)
+    {
+        return this->index->find(query);
+    }
+
+    std::vector<size_t> found;
+    for (size_t i = 0; i < this->items.size(); i++)
+    {
+        if (this->items[i].searchName.contains(query, Qt::CaseInsensitive))
+        {
+            found.push_back(i);
+        }
+    }
+    return found;
+}
+
 EmoteSource::EmoteSource(const Channel *channel,
                          std::unique_ptr<EmoteStrategy> strategy,
                          ActionCallback callback)
@@ -63,10 +162,29 @@ EmoteSource::EmoteSource(const Channel *channel,
 void EmoteSource::update(const QString &query)
 {
     this->output_.clear();
-    if (this->strategy_)
+    if (!this->strategy_)
+    {
+        return;
+    }
+
+    // Every strategy only includes emotes that contain the query (ignoring
+    // case), so only those are passed on
+    QString normalizedQuery = query;
+    if (normalizedQuery.startsWith(':'))
     {
-        this->strategy_->apply(this->items_, this->output_, query);
+        normalizedQuery = normalizedQuery.mid(1);
     }
+
+    std::vector<EmoteItem> candidates;
+    for (const auto &segment : this->segments_)
+    {
+        for (auto i : segment->find(normalizedQuery))
+        {
+            candidates.push_back(segment->items[i]);
+        }
+    }
+
+    this->strategy_->apply(candidates, this->output_, query);
 }
 
 void EmoteSource::addToListModel(GenericListModel &model, size_t maxCount) const
@@ -91,7 +209,7 @@ void EmoteSource::initializeFromChannel(const Channel *channel)
 {
     auto *app = getIApp();
 
-    std::vector<EmoteItem> emotes;
+    std::vector<std::shared_ptr<const EmoteItemSegment>> segments;
     const auto *tc = dynamic_cast<const TwitchChannel *>(channel);
     // returns true also for special Twitch channels (/live, /mentions, /whispers, etc.)
     if (channel->isTwitchChannel())
@@ -99,8 +217,10 @@ void EmoteSource::initializeFromChannel(const Channel *channel)
         if (auto user = app->getAccounts()->twitch.getCurrent())
         {
             // Twitch Emotes available globally
+            // These maps are modified in place, so they can't be cached
             auto emoteData = user->accessEmotes();
-            addEmotes(emotes, emoteData->emotes, "Twitch Emote");
+            segments.push_back(
+                makeSegment(emoteData->emotes, "Twitch Emote", false));
 
             // Twitch Emotes available locally
             auto localEmoteData = user->accessLocalEmotes();
@@ -109,7 +229,8 @@ void EmoteSource::initializeFromChannel(const Channel *channel)
             {
                 if (const auto *localEmotes = &localEmoteData->at(tc->roomId()))
                 {
-                    addEmotes(emotes, *localEmotes, "Local Twitch Emotes");
+                    segments.push_back(makeSegment(
+                        *localEmotes, "Local Twitch Emotes", false));
                 }
             }
         }
@@ -120,41 +241,42 @@ void EmoteSource::initializeFromChannel(const Channel *channel)
                  app->getSeventvPersonalEmotes()->getEmoteSetsForUser(
                      app->getAccounts()->twitch.getCurrent()->getUserId()))
             {
-                addEmotes(emotes, *map, "Personal 7TV");
+                segments.push_back(cachedSegment(map, "Personal 7TV"));
             }
 
             // TODO extract "Channel {BetterTTV,7TV,FrankerFaceZ}" text into a #define.
             if (auto bttv = tc->bttvEmotes())
             {
-                addEmotes(emotes, *bttv, "Channel BetterTTV");
+                segments.push_back(cachedSegment(bttv, "Channel BetterTTV"));
             }
             if (auto ffz = tc->ffzEmotes())
             {
-                addEmotes(emotes, *ffz, "Channel FrankerFaceZ");
+                segments.push_back(cachedSegment(ffz, "Channel FrankerFaceZ"));
             }
             if (auto seventv = tc->seventvEmotes())
             {
-                addEmotes(emotes, *seventv, "Channel 7TV");
+                segments.push_back(cachedSegment(seventv, "Channel 7TV"));
             }
         }
 
         if (auto bttvG = app->getBttvEmotes()->emotes())
         {
-            addEmotes(emotes, *bttvG, "Global BetterTTV");
+            segments.push_back(cachedSegment(bttvG, "Global BetterTTV"));
         }
         if (auto ffzG = app->getFfzEmotes()->emotes())
         {
-            addEmotes(emotes, *ffzG, "Global FrankerFaceZ");
+            segments.push_back(cachedSegment(ffzG, "Global FrankerFaceZ"));
         }
         if (auto seventvG = app->getSeventvEmotes()->globalEmotes())
         {
-            addEmotes(emotes, *seventvG, "Global 7TV");
+            segments.push_back(cachedSegment(seventvG, "Global 7TV"));
         }
     }
 
-    addEmojis(emotes, app->getEmotes()->getEmojis()->getEmojis());
+    segments.push_back(
+        emojiSegment(app->getEmotes()->getEmojis()->getEmojis()));
 
-    this->items_ = std::move(emotes);
+    this->segments_ = std::move(segments);
 }
 
 const std::vector<EmoteItem> &EmoteSource::output() const
@@ -2,6 +2,7 @@
 
 #include "common/Channel.hpp"
 #include "controllers/completion/sources/Source.hpp"
+#include "controllers/completion/sources/SubstringIndex.hpp"
 #include "controllers/completion/strategies/Strategy.hpp"
 #include "messages/Emote.hpp"
 
@@ -9,6 +10,7 @@
 
 #include <functional>
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace chatterino::completion {
@@ -28,6 +30,20 @@ struct EmoteItem {
     bool isEmoji{};
 };
 
+/// Emote items of one provider, optionally with an index over their names
+struct EmoteItemSegment {
+    std::vector<EmoteItem> items;
+    /// Only built for segments that are shared between sources. Building it
+    /// costs more than scanning the items for the few queries of one source.
+    std::optional<SubstringIndex> index;
+
+    EmoteItemSegment(std::vector<EmoteItem> items, bool indexed);
+
+    /// Returns the indices of the items whose search name contains `query`
+    /// (ignoring case) in ascending order
+    std::vector<size_t> find(const QString &query) const;
+};
+
 class EmoteSource : public Source
 {
 public:
@@ -56,7 +72,11 @@ private:
     std::unique_ptr<EmoteStrategy> strategy_;
     ActionCallback callback_;
 
-    std::vector<EmoteItem> items_{};
+    /// Segments in order of precedence. Segments of third-party emote maps
+    /// and emojis are shared between sources and only rebuilt when the
+    /// underlying map changes. Twitch emotes are modified in place, so their
+    /// segments are built for every source and aren't indexed.
+    std::vector<std::shared_ptr<const EmoteItemSegment>> segments_{};
     std::vector<EmoteItem> output_{};
 };
 
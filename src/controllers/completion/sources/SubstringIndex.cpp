@@ -0,0 +1,92 @@
+#include "controllers/completion/sources/SubstringIndex.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace chatterino::completion {
+
+SubstringIndex::SubstringIndex(const std::vector<QString> &names)
+{
+    this->foldedNames_.reserve(names.size());
+
+    size_t suffixCount = 0;
+    for (const auto &name : names)
+    {
+        this->foldedNames_.push_back(name.toCaseFolded());
+        suffixCount += size_t(this->foldedNames_.back().size());
+    }
+
+    this->suffixes_.reserve(suffixCount);
+    for (size_t i = 0; i < this->foldedNames_.size(); i++)
+    {
+        const auto size = this->foldedNames_[i].size();
+        for (qsizetype offset = 0; offset < size; offset++)
+        {
+            this->suffixes_.push_back({uint32_t(i), uint32_t(offset)});
+        }
+    }
+
+    std::sort(this->suffixes_.begin(), this->suffixes_.end(),
+              [this](const Suffix &a, const Suffix &b) {
+                  return this->suffixView(a) < this->suffixView(b);
+              });
+}
+
+std::vector<size_t> SubstringIndex::find(const QString &query) const
+{
+    std::vector<size_t> result;
+
+    if (query.isEmpty())
+    {
+        result.resize(this->foldedNames_.size());
+        std::iota(result.begin(), result.end(), 0);
+        return result;
+    }
+
+    const auto folded = query.toCaseFolded();
+    const QStringView needle(folded);
+
+    // All suffixes starting with the needle are adjacent
+    auto it = std::lower_bound(this->suffixes_.begin(), this->suffixes_.end(),
+                               needle,
+                               [this](const Suffix &suffix, QStringView value) {
+                                   return this->suffixView(suffix) < value;
+                               });
+    // A name can contain the needle more than once. Marking the names is
+    // cheaper than sorting when short queries match most names.
+    std::vector<bool> matched(this->foldedNames_.size());
+    size_t matchCount = 0;
+    for (; it != this->suffixes_.end() &&
+           this->suffixView(*it).startsWith(needle);
+         ++it)
+    {
+        if (!matched[it->name])
+        {
+            matched[it->name] = true;
+            matchCount++;
+        }
+    }
+
+    result.reserve(matchCount);
+    for (size_t i = 0; i < matched.size() && result.size() < matchCount; i++)
+    {
+        if (matched[i])
+        {
+            result.push_back(i);
+        }
+    }
+
+    return result;
+}
+
+size_t SubstringIndex::size() const
+{
+    return this->foldedNames_.size();
+}
+
+QStringView SubstringIndex::suffixView(const Suffix &suffix) const
+{
+    return QStringView(this->foldedNames_[suffix.name]).mid(suffix.offset);
+}
+
+}  // namespace chatterino::completion
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <QString>
+
+#include <cstdint>
+#include <vector>
+
+namespace chatterino::completion {
+
+/**
+ * @brief Case-insensitive substring index over a fixed list of names
+ *
+ * Keeps a suffix array over the case folded names, so finding all names
+ * containing a query is a binary search plus one step per match instead of
+ * a scan over every name.
+ */
+class SubstringIndex
+{
+public:
+    SubstringIndex() = default;
+    explicit SubstringIndex(const std::vector<QString> &names);
+
+    /// Returns the indices of all names containing `query` (ignoring case)
+    /// in ascending order. An empty query matches every name.
+    std::vector<size_t> find(const QString &query) const;
+
+    size_t size() const;
+
+private:
+    struct Suffix {
+        uint32_t name;
+        uint32_t offset;
+    };
+
+    QStringView suffixView(const Suffix &suffix) const;
+
+    std::vector<QString> foldedNames_;
+    std::vector<Suffix> suffixes_;
+};
+
+}  // namespace chatterino::completion
@@ -130,31 +130,44 @@ namespace {
             }
         }
 
-        std::sort(output.begin(), output.end(),
-                  [query, prioritizeUpper, ignoreColonForCost](
-                      const EmoteItem &a, const EmoteItem &b) -> bool {
-                      auto tempA = a.searchName;
-                      auto tempB = b.searchName;
-                      if (ignoreColonForCost && tempA.startsWith(":"))
-                      {
-                          tempA = tempA.mid(1);
-                      }
-                      if (ignoreColonForCost && tempB.startsWith(":"))
-                      {
-                          tempB = tempB.mid(1);
-                      }
+        // Compute the cost of every result once instead of in every comparison
+        struct Ranked {
+            int cost;
+            QString name;
+            size_t index;
+        };
+        std::vector<Ranked> ranked;
+        ranked.reserve(output.size());
+        for (size_t i = 0; i < output.size(); i++)
+        {
+            auto name = output[i].searchName;
+            if (ignoreColonForCost && name.startsWith(":"))
+            {
+                name = name.mid(1);
+            }
+            auto cost = costOfEmote(query, name, prioritizeUpper);
+            ranked.push_back({cost, std::move(name), i});
+        }
 
-                      auto costA = costOfEmote(query, tempA, prioritizeUpper);
-                      auto costB = costOfEmote(query, tempB, prioritizeUpper);
-                      if (costA == costB)
+        std::sort(ranked.begin(), ranked.end(),
+                  [](const Ranked &a, const Ranked &b) -> bool {
+                      if (a.cost == b.cost)
                       {
                           // Case difference and length came up tied for (a, b), break the tie
-                          return QString::compare(tempA, tempB,
+                          return QString::compare(a.name, b.name,
                                                   Qt::CaseInsensitive) < 0;
                       }
 
-                      return costA < costB;
+                      return a.cost < b.cost;
                   });
+
+        std::vector<EmoteItem> sorted;
+        sorted.reserve(output.size());
+        for (const auto &entry : ranked)
+        {
+            sorted.push_back(std::move(output[entry.index]));
+        }
+        output = std::move(sorted);
     }
 }  // namespace
 
@@ -28,7 +28,7 @@ public:
 
     bool valid() const;
 
-    bool filter(const filters::ContextMap &context) const;
+    bool filter(const filters::MessageContext &context) const;
 
     bool operator==(const FilterRecord &other) const;
 
@@ -42,7 +42,7 @@ bool FilterSet::filter(const MessagePtr &m, ChannelPtr channel) const
         return true;
     }
 
-    filters::ContextMap context = filters::buildContextMap(m, channel.get());
+    filters::MessageContext context{*m, channel.get()};
     for (const auto &f : this->filters_.values())
     {
         if (!f->valid() || !f->filter(context))
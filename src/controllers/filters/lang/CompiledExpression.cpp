@@ -0,0 +1,79 @@
+#include "controllers/filters/lang/CompiledExpression.hpp"
+
+#include <cassert>
+
+namespace chatterino::filters {
+
+CompiledExpression CompiledExpression::fromConstant(QVariant constant)
+{
+    CompiledExpression compiled;
+    compiled.constant = std::move(constant);
+    return compiled;
+}
+
+void CompiledExpression::finalize()
+{
+    if (this->constant)
+    {
+        this->value = [value = *this->constant](const MessageContext &) {
+            return value;
+        };
+        this->boolean = [value = this->constant->toBool()](
+                            const MessageContext &) {
+            return value;
+        };
+        this->integer = [value = this->constant->toInt()](
+                            const MessageContext &) {
+            return value;
+        };
+        this->string = [value = this->constant->toString()](
+                           const MessageContext &) {
+            return value;
+        };
+        return;
+    }
+
+    if (!this->value)
+    {
+        if (this->boolean)
+        {
+            this->value = [fn = this->boolean](const MessageContext &context) {
+                return QVariant(fn(context));
+            };
+        }
+        else if (this->integer)
+        {
+            this->value = [fn = this->integer](const MessageContext &context) {
+                return QVariant(fn(context));
+            };
+        }
+        else
+        {
+            assert(this->string);
+            this->value = [fn = this->string](const MessageContext &context) {
+                return QVariant(fn(context));
+            };
+        }
+    }
+
+    if (!this->boolean)
+    {
+        this->boolean = [fn = this->value](const MessageContext &context) {
+            return fn(context).toBool();
+        };
+    }
+    if (!this->integer)
+    {
+        this->integer = [fn = this->value](const MessageContext &context) {
+            return fn(context).toInt();
+        };
+    }
+    if (!this->string)
+    {
+        this->string = [fn = this->value](const MessageContext &context) {
+            return fn(context).toString();
+        };
+    }
+}
+
+}  // namespace chatterino::filters
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "controllers/filters/lang/Types.hpp"
+
+#include <QString>
+#include <QVariant>
+
+#include <functional>
+#include <optional>
+
+namespace chatterino {
+
+class Channel;
+struct Message;
+
+}  // namespace chatterino
+
+namespace chatterino::filters {
+
+/// The message a compiled filter is evaluated on
+struct MessageContext {
+    const Message &message;
+    Channel *channel;
+};
+
+/**
+ * @brief Closure form of an Expression, built by Expression::compile
+ *
+ * Identifiers are resolved to getters that only read the message field they
+ * refer to, parts that don't depend on the message are folded into constants
+ * and operators whose operand types are known up front skip the QVariant
+ * conversions done in Expression::execute.
+ *
+ * After Expression::compile returns, all closures are set. The typed ones are
+ * equal to value(context).toBool(), .toInt() and .toString().
+ */
+struct CompiledExpression {
+    template <typename T>
+    using Fn = std::function<T(const MessageContext &)>;
+
+    Fn<QVariant> value;
+    Fn<bool> boolean;
+    Fn<int> integer;
+    Fn<QString> string;
+
+    /// Type of the expression, empty if it's ill-typed
+    std::optional<Type> type;
+    /// Set if the result doesn't depend on the message
+    std::optional<QVariant> constant;
+
+    static CompiledExpression fromConstant(QVariant constant);
+
+    /// Fills the closures that weren't set by the expression.
+    /// An expression sets either `constant`, `value` or one of the typed closures.
+    void finalize();
+};
+
+}  // namespace chatterino::filters
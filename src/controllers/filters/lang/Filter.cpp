@@ -8,137 +8,184 @@
 #include "providers/twitch/TwitchChannel.hpp"
 #include "providers/twitch/TwitchIrcServer.hpp"
 
+#include <algorithm>
+
 namespace chatterino::filters {
 
-ContextMap buildContextMap(const MessagePtr &m, chatterino::Channel *channel)
-{
-    auto watchingChannel = getIApp()->getTwitch()->getWatchingChannel().get();
-
-    /* 
-     * Looking to add a new identifier to filters? Here's what to do: 
-     *  1. Update validIdentifiersMap in Tokenizer.hpp
-     *  2. Add the identifier to the list below
-     *  3. Add the type of the identifier to MESSAGE_TYPING_CONTEXT in Filter.hpp
-     *  4. Add the value for the identifier to the ContextMap returned by this function
-     * 
-     * List of identifiers:
-     *
-     * author.badges
-     * author.color
-     * author.name
-     * author.no_color
-     * author.subbed
-     * author.sub_length
-     *
-     * channel.name
-     * channel.watching
-     *
-     * flags.highlighted
-     * flags.points_redeemed
-     * flags.sub_message
-     * flags.system_message
-     * flags.reward_message
-     * flags.first_message
-     * flags.elevated_message
-     * flags.cheer_message
-     * flags.whisper
-     * flags.reply
-     * flags.automod
-     * flags.restricted
-     * flags.monitored
-     *
-     * message.content
-     * message.length
-     *
-     * reward.title
-     * reward.cost
-     * reward.id
-     */
+namespace {
 
     using MessageFlag = chatterino::MessageFlag;
 
-    QStringList badges;
-    badges.reserve(m->badges.size());
-    for (const auto &e : m->badges)
+    template <MessageFlag flag>
+    QVariant hasFlag(const MessageContext &ctx)
     {
-        badges << e.key_;
+        return ctx.message.flags.has(flag);
     }
 
-    bool watching = !watchingChannel->getName().isEmpty() &&
-                    watchingChannel->getName().compare(
-                        m->channelName, Qt::CaseInsensitive) == 0;
-
-    bool subscribed = false;
-    int subLength = 0;
-    for (const auto &subBadge : {"subscriber", "founder"})
+    bool hasBadge(const Message &m, const QString &key)
     {
-        if (!badges.contains(subBadge))
-        {
-            continue;
-        }
-        subscribed = true;
-        if (m->badgeInfos.find(subBadge) != m->badgeInfos.end())
-        {
-            subLength = m->badgeInfos.at(subBadge).toInt();
-        }
+        return std::any_of(m.badges.begin(), m.badges.end(),
+                           [&](const auto &badge) {
+                               return badge.key_ == key;
+                           });
     }
-    ContextMap vars = {
-        {"author.badges", std::move(badges)},
-        {"author.color", m->usernameColor},
-        {"author.name", m->displayName},
-        {"author.no_color", !m->usernameColor.isValid()},
-        {"author.subbed", subscribed},
-        {"author.sub_length", subLength},
-
-        {"channel.name", m->channelName},
-        {"channel.watching", watching},
-
-        {"flags.action", m->flags.has(MessageFlag::Action)},
-        {"flags.highlighted", m->flags.has(MessageFlag::Highlighted)},
-        {"flags.points_redeemed", m->flags.has(MessageFlag::RedeemedHighlight)},
-        {"flags.sub_message", m->flags.has(MessageFlag::Subscription)},
-        {"flags.system_message", m->flags.has(MessageFlag::System)},
-        {"flags.reward_message",
-         m->flags.has(MessageFlag::RedeemedChannelPointReward)},
-        {"flags.first_message", m->flags.has(MessageFlag::FirstMessage)},
-        {"flags.elevated_message", m->flags.has(MessageFlag::ElevatedMessage)},
-        {"flags.hype_chat", m->flags.has(MessageFlag::ElevatedMessage)},
-        {"flags.cheer_message", m->flags.has(MessageFlag::CheerMessage)},
-        {"flags.whisper", m->flags.has(MessageFlag::Whisper)},
-        {"flags.reply", m->flags.has(MessageFlag::ReplyMessage)},
-        {"flags.automod", m->flags.has(MessageFlag::AutoMod)},
-        {"flags.restricted", m->flags.has(MessageFlag::RestrictedMessage)},
-        {"flags.monitored", m->flags.has(MessageFlag::MonitoredMessage)},
-
-        {"message.content", m->messageText},
-        {"message.length", m->messageText.length()},
-    };
+
+    QVariant authorSubLength(const MessageContext &ctx)
     {
-        auto *tc = dynamic_cast<TwitchChannel *>(channel);
-        if (channel && !channel->isEmpty() && tc)
-        {
-            vars["channel.live"] = tc->isLive();
-        }
-        else
+        const auto &m = ctx.message;
+
+        int subLength = 0;
+        for (const auto *subBadge : {"subscriber", "founder"})
         {
-            vars["channel.live"] = false;
+            if (!hasBadge(m, subBadge))
+            {
+                continue;
+            }
+            auto it = m.badgeInfos.find(subBadge);
+            if (it != m.badgeInfos.end())
+            {
+                subLength = it->second.toInt();
+            }
         }
+        return subLength;
     }
-    if (m->reward != nullptr)
+
+    /*
+     * Looking to add a new identifier to filters? Here's what to do:
+     *  1. Update validIdentifiersMap in Tokenizer.hpp
+     *  2. Add the type of the identifier to MESSAGE_TYPING_CONTEXT in Filter.hpp
+     *  3. Add a getter for the identifier to the map below
+     */
+    const QMap<QString, MessageFieldGetter> &messageFieldGetters()
     {
-        vars["reward.title"] = m->reward->title;
-        vars["reward.cost"] = m->reward->cost;
-        vars["reward.id"] = m->reward->id;
+        static const QMap<QString, MessageFieldGetter> getters = {
+            {"author.badges",
+             [](const MessageContext &ctx) -> QVariant {
+                 QStringList badges;
+                 badges.reserve(
+                     static_cast<qsizetype>(ctx.message.badges.size()));
+                 for (const auto &e : ctx.message.badges)
+                 {
+                     badges << e.key_;
+                 }
+                 return badges;
+             }},
+            {"author.color",
+             [](const MessageContext &ctx) -> QVariant {
+                 return ctx.message.usernameColor;
+             }},
+            {"author.name",
+             [](const MessageContext &ctx) -> QVariant {
+                 return ctx.message.displayName;
+             }},
+            {"author.no_color",
+             [](const MessageContext &ctx) -> QVariant {
+                 return !ctx.message.usernameColor.isValid();
+             }},
+            {"author.subbed",
+             [](const MessageContext &ctx) -> QVariant {
+                 return hasBadge(ctx.message, "subscriber") ||
+                        hasBadge(ctx.message, "founder");
+             }},
+            {"author.sub_length", &authorSubLength},
+
+            {"channel.name",
+             [](const MessageContext &ctx) -> QVariant {
+                 return ctx.message.channelName;
+             }},
+            {"channel.watching",
+             [](const MessageContext &ctx) -> QVariant {
+                 auto watchingChannel =
+                     getIApp()->getTwitch()->getWatchingChannel().get();
+                 return !watchingChannel->getName().isEmpty() &&
+                        watchingChannel->getName().compare(
+                            ctx.message.channelName, Qt::CaseInsensitive) == 0;
+             }},
+            {"channel.live",
+             [](const MessageContext &ctx) -> QVariant {
+                 auto *tc = dynamic_cast<TwitchChannel *>(ctx.channel);
+                 return ctx.channel && !ctx.channel->isEmpty() && tc &&
+                        tc->isLive();
+             }},
+
+            {"flags.action", &hasFlag<MessageFlag::Action>},
+            {"flags.highlighted", &hasFlag<MessageFlag::Highlighted>},
+            {"flags.points_redeemed",
+             &hasFlag<MessageFlag::RedeemedHighlight>},
+            {"flags.sub_message", &hasFlag<MessageFlag::Subscription>},
+            {"flags.system_message", &hasFlag<MessageFlag::System>},
+            {"flags.reward_message",
+             &hasFlag<MessageFlag::RedeemedChannelPointReward>},
+            {"flags.first_message", &hasFlag<MessageFlag::FirstMessage>},
+            {"flags.elevated_message", &hasFlag<MessageFlag::ElevatedMessage>},
+            {"flags.hype_chat", &hasFlag<MessageFlag::ElevatedMessage>},
+            {"flags.cheer_message", &hasFlag<MessageFlag::CheerMessage>},
+            {"flags.whisper", &hasFlag<MessageFlag::Whisper>},
+            {"flags.reply", &hasFlag<MessageFlag::ReplyMessage>},
+            {"flags.automod", &hasFlag<MessageFlag::AutoMod>},
+            {"flags.restricted", &hasFlag<MessageFlag::RestrictedMessage>},
+            {"flags.monitored", &hasFlag<MessageFlag::MonitoredMessage>},
+
+            {"message.content",
+             [](const MessageContext &ctx) -> QVariant {
+                 return ctx.message.messageText;
+             }},
+            {"message.length",
+             [](const MessageContext &ctx) -> QVariant {
+                 return ctx.message.messageText.length();
+             }},
+
+            {"reward.title",
+             [](const MessageContext &ctx) -> QVariant {
+                 if (ctx.message.reward == nullptr)
+                 {
+                     return "";
+                 }
+                 return ctx.message.reward->title;
+             }},
+            {"reward.cost",
+             [](const MessageContext &ctx) -> QVariant {
+                 if (ctx.message.reward == nullptr)
+                 {
+                     return -1;
+                 }
+                 return ctx.message.reward->cost;
+             }},
+            {"reward.id",
+             [](const MessageContext &ctx) -> QVariant {
+                 if (ctx.message.reward == nullptr)
+                 {
+                     return "";
+                 }
+                 return ctx.message.reward->id;
+             }},
+        };
+        return getters;
     }
-    else
+
+}  // namespace
+
+ContextMap buildContextMap(const MessagePtr &m, chatterino::Channel *channel)
+{
+    MessageContext context{*m, channel};
+
+    ContextMap vars;
+    for (auto it = MESSAGE_TYPING_CONTEXT.keyBegin();
+         it != MESSAGE_TYPING_CONTEXT.keyEnd(); ++it)
     {
-        vars["reward.title"] = "";
-        vars["reward.cost"] = -1;
-        vars["reward.id"] = "";
+        if (auto *getter = messageFieldGetter(*it))
+        {
+            vars.insert(*it, getter(context));
+        }
     }
     return vars;
 }
 
+MessageFieldGetter messageFieldGetter(const QString &identifier)
+{
+    return messageFieldGetters().value(identifier, nullptr);
+}
+
 FilterResult Filter::fromString(const QString &str)
 {
     FilterParser parser(str);
@@ -156,6 +203,7 @@ FilterResult Filter::fromString(const QString &str)
 Filter::Filter(ExpressionPtr expression, Type returnType)
     : expression_(std::move(expression))
     , returnType_(returnType)
+    , compiled_(this->expression_->compile(MESSAGE_TYPING_CONTEXT))
 {
 }
 
@@ -169,6 +217,16 @@ QVariant Filter::execute(const ContextMap &context) const
     return this->expression_->execute(context);
 }
 
+QVariant Filter::execute(const MessageContext &context) const
+{
+    return this->compiled_.value(context);
+}
+
+bool Filter::matches(const MessageContext &context) const
+{
+    return this->compiled_.boolean(context);
+}
+
 QString Filter::filterString() const
 {
     return this->expression_->filterString();
@@ -56,6 +56,12 @@ static const QMap<QString, Type> MESSAGE_TYPING_CONTEXT = {
 
 ContextMap buildContextMap(const MessagePtr &m, chatterino::Channel *channel);
 
+using MessageFieldGetter = QVariant (*)(const MessageContext &);
+
+/// Returns the getter for a variable of MESSAGE_TYPING_CONTEXT, or nullptr if
+/// there's no such variable
+MessageFieldGetter messageFieldGetter(const QString &identifier);
+
 class Filter;
 struct FilterError {
     QString message;
@@ -69,8 +75,15 @@ public:
     static FilterResult fromString(const QString &str);
 
     Type returnType() const;
+
+    /// Interprets the expression tree with all variables taken from `context`
     QVariant execute(const ContextMap &context) const;
 
+    /// Evaluates the compiled filter, reading only the fields it uses
+    QVariant execute(const MessageContext &context) const;
+    /// Same as execute(context).toBool() without the QVariant in between
+    bool matches(const MessageContext &context) const;
+
     QString filterString() const;
     QString debugString(const TypingContext &context) const;
 
@@ -79,6 +92,7 @@ private:
 
     ExpressionPtr expression_;
     Type returnType_;
+    CompiledExpression compiled_;
 };
 
 }  // namespace chatterino::filters
@@ -37,23 +37,11 @@ bool looselyCompareVariants(QVariant &lhs, QVariant &rhs)
     return lhs == rhs;
 }
 
-}  // namespace
-
-namespace chatterino::filters {
+using namespace chatterino::filters;
 
-BinaryOperation::BinaryOperation(TokenType op, ExpressionPtr left,
-                                 ExpressionPtr right)
-    : op_(op)
-    , left_(std::move(left))
-    , right_(std::move(right))
+QVariant evaluate(TokenType op, QVariant left, QVariant right)
 {
-}
-
-QVariant BinaryOperation::execute(const ContextMap &context) const
-{
-    auto left = this->left_->execute(context);
-    auto right = this->right_->execute(context);
-    switch (this->op_)
+    switch (op)
     {
         case PLUS:
             if (static_cast<QMetaType::Type>(left.type()) ==
@@ -269,6 +257,253 @@ QVariant BinaryOperation::execute(const ContextMap &context) const
     }
 }
 
+}  // namespace
+
+namespace chatterino::filters {
+
+BinaryOperation::BinaryOperation(TokenType op, ExpressionPtr left,
+                                 ExpressionPtr right)
+    : op_(op)
+    , left_(std::move(left))
+    , right_(std::move(right))
+{
+}
+
+QVariant BinaryOperation::execute(const ContextMap &context) const
+{
+    return evaluate(this->op_, this->left_->execute(context),
+                    this->right_->execute(context));
+}
+
+CompiledExpression BinaryOperation::compileImpl(
+    const TypingContext &context) const
+{
+    auto left = this->left_->compile(context);
+    auto right = this->right_->compile(context);
+
+    if (left.constant && right.constant)
+    {
+        return CompiledExpression::fromConstant(
+            evaluate(this->op_, *left.constant, *right.constant));
+    }
+
+    const auto both = [&](Type type) {
+        return left.type == type && right.type == type;
+    };
+
+    // Operands with known types take the same branch as evaluate would
+    // without going through QVariant
+    CompiledExpression compiled;
+    switch (this->op_)
+    {
+        case AND:
+            if (both(Type::Bool))
+            {
+                compiled.boolean = [l = std::move(left.boolean),
+                                    r = std::move(right.boolean)](
+                                       const MessageContext &ctx) {
+                    return l(ctx) && r(ctx);
+                };
+                return compiled;
+            }
+            break;
+        case OR:
+            if (both(Type::Bool))
+            {
+                compiled.boolean = [l = std::move(left.boolean),
+                                    r = std::move(right.boolean)](
+                                       const MessageContext &ctx) {
+                    return l(ctx) || r(ctx);
+                };
+                return compiled;
+            }
+            break;
+        case PLUS:
+            if (both(Type::Int))
+            {
+                compiled.integer = [l = std::move(left.integer),
+                                    r = std::move(right.integer)](
+                                       const MessageContext &ctx) {
+                    return l(ctx) + r(ctx);
+                };
+                return compiled;
+            }
+            if (both(Type::String))
+            {
+                compiled.string = [l = std::move(left.string),
+                                   r = std::move(right.string)](
+                                      const MessageContext &ctx) {
+                    return l(ctx).append(r(ctx));
+                };
+                return compiled;
+            }
+            break;
+        case MINUS:
+            if (both(Type::Int))
+            {
+                compiled.integer = [l = std::move(left.integer),
+                                    r = std::move(right.integer)](
+                                       const MessageContext &ctx) {
+                    return l(ctx) - r(ctx);
+                };
+                return compiled;
+            }
+            break;
+        case MULTIPLY:
+            if (both(Type::Int))
+            {
+                compiled.integer = [l = std::move(left.integer),
+                                    r = std::move(right.integer)](
+                                       const MessageContext &ctx) {
+                    return l(ctx) * r(ctx);
+                };
+                return compiled;
+            }
+            break;
+        case EQ:
+        case NEQ: {
+            const bool negate = this->op_ == NEQ;
+            if (both(Type::Int))
+            {
+                compiled.boolean = [l = std::move(left.integer),
+                                    r = std::move(right.integer),
+                                    negate](const MessageContext &ctx) {
+                    return (l(ctx) == r(ctx)) != negate;
+                };
+                return compiled;
+            }
+            if (both(Type::Bool))
+            {
+                compiled.boolean = [l = std::move(left.boolean),
+                                    r = std::move(right.boolean),
+                                    negate](const MessageContext &ctx) {
+                    return (l(ctx) == r(ctx)) != negate;
+                };
+                return compiled;
+            }
+            if (both(Type::String))
+            {
+                compiled.boolean = [l = std::move(left.string),
+                                    r = std::move(right.string),
+                                    negate](const MessageContext &ctx) {
+                    return (l(ctx).compare(r(ctx), Qt::CaseInsensitive) ==
+                            0) != negate;
+                };
+                return compiled;
+            }
+        }
+        break;
+        case LT:
+        case GT:
+        case LTE:
+        case GTE:
+            if (both(Type::Int))
+            {
+                compiled.boolean = [l = std::move(left.integer),
+                                    r = std::move(right.integer),
+                                    op = this->op_](const MessageContext &ctx) {
+                    auto a = l(ctx);
+                    auto b = r(ctx);
+                    switch (op)
+                    {
+                        case LT:
+                            return a < b;
+                        case GT:
+                            return a > b;
+                        case LTE:
+                            return a <= b;
+                        default:
+                            return a >= b;
+                    }
+                };
+                return compiled;
+            }
+            break;
+        case CONTAINS:
+            if (left.type == Type::StringList && right.type == Type::String)
+            {
+                compiled.boolean = [l = std::move(left.value),
+                                    r = std::move(right.string)](
+                                       const MessageContext &ctx) {
+                    return l(ctx).toStringList().contains(r(ctx),
+                                                          Qt::CaseInsensitive);
+                };
+                return compiled;
+            }
+            if (both(Type::String))
+            {
+                compiled.boolean = [l = std::move(left.string),
+                                    r = std::move(right.string)](
+                                       const MessageContext &ctx) {
+                    return l(ctx).contains(r(ctx), Qt::CaseInsensitive);
+                };
+                return compiled;
+            }
+            break;
+        case STARTS_WITH:
+            if (both(Type::String))
+            {
+                compiled.boolean = [l = std::move(left.string),
+                                    r = std::move(right.string)](
+                                       const MessageContext &ctx) {
+                    return l(ctx).startsWith(r(ctx), Qt::CaseInsensitive);
+                };
+                return compiled;
+            }
+            break;
+        case ENDS_WITH:
+            if (both(Type::String))
+            {
+                compiled.boolean = [l = std::move(left.string),
+                                    r = std::move(right.string)](
+                                       const MessageContext &ctx) {
+                    return l(ctx).endsWith(r(ctx), Qt::CaseInsensitive);
+                };
+                return compiled;
+            }
+            break;
+        case MATCH:
+            if (left.type != Type::String || !right.constant)
+            {
+                break;
+            }
+            if (right.type == Type::RegularExpression)
+            {
+                compiled.boolean =
+                    [l = std::move(left.string),
+                     regex = right.constant->toRegularExpression()](
+                        const MessageContext &ctx) {
+                        return regex.match(l(ctx)).hasMatch();
+                    };
+                return compiled;
+            }
+            if (right.type == Type::MatchingSpecifier)
+            {
+                auto list = right.constant->toList();
+                compiled.string =
+                    [l = std::move(left.string),
+                     regex = list.at(0).toRegularExpression(),
+                     group = list.at(1).toInt()](const MessageContext &ctx) {
+                        auto match = regex.match(l(ctx));
+                        if (match.hasMatch())
+                        {
+                            return match.captured(group);
+                        }
+                        return QString("");
+                    };
+                return compiled;
+            }
+            break;
+        default:
+            break;
+    }
+
+    compiled.value = [op = this->op_, l = std::move(left.value),
+                      r = std::move(right.value)](const MessageContext &ctx) {
+        return evaluate(op, l(ctx), r(ctx));
+    };
+    return compiled;
+}
 PossibleType BinaryOperation::synthesizeType(const TypingContext &context) const
 {
     auto leftSyn = this->left_->synthesizeType(context);
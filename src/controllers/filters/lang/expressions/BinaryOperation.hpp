@@ -15,6 +15,9 @@ public:
     QString debug(const TypingContext &context) const override;
     QString filterString() const override;
 
+protected:
+    CompiledExpression compileImpl(const TypingContext &context) const override;
+
 private:
     TokenType op_;
     ExpressionPtr left_;
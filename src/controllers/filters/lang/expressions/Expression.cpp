@@ -2,4 +2,18 @@
 
 namespace chatterino::filters {
 
+CompiledExpression Expression::compile(const TypingContext &context) const
+{
+    auto compiled = this->compileImpl(context);
+
+    auto type = this->synthesizeType(context);
+    if (isWellTyped(type))
+    {
+        compiled.type = std::get<TypeClass>(type).type;
+    }
+
+    compiled.finalize();
+    return compiled;
+}
+
 }  // namespace chatterino::filters
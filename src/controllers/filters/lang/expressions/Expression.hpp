@@ -1,5 +1,6 @@
 #pragma once
 
+#include "controllers/filters/lang/CompiledExpression.hpp"
 #include "controllers/filters/lang/Tokenizer.hpp"
 #include "controllers/filters/lang/Types.hpp"
 
@@ -20,6 +21,14 @@ public:
     virtual PossibleType synthesizeType(const TypingContext &context) const = 0;
     virtual QString debug(const TypingContext &context) const = 0;
     virtual QString filterString() const = 0;
+
+    /// Builds the closure form of this expression, see CompiledExpression
+    CompiledExpression compile(const TypingContext &context) const;
+
+protected:
+    /// Sets either the constant, the value or one of the typed closures
+    virtual CompiledExpression compileImpl(
+        const TypingContext &context) const = 0;
 };
 
 using ExpressionPtr = std::unique_ptr<Expression>;
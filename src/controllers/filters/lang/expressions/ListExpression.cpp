@@ -1,22 +1,19 @@
 #include "controllers/filters/lang/expressions/ListExpression.hpp"
 
-namespace chatterino::filters {
+namespace {
 
-ListExpression::ListExpression(ExpressionList &&list)
-    : list_(std::move(list)){};
+using namespace chatterino::filters;
 
-QVariant ListExpression::execute(const ContextMap &context) const
+QVariant makeList(const QList<QVariant> &results)
 {
-    QList<QVariant> results;
     bool allStrings = true;
-    for (const auto &exp : this->list_)
+    for (const auto &res : results)
     {
-        auto res = exp->execute(context);
-        if (allStrings && variantIsNot(res, QMetaType::QString))
+        if (variantIsNot(res, QMetaType::QString))
         {
             allStrings = false;
+            break;
         }
-        results.append(res);
     }
 
     // if everything is a string return a QStringList for case-insensitive comparison
@@ -34,6 +31,63 @@ QVariant ListExpression::execute(const ContextMap &context) const
     return results;
 }
 
+}  // namespace
+
+namespace chatterino::filters {
+
+ListExpression::ListExpression(ExpressionList &&list)
+    : list_(std::move(list)){};
+
+QVariant ListExpression::execute(const ContextMap &context) const
+{
+    QList<QVariant> results;
+    results.reserve(static_cast<qsizetype>(this->list_.size()));
+    for (const auto &exp : this->list_)
+    {
+        results.append(exp->execute(context));
+    }
+
+    return makeList(results);
+}
+
+CompiledExpression ListExpression::compileImpl(
+    const TypingContext &context) const
+{
+    std::vector<CompiledExpression::Fn<QVariant>> items;
+    QList<QVariant> constants;
+    bool allConstant = true;
+    for (const auto &exp : this->list_)
+    {
+        auto compiled = exp->compile(context);
+        if (compiled.constant)
+        {
+            constants.append(*compiled.constant);
+        }
+        else
+        {
+            allConstant = false;
+        }
+        items.push_back(std::move(compiled.value));
+    }
+
+    if (allConstant)
+    {
+        return CompiledExpression::fromConstant(makeList(constants));
+    }
+
+    CompiledExpression compiled;
+    compiled.value = [items = std::move(items)](const MessageContext &ctx) {
+        QList<QVariant> results;
+        results.reserve(static_cast<qsizetype>(items.size()));
+        for (const auto &item : items)
+        {
+            results.append(item(ctx));
+        }
+        return makeList(results);
+    };
+    return compiled;
+}
+
 PossibleType ListExpression::synthesizeType(const TypingContext &context) const
 {
     std::vector<TypeClass> types;
@@ -14,6 +14,12 @@ QVariant RegexExpression::execute(const ContextMap & /*context*/) const
     return this->regex_;
 }
 
+CompiledExpression RegexExpression::compileImpl(
+    const TypingContext & /*context*/) const
+{
+    return CompiledExpression::fromConstant(this->regex_);
+}
+
 PossibleType RegexExpression::synthesizeType(
     const TypingContext & /*context*/) const
 {
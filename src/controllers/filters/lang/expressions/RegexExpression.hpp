@@ -17,6 +17,9 @@ public:
     QString debug(const TypingContext &context) const override;
     QString filterString() const override;
 
+protected:
+    CompiledExpression compileImpl(const TypingContext &context) const override;
+
 private:
     QString regexString_;
     bool caseInsensitive_;
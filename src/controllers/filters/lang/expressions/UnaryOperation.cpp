@@ -1,5 +1,22 @@
 #include "controllers/filters/lang/expressions/UnaryOperation.hpp"
 
+namespace {
+
+using namespace chatterino::filters;
+
+QVariant evaluate(TokenType op, const QVariant &right)
+{
+    switch (op)
+    {
+        case NOT:
+            return right.canConvert<bool>() && !right.toBool();
+        default:
+            return false;
+    }
+}
+
+}  // namespace
+
 namespace chatterino::filters {
 
 UnaryOperation::UnaryOperation(TokenType op, ExpressionPtr right)
@@ -10,14 +27,35 @@ UnaryOperation::UnaryOperation(TokenType op, ExpressionPtr right)
 
 QVariant UnaryOperation::execute(const ContextMap &context) const
 {
-    auto right = this->right_->execute(context);
-    switch (this->op_)
+    return evaluate(this->op_, this->right_->execute(context));
+}
+
+CompiledExpression UnaryOperation::compileImpl(
+    const TypingContext &context) const
+{
+    auto right = this->right_->compile(context);
+
+    if (right.constant)
     {
-        case NOT:
-            return right.canConvert<bool>() && !right.toBool();
-        default:
-            return false;
+        return CompiledExpression::fromConstant(
+            evaluate(this->op_, *right.constant));
+    }
+
+    CompiledExpression compiled;
+    if (this->op_ == NOT && right.type == Type::Bool)
+    {
+        compiled.boolean = [r = std::move(right.boolean)](
+                               const MessageContext &ctx) {
+            return !r(ctx);
+        };
+        return compiled;
     }
+
+    compiled.value = [op = this->op_,
+                      r = std::move(right.value)](const MessageContext &ctx) {
+        return evaluate(op, r(ctx));
+    };
+    return compiled;
 }
 
 PossibleType UnaryOperation::synthesizeType(const TypingContext &context) const
@@ -1,5 +1,6 @@
 #include "controllers/filters/lang/expressions/ValueExpression.hpp"
 
+#include "controllers/filters/lang/Filter.hpp"
 #include "controllers/filters/lang/Tokenizer.hpp"
 
 namespace chatterino::filters {
@@ -19,6 +20,26 @@ QVariant ValueExpression::execute(const ContextMap &context) const
     return this->value_;
 }
 
+CompiledExpression ValueExpression::compileImpl(
+    const TypingContext & /*context*/) const
+{
+    if (this->type_ != TokenType::IDENTIFIER)
+    {
+        return CompiledExpression::fromConstant(this->value_);
+    }
+
+    auto *getter = messageFieldGetter(this->value_.toString());
+    if (getter == nullptr)
+    {
+        // Same as looking up a missing key in the ContextMap
+        return CompiledExpression::fromConstant({});
+    }
+
+    CompiledExpression compiled;
+    compiled.value = getter;
+    return compiled;
+}
+
 PossibleType ValueExpression::synthesizeType(const TypingContext &context) const
 {
     switch (this->type_)
@@ -16,6 +16,9 @@ public:
     QString debug(const TypingContext &context) const override;
     QString filterString() const override;
 
+protected:
+    CompiledExpression compileImpl(const TypingContext &context) const override;
+
 private:
     QVariant value_;
     TokenType type_;
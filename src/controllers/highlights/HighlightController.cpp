@@ -5,6 +5,7 @@
 #include "controllers/accounts/AccountController.hpp"
 #include "controllers/highlights/HighlightBadge.hpp"
 #include "controllers/highlights/HighlightPhrase.hpp"
+#include "controllers/highlights/HighlightPhraseMatcher.hpp"
 #include "messages/Message.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "providers/colors/ColorProvider.hpp"
@@ -17,40 +18,80 @@ namespace {
 
 using namespace chatterino;
 
-auto highlightPhraseCheck(const HighlightPhrase &highlight) -> HighlightCheck
+/// Adds the side-effects of `other` that aren't set in `result` yet
+void mergeHighlightResult(HighlightResult &result, const HighlightResult &other)
 {
-    return HighlightCheck{
-        [highlight](const auto &args, const auto &badges,
-                    const auto &senderName, const auto &originalMessage,
-                    const auto &flags,
-                    const auto self) -> std::optional<HighlightResult> {
-            (void)args;        // unused
-            (void)badges;      // unused
-            (void)senderName;  // unused
-            (void)flags;       // unused
+    if (other.alert && !result.alert)
+    {
+        result.alert = other.alert;
+    }
+
+    if (other.playSound && !result.playSound)
+    {
+        result.playSound = other.playSound;
+    }
+
+    if (other.customSoundUrl && !result.customSoundUrl)
+    {
+        result.customSoundUrl = other.customSoundUrl;
+    }
+
+    if (other.color && !result.color)
+    {
+        result.color = other.color;
+    }
+
+    if (other.showInMentions && !result.showInMentions)
+    {
+        result.showInMentions = other.showInMentions;
+    }
+}
+
+/**
+ * Checks all message phrases at once. The results of the matching phrases are
+ * merged in the order of the phrases, which gives the same result as having
+ * one check per phrase.
+ */
+auto highlightPhrasesCheck(std::vector<HighlightPhrase> phrases)
+    -> HighlightCheck
+{
+    auto matcher = std::make_shared<const HighlightPhraseMatcher>(
+        std::move(phrases));
 
+    return HighlightCheck{
+        [matcher](const auto & /*args*/, const auto & /*badges*/,
+                  const auto & /*senderName*/, const auto &originalMessage,
+                  const auto & /*flags*/,
+                  const auto self) -> std::optional<HighlightResult> {
             if (self)
             {
                 // Phrase checks should ignore highlights from the user
                 return std::nullopt;
             }
 
-            if (!highlight.isMatch(originalMessage))
+            std::optional<HighlightResult> result;
+            for (const auto *highlight : matcher->match(originalMessage))
             {
-                return std::nullopt;
-            }
+                std::optional<QUrl> highlightSoundUrl;
+                if (highlight->hasCustomSound())
+                {
+                    highlightSoundUrl = highlight->getSoundUrl();
+                }
 
-            std::optional<QUrl> highlightSoundUrl;
-            if (highlight.hasCustomSound())
-            {
-                highlightSoundUrl = highlight.getSoundUrl();
+                HighlightResult phraseResult{
+                    highlight->hasAlert(),       highlight->hasSound(),
+                    highlightSoundUrl,           highlight->getColor(),
+                    highlight->showInMentions(),
+                };
+
+                if (!result)
+                {
+                    result = HighlightResult::emptyResult();
+                }
+                mergeHighlightResult(*result, phraseResult);
             }
 
-            return HighlightResult{
-                highlight.hasAlert(),       highlight.hasSound(),
-                highlightSoundUrl,          highlight.getColor(),
-                highlight.showInMentions(),
-            };
+            return result;
         }};
 }
 
@@ -186,23 +227,26 @@ void rebuildMessageHighlights(Settings &settings,
     auto currentUser = getIApp()->getAccounts()->twitch.getCurrent();
     QString currentUsername = currentUser->getUserName();
 
+    std::vector<HighlightPhrase> phrases;
+
     if (settings.enableSelfHighlight && !currentUsername.isEmpty() &&
         !currentUser->isAnon())
     {
-        HighlightPhrase highlight(
+        phrases.emplace_back(
             currentUsername, settings.showSelfHighlightInMentions,
             settings.enableSelfHighlightTaskbar,
             settings.enableSelfHighlightSound, false, false,
             settings.selfHighlightSoundUrl.getValue(),
             ColorProvider::instance().color(ColorType::SelfHighlight));
-
-        checks.emplace_back(highlightPhraseCheck(highlight));
     }
 
     auto messageHighlights = settings.highlightedMessages.readOnly();
-    for (const auto &highlight : *messageHighlights)
+    phrases.insert(phrases.end(), messageHighlights->begin(),
+                   messageHighlights->end());
+
+    if (!phrases.empty())
     {
-        checks.emplace_back(highlightPhraseCheck(highlight));
+        checks.emplace_back(highlightPhrasesCheck(std::move(phrases)));
     }
 
     if (settings.enableAutomodHighlight)
@@ -561,45 +605,7 @@ std::pair<bool, HighlightResult> HighlightController::check(
         {
             highlighted = true;
 
-            if (checkResult->alert)
-            {
-                if (!result.alert)
-                {
-                    result.alert = checkResult->alert;
-                }
-            }
-
-            if (checkResult->playSound)
-            {
-                if (!result.playSound)
-                {
-                    result.playSound = checkResult->playSound;
-                }
-            }
-
-            if (checkResult->customSoundUrl)
-            {
-                if (!result.customSoundUrl)
-                {
-                    result.customSoundUrl = checkResult->customSoundUrl;
-                }
-            }
-
-            if (checkResult->color)
-            {
-                if (!result.color)
-                {
-                    result.color = checkResult->color;
-                }
-            }
-
-            if (checkResult->showInMentions)
-            {
-                if (!result.showInMentions)
-                {
-                    result.showInMentions = checkResult->showInMentions;
-                }
-            }
+            mergeHighlightResult(result, *checkResult);
 
             if (result.full())
             {
@@ -0,0 +1,301 @@
+#include "controllers/highlights/HighlightPhraseMatcher.hpp"
+
+#include <algorithm>
+#include <deque>
+
+namespace {
+
+/// Simple case folding that keeps the length in UTF-16 code units, so
+/// positions in the folded string are valid in the original string.
+QString foldCase(const QString &str)
+{
+    QString folded(str.size(), Qt::Uninitialized);
+    auto *out = folded.data();
+
+    for (qsizetype i = 0; i < str.size(); ++i)
+    {
+        auto c = str.at(i);
+        if (c.isHighSurrogate() && i + 1 < str.size() &&
+            str.at(i + 1).isLowSurrogate())
+        {
+            auto low = str.at(i + 1);
+            auto cp = QChar::toCaseFolded(QChar::surrogateToUcs4(c, low));
+            if (QChar::requiresSurrogates(cp))
+            {
+                out[i] = QChar(QChar::highSurrogate(cp));
+                out[i + 1] = QChar(QChar::lowSurrogate(cp));
+            }
+            else
+            {
+                out[i] = c;
+                out[i + 1] = low;
+            }
+            ++i;
+            continue;
+        }
+
+        auto cp = QChar::toCaseFolded(static_cast<char32_t>(c.unicode()));
+        out[i] = QChar::requiresSurrogates(cp)
+                     ? c
+                     : QChar(static_cast<char16_t>(cp));
+    }
+
+    return folded;
+}
+
+char32_t codePointAt(const QString &str, qsizetype pos)
+{
+    auto c = str.at(pos);
+    if (c.isHighSurrogate() && pos + 1 < str.size() &&
+        str.at(pos + 1).isLowSurrogate())
+    {
+        return QChar::surrogateToUcs4(c, str.at(pos + 1));
+    }
+    return c.unicode();
+}
+
+char32_t codePointBefore(const QString &str, qsizetype pos)
+{
+    auto c = str.at(pos - 1);
+    if (c.isLowSurrogate() && pos >= 2 && str.at(pos - 2).isHighSurrogate())
+    {
+        return QChar::surrogateToUcs4(str.at(pos - 2), c);
+    }
+    return c.unicode();
+}
+
+/// \w with QRegularExpression::UseUnicodePropertiesOption
+bool isWordChar(char32_t c)
+{
+    return c == U'_' || QChar::isLetterOrNumber(c);
+}
+
+/// (\b|\s|^) before `start`
+bool isStartBoundary(const QString &str, qsizetype start)
+{
+    if (start == 0)
+    {
+        return true;
+    }
+
+    auto before = codePointBefore(str, start);
+    return QChar::isSpace(before) ||
+           isWordChar(before) != isWordChar(codePointAt(str, start));
+}
+
+/// (\b|\s|$) after `end`
+bool isEndBoundary(const QString &str, qsizetype end)
+{
+    if (end == str.size())
+    {
+        return true;
+    }
+
+    auto after = codePointAt(str, end);
+    return QChar::isSpace(after) ||
+           isWordChar(codePointBefore(str, end)) != isWordChar(after);
+}
+
+}  // namespace
+
+namespace chatterino {
+
+HighlightPhraseMatcher::Automaton::Automaton()
+    : nodes_(1)
+{
+}
+
+void HighlightPhraseMatcher::Automaton::add(const QString &pattern,
+                                            uint32_t phrase)
+{
+    uint32_t node = 0;
+    for (auto qc : pattern)
+    {
+        auto c = static_cast<char16_t>(qc.unicode());
+        auto child = this->findEdge(node, c);
+        if (child == 0)
+        {
+            child = static_cast<uint32_t>(this->nodes_.size());
+            this->nodes_.emplace_back();
+
+            auto &edges = this->nodes_[node].edges;
+            auto it = std::lower_bound(edges.begin(), edges.end(), c,
+                                       [](const auto &edge, char16_t c) {
+                                           return edge.first < c;
+                                       });
+            edges.insert(it, {c, child});
+        }
+        node = child;
+    }
+
+    this->nodes_[node].outputs.push_back(phrase);
+}
+
+void HighlightPhraseMatcher::Automaton::build()
+{
+    std::deque<uint32_t> queue;
+    for (auto [c, child] : this->nodes_[0].edges)
+    {
+        queue.push_back(child);
+    }
+
+    // Breadth-first, so the failure target is always done before its users
+    while (!queue.empty())
+    {
+        auto node = queue.front();
+        queue.pop_front();
+
+        for (auto [c, child] : this->nodes_[node].edges)
+        {
+            auto fail = this->nodes_[node].fail;
+            while (fail != 0 && this->findEdge(fail, c) == 0)
+            {
+                fail = this->nodes_[fail].fail;
+            }
+            auto target = this->findEdge(fail, c);
+
+            this->nodes_[child].fail = target;
+            const auto &inherited = this->nodes_[target].outputs;
+            auto &outputs = this->nodes_[child].outputs;
+            outputs.insert(outputs.end(), inherited.begin(), inherited.end());
+
+            queue.push_back(child);
+        }
+    }
+}
+
+bool HighlightPhraseMatcher::Automaton::empty() const
+{
+    return this->nodes_.size() == 1;
+}
+
+uint32_t HighlightPhraseMatcher::Automaton::findEdge(uint32_t node,
+                                                     char16_t c) const
+{
+    const auto &edges = this->nodes_[node].edges;
+    auto it = std::lower_bound(edges.begin(), edges.end(), c,
+                               [](const auto &edge, char16_t c) {
+                                   return edge.first < c;
+                               });
+    if (it != edges.end() && it->first == c)
+    {
+        return it->second;
+    }
+    return 0;
+}
+
+uint32_t HighlightPhraseMatcher::Automaton::next(uint32_t node,
+                                                 char16_t c) const
+{
+    while (true)
+    {
+        if (auto target = this->findEdge(node, c); target != 0)
+        {
+            return target;
+        }
+        if (node == 0)
+        {
+            return 0;
+        }
+        node = this->nodes_[node].fail;
+    }
+}
+
+template <typename F>
+void HighlightPhraseMatcher::Automaton::scan(const QString &text,
+                                             F &&onMatch) const
+{
+    uint32_t node = 0;
+    for (qsizetype i = 0; i < text.size(); ++i)
+    {
+        node = this->next(node, static_cast<char16_t>(text.at(i).unicode()));
+        for (auto phrase : this->nodes_[node].outputs)
+        {
+            onMatch(phrase, i + 1);
+        }
+    }
+}
+
+HighlightPhraseMatcher::HighlightPhraseMatcher(
+    std::vector<HighlightPhrase> phrases)
+    : phrases_(std::move(phrases))
+    , lengths_(this->phrases_.size(), 0)
+{
+    for (uint32_t i = 0; i < this->phrases_.size(); ++i)
+    {
+        const auto &phrase = this->phrases_[i];
+        if (!phrase.isValid())
+        {
+            continue;
+        }
+
+        if (phrase.isRegex())
+        {
+            this->regexPhrases_.push_back(i);
+            continue;
+        }
+
+        this->lengths_[i] = phrase.getPattern().size();
+        if (phrase.isCaseSensitive())
+        {
+            this->caseSensitive_.add(phrase.getPattern(), i);
+        }
+        else
+        {
+            this->caseInsensitive_.add(foldCase(phrase.getPattern()), i);
+        }
+    }
+
+    this->caseSensitive_.build();
+    this->caseInsensitive_.build();
+}
+
+std::vector<const HighlightPhrase *> HighlightPhraseMatcher::match(
+    const QString &subject) const
+{
+    std::vector<bool> matched(this->phrases_.size(), false);
+
+    auto onMatch = [&](uint32_t phrase, qsizetype end) {
+        if (matched[phrase])
+        {
+            return;
+        }
+
+        auto start = end - this->lengths_[phrase];
+        if (isStartBoundary(subject, start) && isEndBoundary(subject, end))
+        {
+            matched[phrase] = true;
+        }
+    };
+
+    if (!this->caseSensitive_.empty())
+    {
+        this->caseSensitive_.scan(subject, onMatch);
+    }
+    if (!this->caseInsensitive_.empty())
+    {
+        this->caseInsensitive_.scan(foldCase(subject), onMatch);
+    }
+
+    for (auto i : this->regexPhrases_)
+    {
+        matched[i] = this->phrases_[i].isMatch(subject);
+    }
+
+    std::vector<const HighlightPhrase *> result;
+    for (size_t i = 0; i < matched.size(); ++i)
+    {
+        if (matched[i])
+        {
+            result.push_back(&this->phrases_[i]);
+        }
+    }
+    return result;
+}
+
+const std::vector<HighlightPhrase> &HighlightPhraseMatcher::phrases() const
+{
+    return this->phrases_;
+}
+
+}  // namespace chatterino
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "controllers/highlights/HighlightPhrase.hpp"
+
+#include <QString>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace chatterino {
+
+/**
+ * @brief Matches a list of highlight phrases against a message in one pass
+ *
+ * Phrases that aren't regular expressions are compiled into two Aho-Corasick
+ * automatons, one for case-sensitive phrases and one for case-insensitive
+ * phrases, which run over the message once. Every occurrence found is then
+ * checked for the same word boundaries HighlightPhrase uses
+ * (`(\b|\s|^)phrase(\b|\s|$)`). Regular expression phrases are still matched
+ * one by one.
+ *
+ * This class is immutable after construction and can be shared between
+ * threads.
+ */
+class HighlightPhraseMatcher
+{
+public:
+    explicit HighlightPhraseMatcher(std::vector<HighlightPhrase> phrases);
+
+    /// Returns all phrases matching `subject`, in the order they were given
+    std::vector<const HighlightPhrase *> match(const QString &subject) const;
+
+    const std::vector<HighlightPhrase> &phrases() const;
+
+private:
+    class Automaton
+    {
+    public:
+        Automaton();
+
+        void add(const QString &pattern, uint32_t phrase);
+        /// Computes the failure links, must be called once after all adds
+        void build();
+
+        bool empty() const;
+
+        /// Calls `onMatch(phrase, end)` for every occurrence of a pattern
+        /// ending right before `end`.
+        template <typename F>
+        void scan(const QString &text, F &&onMatch) const;
+
+    private:
+        struct Node {
+            /// Sorted by character
+            std::vector<std::pair<char16_t, uint32_t>> edges;
+            uint32_t fail = 0;
+            /// Phrases ending in this node, including the ones of the
+            /// failure chain
+            std::vector<uint32_t> outputs;
+        };
+
+        uint32_t next(uint32_t node, char16_t c) const;
+        uint32_t findEdge(uint32_t node, char16_t c) const;
+
+        std::vector<Node> nodes_;
+    };
+
+    std::vector<HighlightPhrase> phrases_;
+    /// Length of the pattern of every phrase in UTF-16 code units
+    std::vector<qsizetype> lengths_;
+    /// Indices of valid regex phrases
+    std::vector<uint32_t> regexPhrases_;
+
+    Automaton caseSensitive_;
+    Automaton caseInsensitive_;
+};
+
+}  // namespace chatterino
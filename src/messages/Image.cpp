@@ -7,28 +7,42 @@
 #include "common/QLogging.hpp"
 #include "debug/AssertInGuiThread.hpp"
 #include "debug/Benchmark.hpp"
+#include "messages/ImageAtlas.hpp"
+#include "messages/ImageCache.hpp"
 #include "singletons/Emotes.hpp"
 #include "singletons/helper/GifTimer.hpp"
+#include "singletons/Settings.hpp"
 #include "singletons/WindowManager.hpp"
 #include "util/DebugCount.hpp"
 #include "util/PostToThread.hpp"
 
 #include <boost/functional/hash.hpp>
 #include <QBuffer>
+#include <QElapsedTimer>
 #include <QImageReader>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QNetworkRequest>
+#include <QPainter>
+#include <QtConcurrent>
+#include <QThreadPool>
 #include <QTimer>
 
 #include <functional>
-#include <queue>
 #include <thread>
 
 // Duration between each check of every Image instance
 const auto IMAGE_POOL_CLEANUP_INTERVAL = std::chrono::minutes(1);
 // Duration since last usage of Image pixmap before expiration of frames
 const auto IMAGE_POOL_IMAGE_LIFETIME = std::chrono::minutes(10);
+// Time the GUI thread may spend converting decoded frames to pixmaps before
+// yielding back to the event loop
+const auto TICK_BUDGET = std::chrono::milliseconds(4);
+// Delay before the first conversion tick, to batch images that are decoded
+// at around the same time
+const auto FIRST_TICK_DELAY = std::chrono::milliseconds(10);
+// Minimum interval between layouts while frames are still being converted
+const auto LAYOUT_INTERVAL = std::chrono::milliseconds(100);
 
 namespace chatterino {
 namespace detail {
@@ -48,6 +62,11 @@ namespace detail {
             DebugCount::increase("loaded images");
         }
 
+        if (getSettings()->useImageAtlas)
+        {
+            this->packIntoAtlas();
+        }
+
         if (this->animated())
         {
             DebugCount::increase("animated images");
@@ -93,6 +112,10 @@ namespace detail {
         {
             DebugCount::decrease("animated images");
         }
+        if (!this->regions_.empty())
+        {
+            DebugCount::decrease("atlas images");
+        }
         DebugCount::decrease("image bytes", this->memoryUsage());
         DebugCount::increase("image bytes (ever unloaded)",
                              this->memoryUsage());
@@ -114,6 +137,32 @@ namespace detail {
         return usage;
     }
 
+    void Frames::packIntoAtlas()
+    {
+        if (this->items_.empty())
+        {
+            return;
+        }
+
+        for (const auto &frame : this->items_)
+        {
+            if (!ImageAtlas::supports(frame.image.size()))
+            {
+                return;
+            }
+        }
+
+        this->regions_.reserve(this->items_.size());
+        for (auto &frame : this->items_)
+        {
+            this->regions_.push_back(ImageAtlas::instance().insert(frame.image));
+            // The atlas holds the pixels now
+            frame.image = QPixmap();
+        }
+
+        DebugCount::increase("atlas images");
+    }
+
     void Frames::advance()
     {
         this->durationOffset_ += GIF_FRAME_LENGTH;
@@ -154,7 +203,13 @@ namespace detail {
         DebugCount::increase("image bytes (ever unloaded)",
                              this->memoryUsage());
 
+        if (!this->regions_.empty())
+        {
+            DebugCount::decrease("atlas images");
+        }
+
         this->items_.clear();
+        this->regions_.clear();
         this->index_ = 0;
         this->durationOffset_ = 0;
         this->gifTimerConnection_.disconnect();
@@ -177,6 +232,11 @@ namespace detail {
             return std::nullopt;
         }
 
+        if (!this->regions_.empty())
+        {
+            return this->regions_[this->index_]->standalone();
+        }
+
         return this->items_[this->index_].image;
     }
 
@@ -187,11 +247,70 @@ namespace detail {
             return std::nullopt;
         }
 
+        if (!this->regions_.empty())
+        {
+            return this->regions_.front()->standalone();
+        }
+
         return this->items_.front().image;
     }
 
+    std::optional<QSize> Frames::firstSize() const
+    {
+        if (this->items_.empty())
+        {
+            return std::nullopt;
+        }
+
+        if (!this->regions_.empty())
+        {
+            return this->regions_.front()->rect().size();
+        }
+
+        return this->items_.front().image.size();
+    }
+
+    int Frames::index() const
+    {
+        return this->index_;
+    }
+
+    bool Frames::paintCurrent(QPainter &painter, const QRectF &rect) const
+    {
+        if (this->items_.empty())
+        {
+            return false;
+        }
+
+        if (!this->regions_.empty())
+        {
+            const auto &region = this->regions_[this->index_];
+            painter.drawPixmap(rect, region->pixmap(), QRectF(region->rect()));
+        }
+        else
+        {
+            painter.drawPixmap(rect, this->items_[this->index_].image,
+                               QRectF());
+        }
+
+        return true;
+    }
+
     // functions
-    QVector<Frame<QImage>> readFrames(QImageReader &reader, const Url &url)
+    QThreadPool &decodePool()
+    {
+        static auto *pool = [] {
+            auto *pool = new QThreadPool;
+            // Leave room for the network and GUI threads
+            pool->setMaxThreadCount(
+                std::max(2, QThread::idealThreadCount() / 2));
+            return pool;
+        }();
+        return *pool;
+    }
+
+    QVector<Frame<QImage>> readFrames(QImageReader &reader, const Url &url,
+                                      const FirstFrameCallback &onFirstFrame)
     {
         QVector<Frame<QImage>> frames;
         frames.reserve(reader.imageCount());
@@ -212,7 +331,18 @@ namespace detail {
                     duration = 100;
                 }
                 duration = std::max(20, duration);
-                frames.push_back(Frame<QImage>{std::move(image), duration});
+                // Premultiplied is what the raster paint engine uses, so
+                // converting here keeps that work off the GUI thread and
+                // lets the frames be cached as-is.
+                frames.push_back(Frame<QImage>{
+                    image.convertToFormat(QImage::Format_ARGB32_Premultiplied),
+                    duration});
+
+                if (frames.size() == 1 && onFirstFrame &&
+                    reader.imageCount() > 1)
+                {
+                    onFirstFrame(frames.front());
+                }
             }
         }
 
@@ -226,69 +356,99 @@ namespace detail {
         return frames;
     }
 
-    // parsed
-    template <typename Assign>
-    void assignDelayed(
-        std::queue<std::pair<Assign, QVector<Frame<QPixmap>>>> &queued,
-        std::mutex &mutex, std::atomic_bool &loadedEventQueued)
+    FrameHandoff &FrameHandoff::instance()
     {
-        std::lock_guard<std::mutex> lock(mutex);
-        int i = 0;
+        static auto *instance = new FrameHandoff;
+        return *instance;
+    }
 
-        while (!queued.empty())
-        {
-            auto front = std::move(queued.front());
-            queued.pop();
+    void FrameHandoff::push(QVector<Frame<QImage>> frames, Assign assign,
+                            bool preview)
+    {
+        std::lock_guard lock(this->mutex_);
 
-            // Call Assign with the vector of frames
-            front.first(std::move(front.second));
+        auto &queue = preview ? this->incomingPreviews_ : this->incoming_;
+        queue.push_back({std::move(frames), {}, std::move(assign)});
 
-            if (++i > 50)
-            {
-                QTimer::singleShot(3, [&] {
-                    assignDelayed(queued, mutex, loadedEventQueued);
+        if (!this->tickQueued_)
+        {
+            this->tickQueued_ = true;
+
+            // Give other images that finish decoding around the same time a
+            // chance to be handled in the same tick.
+            postToThread([this] {
+                QTimer::singleShot(FIRST_TICK_DELAY, [this] {
+                    this->tick();
                 });
-                return;
-            }
+            });
         }
-
-        getIApp()->getWindows()->forceLayoutChannelViews();
-
-        loadedEventQueued = false;
     }
 
-    template <typename Assign>
-    auto makeConvertCallback(const QVector<Frame<QImage>> &parsed,
-                             Assign assign)
+    void FrameHandoff::tick()
     {
-        static std::queue<std::pair<Assign, QVector<Frame<QPixmap>>>> queued;
-        static std::mutex mutex;
-        static std::atomic_bool loadedEventQueued{false};
+        assertInGuiThread();
 
-        return [parsed, assign] {
-            // convert to pixmap
-            QVector<Frame<QPixmap>> frames;
-            frames.reserve(parsed.size());
-            std::transform(parsed.begin(), parsed.end(),
-                           std::back_inserter(frames), [](auto &frame) {
-                               return Frame<QPixmap>{
-                                   QPixmap::fromImage(frame.image),
-                                   frame.duration};
-                           });
+        {
+            std::lock_guard lock(this->mutex_);
+            std::move(this->incomingPreviews_.begin(),
+                      this->incomingPreviews_.end(),
+                      std::back_inserter(this->previews_));
+            this->incomingPreviews_.clear();
+            std::move(this->incoming_.begin(), this->incoming_.end(),
+                      std::back_inserter(this->pending_));
+            this->incoming_.clear();
+        }
 
-            // put into stack
-            std::lock_guard<std::mutex> lock(mutex);
-            queued.emplace(assign, frames);
+        QElapsedTimer timer;
+        timer.start();
 
-            if (!loadedEventQueued)
+        // First frames of animated images go before complete images
+        while (timer.elapsed() < TICK_BUDGET.count())
+        {
+            auto &queue = this->previews_.empty() ? this->pending_
+                                                  : this->previews_;
+            if (queue.empty())
             {
-                loadedEventQueued = true;
+                break;
+            }
 
-                QTimer::singleShot(100, [=] {
-                    assignDelayed(queued, mutex, loadedEventQueued);
-                });
+            auto &front = queue.front();
+            auto index = front.pixmaps.size();
+            if (index < front.images.size())
+            {
+                const auto &frame = front.images[index];
+                front.pixmaps.push_back(
+                    {QPixmap::fromImage(frame.image), frame.duration});
+                continue;
             }
-        };
+
+            front.assign(std::move(front.pixmaps));
+            queue.pop_front();
+            this->assignedSinceLayout_ = true;
+        }
+
+        bool idle = this->previews_.empty() && this->pending_.empty();
+
+        if (this->assignedSinceLayout_ &&
+            (idle || !this->lastLayout_.isValid() ||
+             this->lastLayout_.elapsed() > LAYOUT_INTERVAL.count()))
+        {
+            getIApp()->getWindows()->forceLayoutChannelViews();
+            this->lastLayout_.start();
+            this->assignedSinceLayout_ = false;
+        }
+
+        std::lock_guard lock(this->mutex_);
+        if (idle && this->incomingPreviews_.empty() && this->incoming_.empty())
+        {
+            this->tickQueued_ = false;
+            return;
+        }
+
+        DebugCount::increase("image handoff ticks over budget");
+        QTimer::singleShot(0, [this] {
+            this->tick();
+        });
     }
 }  // namespace detail
 
@@ -441,6 +601,18 @@ std::optional<QPixmap> Image::pixmapOrLoad() const
     return this->frames_->current();
 }
 
+bool Image::paintOrLoad(QPainter &painter, const QRectF &rect) const
+{
+    assertInGuiThread();
+
+    // See pixmapOrLoad
+    this->lastUsed_ = std::chrono::steady_clock::now();
+
+    this->load();
+
+    return this->frames_->paintCurrent(painter, rect);
+}
+
 void Image::load() const
 {
     assertInGuiThread();
@@ -473,13 +645,20 @@ bool Image::animated() const
     return this->frames_->animated();
 }
 
+int Image::frameIndex() const
+{
+    assertInGuiThread();
+
+    return this->frames_->index();
+}
+
 int Image::width() const
 {
     assertInGuiThread();
 
-    if (auto pixmap = this->frames_->first())
+    if (auto size = this->frames_->firstSize())
     {
-        return static_cast<int>(pixmap->width() * this->scale_);
+        return static_cast<int>(size->width() * this->scale_);
     }
 
     // No frames loaded, use the expected size
@@ -490,9 +669,9 @@ int Image::height() const
 {
     assertInGuiThread();
 
-    if (auto pixmap = this->frames_->first())
+    if (auto size = this->frames_->firstSize())
     {
-        return static_cast<int>(pixmap->height() * this->scale_);
+        return static_cast<int>(size->height() * this->scale_);
     }
 
     // No frames loaded, use the expected size
@@ -502,69 +681,43 @@ int Image::height() const
 void Image::actuallyLoad()
 {
     auto weak = weakOf(this);
-    NetworkRequest(this->url().string)
-        .concurrent()
-        .cache()
-        .onSuccess([weak](auto result) {
-            auto shared = weak.lock();
-            if (!shared)
+    std::ignore = QtConcurrent::run(
+        &detail::decodePool(), [weak, url = this->url()] {
+            if (auto cached = ImageCache::instance().load(url))
             {
+                detail::FrameHandoff::instance().push(
+                    std::move(*cached), Image::frameAssigner(weak));
                 return;
             }
 
-            auto data = result.getData();
-
-            // const cast since we are only reading from it
-            QBuffer buffer(const_cast<QByteArray *>(&data));
-            buffer.open(QIODevice::ReadOnly);
-            QImageReader reader(&buffer);
-
-            if (!reader.canRead())
-            {
-                qCDebug(chatterinoImage)
-                    << "Error: image cant be read " << shared->url().string;
-                shared->empty_ = true;
-                return;
-            }
-
-            const auto size = reader.size();
-            if (size.isEmpty())
-            {
-                shared->empty_ = true;
-                return;
-            }
+            Image::loadFromNetwork(weak, url);
+        });
+}
 
-            // returns 1 for non-animated formats
-            if (reader.imageCount() <= 0)
-            {
-                qCDebug(chatterinoImage)
-                    << "Error: image has less than 1 frame "
-                    << shared->url().string << ": " << reader.errorString();
-                shared->empty_ = true;
-                return;
-            }
+void Image::loadFromNetwork(const std::weak_ptr<Image> &weak, const Url &url)
+{
+    // Images are loaded once they're painted, so they're in view
+    auto request = NetworkRequest(url.string)
+                       .concurrent()
+                       .priority(QNetworkRequest::HighPriority);
+    if (!ImageCache::instance().enabled())
+    {
+        // Without the image cache, at least keep the encoded image around
+        request = std::move(request).cache();
+    }
 
-            // use "double" to prevent int overflows
-            if (double(size.width()) * double(size.height()) *
-                    double(reader.imageCount()) * 4.0 >
-                double(Image::maxBytesRam))
+    std::move(request)
+        .onSuccess([weak](auto result) {
+            if (weak.expired())
             {
-                qCDebug(chatterinoImage) << "image too large in RAM";
-
-                shared->empty_ = true;
                 return;
             }
 
-            auto parsed = detail::readFrames(reader, shared->url());
-
-            postToThread(makeConvertCallback(
-                parsed, [weak = std::weak_ptr<Image>(shared)](auto &&frames) {
-                    if (auto shared = weak.lock())
-                    {
-                        shared->frames_ = std::make_unique<detail::Frames>(
-                            std::forward<decltype(frames)>(frames));
-                    }
-                }));
+            // Don't block the shared thread pool with decoding
+            std::ignore = QtConcurrent::run(
+                &detail::decodePool(), [weak, data = result.getData()] {
+                    Image::decode(weak, data);
+                });
         })
         .onError([weak](auto /*result*/) {
             auto shared = weak.lock();
@@ -581,6 +734,79 @@ void Image::actuallyLoad()
         .execute();
 }
 
+void Image::decode(const std::weak_ptr<Image> &weak, const QByteArray &data)
+{
+    auto shared = weak.lock();
+    if (!shared)
+    {
+        return;
+    }
+
+    // const cast since we are only reading from it
+    QBuffer buffer(const_cast<QByteArray *>(&data));
+    buffer.open(QIODevice::ReadOnly);
+    QImageReader reader(&buffer);
+
+    if (!reader.canRead())
+    {
+        qCDebug(chatterinoImage)
+            << "Error: image cant be read " << shared->url().string;
+        shared->empty_ = true;
+        return;
+    }
+
+    const auto size = reader.size();
+    if (size.isEmpty())
+    {
+        shared->empty_ = true;
+        return;
+    }
+
+    // returns 1 for non-animated formats
+    if (reader.imageCount() <= 0)
+    {
+        qCDebug(chatterinoImage) << "Error: image has less than 1 frame "
+                                 << shared->url().string << ": "
+                                 << reader.errorString();
+        shared->empty_ = true;
+        return;
+    }
+
+    // use "double" to prevent int overflows
+    if (double(size.width()) * double(size.height()) *
+            double(reader.imageCount()) * 4.0 >
+        double(Image::maxBytesRam))
+    {
+        qCDebug(chatterinoImage) << "image too large in RAM";
+
+        shared->empty_ = true;
+        return;
+    }
+
+    // Show the first frame of animated images while the rest is decoded
+    auto parsed = detail::readFrames(
+        reader, shared->url(), [&weak](const auto &firstFrame) {
+            detail::FrameHandoff::instance().push(
+                {firstFrame}, Image::frameAssigner(weak), true);
+        });
+
+    ImageCache::instance().store(shared->url(), parsed);
+
+    detail::FrameHandoff::instance().push(std::move(parsed),
+                                          Image::frameAssigner(weak));
+}
+
+detail::FrameHandoff::Assign Image::frameAssigner(std::weak_ptr<Image> weak)
+{
+    return [weak = std::move(weak)](QVector<detail::Frame<QPixmap>> &&frames) {
+        if (auto shared = weak.lock())
+        {
+            shared->frames_ =
+                std::make_unique<detail::Frames>(std::move(frames));
+        }
+    };
+}
+
 void Image::expireFrames()
 {
     assertInGuiThread();
@@ -5,7 +5,9 @@
 
 #include <boost/variant.hpp>
 #include <pajlada/signals/signal.hpp>
+#include <QElapsedTimer>
 #include <QPixmap>
+#include <QRectF>
 #include <QString>
 #include <QThread>
 #include <QTimer>
@@ -13,12 +15,20 @@
 
 #include <atomic>
 #include <chrono>
+#include <deque>
+#include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <vector>
+
+class QPainter;
 
 namespace chatterino {
+
+class ImageAtlasRegion;
+
 namespace detail {
     template <typename Image>
     struct Frame {
@@ -44,15 +54,69 @@ namespace detail {
         void advance();
         std::optional<QPixmap> current() const;
         std::optional<QPixmap> first() const;
+        std::optional<QSize> firstSize() const;
+        /// Index of the current frame
+        int index() const;
+        /// Paints the current frame, returns false if there is none
+        bool paintCurrent(QPainter &painter, const QRectF &rect) const;
 
     private:
         int64_t memoryUsage() const;
         void processOffset();
+        void packIntoAtlas();
         QVector<Frame<QPixmap>> items_;
+        /// If the frames are packed into the ImageAtlas, the pixmaps in items_
+        /// are null and this holds one region per frame.
+        std::vector<std::unique_ptr<ImageAtlasRegion>> regions_;
         int index_{0};
         int durationOffset_{0};
         pajlada::Signals::Connection gifTimerConnection_;
     };
+
+    using FirstFrameCallback = std::function<void(const Frame<QImage> &)>;
+
+    /**
+     * @brief Hands decoded frames over to the GUI thread
+     *
+     * Frames have to be converted to QPixmap on the GUI thread. Instead of
+     * converting a fixed number of images at once, every event loop tick
+     * converts frames until a time budget is used up. First frames of
+     * animated images are converted before complete images, so they show up
+     * while the rest of the animation is still being decoded.
+     */
+    class FrameHandoff
+    {
+    public:
+        using Assign = std::function<void(QVector<Frame<QPixmap>> &&)>;
+
+        static FrameHandoff &instance();
+
+        /// Queues frames to be converted and passed to `assign`. Thread safe.
+        void push(QVector<Frame<QImage>> frames, Assign assign,
+                  bool preview = false);
+
+    private:
+        FrameHandoff() = default;
+
+        void tick();
+
+        struct Pending {
+            QVector<Frame<QImage>> images;
+            QVector<Frame<QPixmap>> pixmaps;
+            Assign assign;
+        };
+
+        std::mutex mutex_;
+        std::deque<Pending> incoming_;
+        std::deque<Pending> incomingPreviews_;
+        bool tickQueued_{false};
+
+        // gui thread only
+        std::deque<Pending> pending_;
+        std::deque<Pending> previews_;
+        QElapsedTimer lastLayout_;
+        bool assignedSinceLayout_{false};
+    };
 }  // namespace detail
 
 class Image;
@@ -82,12 +146,18 @@ public:
     bool loaded() const;
     // either returns the current pixmap, or triggers loading it (lazy loading)
     std::optional<QPixmap> pixmapOrLoad() const;
+    // either paints the current frame into rect, or triggers loading it
+    // returns true if something was painted
+    bool paintOrLoad(QPainter &painter, const QRectF &rect) const;
     void load() const;
     qreal scale() const;
     bool isEmpty() const;
     int width() const;
     int height() const;
     bool animated() const;
+    /// Index of the frame that's currently shown, changes as the GIF timer
+    /// advances animated images
+    int frameIndex() const;
 
     bool operator==(const Image &image) = delete;
     bool operator!=(const Image &image) = delete;
@@ -99,6 +169,12 @@ private:
 
     void setPixmap(const QPixmap &pixmap);
     void actuallyLoad();
+    static void loadFromNetwork(const std::weak_ptr<Image> &weak,
+                                const Url &url);
+    static void decode(const std::weak_ptr<Image> &weak,
+                       const QByteArray &data);
+    static detail::FrameHandoff::Assign frameAssigner(
+        std::weak_ptr<Image> weak);
     void expireFrames();
 
     const Url url_{};
@@ -0,0 +1,204 @@
+#include "messages/ImageAtlas.hpp"
+
+#include "debug/AssertInGuiThread.hpp"
+#include "util/DebugCount.hpp"
+
+#include <QPainter>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <optional>
+
+namespace {
+
+// Width and height of a page, 1 MiB per page at 32 bits per pixel
+constexpr int PAGE_SIZE = 512;
+
+constexpr std::array<int, 3> CELL_SIZES{28, 56, 112};
+
+}  // namespace
+
+namespace chatterino {
+
+class ImageAtlasPage
+{
+public:
+    explicit ImageAtlasPage(int cellSize)
+        : cellSize_(cellSize)
+        , columns_(PAGE_SIZE / cellSize)
+        , pixmap_(PAGE_SIZE, PAGE_SIZE)
+    {
+        this->pixmap_.fill(Qt::transparent);
+
+        const auto cells = this->columns_ * this->columns_;
+        this->freeCells_.reserve(cells);
+        // Hand out cells from the top left first
+        for (int i = cells - 1; i >= 0; --i)
+        {
+            this->freeCells_.push_back(i);
+        }
+
+        DebugCount::increase("image atlas pages");
+        DebugCount::increase("image atlas cells total", cells);
+        DebugCount::increase("image atlas bytes",
+                             int64_t(PAGE_SIZE) * PAGE_SIZE * 4);
+    }
+
+    ~ImageAtlasPage()
+    {
+        DebugCount::decrease("image atlas pages");
+        DebugCount::decrease("image atlas cells total",
+                             this->columns_ * this->columns_);
+        DebugCount::decrease("image atlas bytes",
+                             int64_t(PAGE_SIZE) * PAGE_SIZE * 4);
+    }
+
+    ImageAtlasPage(const ImageAtlasPage &) = delete;
+    ImageAtlasPage &operator=(const ImageAtlasPage &) = delete;
+
+    ImageAtlasPage(ImageAtlasPage &&) = delete;
+    ImageAtlasPage &operator=(ImageAtlasPage &&) = delete;
+
+    bool full() const
+    {
+        return this->freeCells_.empty();
+    }
+
+    std::optional<int> allocate(const QPixmap &pixmap)
+    {
+        if (this->freeCells_.empty())
+        {
+            return std::nullopt;
+        }
+
+        auto cell = this->freeCells_.back();
+        this->freeCells_.pop_back();
+
+        QPainter painter(&this->pixmap_);
+        // Overwrite whatever a previous region left in this cell
+        painter.setCompositionMode(QPainter::CompositionMode_Source);
+        painter.drawPixmap(this->cellRect(cell), pixmap);
+
+        DebugCount::increase("image atlas cells used");
+        return cell;
+    }
+
+    void release(int cell)
+    {
+        this->freeCells_.push_back(cell);
+        DebugCount::decrease("image atlas cells used");
+    }
+
+    QRect cellRect(int cell) const
+    {
+        return {
+            (cell % this->columns_) * this->cellSize_,
+            (cell / this->columns_) * this->cellSize_,
+            this->cellSize_,
+            this->cellSize_,
+        };
+    }
+
+    const QPixmap &pixmap() const
+    {
+        return this->pixmap_;
+    }
+
+private:
+    const int cellSize_;
+    const int columns_;
+    QPixmap pixmap_;
+    std::vector<int> freeCells_;
+};
+
+ImageAtlasRegion::ImageAtlasRegion(std::shared_ptr<ImageAtlasPage> page,
+                                   int cell)
+    : page_(std::move(page))
+    , cell_(cell)
+{
+}
+
+ImageAtlasRegion::~ImageAtlasRegion()
+{
+    assertInGuiThread();
+    this->page_->release(this->cell_);
+}
+
+const QPixmap &ImageAtlasRegion::pixmap() const
+{
+    return this->page_->pixmap();
+}
+
+QRect ImageAtlasRegion::rect() const
+{
+    return this->page_->cellRect(this->cell_);
+}
+
+const QPixmap &ImageAtlasRegion::standalone() const
+{
+    if (this->standalone_.isNull())
+    {
+        this->standalone_ = this->pixmap().copy(this->rect());
+    }
+    return this->standalone_;
+}
+
+ImageAtlas &ImageAtlas::instance()
+{
+    static auto *instance = new ImageAtlas;
+    return *instance;
+}
+
+ImageAtlas::ImageAtlas()
+{
+    DebugCount::configure("image atlas bytes", DebugCount::Flag::DataSize);
+}
+
+bool ImageAtlas::supports(QSize size)
+{
+    return size.width() == size.height() &&
+           std::find(CELL_SIZES.begin(), CELL_SIZES.end(), size.width()) !=
+               CELL_SIZES.end();
+}
+
+std::unique_ptr<ImageAtlasRegion> ImageAtlas::insert(const QPixmap &pixmap)
+{
+    assertInGuiThread();
+
+    if (!ImageAtlas::supports(pixmap.size()))
+    {
+        return nullptr;
+    }
+
+    auto &pages = this->pages_[pixmap.width()];
+
+    // Drop pages that were freed since the last insertion
+    pages.erase(std::remove_if(pages.begin(), pages.end(),
+                               [](const auto &page) {
+                                   return page.expired();
+                               }),
+                pages.end());
+
+    for (const auto &weakPage : pages)
+    {
+        auto page = weakPage.lock();
+        if (page && !page->full())
+        {
+            if (auto cell = page->allocate(pixmap))
+            {
+                return std::make_unique<ImageAtlasRegion>(std::move(page),
+                                                          *cell);
+            }
+        }
+    }
+
+    auto page = std::make_shared<ImageAtlasPage>(pixmap.width());
+    pages.push_back(page);
+
+    auto cell = page->allocate(pixmap);
+    assert(cell.has_value());
+    return std::make_unique<ImageAtlasRegion>(std::move(page), *cell);
+}
+
+}  // namespace chatterino
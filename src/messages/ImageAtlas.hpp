@@ -0,0 +1,74 @@
+#pragma once
+
+#include <QPixmap>
+#include <QRect>
+#include <QSize>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace chatterino {
+
+class ImageAtlasPage;
+
+/**
+ * @brief A cell of an ImageAtlas page holding a single frame
+ *
+ * The cell is returned to its page when the region is destroyed.
+ * Must only be used in the GUI thread.
+ */
+class ImageAtlasRegion
+{
+public:
+    ImageAtlasRegion(std::shared_ptr<ImageAtlasPage> page, int cell);
+    ~ImageAtlasRegion();
+
+    ImageAtlasRegion(const ImageAtlasRegion &) = delete;
+    ImageAtlasRegion &operator=(const ImageAtlasRegion &) = delete;
+
+    ImageAtlasRegion(ImageAtlasRegion &&) = delete;
+    ImageAtlasRegion &operator=(ImageAtlasRegion &&) = delete;
+
+    /// The page pixmap, only the area in rect() belongs to this region
+    const QPixmap &pixmap() const;
+    QRect rect() const;
+
+    /// The region as its own pixmap, for users that can't paint a sub-rect.
+    /// It's copied out of the page on the first call and kept afterwards.
+    const QPixmap &standalone() const;
+
+private:
+    std::shared_ptr<ImageAtlasPage> page_;
+    int cell_;
+    mutable QPixmap standalone_;
+};
+
+/**
+ * @brief Packs frames of common emote sizes into shared pixmaps
+ *
+ * Frames of 28x28, 56x56 and 112x112 (the 1x, 2x and 4x emote sizes) are
+ * drawn into cells of large page pixmaps instead of owning their own pixmap.
+ * Pages are freed once none of their cells are in use.
+ *
+ * Must only be used in the GUI thread.
+ */
+class ImageAtlas
+{
+public:
+    static ImageAtlas &instance();
+
+    /// Returns true if frames of this size can be stored in the atlas
+    static bool supports(QSize size);
+
+    /// Copies the pixmap into a free cell, returns nullptr if it's not supported
+    std::unique_ptr<ImageAtlasRegion> insert(const QPixmap &pixmap);
+
+private:
+    ImageAtlas();
+
+    /// cell size -> pages with that cell size
+    std::map<int, std::vector<std::weak_ptr<ImageAtlasPage>>> pages_;
+};
+
+}  // namespace chatterino
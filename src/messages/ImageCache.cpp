@@ -0,0 +1,564 @@
+#include "messages/ImageCache.hpp"
+
+#include "Application.hpp"
+#include "common/QLogging.hpp"
+#include "singletons/Paths.hpp"
+#include "singletons/Settings.hpp"
+#include "util/CombinePath.hpp"
+#include "util/DebugCount.hpp"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QSaveFile>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+using namespace chatterino;
+
+constexpr uint32_t INDEX_MAGIC = 0x43494458;  // "CIDX"
+constexpr uint32_t FRAMES_MAGIC = 0x4346524D;  // "CFRM"
+constexpr uint32_t FORMAT_VERSION = 1;
+constexpr uint32_t INITIAL_CAPACITY = 1024;
+
+// When the budget is exceeded, evict until we're below this fraction of it
+// so we don't evict on every single store.
+constexpr double EVICTION_TARGET = 0.9;
+
+// Upper bound for frame dimensions, larger frames aren't stored and larger
+// values read from disk mean corruption
+constexpr uint32_t MAX_DIMENSION = 4096;
+
+struct FramesHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t urlLength;
+    uint32_t frameCount;
+};
+
+struct FrameHeader {
+    uint32_t width;
+    uint32_t height;
+    int32_t duration;
+    uint32_t reserved;
+};
+
+uint64_t keyOf(const Url &url)
+{
+    auto hash = QCryptographicHash::hash(url.string.toUtf8(),
+                                         QCryptographicHash::Sha256);
+    uint64_t key = 0;
+    std::memcpy(&key, hash.constData(), sizeof(key));
+
+    // 0 marks unused index slots
+    return key == 0 ? 1 : key;
+}
+
+QString fileNameOf(uint64_t key)
+{
+    return QString::number(key, 16).rightJustified(16, '0') + ".frames";
+}
+
+int64_t now()
+{
+    return QDateTime::currentSecsSinceEpoch();
+}
+
+}  // namespace
+
+namespace chatterino {
+
+ImageCache &ImageCache::instance()
+{
+    static auto *instance = new ImageCache;
+    return *instance;
+}
+
+ImageCache::ImageCache()
+{
+    DebugCount::configure("image cache bytes", DebugCount::Flag::DataSize);
+}
+
+ImageCache::~ImageCache()
+{
+    std::lock_guard lock(this->mutex_);
+    this->closeIndex();
+}
+
+bool ImageCache::enabled() const
+{
+    return getSettings()->imageCacheBudgetMb > 0;
+}
+
+std::optional<QVector<detail::Frame<QImage>>> ImageCache::load(const Url &url)
+{
+    if (!this->enabled())
+    {
+        return std::nullopt;
+    }
+
+    const auto key = keyOf(url);
+    QString path;
+
+    {
+        std::lock_guard lock(this->mutex_);
+        if (!this->ensureOpen())
+        {
+            return std::nullopt;
+        }
+
+        auto it = this->slots_.find(key);
+        if (it == this->slots_.end())
+        {
+            DebugCount::increase("image cache misses");
+            return std::nullopt;
+        }
+
+        // The index is mapped, so this is persisted without an explicit write
+        this->entries()[it->second].lastUsed = now();
+        path = combinePath(this->directory_, fileNameOf(key));
+    }
+
+    auto invalidate = [&] {
+        std::lock_guard lock(this->mutex_);
+        this->removeEntry(key);
+        DebugCount::increase("image cache misses");
+        return std::nullopt;
+    };
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return invalidate();
+    }
+
+    const auto fileSize = file.size();
+    const uchar *data = file.map(0, fileSize);
+    if (data == nullptr)
+    {
+        return invalidate();
+    }
+
+    qint64 pos = 0;
+    auto read = [&](void *out, qint64 size) {
+        if (pos + size > fileSize)
+        {
+            return false;
+        }
+        std::memcpy(out, data + pos, size);
+        pos += size;
+        return true;
+    };
+
+    FramesHeader header{};
+    if (!read(&header, sizeof(header)) || header.magic != FRAMES_MAGIC ||
+        header.version != FORMAT_VERSION ||
+        pos + header.urlLength > fileSize)
+    {
+        return invalidate();
+    }
+
+    // Guards against the (unlikely) case of two URLs sharing a key
+    auto storedUrl = QString::fromUtf8(reinterpret_cast<const char *>(data) +
+                                           pos,
+                                       static_cast<qsizetype>(header.urlLength));
+    pos += header.urlLength;
+    if (storedUrl != url.string)
+    {
+        DebugCount::increase("image cache misses");
+        return std::nullopt;
+    }
+
+    // Every frame needs at least its header, so a larger count than that
+    // can't be right and mustn't be used to allocate anything
+    if (header.frameCount == 0 ||
+        header.frameCount > uint64_t(fileSize - pos) / sizeof(FrameHeader))
+    {
+        return invalidate();
+    }
+
+    QVector<detail::Frame<QImage>> frames;
+    frames.reserve(static_cast<qsizetype>(header.frameCount));
+
+    for (uint32_t i = 0; i < header.frameCount; ++i)
+    {
+        FrameHeader frameHeader{};
+        if (!read(&frameHeader, sizeof(frameHeader)) ||
+            frameHeader.width > MAX_DIMENSION ||
+            frameHeader.height > MAX_DIMENSION ||
+            uint64_t(frameHeader.width) * frameHeader.height * 4 >
+                uint64_t(fileSize - pos))
+        {
+            return invalidate();
+        }
+
+        QImage image(static_cast<int>(frameHeader.width),
+                     static_cast<int>(frameHeader.height),
+                     QImage::Format_ARGB32_Premultiplied);
+        const auto rowBytes = static_cast<qint64>(frameHeader.width) * 4;
+        for (int y = 0; y < image.height(); ++y)
+        {
+            if (!read(image.scanLine(y), rowBytes))
+            {
+                return invalidate();
+            }
+        }
+
+        frames.push_back({std::move(image), frameHeader.duration});
+    }
+
+    if (pos != fileSize)
+    {
+        return invalidate();
+    }
+
+    DebugCount::increase("image cache hits");
+    return frames;
+}
+
+void ImageCache::store(const Url &url,
+                       const QVector<detail::Frame<QImage>> &frames)
+{
+    const auto budget =
+        static_cast<uint64_t>(getSettings()->imageCacheBudgetMb.getValue()) *
+        1024 * 1024;
+    if (budget == 0 || frames.empty())
+    {
+        return;
+    }
+
+    // load() would reject these, so don't write them in the first place
+    for (const auto &frame : frames)
+    {
+        if (frame.image.isNull() ||
+            static_cast<uint32_t>(frame.image.width()) > MAX_DIMENSION ||
+            static_cast<uint32_t>(frame.image.height()) > MAX_DIMENSION)
+        {
+            return;
+        }
+    }
+
+    const auto key = keyOf(url);
+    const auto urlBytes = url.string.toUtf8();
+
+    QString path;
+    {
+        std::lock_guard lock(this->mutex_);
+        if (!this->ensureOpen())
+        {
+            return;
+        }
+        path = combinePath(this->directory_, fileNameOf(key));
+    }
+
+    // Write the file outside of the lock, QSaveFile makes sure readers never
+    // see a partially written file.
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qCWarning(chatterinoCache) << "Failed to open" << path << "for writing";
+        return;
+    }
+
+    FramesHeader header{
+        FRAMES_MAGIC,
+        FORMAT_VERSION,
+        static_cast<uint32_t>(urlBytes.size()),
+        static_cast<uint32_t>(frames.size()),
+    };
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(urlBytes);
+
+    for (const auto &frame : frames)
+    {
+        const QImage image =
+            frame.image.format() == QImage::Format_ARGB32_Premultiplied
+                ? frame.image
+                : frame.image.convertToFormat(
+                      QImage::Format_ARGB32_Premultiplied);
+
+        FrameHeader frameHeader{
+            static_cast<uint32_t>(image.width()),
+            static_cast<uint32_t>(image.height()),
+            frame.duration,
+            0,
+        };
+        file.write(reinterpret_cast<const char *>(&frameHeader),
+                   sizeof(frameHeader));
+
+        const auto rowBytes = static_cast<qint64>(image.width()) * 4;
+        for (int y = 0; y < image.height(); ++y)
+        {
+            file.write(reinterpret_cast<const char *>(image.constScanLine(y)),
+                       rowBytes);
+        }
+    }
+
+    const auto bytes = static_cast<uint64_t>(file.size());
+    if (!file.commit())
+    {
+        qCWarning(chatterinoCache) << "Failed to write" << path;
+        return;
+    }
+
+    std::lock_guard lock(this->mutex_);
+    if (!this->ensureOpen())
+    {
+        return;
+    }
+
+    IndexEntry *entry = nullptr;
+    if (auto it = this->slots_.find(key); it != this->slots_.end())
+    {
+        entry = &this->entries()[it->second];
+        this->totalBytes_ -= entry->bytes;
+        DebugCount::decrease("image cache bytes", int64_t(entry->bytes));
+    }
+    else
+    {
+        entry = this->allocateEntry();
+        if (entry == nullptr)
+        {
+            QFile::remove(path);
+            return;
+        }
+        this->slots_[key] = static_cast<uint32_t>(entry - this->entries());
+        DebugCount::increase("image cache entries");
+    }
+
+    entry->key = key;
+    entry->lastUsed = now();
+    entry->bytes = bytes;
+    this->totalBytes_ += bytes;
+    DebugCount::increase("image cache bytes", int64_t(bytes));
+
+    if (this->totalBytes_ > budget)
+    {
+        this->evict(static_cast<uint64_t>(double(budget) * EVICTION_TARGET));
+    }
+}
+
+void ImageCache::unload()
+{
+    std::lock_guard lock(this->mutex_);
+    this->closeIndex();
+}
+
+bool ImageCache::ensureOpen()
+{
+    if (this->map_ != nullptr)
+    {
+        return true;
+    }
+    if (this->failed_)
+    {
+        return false;
+    }
+
+    this->directory_ =
+        combinePath(getIApp()->getPaths().cacheDirectory(), "images");
+    if (!QDir().mkpath(this->directory_))
+    {
+        qCWarning(chatterinoCache)
+            << "Failed to create image cache directory" << this->directory_;
+        this->failed_ = true;
+        return false;
+    }
+
+    this->indexFile_.setFileName(combinePath(this->directory_, "index.bin"));
+    if (!this->indexFile_.open(QIODevice::ReadWrite))
+    {
+        qCWarning(chatterinoCache)
+            << "Failed to open image cache index" << this->indexFile_.fileName()
+            << this->indexFile_.errorString();
+        this->failed_ = true;
+        return false;
+    }
+
+    uint32_t capacity = INITIAL_CAPACITY;
+    bool valid = false;
+    if (this->indexFile_.size() >= qint64(sizeof(IndexHeader)))
+    {
+        IndexHeader header{};
+        this->indexFile_.read(reinterpret_cast<char *>(&header),
+                              sizeof(header));
+        valid = header.magic == INDEX_MAGIC &&
+                header.version == FORMAT_VERSION &&
+                this->indexFile_.size() ==
+                    qint64(sizeof(IndexHeader) +
+                           sizeof(IndexEntry) * uint64_t(header.capacity));
+        if (valid)
+        {
+            capacity = header.capacity;
+        }
+    }
+
+    if (!valid)
+    {
+        // Unknown or corrupt index: start over, the frame files it referenced
+        // can't be accounted for anymore.
+        for (const auto &name :
+             QDir(this->directory_).entryList({"*.frames"}, QDir::Files))
+        {
+            QFile::remove(combinePath(this->directory_, name));
+        }
+        this->indexFile_.resize(0);
+    }
+
+    if (!this->mapIndex(capacity))
+    {
+        this->closeIndex();
+        this->failed_ = true;
+        return false;
+    }
+
+    this->slots_.clear();
+    this->totalBytes_ = 0;
+    auto *entries = this->entries();
+    for (uint32_t i = 0; i < this->capacity_; ++i)
+    {
+        if (entries[i].key != 0)
+        {
+            this->slots_[entries[i].key] = i;
+            this->totalBytes_ += entries[i].bytes;
+        }
+    }
+
+    DebugCount::set("image cache entries", int64_t(this->slots_.size()));
+    DebugCount::set("image cache bytes", int64_t(this->totalBytes_));
+    qCDebug(chatterinoCache) << "Opened image cache with" << this->slots_.size()
+                             << "entries," << this->totalBytes_ << "bytes";
+
+    return true;
+}
+
+bool ImageCache::mapIndex(uint32_t capacity)
+{
+    if (this->map_ != nullptr)
+    {
+        this->indexFile_.unmap(this->map_);
+        this->map_ = nullptr;
+    }
+
+    const auto oldSize = this->indexFile_.size();
+    const auto newSize =
+        qint64(sizeof(IndexHeader) + sizeof(IndexEntry) * uint64_t(capacity));
+    if (oldSize < newSize)
+    {
+        // New slots are zero-filled by resize, which marks them as unused
+        if (!this->indexFile_.resize(newSize))
+        {
+            return false;
+        }
+    }
+
+    this->map_ = this->indexFile_.map(0, newSize);
+    if (this->map_ == nullptr)
+    {
+        qCWarning(chatterinoCache) << "Failed to map image cache index"
+                                   << this->indexFile_.errorString();
+        return false;
+    }
+
+    IndexHeader header{INDEX_MAGIC, FORMAT_VERSION, capacity, 0};
+    std::memcpy(this->map_, &header, sizeof(header));
+    this->capacity_ = capacity;
+
+    return true;
+}
+
+void ImageCache::closeIndex()
+{
+    if (this->map_ != nullptr)
+    {
+        this->indexFile_.unmap(this->map_);
+        this->map_ = nullptr;
+    }
+    this->indexFile_.close();
+    this->capacity_ = 0;
+    this->slots_.clear();
+    this->totalBytes_ = 0;
+    this->failed_ = false;
+}
+
+ImageCache::IndexEntry *ImageCache::entries() const
+{
+    return reinterpret_cast<IndexEntry *>(this->map_ + sizeof(IndexHeader));
+}
+
+ImageCache::IndexEntry *ImageCache::allocateEntry()
+{
+    if (this->slots_.size() >= this->capacity_)
+    {
+        if (!this->mapIndex(this->capacity_ * 2))
+        {
+            return nullptr;
+        }
+    }
+
+    auto *entries = this->entries();
+    for (uint32_t i = 0; i < this->capacity_; ++i)
+    {
+        if (entries[i].key == 0)
+        {
+            return &entries[i];
+        }
+    }
+
+    return nullptr;
+}
+
+void ImageCache::removeEntry(uint64_t key)
+{
+    auto it = this->slots_.find(key);
+    if (it == this->slots_.end())
+    {
+        return;
+    }
+
+    auto &entry = this->entries()[it->second];
+    QFile::remove(combinePath(this->directory_, fileNameOf(key)));
+
+    this->totalBytes_ -= entry.bytes;
+    DebugCount::decrease("image cache bytes", int64_t(entry.bytes));
+    DebugCount::decrease("image cache entries");
+
+    entry = {};
+    this->slots_.erase(it);
+}
+
+void ImageCache::evict(uint64_t budget)
+{
+    std::vector<IndexEntry> candidates;
+    candidates.reserve(this->slots_.size());
+    for (const auto &[key, slot] : this->slots_)
+    {
+        candidates.push_back(this->entries()[slot]);
+    }
+
+    std::sort(candidates.begin(), candidates.end(),
+              [](const auto &a, const auto &b) {
+                  return a.lastUsed < b.lastUsed;
+              });
+
+    size_t evicted = 0;
+    for (const auto &candidate : candidates)
+    {
+        if (this->totalBytes_ <= budget)
+        {
+            break;
+        }
+        this->removeEntry(candidate.key);
+        ++evicted;
+    }
+
+    DebugCount::increase("image cache evictions", int64_t(evicted));
+    qCDebug(chatterinoCache) << "Evicted" << evicted << "images,"
+                             << this->totalBytes_ << "bytes left";
+}
+
+}  // namespace chatterino
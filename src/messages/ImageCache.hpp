@@ -0,0 +1,113 @@
+#pragma once
+
+#include "common/Aliases.hpp"
+#include "messages/Image.hpp"
+
+#include <QFile>
+#include <QImage>
+#include <QString>
+#include <QVector>
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+namespace chatterino {
+
+/**
+ * @brief Persistent cache of decoded image frames
+ *
+ * Frames are stored on disk as raw ARGB32 premultiplied pixels in
+ * `<cache directory>/images`, one file per URL, so a cache hit doesn't need
+ * any network request or image decoding.
+ *
+ * The entries are tracked in a memory-mapped index (`index.bin`) which records
+ * the size and last use of every file. Once the total size exceeds the budget
+ * set in the "/cache/imageBudgetMb" setting, the least recently used entries
+ * are evicted. A budget of 0 disables the cache.
+ *
+ * This class is thread safe.
+ */
+class ImageCache
+{
+public:
+    static ImageCache &instance();
+
+    ~ImageCache();
+
+    ImageCache(const ImageCache &) = delete;
+    ImageCache &operator=(const ImageCache &) = delete;
+
+    ImageCache(ImageCache &&) = delete;
+    ImageCache &operator=(ImageCache &&) = delete;
+
+    /// Returns false if the budget is set to 0
+    bool enabled() const;
+
+    /**
+     * @brief Loads the frames stored for the given URL
+     *
+     * The returned images are in QImage::Format_ARGB32_Premultiplied.
+     *
+     * @return the frames, or std::nullopt if the URL isn't cached
+     */
+    std::optional<QVector<detail::Frame<QImage>>> load(const Url &url);
+
+    /**
+     * @brief Stores the frames for the given URL, evicting old entries if needed
+     *
+     * Frames that aren't in QImage::Format_ARGB32_Premultiplied are converted.
+     * Nothing is stored if a frame is empty or larger than 4096 pixels in
+     * either dimension.
+     */
+    void store(const Url &url, const QVector<detail::Frame<QImage>> &frames);
+
+    /**
+     * @brief Closes the index so the cache directory can be removed
+     *
+     * The index is reopened on the next load or store.
+     */
+    void unload();
+
+private:
+    ImageCache();
+
+    struct IndexHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t capacity;
+        uint32_t reserved;
+    };
+
+    struct IndexEntry {
+        /// 0 marks an unused slot
+        uint64_t key;
+        /// Seconds since epoch
+        int64_t lastUsed;
+        uint64_t bytes;
+    };
+
+    // All of the following must be called with mutex_ held
+    bool ensureOpen();
+    bool mapIndex(uint32_t capacity);
+    void closeIndex();
+    IndexEntry *entries() const;
+    IndexEntry *allocateEntry();
+    void removeEntry(uint64_t key);
+    void evict(uint64_t budget);
+
+    QString directory_;
+    QFile indexFile_;
+    uchar *map_{nullptr};
+    uint32_t capacity_{0};
+
+    /// key -> slot in the index
+    std::unordered_map<uint64_t, uint32_t> slots_;
+    uint64_t totalBytes_{0};
+    bool failed_{false};
+
+    mutable std::mutex mutex_;
+};
+
+}  // namespace chatterino
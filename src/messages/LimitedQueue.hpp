@@ -1,37 +1,54 @@
 #pragma once
 
+#include "common/Atomic.hpp"
 #include "messages/LimitedQueueSnapshot.hpp"
 
-#include <boost/circular_buffer.hpp>
-
+#include <algorithm>
 #include <cassert>
 #include <mutex>
 #include <optional>
-#include <shared_mutex>
 #include <vector>
 
 namespace chatterino {
 
+/**
+ * @brief Bounded FIFO queue with lock-free readers
+ *
+ * The contents are stored in fixed-size chunks and published as an immutable
+ * detail::LimitedQueueState. Readers (snapshots, get, find, ...) only load the
+ * current state and never block. Writers are serialized by a mutex that
+ * readers never touch, so the queue is intended to have a single writer
+ * thread and many readers.
+ *
+ * Appending only writes into a slot that no published state can see yet, so
+ * pushBack doesn't copy any items. Modifying or inserting existing items
+ * copies the affected chunks instead.
+ */
 template <typename T>
 class LimitedQueue
 {
+    using State = detail::LimitedQueueState<T>;
+    using Chunk = detail::LimitedQueueChunk<T>;
+    using ChunkPtr = typename State::ChunkPtr;
+    using ChunkList = std::vector<ChunkPtr>;
+
+    static constexpr size_t CHUNK_SIZE = detail::LIMITED_QUEUE_CHUNK_SIZE;
+
 public:
     LimitedQueue(size_t limit = 1000)
         : limit_(limit)
-        , buffer_(limit)
+        , state_(this->makeState({}, 0, 0))
     {
     }
 
 private:
     /// Property Accessors
     /**
-     * @brief Return the amount of space left in the buffer
-     *
-     * This does not lock
+     * @brief Return the amount of space left in the given state
      */
-    [[nodiscard]] size_t space() const
+    [[nodiscard]] size_t space(const State &state) const
     {
-        return this->limit() - this->buffer_.size();
+        return this->limit() - state.size;
     }
 
 public:
@@ -48,9 +65,7 @@ public:
      */
     [[nodiscard]] bool empty() const
     {
-        std::shared_lock lock(this->mutex_);
-
-        return this->buffer_.empty();
+        return this->state_.get()->size == 0;
     }
 
     /// Value Accessors
@@ -64,14 +79,14 @@ public:
      */
     [[nodiscard]] std::optional<T> get(size_t index) const
     {
-        std::shared_lock lock(this->mutex_);
+        auto state = this->state_.get();
 
-        if (index >= this->buffer_.size())
+        if (index >= state->size)
         {
             return std::nullopt;
         }
 
-        return this->buffer_[index];
+        return state->at(index);
     }
 
     /**
@@ -81,14 +96,14 @@ public:
      */
     [[nodiscard]] std::optional<T> first() const
     {
-        std::shared_lock lock(this->mutex_);
+        auto state = this->state_.get();
 
-        if (this->buffer_.empty())
+        if (state->size == 0)
         {
             return std::nullopt;
         }
 
-        return this->buffer_.front();
+        return state->at(0);
     }
 
     /**
@@ -98,14 +113,14 @@ public:
      */
     [[nodiscard]] std::optional<T> last() const
     {
-        std::shared_lock lock(this->mutex_);
+        auto state = this->state_.get();
 
-        if (this->buffer_.empty())
+        if (state->size == 0)
         {
             return std::nullopt;
         }
 
-        return this->buffer_.back();
+        return state->at(state->size - 1);
     }
 
     /// Modifiers
@@ -113,9 +128,9 @@ public:
     // Clear the buffer
     void clear()
     {
-        std::unique_lock lock(this->mutex_);
+        std::lock_guard lock(this->writeMutex_);
 
-        this->buffer_.clear();
+        this->state_.set(this->makeState({}, 0, 0));
     }
 
     /**
@@ -127,15 +142,9 @@ public:
      */
     bool pushBack(const T &item, T &deleted)
     {
-        std::unique_lock lock(this->mutex_);
+        std::lock_guard lock(this->writeMutex_);
 
-        bool full = this->buffer_.full();
-        if (full)
-        {
-            deleted = this->buffer_.front();
-        }
-        this->buffer_.push_back(item);
-        return full;
+        return this->pushBackImpl(item, &deleted);
     }
 
     /**
@@ -146,11 +155,9 @@ public:
      */
     bool pushBack(const T &item)
     {
-        std::unique_lock lock(this->mutex_);
+        std::lock_guard lock(this->writeMutex_);
 
-        bool full = this->buffer_.full();
-        this->buffer_.push_back(item);
-        return full;
+        return this->pushBackImpl(item, nullptr);
     }
 
     /**
@@ -165,20 +172,25 @@ public:
      */
     std::vector<T> pushFront(const std::vector<T> &items)
     {
-        std::unique_lock lock(this->mutex_);
+        std::lock_guard lock(this->writeMutex_);
 
-        size_t numToPush = std::min(items.size(), this->space());
-        std::vector<T> pushed;
-        pushed.reserve(numToPush);
+        auto state = this->state_.get();
 
-        size_t f = items.size() - numToPush;
-        size_t b = items.size() - 1;
-        for (; f < items.size(); ++f, --b)
+        size_t numToPush = std::min(items.size(), this->space(*state));
+        if (numToPush == 0)
         {
-            this->buffer_.push_front(items[b]);
-            pushed.push_back(items[f]);
+            return {};
         }
 
+        std::vector<T> pushed(items.end() - numToPush, items.end());
+
+        std::vector<T> contents;
+        contents.reserve(state->size + numToPush);
+        contents.insert(contents.end(), pushed.begin(), pushed.end());
+        this->appendContents(*state, contents);
+
+        this->rebuild(contents);
+
         return pushed;
     }
 
@@ -193,15 +205,17 @@ public:
     template <typename Equals = std::equal_to<T>>
     int replaceItem(const T &needle, const T &replacement)
     {
-        std::unique_lock lock(this->mutex_);
+        std::lock_guard lock(this->writeMutex_);
+
+        auto state = this->state_.get();
 
         Equals eq;
-        for (int i = 0; i < this->buffer_.size(); ++i)
+        for (size_t i = 0; i < state->size; ++i)
         {
-            if (eq(this->buffer_[i], needle))
+            if (eq(state->at(i), needle))
             {
-                this->buffer_[i] = replacement;
-                return i;
+                this->replaceImpl(*state, i, replacement);
+                return static_cast<int>(i);
             }
         }
         return -1;
@@ -216,74 +230,76 @@ public:
      */
     bool replaceItem(size_t index, const T &replacement)
     {
-        std::unique_lock lock(this->mutex_);
+        std::lock_guard lock(this->writeMutex_);
 
-        if (index >= this->buffer_.size())
+        auto state = this->state_.get();
+
+        if (index >= state->size)
         {
             return false;
         }
 
-        this->buffer_[index] = replacement;
+        this->replaceImpl(*state, index, replacement);
         return true;
     }
 
     /**
      * @brief Inserts the given item before another item
-     * 
+     *
+     * When the queue is full, the first item is deleted to make room. Nothing
+     * can be inserted before the first item of a full queue.
+     *
      * @param[in] needle the item to use as positional reference
      * @param[in] item the item to insert before needle
+     * @param[out] deleted the item that was deleted to make room, if any
      * @tparam Equality function object to use for comparison
      * @return true if an insertion took place
      */
     template <typename Equals = std::equal_to<T>>
-    bool insertBefore(const T &needle, const T &item)
+    bool insertBefore(const T &needle, const T &item,
+                      std::optional<T> &deleted)
     {
-        std::unique_lock lock(this->mutex_);
-
-        Equals eq;
-        for (auto it = this->buffer_.begin(); it != this->buffer_.end(); ++it)
-        {
-            if (eq(*it, needle))
-            {
-                this->buffer_.insert(it, item);
-                return true;
-            }
-        }
+        return this->insertNear<Equals>(needle, item, 0, &deleted);
+    }
 
-        return false;
+    template <typename Equals = std::equal_to<T>>
+    bool insertBefore(const T &needle, const T &item)
+    {
+        return this->insertNear<Equals>(needle, item, 0, nullptr);
     }
 
     /**
      * @brief Inserts the given item after another item
-     * 
+     *
+     * When the queue is full, the first item is deleted to make room.
+     *
      * @param[in] needle the item to use as positional reference
      * @param[in] item the item to insert after needle
+     * @param[out] deleted the item that was deleted to make room, if any
      * @tparam Equality function object to use for comparison
      * @return true if an insertion took place
      */
     template <typename Equals = std::equal_to<T>>
-    bool insertAfter(const T &needle, const T &item)
+    bool insertAfter(const T &needle, const T &item, std::optional<T> &deleted)
     {
-        std::unique_lock lock(this->mutex_);
-
-        Equals eq;
-        for (auto it = this->buffer_.begin(); it != this->buffer_.end(); ++it)
-        {
-            if (eq(*it, needle))
-            {
-                ++it;  // advance to insert after it
-                this->buffer_.insert(it, item);
-                return true;
-            }
-        }
+        return this->insertNear<Equals>(needle, item, 1, &deleted);
+    }
 
-        return false;
+    template <typename Equals = std::equal_to<T>>
+    bool insertAfter(const T &needle, const T &item)
+    {
+        return this->insertNear<Equals>(needle, item, 1, nullptr);
     }
 
+    /**
+     * @brief Returns a snapshot of the current contents
+     *
+     * This doesn't lock or copy any items, the snapshot shares the
+     * published state with the queue.
+     */
     [[nodiscard]] LimitedQueueSnapshot<T> getSnapshot() const
     {
-        std::shared_lock lock(this->mutex_);
-        return LimitedQueueSnapshot<T>(this->buffer_);
+        return LimitedQueueSnapshot<T>(this->state_.get());
     }
 
     // Actions
@@ -302,10 +318,11 @@ public:
     template <typename Predicate>
     [[nodiscard]] std::optional<T> find(Predicate pred) const
     {
-        std::shared_lock lock(this->mutex_);
+        auto state = this->state_.get();
 
-        for (const auto &item : this->buffer_)
+        for (size_t i = 0; i < state->size; ++i)
         {
+            const auto &item = state->at(i);
             if (pred(item))
             {
                 return item;
@@ -329,13 +346,14 @@ public:
     template <typename Predicate>
     [[nodiscard]] std::optional<T> rfind(Predicate pred) const
     {
-        std::shared_lock lock(this->mutex_);
+        auto state = this->state_.get();
 
-        for (auto it = this->buffer_.rbegin(); it != this->buffer_.rend(); ++it)
+        for (size_t i = state->size; i > 0; --i)
         {
-            if (pred(*it))
+            const auto &item = state->at(i - 1);
+            if (pred(item))
             {
-                return *it;
+                return item;
             }
         }
 
@@ -343,10 +361,178 @@ public:
     }
 
 private:
-    mutable std::shared_mutex mutex_;
+    std::shared_ptr<const State> makeState(
+        std::shared_ptr<const ChunkList> chunks, size_t offset,
+        size_t size) const
+    {
+        auto state = std::make_shared<State>();
+        if (chunks)
+        {
+            state->chunks = std::move(chunks);
+        }
+        state->offset = offset;
+        state->size = size;
+        return state;
+    }
+
+    void appendContents(const State &state, std::vector<T> &out) const
+    {
+        for (size_t i = 0; i < state.size; ++i)
+        {
+            out.push_back(state.at(i));
+        }
+    }
+
+    // Must be called with writeMutex_ held
+    bool pushBackImpl(const T &item, T *deleted)
+    {
+        auto state = this->state_.get();
+
+        auto chunks = state->chunks;
+        size_t offset = state->offset;
+        size_t size = state->size;
+
+        bool full = size >= this->limit_;
+        if (full)
+        {
+            if (size == 0)
+            {
+                // limit_ is 0, nothing can ever be stored
+                return true;
+            }
+            if (deleted != nullptr)
+            {
+                *deleted = state->at(0);
+            }
+            ++offset;
+            --size;
+        }
+
+        // The front chunk is no longer referenced by the new state
+        bool dropFront = offset >= CHUNK_SIZE;
+        // All slots of the last chunk have been written
+        bool needChunk = offset + size == chunks->size() * CHUNK_SIZE;
+
+        if (dropFront || needChunk)
+        {
+            auto newChunks = std::make_shared<ChunkList>();
+            newChunks->reserve(chunks->size() + 1);
+            newChunks->insert(newChunks->end(),
+                              chunks->begin() + (dropFront ? 1 : 0),
+                              chunks->end());
+            if (dropFront)
+            {
+                offset -= CHUNK_SIZE;
+            }
+            if (needChunk)
+            {
+                newChunks->push_back(std::make_shared<Chunk>());
+            }
+            chunks = std::move(newChunks);
+        }
+
+        // This slot isn't visible to any published state yet
+        const auto pos = offset + size;
+        (*chunks)[pos / CHUNK_SIZE]->items[pos % CHUNK_SIZE] = item;
+
+        this->state_.set(this->makeState(std::move(chunks), offset, size + 1));
+
+        return full;
+    }
+
+    // Must be called with writeMutex_ held
+    void replaceImpl(const State &state, size_t index, const T &replacement)
+    {
+        const auto pos = state.offset + index;
+        const auto chunkIndex = pos / CHUNK_SIZE;
+
+        // Copy-on-write the chunk containing the item, snapshots keep the old one
+        const auto &oldChunk = (*state.chunks)[chunkIndex];
+        auto newChunk = std::make_shared<Chunk>();
+        std::copy_n(oldChunk->items.get(), CHUNK_SIZE,
+                    newChunk->items.get());
+        newChunk->items[pos % CHUNK_SIZE] = replacement;
+
+        auto newChunks = std::make_shared<ChunkList>(*state.chunks);
+        (*newChunks)[chunkIndex] = std::move(newChunk);
+
+        this->state_.set(
+            this->makeState(std::move(newChunks), state.offset, state.size));
+    }
+
+    template <typename Equals>
+    bool insertNear(const T &needle, const T &item, size_t offset,
+                    std::optional<T> *deleted)
+    {
+        std::lock_guard lock(this->writeMutex_);
+
+        auto state = this->state_.get();
+
+        Equals eq;
+        for (size_t i = 0; i < state->size; ++i)
+        {
+            if (eq(state->at(i), needle))
+            {
+                return this->insertImpl(*state, i + offset, item, deleted);
+            }
+        }
+
+        return false;
+    }
+
+    // Must be called with writeMutex_ held
+    bool insertImpl(const State &state, size_t index, const T &item,
+                    std::optional<T> *deleted)
+    {
+        std::vector<T> contents;
+        contents.reserve(state.size + 1);
+        this->appendContents(state, contents);
+
+        if (contents.size() >= this->limit_)
+        {
+            // Matches boost::circular_buffer::insert: when full, the first
+            // element is overwritten, and nothing is inserted at the front
+            if (index == 0 || contents.empty())
+            {
+                return false;
+            }
+            if (deleted != nullptr)
+            {
+                *deleted = contents.front();
+            }
+            contents.erase(contents.begin());
+            --index;
+        }
+
+        contents.insert(contents.begin() + index, item);
+
+        this->rebuild(contents);
+        return true;
+    }
+
+    // Must be called with writeMutex_ held
+    void rebuild(const std::vector<T> &contents)
+    {
+        auto chunks = std::make_shared<ChunkList>();
+        chunks->reserve(contents.size() / CHUNK_SIZE + 1);
+
+        for (size_t i = 0; i < contents.size(); ++i)
+        {
+            if (i % CHUNK_SIZE == 0)
+            {
+                chunks->push_back(std::make_shared<Chunk>());
+            }
+            chunks->back()->items[i % CHUNK_SIZE] = contents[i];
+        }
+
+        this->state_.set(
+            this->makeState(std::move(chunks), 0, contents.size()));
+    }
+
+    std::mutex writeMutex_;
 
     const size_t limit_;
-    boost::circular_buffer<T> buffer_;
+    Atomic<std::shared_ptr<const State>> state_;
 };
 
 }  // namespace chatterino
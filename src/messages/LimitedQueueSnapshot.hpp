@@ -1,8 +1,8 @@
 #pragma once
 
-#include <boost/circular_buffer.hpp>
-
 #include <cassert>
+#include <cstddef>
+#include <iterator>
 #include <memory>
 #include <vector>
 
@@ -11,52 +11,210 @@ namespace chatterino {
 template <typename T>
 class LimitedQueue;
 
+namespace detail {
+
+    /// Items per LimitedQueueChunk, a power of two so indexing stays cheap
+    constexpr size_t LIMITED_QUEUE_CHUNK_SIZE = 64;
+
+    /**
+     * @brief Fixed-size block of items owned by a LimitedQueue
+     *
+     * Slots are written exactly once by the writer before they are published
+     * through a LimitedQueueState. Published slots are never modified again,
+     * modifications of existing items copy the whole chunk instead.
+     */
+    template <typename T>
+    struct LimitedQueueChunk {
+        LimitedQueueChunk()
+            : items(std::make_unique<T[]>(LIMITED_QUEUE_CHUNK_SIZE))
+        {
+        }
+
+        std::unique_ptr<T[]> items;
+    };
+
+    /**
+     * @brief Immutable view of the contents of a LimitedQueue
+     *
+     * A state is published atomically by the writer and shared by all
+     * snapshots taken while it was current.
+     */
+    template <typename T>
+    struct LimitedQueueState {
+        using ChunkPtr = std::shared_ptr<LimitedQueueChunk<T>>;
+
+        std::shared_ptr<const std::vector<ChunkPtr>> chunks =
+            std::make_shared<const std::vector<ChunkPtr>>();
+        /// Index of the first item inside chunks->front()
+        size_t offset = 0;
+        size_t size = 0;
+
+        const T &at(size_t index) const
+        {
+            assert(index < this->size);
+
+            const auto pos = this->offset + index;
+            return (*this->chunks)[pos / LIMITED_QUEUE_CHUNK_SIZE]
+                ->items[pos % LIMITED_QUEUE_CHUNK_SIZE];
+        }
+    };
+
+}  // namespace detail
+
 template <typename T>
 class LimitedQueueSnapshot
 {
 private:
     friend class LimitedQueue<T>;
 
-    LimitedQueueSnapshot(const boost::circular_buffer<T> &buf)
-        : buffer_(buf.begin(), buf.end())
+    using State = detail::LimitedQueueState<T>;
+
+    LimitedQueueSnapshot(std::shared_ptr<const State> state)
+        : state_(std::move(state))
     {
     }
 
 public:
+    class Iterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T *;
+        using reference = const T &;
+
+        Iterator() = default;
+
+        Iterator(const State *state, size_t index)
+            : state_(state)
+            , index_(index)
+        {
+        }
+
+        reference operator*() const
+        {
+            return this->state_->at(this->index_);
+        }
+
+        pointer operator->() const
+        {
+            return &this->state_->at(this->index_);
+        }
+
+        reference operator[](difference_type n) const
+        {
+            return this->state_->at(this->index_ + n);
+        }
+
+        Iterator &operator++()
+        {
+            ++this->index_;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            auto copy = *this;
+            ++this->index_;
+            return copy;
+        }
+
+        Iterator &operator--()
+        {
+            --this->index_;
+            return *this;
+        }
+
+        Iterator operator--(int)
+        {
+            auto copy = *this;
+            --this->index_;
+            return copy;
+        }
+
+        Iterator &operator+=(difference_type n)
+        {
+            this->index_ += n;
+            return *this;
+        }
+
+        Iterator &operator-=(difference_type n)
+        {
+            this->index_ -= n;
+            return *this;
+        }
+
+        friend Iterator operator+(Iterator it, difference_type n)
+        {
+            return it += n;
+        }
+
+        friend Iterator operator+(difference_type n, Iterator it)
+        {
+            return it += n;
+        }
+
+        friend Iterator operator-(Iterator it, difference_type n)
+        {
+            return it -= n;
+        }
+
+        friend difference_type operator-(const Iterator &a, const Iterator &b)
+        {
+            return static_cast<difference_type>(a.index_) -
+                   static_cast<difference_type>(b.index_);
+        }
+
+        friend bool operator==(const Iterator &a, const Iterator &b)
+        {
+            return a.index_ == b.index_;
+        }
+
+        friend auto operator<=>(const Iterator &a, const Iterator &b)
+        {
+            return a.index_ <=> b.index_;
+        }
+
+    private:
+        const State *state_ = nullptr;
+        size_t index_ = 0;
+    };
+
     LimitedQueueSnapshot() = default;
 
     size_t size() const
     {
-        return this->buffer_.size();
+        return this->state_ ? this->state_->size : 0;
     }
 
     const T &operator[](size_t index) const
     {
-        return this->buffer_[index];
+        return this->state_->at(index);
     }
 
-    auto begin() const
+    Iterator begin() const
     {
-        return this->buffer_.begin();
+        return {this->state_.get(), 0};
     }
 
-    auto end() const
+    Iterator end() const
     {
-        return this->buffer_.end();
+        return {this->state_.get(), this->size()};
     }
 
     auto rbegin() const
     {
-        return this->buffer_.rbegin();
+        return std::reverse_iterator<Iterator>(this->end());
     }
 
     auto rend() const
     {
-        return this->buffer_.rend();
+        return std::reverse_iterator<Iterator>(this->begin());
     }
 
 private:
-    std::vector<T> buffer_;
+    std::shared_ptr<const State> state_;
 };
 
 }  // namespace chatterino
@@ -0,0 +1,171 @@
+#include "messages/MergedEmoteMap.hpp"
+
+#include "messages/Emote.hpp"
+
+#include <unordered_set>
+
+namespace chatterino {
+
+std::atomic<uint64_t> MergedEmoteMap::globalGeneration_{1};
+
+MergedEmoteMap::MergedEmoteMap()
+{
+    static const auto emptyShard = std::make_shared<const Shard>();
+
+    this->layers_.fill(EMPTY_EMOTE_MAP);
+    this->shards_.fill(emptyShard);
+}
+
+const MergedEmoteMap::Entry *MergedEmoteMap::find(const EmoteName &name) const
+{
+    const auto &shard = *this->shards_[shardOf(name)];
+    auto it = shard.find(name);
+    if (it == shard.end())
+    {
+        return nullptr;
+    }
+
+    return &it->second;
+}
+
+const std::shared_ptr<const EmoteMap> &MergedEmoteMap::layer(
+    EmoteLayer layer) const
+{
+    return this->layers_[size_t(layer)];
+}
+
+std::shared_ptr<const MergedEmoteMap> MergedEmoteMap::withLayers(
+    std::initializer_list<LayerChange> changes) const
+{
+    auto merged = std::make_shared<MergedEmoteMap>(*this);
+    merged->applyLayers(changes);
+    return merged;
+}
+
+std::shared_ptr<const MergedEmoteMap> MergedEmoteMap::withEmotes(
+    EmoteLayer layer, std::shared_ptr<const EmoteMap> map,
+    std::initializer_list<EmoteName> names) const
+{
+    auto merged = std::make_shared<MergedEmoteMap>(*this);
+    merged->layers_[size_t(layer)] = map ? std::move(map) : EMPTY_EMOTE_MAP;
+
+    // The names are resolved even if the layer already was `map`, an earlier
+    // call could have set it without knowing about these names
+    merged->resolve(std::unordered_set<EmoteName>(names));
+    return merged;
+}
+
+uint64_t MergedEmoteMap::globalsGeneration() const
+{
+    return this->globalsGeneration_;
+}
+
+std::shared_ptr<const MergedEmoteMap> MergedEmoteMap::withGlobals(
+    std::initializer_list<LayerChange> changes, uint64_t generation) const
+{
+    auto merged = std::make_shared<MergedEmoteMap>(*this);
+    merged->applyLayers(changes);
+    merged->globalsGeneration_ = generation;
+    return merged;
+}
+
+size_t MergedEmoteMap::size() const
+{
+    size_t size = 0;
+    for (const auto &shard : this->shards_)
+    {
+        size += shard->size();
+    }
+    return size;
+}
+
+uint64_t MergedEmoteMap::globalGeneration()
+{
+    return globalGeneration_.load(std::memory_order_acquire);
+}
+
+void MergedEmoteMap::globalsChanged()
+{
+    globalGeneration_.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void MergedEmoteMap::applyLayers(std::initializer_list<LayerChange> changes)
+{
+    std::unordered_set<EmoteName> changed;
+
+    for (const auto &[layer, map] : changes)
+    {
+        auto &current = this->layers_[size_t(layer)];
+        const auto &next = map ? map : EMPTY_EMOTE_MAP;
+        if (current == next)
+        {
+            continue;
+        }
+
+        // Emote maps are copied when a single emote changes, so most emotes
+        // are still the same pointers
+        for (const auto &[name, emote] : *current)
+        {
+            auto it = next->find(name);
+            if (it == next->end() || it->second != emote)
+            {
+                changed.insert(name);
+            }
+        }
+        for (const auto &[name, emote] : *next)
+        {
+            auto it = current->find(name);
+            if (it == current->end() || it->second != emote)
+            {
+                changed.insert(name);
+            }
+        }
+
+        current = next;
+    }
+
+    this->resolve(changed);
+}
+
+size_t MergedEmoteMap::shardOf(const EmoteName &name)
+{
+    return std::hash<EmoteName>{}(name) % SHARD_COUNT;
+}
+
+void MergedEmoteMap::resolve(const std::unordered_set<EmoteName> &names)
+{
+    // Copies of the shards that are changed, the others stay shared
+    std::array<std::shared_ptr<Shard>, SHARD_COUNT> copies;
+
+    for (const auto &name : names)
+    {
+        const auto index = shardOf(name);
+        auto &shard = copies[index];
+        if (!shard)
+        {
+            shard = std::make_shared<Shard>(*this->shards_[index]);
+        }
+
+        shard->erase(name);
+        for (size_t i = 0; i < LAYER_COUNT; i++)
+        {
+            const auto &map = *this->layers_[i];
+            auto it = map.find(name);
+            if (it != map.end())
+            {
+                shard->emplace(name, Entry{it->second, EmoteLayer(i)});
+                break;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < SHARD_COUNT; i++)
+    {
+        if (copies[i])
+        {
+            this->shards_[i] = std::move(copies[i]);
+        }
+    }
+}
+
+}  // namespace chatterino
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "common/Aliases.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace chatterino {
+
+struct Emote;
+using EmotePtr = std::shared_ptr<const Emote>;
+class EmoteMap;
+
+/// The emote maps merged into a MergedEmoteMap, in order of precedence
+enum class EmoteLayer : uint8_t {
+    FfzChannel,
+    BttvChannel,
+    SeventvChannel,
+    FfzGlobal,
+    BttvGlobal,
+    SeventvGlobal,
+};
+
+/**
+ * @brief Immutable lookup table of the third-party emotes usable in a channel
+ *
+ * Merges the channel and global emote maps of FFZ, BTTV and 7TV so a word
+ * can be resolved with a single lookup. If multiple maps contain the same
+ * name, the emote from the layer that comes first in EmoteLayer wins.
+ *
+ * Changing a layer creates a new table. Only the names that differ between
+ * the old and the new map of that layer are resolved again. The entries are
+ * split into shards that are shared between tables, so a new table only
+ * copies the shards containing those names.
+ */
+class MergedEmoteMap
+{
+public:
+    struct Entry {
+        EmotePtr emote;
+        EmoteLayer layer;
+    };
+
+    using LayerChange = std::pair<EmoteLayer, std::shared_ptr<const EmoteMap>>;
+
+    /// An empty table with all layers empty
+    MergedEmoteMap();
+
+    /// Returns the emote `name` resolves to, or nullptr if there's none
+    const Entry *find(const EmoteName &name) const;
+
+    /// Returns the map of `layer` this table was built from
+    const std::shared_ptr<const EmoteMap> &layer(EmoteLayer layer) const;
+
+    /// Returns a copy of this table with the given layers replaced
+    std::shared_ptr<const MergedEmoteMap> withLayers(
+        std::initializer_list<LayerChange> changes) const;
+
+    /// Returns a copy of this table with `layer` replaced by `map`, which
+    /// only differs from the current map of that layer in the emotes called
+    /// `names`. Unlike withLayers(), the maps aren't compared.
+    std::shared_ptr<const MergedEmoteMap> withEmotes(
+        EmoteLayer layer, std::shared_ptr<const EmoteMap> map,
+        std::initializer_list<EmoteName> names) const;
+
+    /// The value of globalGeneration() the global layers were set at
+    uint64_t globalsGeneration() const;
+    /// Returns a copy of this table with the given global layers replaced
+    std::shared_ptr<const MergedEmoteMap> withGlobals(
+        std::initializer_list<LayerChange> changes,
+        uint64_t generation) const;
+
+    size_t size() const;
+
+    /// Incremented every time any global emote map changes
+    static uint64_t globalGeneration();
+    /// Must be called after a global emote map was changed
+    static void globalsChanged();
+
+private:
+    static constexpr size_t LAYER_COUNT = size_t(EmoteLayer::SeventvGlobal) + 1;
+    static constexpr size_t SHARD_COUNT = 64;
+
+    using Shard = std::unordered_map<EmoteName, Entry>;
+
+    static size_t shardOf(const EmoteName &name);
+
+    void applyLayers(std::initializer_list<LayerChange> changes);
+    /// Resolves `names` again, copying the shards they're in
+    void resolve(const std::unordered_set<EmoteName> &names);
+
+    std::array<std::shared_ptr<const EmoteMap>, LAYER_COUNT> layers_;
+    std::array<std::shared_ptr<const Shard>, SHARD_COUNT> shards_;
+    uint64_t globalsGeneration_ = 0;
+
+    static std::atomic<uint64_t> globalGeneration_;
+};
+
+}  // namespace chatterino
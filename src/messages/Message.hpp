@@ -4,6 +4,8 @@
 #include "providers/twitch/ChannelPointReward.hpp"
 #include "util/QStringHash.hpp"
 
+#include <boost/container/flat_map.hpp>
+#include <boost/container/small_vector.hpp>
 #include <magic_enum/magic_enum.hpp>
 #include <QColor>
 #include <QTime>
@@ -11,7 +13,6 @@
 #include <cinttypes>
 #include <functional>
 #include <memory>
-#include <unordered_map>
 #include <vector>
 
 namespace chatterino {
@@ -64,9 +65,17 @@ enum class MessageFlag : int64_t {
     MonitoredMessage = (1LL << 35),
     /// The message is an ACTION message (/me)
     Action = (1LL << 36),
+    /// The message contains a link (set by MessageBuilder::addLink)
+    HasLink = (1LL << 37),
 };
 using MessageFlags = FlagsEnum<MessageFlag>;
 
+/// Most messages carry at most one badge info (subscriber), so it's stored
+/// inline instead of in a node-based map.
+using BadgeInfos = boost::container::flat_map<
+    QString, QString, std::less<QString>,
+    boost::container::small_vector<std::pair<QString, QString>, 1>>;
+
 struct Message;
 using MessagePtr = std::shared_ptr<const Message>;
 struct Message {
@@ -98,7 +107,7 @@ struct Message {
     QColor usernameColor;
     QDateTime serverReceivedTime;
     std::vector<Badge> badges;
-    std::unordered_map<QString, QString> badgeInfos;
+    BadgeInfos badgeInfos;
     std::shared_ptr<QColor> highlightColor;
     // Each reply holds a reference to the thread. When every reply is dropped,
     // the reply thread will be cleaned up by the TwitchChannel.
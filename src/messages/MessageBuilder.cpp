@@ -16,6 +16,7 @@
 #include "singletons/Theme.hpp"
 #include "util/FormatTime.hpp"
 #include "util/Qt.hpp"
+#include "util/StringInterner.hpp"
 
 #include <QDateTime>
 
@@ -580,6 +581,18 @@ MessagePtr MessageBuilder::release()
 {
     std::shared_ptr<Message> ptr;
     this->message_.swap(ptr);
+
+    // Messages are kept around for a long time (see the message limit), share
+    // the names with all other messages and drop the builder's slack.
+    auto &interner = StringInterner::instance();
+    ptr->loginName = interner.intern(ptr->loginName);
+    ptr->displayName = interner.intern(ptr->displayName);
+    ptr->localizedName = interner.intern(ptr->localizedName);
+    ptr->timeoutUser = interner.intern(ptr->timeoutUser);
+    ptr->channelName = interner.intern(ptr->channelName);
+    ptr->elements.shrink_to_fit();
+    ptr->badges.shrink_to_fit();
+
     return ptr;
 }
 
@@ -638,6 +651,7 @@ void MessageBuilder::addLink(const ParsedLink &parsedLink)
                             .original = origLink},
         fullUrl, MessageElementFlag::Text, textColor);
     getIApp()->getLinkResolver()->resolve(el->linkInfo());
+    this->message().flags.set(MessageFlag::HasLink);
 }
 
 void MessageBuilder::addIrcMessageText(const QString &text)
@@ -7,11 +7,13 @@
 #include "messages/Image.hpp"
 #include "messages/layouts/MessageLayoutContainer.hpp"
 #include "messages/layouts/MessageLayoutElement.hpp"
+#include "messages/layouts/MessageLayoutWorker.hpp"
 #include "providers/emoji/Emojis.hpp"
 #include "singletons/Emotes.hpp"
 #include "singletons/Settings.hpp"
 #include "singletons/Theme.hpp"
 #include "util/DebugCount.hpp"
+#include "util/SlabAllocator.hpp"
 #include "util/Variant.hpp"
 
 #include <memory>
@@ -34,8 +36,30 @@ namespace {
         return QSize(width, height);
     }
 
+    SlabAllocator &elementAllocator()
+    {
+        // Leaked on purpose, elements may outlive static destruction
+        static auto *allocator = new SlabAllocator;
+        return *allocator;
+    }
+
 }  // namespace
 
+void *MessageElement::operator new(std::size_t size)
+{
+    return elementAllocator().allocate(size);
+}
+
+void MessageElement::operator delete(void *ptr, std::size_t size) noexcept
+{
+    elementAllocator().deallocate(ptr, size);
+}
+
+const SlabAllocator &MessageElement::allocator()
+{
+    return elementAllocator();
+}
+
 MessageElement::MessageElement(MessageElementFlags flags)
     : flags_(flags)
 {
@@ -552,6 +576,16 @@ QStringList TextElement::words() const
     return this->words_;
 }
 
+QStringList TextElement::layoutWords() const
+{
+    return this->words_;
+}
+
+FontStyle TextElement::layoutStyle() const
+{
+    return this->style_;
+}
+
 void TextElement::addToContainer(MessageLayoutContainer &container,
                                  MessageElementFlags flags)
 {
@@ -562,6 +596,14 @@ void TextElement::addToContainer(MessageLayoutContainer &container,
         QFontMetrics metrics =
             app->getFonts()->getFontMetrics(this->style_, container.getScale());
 
+        // widths measured by the MessageLayoutWorker, if available
+        const std::vector<int> *measuredWidths = nullptr;
+        if (const auto &textMetrics = container.textMetrics())
+        {
+            measuredWidths = textMetrics->wordWidths(*this);
+        }
+        size_t wordIndex = 0;
+
         for (const auto &word : this->words_)
         {
             auto wordId = container.nextWordId();
@@ -581,7 +623,10 @@ void TextElement::addToContainer(MessageLayoutContainer &container,
                 return e;
             };
 
-            auto width = metrics.horizontalAdvance(word);
+            auto width = measuredWidths != nullptr
+                             ? (*measuredWidths)[wordIndex]
+                             : metrics.horizontalAdvance(word);
+            wordIndex++;
 
             // see if the text fits in the current line
             if (container.fitsInLine(width))
@@ -809,11 +854,16 @@ LinkElement::LinkElement(const Parsed &parsed, const QString &fullUrl,
     this->setTooltip(parsed.original);
 }
 
+QStringList LinkElement::layoutWords() const
+{
+    return getSettings()->lowercaseDomains ? this->lowercase_
+                                           : this->original_;
+}
+
 void LinkElement::addToContainer(MessageLayoutContainer &container,
                                  MessageElementFlags flags)
 {
-    this->words_ =
-        getSettings()->lowercaseDomains ? this->lowercase_ : this->original_;
+    this->words_ = this->layoutWords();
     TextElement::addToContainer(container, flags);
 }
 
@@ -864,16 +914,19 @@ void MentionElement::addToContainer(MessageLayoutContainer &container,
         this->color_ = this->fallbackColor;
     }
 
+    this->style_ = this->layoutStyle();
+
+    TextElement::addToContainer(container, flags);
+}
+
+FontStyle MentionElement::layoutStyle() const
+{
     if (getSettings()->boldUsernames)
     {
-        this->style_ = FontStyle::ChatMediumBold;
-    }
-    else
-    {
-        this->style_ = FontStyle::ChatMedium;
+        return FontStyle::ChatMediumBold;
     }
 
-    TextElement::addToContainer(container, flags);
+    return FontStyle::ChatMedium;
 }
 
 std::unique_ptr<MessageElement> MentionElement::clone() const
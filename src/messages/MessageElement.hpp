@@ -18,6 +18,7 @@
 
 namespace chatterino {
 class Channel;
+class SlabAllocator;
 struct MessageLayoutContainer;
 class MessageLayoutElement;
 
@@ -169,6 +170,14 @@ public:
     MessageElement(MessageElement &&) = delete;
     MessageElement &operator=(MessageElement &&) = delete;
 
+    // Elements are small and allocated by the thousands, they're kept in
+    // size-classed slabs instead of going through the system allocator.
+    static void *operator new(std::size_t size);
+    static void operator delete(void *ptr, std::size_t size) noexcept;
+
+    /// The allocator backing all elements, used for statistics
+    static const SlabAllocator &allocator();
+
     MessageElement *setLink(const Link &link);
     MessageElement *setTooltip(const QString &tooltip);
 
@@ -247,6 +256,13 @@ public:
 
     QStringList words() const;
 
+    /// The words this element will be laid out with, these can depend on
+    /// settings. Must be called in the GUI thread.
+    virtual QStringList layoutWords() const;
+    /// The style this element will be laid out with, this can depend on
+    /// settings. Must be called in the GUI thread.
+    virtual FontStyle layoutStyle() const;
+
     void addToContainer(MessageLayoutContainer &container,
                         MessageElementFlags flags) override;
 
@@ -304,6 +320,8 @@ public:
     LinkElement &operator=(const LinkElement &) = delete;
     LinkElement &operator=(LinkElement &&) = delete;
 
+    QStringList layoutWords() const override;
+
     void addToContainer(MessageLayoutContainer &container,
                         MessageElementFlags flags) override;
 
@@ -344,6 +362,8 @@ public:
     MentionElement &operator=(const MentionElement &) = delete;
     MentionElement &operator=(MentionElement &&) = delete;
 
+    FontStyle layoutStyle() const override;
+
     void addToContainer(MessageLayoutContainer &container,
                         MessageElementFlags flags) override;
 
@@ -0,0 +1,362 @@
+#include "messages/MessageIndex.hpp"
+
+#include "messages/Message.hpp"
+#include "providers/twitch/TwitchBadge.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace {
+
+using namespace chatterino;
+
+bool hasLink(const Message &message)
+{
+    return message.flags.has(MessageFlag::HasLink);
+}
+
+/// Searches are lowercase, logins should be too, but aren't guaranteed to be
+QString indexedLogin(const Message &message)
+{
+    return message.loginName.toLower();
+}
+
+/// Display names that only differ in casing from the login aren't indexed
+/// separately
+QString indexedDisplayName(const Message &message)
+{
+    auto name = message.displayName.toLower();
+    if (name == indexedLogin(message))
+    {
+        return {};
+    }
+    return name;
+}
+
+/// The user a message is about without having been sent by them
+QString targetOf(const Message &message)
+{
+    if (!message.timeoutUser.isEmpty())
+    {
+        return message.timeoutUser.toLower();
+    }
+
+    if (message.flags.has(MessageFlag::Subscription) &&
+        message.loginName.isEmpty())
+    {
+        return message.messageText.section(' ', 0, 0).toLower();
+    }
+
+    return {};
+}
+
+}  // namespace
+
+namespace chatterino {
+
+void MessageIndex::add(const MessagePtr &message)
+{
+    std::lock_guard lock(this->mutex_);
+    this->addLocked(message, Position::End);
+}
+
+void MessageIndex::addAtStart(const MessagePtr &message)
+{
+    std::lock_guard lock(this->mutex_);
+    this->addLocked(message, Position::Start);
+}
+
+void MessageIndex::addInserted(const MessagePtr &message)
+{
+    std::lock_guard lock(this->mutex_);
+    this->addLocked(message, Position::Received);
+}
+
+void MessageIndex::remove(const MessagePtr &message)
+{
+    std::lock_guard lock(this->mutex_);
+    this->removeLocked(message);
+}
+
+void MessageIndex::replace(const MessagePtr &message,
+                           const MessagePtr &replacement)
+{
+    if (!message || !replacement)
+    {
+        std::lock_guard lock(this->mutex_);
+        this->removeLocked(message);
+        this->addLocked(replacement, Position::End);
+        return;
+    }
+
+    std::lock_guard lock(this->mutex_);
+    replace(this->byID_, message->id, replacement->id, message, replacement);
+    replace(this->byAuthor_, indexedLogin(*message), indexedLogin(*replacement),
+            message, replacement);
+    replace(this->byDisplayName_, indexedDisplayName(*message),
+            indexedDisplayName(*replacement), message, replacement);
+    replace(this->byTarget_, targetOf(*message), targetOf(*replacement),
+            message, replacement);
+
+    for (const auto &badge : message->badges)
+    {
+        erase(this->byBadge_, badge.key_.toLower(), message);
+    }
+    for (const auto &badge : replacement->badges)
+    {
+        insert(this->byBadge_, badge.key_.toLower(), replacement,
+               Position::Received);
+    }
+
+    // Replaced messages are usually recent ones
+    auto link = std::find(this->withLinks_.rbegin(), this->withLinks_.rend(),
+                          message);
+    bool replacementHasLink = hasLink(*replacement);
+    if (link != this->withLinks_.rend() && replacementHasLink)
+    {
+        *link = replacement;
+    }
+    else
+    {
+        if (link != this->withLinks_.rend())
+        {
+            this->withLinks_.erase(std::next(link).base());
+        }
+        if (replacementHasLink)
+        {
+            insert(this->withLinks_, replacement, Position::Received);
+        }
+    }
+}
+
+void MessageIndex::clear()
+{
+    std::lock_guard lock(this->mutex_);
+    this->byID_.clear();
+    this->byAuthor_.clear();
+    this->byDisplayName_.clear();
+    this->byBadge_.clear();
+    this->byTarget_.clear();
+    this->withLinks_.clear();
+}
+
+MessagePtr MessageIndex::findByID(const QString &id) const
+{
+    std::lock_guard lock(this->mutex_);
+    auto it = this->byID_.find(id);
+    if (it == this->byID_.end())
+    {
+        return nullptr;
+    }
+
+    return it->second.back();
+}
+
+std::vector<MessagePtr> MessageIndex::findByAuthor(const QString &login) const
+{
+    std::lock_guard lock(this->mutex_);
+    return find(this->byAuthor_, login.toLower());
+}
+
+std::vector<MessagePtr> MessageIndex::findByAuthorName(
+    const QString &name) const
+{
+    const auto lower = name.toLower();
+
+    std::lock_guard lock(this->mutex_);
+    auto byLogin = find(this->byAuthor_, lower);
+    // Messages are only indexed by their display name if it differs from
+    // the login, so the two lists don't overlap
+    auto byDisplayName = find(this->byDisplayName_, lower);
+
+    // Both lists are in channel order, keep it for the caller
+    std::vector<MessagePtr> messages;
+    messages.reserve(byLogin.size() + byDisplayName.size());
+    std::merge(byLogin.begin(), byLogin.end(), byDisplayName.begin(),
+               byDisplayName.end(), std::back_inserter(messages),
+               [](const MessagePtr &a, const MessagePtr &b) {
+                   return a->serverReceivedTime < b->serverReceivedTime;
+               });
+    return messages;
+}
+
+std::vector<MessagePtr> MessageIndex::findByBadge(const QString &badge) const
+{
+    std::lock_guard lock(this->mutex_);
+    return find(this->byBadge_, badge.toLower());
+}
+
+std::vector<MessagePtr> MessageIndex::findWithLinks() const
+{
+    std::lock_guard lock(this->mutex_);
+    return {this->withLinks_.begin(), this->withLinks_.end()};
+}
+
+std::vector<MessagePtr> MessageIndex::findByTarget(const QString &login) const
+{
+    std::lock_guard lock(this->mutex_);
+    return find(this->byTarget_, login.toLower());
+}
+
+void MessageIndex::addLocked(const MessagePtr &message, Position position)
+{
+    if (!message)
+    {
+        return;
+    }
+
+    insert(this->byID_, message->id, message, position);
+    insert(this->byAuthor_, indexedLogin(*message), message, position);
+    insert(this->byDisplayName_, indexedDisplayName(*message), message,
+           position);
+    insert(this->byTarget_, targetOf(*message), message, position);
+    for (const auto &badge : message->badges)
+    {
+        insert(this->byBadge_, badge.key_.toLower(), message, position);
+    }
+    if (hasLink(*message))
+    {
+        insert(this->withLinks_, message, position);
+    }
+}
+
+void MessageIndex::removeLocked(const MessagePtr &message)
+{
+    if (!message)
+    {
+        return;
+    }
+
+    erase(this->byID_, message->id, message);
+    erase(this->byAuthor_, indexedLogin(*message), message);
+    erase(this->byDisplayName_, indexedDisplayName(*message), message);
+    erase(this->byTarget_, targetOf(*message), message);
+    for (const auto &badge : message->badges)
+    {
+        erase(this->byBadge_, badge.key_.toLower(), message);
+    }
+    if (hasLink(*message))
+    {
+        erase(this->withLinks_, message);
+    }
+}
+
+void MessageIndex::insert(Map &map, const QString &key,
+                          const MessagePtr &message, Position position)
+{
+    if (key.isEmpty())
+    {
+        return;
+    }
+
+    insert(map[key], message, position);
+}
+
+void MessageIndex::erase(Map &map, const QString &key,
+                         const MessagePtr &message)
+{
+    if (key.isEmpty())
+    {
+        return;
+    }
+
+    auto it = map.find(key);
+    if (it == map.end())
+    {
+        return;
+    }
+
+    erase(it->second, message);
+    if (it->second.empty())
+    {
+        map.erase(it);
+    }
+}
+
+void MessageIndex::replace(Map &map, const QString &key,
+                           const QString &replacementKey,
+                           const MessagePtr &message,
+                           const MessagePtr &replacement)
+{
+    if (key == replacementKey)
+    {
+        auto it = map.find(key);
+        if (it != map.end())
+        {
+            replace(it->second, message, replacement);
+        }
+        return;
+    }
+
+    erase(map, key, message);
+    insert(map, replacementKey, replacement, Position::Received);
+}
+
+void MessageIndex::insert(Bucket &bucket, const MessagePtr &message,
+                          Position position)
+{
+    switch (position)
+    {
+        case Position::End:
+            bucket.push_back(message);
+            break;
+
+        case Position::Start:
+            bucket.push_front(message);
+            break;
+
+        case Position::Received: {
+            // System messages don't have a received time and are skipped,
+            // like in Channel::fillInMissingMessages
+            auto pos = std::find_if(
+                bucket.begin(), bucket.end(), [&](const auto &other) {
+                    return !other->flags.has(MessageFlag::System) &&
+                           message->serverReceivedTime <
+                               other->serverReceivedTime;
+                });
+            bucket.insert(pos, message);
+        }
+        break;
+    }
+}
+
+void MessageIndex::replace(Bucket &bucket, const MessagePtr &message,
+                           const MessagePtr &replacement)
+{
+    // Replaced messages are usually recent ones
+    auto pos = std::find(bucket.rbegin(), bucket.rend(), message);
+    if (pos != bucket.rend())
+    {
+        *pos = replacement;
+    }
+}
+
+void MessageIndex::erase(Bucket &bucket, const MessagePtr &message)
+{
+    // Evicted messages are the oldest ones, so they're at the front unless
+    // the buffer was cleared or replaced
+    if (!bucket.empty() && bucket.front() == message)
+    {
+        bucket.pop_front();
+        return;
+    }
+
+    auto pos = std::find(bucket.begin(), bucket.end(), message);
+    if (pos != bucket.end())
+    {
+        bucket.erase(pos);
+    }
+}
+
+std::vector<MessagePtr> MessageIndex::find(const Map &map, const QString &key)
+{
+    auto it = map.find(key);
+    if (it == map.end())
+    {
+        return {};
+    }
+
+    return {it->second.begin(), it->second.end()};
+}
+
+}  // namespace chatterino
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "util/QStringHash.hpp"
+
+#include <QString>
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace chatterino {
+
+struct Message;
+using MessagePtr = std::shared_ptr<const Message>;
+
+/**
+ * @brief Secondary indexes of the messages in a channel
+ *
+ * Maps message IDs, authors, badges and links to the messages currently in
+ * the channel's buffer, so deletions, timeouts and searches don't have to
+ * scan the whole buffer. The owner has to keep the index in sync with its
+ * buffer, i.e. add every message that's added and remove every message that's
+ * evicted or replaced.
+ *
+ * All functions are thread safe.
+ */
+class MessageIndex
+{
+public:
+    /// Adds a message that was appended to the buffer
+    void add(const MessagePtr &message);
+    /// Adds a message that was added to the start of the buffer
+    void addAtStart(const MessagePtr &message);
+    /// Adds a message that was inserted between existing messages. It's put
+    /// before the first message in each list that was received after it, the
+    /// same way Channel::fillInMissingMessages places it in the buffer.
+    void addInserted(const MessagePtr &message);
+    /// Removes a message that was evicted from the buffer
+    void remove(const MessagePtr &message);
+    /// Replaces `message` with `replacement`, keeping its position
+    void replace(const MessagePtr &message, const MessagePtr &replacement);
+    void clear();
+
+    /// Returns the most recent message with the ID `id` or nullptr
+    MessagePtr findByID(const QString &id) const;
+    /// Returns all messages sent by `login` (ignoring case), oldest first
+    std::vector<MessagePtr> findByAuthor(const QString &login) const;
+    /// Returns all messages whose author's login or display name is `name`
+    /// (ignoring case). Messages matching both are only returned once.
+    std::vector<MessagePtr> findByAuthorName(const QString &name) const;
+    /// Returns all messages with a badge named `badge` (ignoring case),
+    /// oldest first
+    std::vector<MessagePtr> findByBadge(const QString &badge) const;
+    /// Returns all messages containing a link, oldest first
+    std::vector<MessagePtr> findWithLinks() const;
+    /// Returns all messages about `login` that it didn't send (timeouts and
+    /// system messages for subscriptions), oldest first
+    std::vector<MessagePtr> findByTarget(const QString &login) const;
+
+private:
+    /// Messages in buffer order. The buffer evicts its oldest message
+    /// first, so evicted messages are popped off the front.
+    using Bucket = std::deque<MessagePtr>;
+    using Map = std::unordered_map<QString, Bucket>;
+
+    enum class Position {
+        End,
+        Start,
+        /// Ordered by the time the message was received
+        Received,
+    };
+
+    void addLocked(const MessagePtr &message, Position position);
+    void removeLocked(const MessagePtr &message);
+
+    static void insert(Map &map, const QString &key, const MessagePtr &message,
+                       Position position);
+    static void erase(Map &map, const QString &key, const MessagePtr &message);
+    static void replace(Map &map, const QString &key,
+                        const QString &replacementKey,
+                        const MessagePtr &message,
+                        const MessagePtr &replacement);
+    static void insert(Bucket &bucket, const MessagePtr &message,
+                       Position position);
+    static void erase(Bucket &bucket, const MessagePtr &message);
+    static void replace(Bucket &bucket, const MessagePtr &message,
+                        const MessagePtr &replacement);
+
+    static std::vector<MessagePtr> find(const Map &map, const QString &key);
+
+    mutable std::mutex mutex_;
+    Map byID_;
+    Map byAuthor_;
+    /// Lowercase display names that differ from the login
+    Map byDisplayName_;
+    /// Lowercase badge names
+    Map byBadge_;
+    /// Lowercase logins
+    Map byTarget_;
+    Bucket withLinks_;
+};
+
+}  // namespace chatterino
@@ -53,6 +53,7 @@ SharedMessageBuilder::SharedMessageBuilder(
     , ircMessage(_ircMessage)
     , args(_args)
     , tags(this->ircMessage->tags())
+    , nick_(this->ircMessage->nick())
     , originalMessage_(_ircMessage->content())
     , action_(_ircMessage->isAction())
 {
@@ -65,11 +66,26 @@ SharedMessageBuilder::SharedMessageBuilder(
     , ircMessage(_ircMessage)
     , args(_args)
     , tags(this->ircMessage->tags())
+    , nick_(this->ircMessage->nick())
     , originalMessage_(content)
     , action_(isAction)
 {
 }
 
+SharedMessageBuilder::SharedMessageBuilder(Channel *_channel,
+                                           IrcTags _tags, QString nick,
+                                           const MessageParseArgs &_args,
+                                           QString content, bool isAction)
+    : channel(_channel)
+    , ircMessage(nullptr)
+    , args(_args)
+    , tags(std::move(_tags))
+    , nick_(std::move(nick))
+    , originalMessage_(std::move(content))
+    , action_(isAction)
+{
+}
+
 void SharedMessageBuilder::parse()
 {
     this->parseUsernameColor();
@@ -99,17 +115,17 @@ std::pair<QString, QString> SharedMessageBuilder::slashKeyValue(
     };
 }
 
-std::vector<Badge> SharedMessageBuilder::parseBadgeTag(const QVariantMap &tags)
+std::vector<Badge> SharedMessageBuilder::parseBadgeTag(const IrcTags &tags)
 {
     std::vector<Badge> b;
 
-    auto badgesIt = tags.constFind("badges");
-    if (badgesIt == tags.end())
+    auto badgesTag = tags.value("badges");
+    if (!badgesTag.isValid())
     {
         return b;
     }
 
-    auto badges = badgesIt.value().toString().split(',', Qt::SkipEmptyParts);
+    auto badges = badgesTag.toString().split(',', Qt::SkipEmptyParts);
 
     for (const QString &badge : badges)
     {
@@ -136,14 +152,14 @@ void SharedMessageBuilder::parseUsernameColor()
 {
     if (getSettings()->colorizeNicknames)
     {
-        this->usernameColor_ = getRandomColor(this->ircMessage->nick());
+        this->usernameColor_ = getRandomColor(this->nick_);
     }
 }
 
 void SharedMessageBuilder::parseUsername()
 {
     // username
-    this->userName = this->ircMessage->nick();
+    this->userName = this->nick_;
 
     this->message().loginName = this->userName;
 }
@@ -3,6 +3,7 @@
 #include "common/Aliases.hpp"
 #include "common/Outcome.hpp"
 #include "messages/MessageBuilder.hpp"
+#include "providers/irc/IrcTags.hpp"
 
 #include <IrcMessage>
 #include <QColor>
@@ -29,6 +30,11 @@ public:
                                   const MessageParseArgs &_args,
                                   QString content, bool isAction);
 
+    /// For messages that weren't parsed by Communi, ircMessage will be null
+    explicit SharedMessageBuilder(Channel *_channel, IrcTags _tags,
+                                  QString nick, const MessageParseArgs &_args,
+                                  QString content, bool isAction);
+
     QString userName;
 
     [[nodiscard]] virtual bool isIgnored() const;
@@ -40,7 +46,7 @@ public:
     static std::pair<QString, QString> slashKeyValue(const QString &kvStr);
 
     // Parses "badges" tag which contains a comma separated list of key-value elements
-    static std::vector<Badge> parseBadgeTag(const QVariantMap &tags);
+    static std::vector<Badge> parseBadgeTag(const IrcTags &tags);
 
     static QString stylizeUsername(const QString &username,
                                    const Message &message);
@@ -67,9 +73,12 @@ protected:
     void appendChannelName();
 
     Channel *channel;
+    /// May be null if the message wasn't parsed by Communi
     const Communi::IrcMessage *ircMessage;
     MessageParseArgs args;
-    const QVariantMap tags;
+    const IrcTags tags;
+    /// The nick from the IRC prefix
+    const QString nick_;
     QString originalMessage_;
 
     const bool action_{};
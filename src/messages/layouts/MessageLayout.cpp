@@ -4,10 +4,12 @@
 #include "messages/layouts/MessageLayoutContainer.hpp"
 #include "messages/layouts/MessageLayoutContext.hpp"
 #include "messages/layouts/MessageLayoutElement.hpp"
+#include "messages/layouts/MessageLayoutWorker.hpp"
 #include "messages/Message.hpp"
 #include "messages/MessageElement.hpp"
 #include "messages/Selection.hpp"
 #include "providers/colors/ColorProvider.hpp"
+#include "singletons/Fonts.hpp"
 #include "singletons/Settings.hpp"
 #include "singletons/StreamerMode.hpp"
 #include "singletons/WindowManager.hpp"
@@ -42,12 +44,15 @@ namespace {
 
 MessageLayout::MessageLayout(MessagePtr message)
     : message_(std::move(message))
+    , shared_(std::make_shared<SharedMessageLayout>())
 {
     DebugCount::increase("message layout");
 }
 
 MessageLayout::~MessageLayout()
 {
+    this->releaseBuffer();
+    this->deleteOwnBuffer();
     DebugCount::decrease("message layout");
 }
 
@@ -64,19 +69,24 @@ const MessagePtr &MessageLayout::getMessagePtr() const
 // Height
 int MessageLayout::getHeight() const
 {
-    return this->container_.getHeight();
+    if (!this->laidOut_)
+    {
+        return this->placeholderHeight_;
+    }
+
+    return this->shared_->container.getHeight();
 }
 
 int MessageLayout::getWidth() const
 {
-    return this->container_.getWidth();
+    return this->shared_->container.getWidth();
 }
 
 // Layout
 // return true if redraw is required
 bool MessageLayout::layout(int width, float scale, float imageScale,
                            MessageElementFlags flags,
-                           bool shouldInvalidateBuffer)
+                           bool shouldInvalidateBuffer, TextMeasuring measuring)
 {
     //    BenchmarkGuard benchmark("MessageLayout::layout()");
 
@@ -120,14 +130,121 @@ bool MessageLayout::layout(int width, float scale, float imageScale,
         return false;
     }
 
-    int oldHeight = this->container_.getHeight();
+    SharedMessageLayout::Key key{
+        .message = this->message_.get(),
+        .width = width,
+        .scale = scale,
+        .imageScale = imageScale,
+        .elementFlags = flags,
+        .layoutFlags = this->sharedLayoutFlags(),
+        .generation = layoutGeneration,
+    };
+
+    // Another view might have laid out this message the same way already
+    if (this->adoptShared(key))
+    {
+        return true;
+    }
+
+    const auto fontGeneration = getIApp()->getFonts()->getGeneration();
+    auto hasTextMetrics = [&] {
+        return this->textMetrics_ &&
+               this->textMetrics_->matches(scale, fontGeneration);
+    };
+    if (!hasTextMetrics())
+    {
+        auto &worker = MessageLayoutWorker::instance();
+        auto self = this->weak_from_this().lock();
+        if (measuring == TextMeasuring::InBackground && self &&
+            !this->laidOut_)
+        {
+            // Sets the metrics right away if another view measured them
+            worker.measure(self, scale);
+            if (!hasTextMetrics())
+            {
+                this->placeholderHeight_ =
+                    getIApp()
+                        ->getFonts()
+                        ->getFontMetrics(FontStyle::ChatMedium, scale)
+                        .height() +
+                    int(8 * scale);
+                this->flags.set(MessageLayoutFlag::RequiresLayout);
+                return false;
+            }
+            // The metrics asked for the layout that's happening now
+            this->flags.unset(MessageLayoutFlag::RequiresLayout);
+        }
+        else
+        {
+            // Messages that are about to be shown, or were shown before,
+            // don't wait for the worker
+            this->textMetrics_ = worker.measureNow(this->message_, scale);
+            this->measuringScale_ = scale;
+            this->measuringFontGeneration_ = fontGeneration;
+        }
+    }
+
+    if (this->shared_.use_count() > 1)
+    {
+        // Other views still show the current layout
+        this->setShared(std::make_shared<SharedMessageLayout>());
+    }
+
+    auto &container = this->shared_->container;
+    container.setTextMetrics(this->textMetrics_);
+
+    int oldHeight = container.getHeight();
     this->actuallyLayout(width, flags);
-    if (widthChanged || this->container_.getHeight() != oldHeight)
+    this->laidOut_ = true;
+    if (widthChanged || container.getHeight() != oldHeight)
     {
-        this->deleteBuffer();
+        this->shared_->deleteBuffer();
     }
     this->invalidateBuffer();
 
+    SharedMessageLayout::publish(this->shared_, key);
+
+    return true;
+}
+
+bool MessageLayout::beginMeasuring(float scale, int fontGeneration)
+{
+    if (this->textMetrics_ &&
+        this->textMetrics_->matches(scale, fontGeneration))
+    {
+        return false;
+    }
+
+    if (this->measuringScale_ == scale &&
+        this->measuringFontGeneration_ == fontGeneration)
+    {
+        return false;
+    }
+
+    this->measuringScale_ = scale;
+    this->measuringFontGeneration_ = fontGeneration;
+    return true;
+}
+
+bool MessageLayout::setTextMetrics(
+    std::shared_ptr<const MessageTextMetrics> metrics)
+{
+    // Results of an older request might arrive after newer ones
+    if (!metrics->matches(this->measuringScale_,
+                          this->measuringFontGeneration_))
+    {
+        return false;
+    }
+
+    this->textMetrics_ = std::move(metrics);
+
+    if (this->laidOut_)
+    {
+        // The next layout will use the metrics, the current one is correct
+        return false;
+    }
+
+    this->flags.set(MessageLayoutFlag::RequiresLayout);
     return true;
 }
 
@@ -151,7 +268,8 @@ void MessageLayout::actuallyLayout(int width, MessageElementFlags flags)
     bool hideSimilar = getSettings()->hideSimilar;
     bool hideReplies = !flags.has(MessageElementFlag::RepliedMessage);
 
-    this->container_.beginLayout(width, this->scale_, this->imageScale_,
+    auto &shared = *this->shared_;
+    shared.container.beginLayout(width, this->scale_, this->imageScale_,
                                  messageFlags);
 
     for (const auto &element : this->message_->elements)
@@ -183,23 +301,20 @@ void MessageLayout::actuallyLayout(int width, MessageElementFlags flags)
             continue;
         }
 
-        element->addToContainer(this->container_, flags);
+        element->addToContainer(shared.container, flags);
     }
 
-    if (this->height_ != this->container_.getHeight())
+    if (shared.height != shared.container.getHeight())
     {
-        this->deleteBuffer();
+        shared.deleteBuffer();
     }
 
-    this->container_.endLayout();
-    this->height_ = this->container_.getHeight();
+    shared.container.endLayout();
+    shared.height = shared.container.getHeight();
 
     // collapsed state
-    this->flags.unset(MessageLayoutFlag::Collapsed);
-    if (this->container_.isCollapsed())
-    {
-        this->flags.set(MessageLayoutFlag::Collapsed);
-    }
+    shared.collapsed = shared.container.isCollapsed();
+    this->flags.set(MessageLayoutFlag::Collapsed, shared.collapsed);
 }
 
 // Painting
@@ -207,9 +322,18 @@ MessagePaintResult MessageLayout::paint(const MessagePaintContext &ctx)
 {
     MessagePaintResult result;
 
+    if (!this->laidOut_)
+    {
+        // Waiting for the MessageLayoutWorker
+        return result;
+    }
+
     QPixmap *pixmap = this->ensureBuffer(ctx.painter, ctx.canvasWidth);
+    bool &bufferValid = this->ownBuffer_ != nullptr
+                            ? this->ownBufferValid_
+                            : this->shared_->bufferValid;
 
-    if (!this->bufferValid_)
+    if (!bufferValid)
     {
         this->updateBuffer(pixmap, ctx);
     }
@@ -219,7 +343,8 @@ MessagePaintResult MessageLayout::paint(const MessagePaintContext &ctx)
 
     // draw gif emotes
     result.hasAnimatedElements =
-        this->container_.paintAnimatedElements(ctx.painter, ctx.y);
+        this->shared_->container.paintAnimatedElements(ctx.painter, ctx.y,
+                                                       ctx.animatedRegions);
 
     // draw disabled
     if (this->message_->flags.has(MessageFlag::Disabled))
@@ -247,14 +372,14 @@ MessagePaintResult MessageLayout::paint(const MessagePaintContext &ctx)
     // draw selection
     if (!ctx.selection.isEmpty())
     {
-        this->container_.paintSelection(ctx.painter, ctx.messageIndex,
-                                        ctx.selection, ctx.y);
+        this->shared_->container.paintSelection(ctx.painter, ctx.messageIndex,
+                                                ctx.selection, ctx.y);
     }
 
     // draw message seperation line
     if (ctx.preferences.separateMessages)
     {
-        ctx.painter.fillRect(0, ctx.y, this->container_.getWidth() + 64, 1,
+        ctx.painter.fillRect(0, ctx.y, this->getWidth() + 64, 1,
                              ctx.messageColors.messageSeperator);
     }
 
@@ -275,32 +400,65 @@ MessagePaintResult MessageLayout::paint(const MessagePaintContext &ctx)
 
         QBrush brush(color, ctx.preferences.lastMessagePattern);
 
-        ctx.painter.fillRect(0, ctx.y + this->container_.getHeight() - 1,
+        ctx.painter.fillRect(0, ctx.y + this->getHeight() - 1,
                              pixmap->width(), 1, brush);
     }
 
-    this->bufferValid_ = true;
+    bufferValid = true;
 
     return result;
 }
 
 QPixmap *MessageLayout::ensureBuffer(QPainter &painter, int width)
 {
-    if (this->buffer_ != nullptr)
+    auto &shared = *this->shared_;
+    const auto dpr = painter.device()->devicePixelRatioF();
+    const auto fits = [&](const std::unique_ptr<QPixmap> &buffer) {
+        return buffer != nullptr && buffer->width() == int(width * dpr) &&
+               buffer->height() == int(shared.container.getHeight() * dpr) &&
+               buffer->devicePixelRatio() == dpr;
+    };
+
+    auto otherUsers = shared.bufferUsers - (this->holdsBuffer_ ? 1 : 0);
+    if (!fits(shared.buffer) && shared.buffer != nullptr && otherUsers > 0)
+    {
+        // Another view with a different canvas width (e.g. without a
+        // scrollbar) or DPR paints the shared buffer. Recreating it would make
+        // both views repaint the message on every frame.
+        this->releaseBuffer();
+        if (!fits(this->ownBuffer_))
+        {
+            this->deleteOwnBuffer();
+            this->ownBuffer_ = std::make_unique<QPixmap>(
+                int(width * dpr), int(shared.container.getHeight() * dpr));
+            this->ownBuffer_->setDevicePixelRatio(dpr);
+            this->ownBufferValid_ = false;
+            DebugCount::increase("message drawing buffers");
+        }
+        return this->ownBuffer_.get();
+    }
+
+    this->deleteOwnBuffer();
+    if (!this->holdsBuffer_)
+    {
+        this->holdsBuffer_ = true;
+        shared.bufferUsers++;
+    }
+
+    if (fits(shared.buffer))
     {
-        return this->buffer_.get();
+        return shared.buffer.get();
     }
+    shared.deleteBuffer();
 
     // Create new buffer
-    this->buffer_ = std::make_unique<QPixmap>(
-        int(width * painter.device()->devicePixelRatioF()),
-        int(this->container_.getHeight() *
-            painter.device()->devicePixelRatioF()));
-    this->buffer_->setDevicePixelRatio(painter.device()->devicePixelRatioF());
+    shared.buffer = std::make_unique<QPixmap>(
+        int(width * dpr), int(shared.container.getHeight() * dpr));
+    shared.buffer->setDevicePixelRatio(dpr);
 
-    this->bufferValid_ = false;
+    shared.bufferValid = false;
     DebugCount::increase("message drawing buffers");
-    return this->buffer_.get();
+    return shared.buffer.get();
 }
 
 void MessageLayout::updateBuffer(QPixmap *buffer,
@@ -394,7 +552,7 @@ void MessageLayout::updateBuffer(QPixmap *buffer,
     painter.fillRect(buffer->rect(), backgroundColor);
 
     // draw message
-    this->container_.paintElements(painter, ctx);
+    this->shared_->container.paintElements(painter, ctx);
 
 #ifdef FOURTF
     // debug
@@ -405,7 +563,7 @@ void MessageLayout::updateBuffer(QPixmap *buffer,
     QTextOption option;
     option.setAlignment(Qt::AlignRight | Qt::AlignTop);
 
-    painter.drawText(QRectF(1, 1, this->container_.getWidth() - 3, 1000),
+    painter.drawText(QRectF(1, 1, this->getWidth() - 3, 1000),
                      QString::number(this->layoutCount_) + ", " +
                          QString::number(++this->bufferUpdatedCount_),
                      option);
@@ -414,16 +572,18 @@ void MessageLayout::updateBuffer(QPixmap *buffer,
 
 void MessageLayout::invalidateBuffer()
 {
-    this->bufferValid_ = false;
+    this->shared_->bufferValid = false;
+    this->ownBufferValid_ = false;
 }
 
 void MessageLayout::deleteBuffer()
 {
-    if (this->buffer_ != nullptr)
-    {
-        DebugCount::decrease("message drawing buffers");
+    this->releaseBuffer();
+    this->deleteOwnBuffer();
 
-        this->buffer_ = nullptr;
+    if (this->shared_->bufferUsers == 0)
+    {
+        this->shared_->deleteBuffer();
     }
 }
 
@@ -432,10 +592,67 @@ void MessageLayout::deleteCache()
     this->deleteBuffer();
 
 #ifdef XD
-    this->container_.clear();
+    this->shared_->container.clear();
 #endif
 }
 
+uint8_t MessageLayout::sharedLayoutFlags() const
+{
+    auto layoutFlags = this->flags;
+    layoutFlags.unset(MessageLayoutFlag::RequiresBufferUpdate);
+    layoutFlags.unset(MessageLayoutFlag::RequiresLayout);
+    layoutFlags.unset(MessageLayoutFlag::Collapsed);
+    return static_cast<uint8_t>(layoutFlags.value());
+}
+
+bool MessageLayout::adoptShared(const SharedMessageLayout::Key &key)
+{
+    auto existing = SharedMessageLayout::find(key);
+    if (!existing)
+    {
+        return false;
+    }
+
+    if (existing != this->shared_)
+    {
+        this->setShared(std::move(existing));
+    }
+    this->laidOut_ = true;
+    this->flags.set(MessageLayoutFlag::Collapsed, this->shared_->collapsed);
+    return true;
+}
+
+void MessageLayout::setShared(std::shared_ptr<SharedMessageLayout> shared)
+{
+    this->releaseBuffer();
+    this->deleteOwnBuffer();
+    this->shared_ = std::move(shared);
+}
+
+void MessageLayout::releaseBuffer()
+{
+    if (!this->holdsBuffer_)
+    {
+        return;
+    }
+
+    this->holdsBuffer_ = false;
+    this->shared_->bufferUsers--;
+    if (this->shared_->bufferUsers == 0)
+    {
+        this->shared_->deleteBuffer();
+    }
+}
+
+void MessageLayout::deleteOwnBuffer()
+{
+    if (this->ownBuffer_ != nullptr)
+    {
+        DebugCount::decrease("message drawing buffers");
+        this->ownBuffer_ = nullptr;
+    }
+}
+
 // Elements
 //    assert(QThread::currentThread() == QApplication::instance()->thread());
 
@@ -445,7 +662,7 @@ void MessageLayout::deleteCache()
 const MessageLayoutElement *MessageLayout::getElementAt(QPoint point) const
 {
     // go through all words and return the first one that contains the point.
-    return this->container_.getElementAt(point);
+    return this->shared_->container.getElementAt(point);
 }
 
 std::pair<int, int> MessageLayout::getWordBounds(
@@ -455,7 +672,7 @@ std::pair<int, int> MessageLayout::getWordBounds(
     // elements in the container
     if (hoveredElement->getWordId() != -1)
     {
-        return this->container_.getWordBounds(hoveredElement);
+        return this->shared_->container.getWordBounds(hoveredElement);
     }
 
     const auto wordStart = this->getSelectionIndex(relativePos) -
@@ -469,23 +686,23 @@ std::pair<int, int> MessageLayout::getWordBounds(
 
 size_t MessageLayout::getLastCharacterIndex() const
 {
-    return this->container_.getLastCharacterIndex();
+    return this->shared_->container.getLastCharacterIndex();
 }
 
 size_t MessageLayout::getFirstMessageCharacterIndex() const
 {
-    return this->container_.getFirstMessageCharacterIndex();
+    return this->shared_->container.getFirstMessageCharacterIndex();
 }
 
 size_t MessageLayout::getSelectionIndex(QPoint position) const
 {
-    return this->container_.getSelectionIndex(position);
+    return this->shared_->container.getSelectionIndex(position);
 }
 
 void MessageLayout::addSelectionText(QString &str, uint32_t from, uint32_t to,
                                      CopyMode copymode)
 {
-    this->container_.addSelectionText(str, from, to, copymode);
+    this->shared_->container.addSelectionText(str, from, to, copymode);
 }
 
 bool MessageLayout::isReplyable() const
@@ -3,6 +3,7 @@
 #include "common/Common.hpp"
 #include "common/FlagsEnum.hpp"
 #include "messages/layouts/MessageLayoutContainer.hpp"
+#include "messages/layouts/SharedMessageLayout.hpp"
 
 #include <QPixmap>
 
@@ -15,7 +16,7 @@ struct Message;
 using MessagePtr = std::shared_ptr<const Message>;
 
 struct Selection;
-struct MessageLayoutContainer;
+class MessageTextMetrics;
 class MessageLayoutElement;
 struct MessagePaintContext;
 
@@ -32,11 +33,21 @@ enum class MessageLayoutFlag : uint8_t {
 };
 using MessageLayoutFlags = FlagsEnum<MessageLayoutFlag>;
 
+/// How MessageLayout::layout gets the widths of words that weren't measured
+/// for the current scale and fonts yet
+enum class TextMeasuring : uint8_t {
+    /// Measure them right away (for messages that are about to be shown)
+    Now,
+    /// Let the MessageLayoutWorker measure them if the message was never laid
+    /// out. It keeps a placeholder height until then.
+    InBackground,
+};
+
 struct MessagePaintResult {
     bool hasAnimatedElements = false;
 };
 
-class MessageLayout
+class MessageLayout : public std::enable_shared_from_this<MessageLayout>
 {
 public:
     MessageLayout(MessagePtr message_);
@@ -56,12 +67,42 @@ public:
 
     MessageLayoutFlags flags;
 
+    /**
+     * Lays out the message if anything changed since the last layout
+     *
+     * With TextMeasuring::InBackground, the text of a message that was never
+     * laid out is measured by the MessageLayoutWorker if this layout is owned
+     * by a shared_ptr. Until that's done, it keeps a placeholder height and
+     * isn't painted.
+     *
+     * If another view already laid out the same message with the same
+     * parameters, its result and paint buffer are reused.
+     *
+     * @return true if a redraw is required
+     */
     bool layout(int width, float scale_, float imageScale,
-                MessageElementFlags flags, bool shouldInvalidateBuffer);
+                MessageElementFlags flags, bool shouldInvalidateBuffer,
+                TextMeasuring measuring = TextMeasuring::Now);
+
+    /**
+     * Marks the text of this message as being measured with the given
+     * parameters by the MessageLayoutWorker
+     *
+     * @return false if metrics for these parameters exist or are pending
+     */
+    bool beginMeasuring(float scale, int fontGeneration);
+
+    /**
+     * Sets the text metrics measured by the MessageLayoutWorker
+     *
+     * @return true if the message has to be laid out again
+     */
+    bool setTextMetrics(std::shared_ptr<const MessageTextMetrics> metrics);
 
     // Painting
     MessagePaintResult paint(const MessagePaintContext &ctx);
     void invalidateBuffer();
+    /// Deletes the paint buffer unless other views still paint it
     void deleteBuffer();
     void deleteCache();
 
@@ -115,22 +156,43 @@ private:
     void actuallyLayout(int width, MessageElementFlags flags);
     void updateBuffer(QPixmap *buffer, const MessagePaintContext &ctx);
 
-    // Create new buffer if required, returning the buffer
+    /// Returns the buffer to paint for a canvas of `width`, creating it if
+    /// required. This is the shared buffer unless another view paints it with
+    /// a different width or DPR, in which case this layout uses its own one.
     QPixmap *ensureBuffer(QPainter &painter, int width);
 
+    /// The flags that are part of the SharedMessageLayout::Key
+    uint8_t sharedLayoutFlags() const;
+    /// Switches to the layout published with `key`, if there is one
+    bool adoptShared(const SharedMessageLayout::Key &key);
+    void setShared(std::shared_ptr<SharedMessageLayout> shared);
+    /// Stops counting this layout as a user of the shared buffer
+    void releaseBuffer();
+    void deleteOwnBuffer();
+
     // variables
     MessagePtr message_;
-    MessageLayoutContainer container_;
-    std::unique_ptr<QPixmap> buffer_{};
-    bool bufferValid_ = false;
+    std::shared_ptr<SharedMessageLayout> shared_;
+    /// Whether this layout is counted in shared_->bufferUsers
+    bool holdsBuffer_ = false;
+    /// Used instead of the shared buffer if another view paints that one
+    /// with a different size
+    std::unique_ptr<QPixmap> ownBuffer_;
+    bool ownBufferValid_ = false;
 
-    int height_ = 0;
     int currentLayoutWidth_ = -1;
     int layoutState_ = -1;
     float scale_ = -1;
     float imageScale_ = -1.F;
     MessageElementFlags currentWordFlags_;
 
+    std::shared_ptr<const MessageTextMetrics> textMetrics_;
+    float measuringScale_ = -1.F;
+    int measuringFontGeneration_ = -1;
+    /// False until the first layout with measured text
+    bool laidOut_ = false;
+    int placeholderHeight_ = 0;
+
 #ifdef FOURTF
     // Debug counters
     unsigned int layoutCount_ = 0;
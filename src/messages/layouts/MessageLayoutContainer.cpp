@@ -237,13 +237,14 @@ void MessageLayoutContainer::paintElements(QPainter &painter,
     }
 }
 
-bool MessageLayoutContainer::paintAnimatedElements(QPainter &painter,
-                                                   int yOffset) const
+bool MessageLayoutContainer::paintAnimatedElements(
+    QPainter &painter, int yOffset, std::vector<AnimatedRegion> *regions) const
 {
     bool anyAnimatedElement = false;
     for (const auto &element : this->elements_)
     {
-        anyAnimatedElement |= element->paintAnimated(painter, yOffset);
+        anyAnimatedElement |=
+            element->paintAnimated(painter, yOffset, regions);
     }
     return anyAnimatedElement;
 }
@@ -561,6 +562,18 @@ int MessageLayoutContainer::nextWordId()
     return this->currentWordId_++;
 }
 
+void MessageLayoutContainer::setTextMetrics(
+    std::shared_ptr<const MessageTextMetrics> metrics)
+{
+    this->textMetrics_ = std::move(metrics);
+}
+
+const std::shared_ptr<const MessageTextMetrics> &
+    MessageLayoutContainer::textMetrics() const
+{
+    return this->textMetrics_;
+}
+
 void MessageLayoutContainer::addElement(MessageLayoutElement *element,
                                         const bool forceAdd,
                                         const int prevIndex)
@@ -18,8 +18,10 @@ enum class MessageFlag : int64_t;
 enum class FirstWord { Neutral, RTL, LTR };
 using MessageFlags = FlagsEnum<MessageFlag>;
 class MessageLayoutElement;
+class MessageTextMetrics;
 struct Selection;
 struct MessagePaintContext;
+struct AnimatedRegion;
 
 struct MessageLayoutContainer {
     MessageLayoutContainer() = default;
@@ -65,9 +67,11 @@ struct MessageLayoutContainer {
 
     /**
      * Paint the animated elements in this message
+     * @param regions if not null, receives the areas of the painted elements
      * @returns true if this container contains at least one animated element
      */
-    bool paintAnimatedElements(QPainter &painter, int yOffset) const;
+    bool paintAnimatedElements(QPainter &painter, int yOffset,
+                               std::vector<AnimatedRegion> *regions) const;
 
     /**
      * Paint the selection for this container
@@ -179,6 +183,18 @@ struct MessageLayoutContainer {
      */
     int nextWordId();
 
+    /**
+     * Sets the precomputed text widths used by the following layouts
+     *
+     * Elements without metrics are measured while they're added.
+     */
+    void setTextMetrics(std::shared_ptr<const MessageTextMetrics> metrics);
+
+    /**
+     * Returns the precomputed text widths, may be null
+     */
+    const std::shared_ptr<const MessageTextMetrics> &textMetrics() const;
+
 private:
     struct Line {
         /**
@@ -314,6 +330,8 @@ private:
 
     std::vector<std::unique_ptr<MessageLayoutElement>> elements_;
 
+    std::shared_ptr<const MessageTextMetrics> textMetrics_;
+
     /**
      * A list of lines covering this message
      * A message that spans 3 lines in a view will have 3 elements in lines_
@@ -1,5 +1,6 @@
 #include "messages/layouts/MessageLayoutContext.hpp"
 
+#include "messages/Image.hpp"
 #include "singletons/Settings.hpp"
 #include "singletons/Theme.hpp"
 
@@ -85,4 +86,17 @@ void MessagePreferences::connectSettings(Settings *settings,
         holder);
 }
 
+bool AnimatedRegion::advanced() const
+{
+    auto image = this->image.lock();
+    if (!image)
+    {
+        // Either repainted on every tick or the image is gone, in which case
+        // the repaint drops this region
+        return true;
+    }
+
+    return image->frameIndex() != this->frame;
+}
+
 }  // namespace chatterino
@@ -2,6 +2,10 @@
 
 #include <QColor>
 #include <QPainter>
+#include <QRect>
+
+#include <memory>
+#include <vector>
 
 namespace pajlada::Signals {
 class SignalHolder;
@@ -10,6 +14,7 @@ class SignalHolder;
 namespace chatterino {
 
 class ColorProvider;
+class Image;
 class Theme;
 class Settings;
 struct Selection;
@@ -48,6 +53,17 @@ struct MessagePreferences {
                          pajlada::Signals::SignalHolder &holder);
 };
 
+/// An animated element painted by a view and the frame it showed
+struct AnimatedRegion {
+    QRect rect;
+    /// Empty if the element has to be repainted on every animation tick
+    std::weak_ptr<const Image> image;
+    int frame{};
+
+    /// @returns true if the element shows a different frame by now
+    bool advanced() const;
+};
+
 struct MessagePaintContext {
     QPainter &painter;
     const Selection &selection;
@@ -70,6 +86,9 @@ struct MessagePaintContext {
     size_t messageIndex{};
 
     bool isLastReadMessage{};
+
+    // collects the animated elements that were painted, can be null
+    std::vector<AnimatedRegion> *animatedRegions{};
 };
 
 }  // namespace chatterino
@@ -166,15 +166,15 @@ void ImageLayoutElement::paint(QPainter &painter,
         return;
     }
 
-    auto pixmap = this->image_->pixmapOrLoad();
-    if (pixmap && !this->image_->animated())
+    if (!this->image_->animated())
     {
         // fourtf: make it use qreal values
-        painter.drawPixmap(QRectF(this->getRect()), *pixmap, QRectF());
+        this->image_->paintOrLoad(painter, QRectF(this->getRect()));
     }
 }
 
-bool ImageLayoutElement::paintAnimated(QPainter &painter, int yOffset)
+bool ImageLayoutElement::paintAnimated(QPainter &painter, int yOffset,
+                                       std::vector<AnimatedRegion> *regions)
 {
     if (this->image_ == nullptr)
     {
@@ -183,13 +183,14 @@ bool ImageLayoutElement::paintAnimated(QPainter &painter, int yOffset)
 
     if (this->image_->animated())
     {
-        if (auto pixmap = this->image_->pixmapOrLoad())
+        auto rect = this->getRect();
+        rect.moveTop(rect.y() + yOffset);
+        if (regions)
         {
-            auto rect = this->getRect();
-            rect.moveTop(rect.y() + yOffset);
-            painter.drawPixmap(QRectF(rect), *pixmap, QRectF());
-            return true;
+            regions->push_back(
+                {rect, this->image_, this->image_->frameIndex()});
         }
+        return this->image_->paintOrLoad(painter, QRectF(rect));
     }
     return false;
 }
@@ -265,7 +266,6 @@ void LayeredImageLayoutElement::paint(QPainter &painter,
             continue;
         }
 
-        auto pixmap = img->pixmapOrLoad();
         if (img->animated())
         {
             // As soon as we see an animated emote layer, we can stop rendering
@@ -274,21 +274,19 @@ void LayeredImageLayoutElement::paint(QPainter &painter,
             return;
         }
 
-        if (pixmap)
-        {
-            // Matching the web chat behavior, we center the emote within the overall
-            // binding box. E.g. small overlay emotes like cvMask will sit in the direct
-            // center of even wide emotes.
-            auto &size = this->sizes_[i];
-            QRectF destRect(0, 0, size.width(), size.height());
-            alignRectBottomCenter(destRect, fullRect);
+        // Matching the web chat behavior, we center the emote within the overall
+        // binding box. E.g. small overlay emotes like cvMask will sit in the direct
+        // center of even wide emotes.
+        auto &size = this->sizes_[i];
+        QRectF destRect(0, 0, size.width(), size.height());
+        alignRectBottomCenter(destRect, fullRect);
 
-            painter.drawPixmap(destRect, *pixmap, QRectF());
-        }
+        img->paintOrLoad(painter, destRect);
     }
 }
 
-bool LayeredImageLayoutElement::paintAnimated(QPainter &painter, int yOffset)
+bool LayeredImageLayoutElement::paintAnimated(
+    QPainter &painter, int yOffset, std::vector<AnimatedRegion> *regions)
 {
     auto fullRect = QRectF(this->getRect());
     fullRect.moveTop(fullRect.y() + yOffset);
@@ -306,18 +304,25 @@ bool LayeredImageLayoutElement::paintAnimated(QPainter &painter, int yOffset)
         // to render the static emote again after animating anything below it.
         if (img->animated() || animatedFlag)
         {
-            if (auto pixmap = img->pixmapOrLoad())
+            // Matching the web chat behavior, we center the emote within the overall
+            // binding box. E.g. small overlay emotes like cvMask will sit in the direct
+            // center of even wide emotes.
+            auto &size = this->sizes_[i];
+            QRectF destRect(0, 0, size.width(), size.height());
+            alignRectBottomCenter(destRect, fullRect);
+
+            if (img->paintOrLoad(painter, destRect))
             {
-                // Matching the web chat behavior, we center the emote within the overall
-                // binding box. E.g. small overlay emotes like cvMask will sit in the direct
-                // center of even wide emotes.
-                auto &size = this->sizes_[i];
-                QRectF destRect(0, 0, size.width(), size.height());
-                alignRectBottomCenter(destRect, fullRect);
-
-                painter.drawPixmap(destRect, *pixmap, QRectF());
                 animatedFlag = true;
             }
+
+            // Any animated layer changing means the layers on top of it have
+            // to be painted again as well
+            if (regions && img->animated())
+            {
+                regions->push_back(
+                    {fullRect.toAlignedRect(), img, img->frameIndex()});
+            }
         }
     }
     return animatedFlag;
@@ -363,13 +368,15 @@ void ImageWithBackgroundLayoutElement::paint(
         return;
     }
 
-    auto pixmap = this->image_->pixmapOrLoad();
-    if (pixmap && !this->image_->animated())
+    if (!this->image_->animated())
     {
-        painter.fillRect(QRectF(this->getRect()), this->color_);
+        if (this->image_->loaded())
+        {
+            painter.fillRect(QRectF(this->getRect()), this->color_);
+        }
 
         // fourtf: make it use qreal values
-        painter.drawPixmap(QRectF(this->getRect()), *pixmap, QRectF());
+        this->image_->paintOrLoad(painter, QRectF(this->getRect()));
     }
 }
 
@@ -395,20 +402,22 @@ void ImageWithCircleBackgroundLayoutElement::paint(
         return;
     }
 
-    auto pixmap = this->image_->pixmapOrLoad();
-    if (pixmap && !this->image_->animated())
+    if (!this->image_->animated())
     {
         QRectF boxRect(this->getRect());
-        painter.setPen(Qt::NoPen);
-        painter.setBrush(QBrush(this->color_, Qt::SolidPattern));
-        painter.drawEllipse(boxRect);
+        if (this->image_->loaded())
+        {
+            painter.setPen(Qt::NoPen);
+            painter.setBrush(QBrush(this->color_, Qt::SolidPattern));
+            painter.drawEllipse(boxRect);
+        }
 
         QRectF imgRect;
         imgRect.setTopLeft(boxRect.topLeft());
         imgRect.setSize(this->imageSize_);
         imgRect.translate(this->padding_, this->padding_);
 
-        painter.drawPixmap(imgRect, *pixmap, QRectF());
+        this->image_->paintOrLoad(painter, imgRect);
     }
 }
 
@@ -488,7 +497,8 @@ void TextLayoutElement::paint(QPainter &painter,
     }
 }
 
-bool TextLayoutElement::paintAnimated(QPainter &painter, const int yOffset)
+bool TextLayoutElement::paintAnimated(QPainter &painter, const int yOffset,
+                                      std::vector<AnimatedRegion> *regions)
 {
     if (this->getRect().isEmpty())
     {
@@ -516,6 +526,11 @@ bool TextLayoutElement::paintAnimated(QPainter &painter, const int yOffset)
         auto rect = this->getRect();
         rect.moveTop(rect.y() + yOffset);
         painter.drawPixmap(rect, paintPixmap, QRectF());
+        if (regions)
+        {
+            auto image = paint->animationImage();
+            regions->push_back({rect, image, image ? image->frameIndex() : 0});
+        }
         return true;
     }
 
@@ -639,8 +654,9 @@ void TextIconLayoutElement::paint(QPainter &painter,
     }
 }
 
-bool TextIconLayoutElement::paintAnimated(QPainter & /*painter*/,
-                                          int /*yOffset*/)
+bool TextIconLayoutElement::paintAnimated(
+    QPainter & /*painter*/, int /*yOffset*/,
+    std::vector<AnimatedRegion> * /*regions*/)
 {
     return false;
 }
@@ -714,8 +730,9 @@ void ReplyCurveLayoutElement::paint(QPainter &painter,
     painter.drawPath(path);
 }
 
-bool ReplyCurveLayoutElement::paintAnimated(QPainter & /*painter*/,
-                                            int /*yOffset*/)
+bool ReplyCurveLayoutElement::paintAnimated(
+    QPainter & /*painter*/, int /*yOffset*/,
+    std::vector<AnimatedRegion> * /*regions*/)
 {
     return false;
 }
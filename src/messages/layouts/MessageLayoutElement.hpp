@@ -11,6 +11,8 @@
 
 #include <climits>
 #include <cstdint>
+#include <memory>
+#include <vector>
 
 class QPainter;
 
@@ -21,6 +23,7 @@ using ImagePtr = std::shared_ptr<Image>;
 enum class FontStyle : uint8_t;
 enum class MessageElementFlag : int64_t;
 struct MessageColors;
+struct AnimatedRegion;
 
 class MessageLayoutElement
 {
@@ -57,8 +60,10 @@ public:
     virtual size_t getSelectionIndexCount() const = 0;
     virtual void paint(QPainter &painter,
                        const MessageColors &messageColors) = 0;
+    /// @param regions if not null, receives the areas that were painted
     /// @returns true if anything was painted
-    virtual bool paintAnimated(QPainter &painter, int yOffset) = 0;
+    virtual bool paintAnimated(QPainter &painter, int yOffset,
+                               std::vector<AnimatedRegion> *regions) = 0;
     virtual int getMouseOverIndex(const QPoint &abs) const = 0;
     virtual int getXFromIndex(size_t index) = 0;
 
@@ -107,7 +112,8 @@ protected:
                              uint32_t to = UINT32_MAX) const override;
     size_t getSelectionIndexCount() const override;
     void paint(QPainter &painter, const MessageColors &messageColors) override;
-    bool paintAnimated(QPainter &painter, int yOffset) override;
+    bool paintAnimated(QPainter &painter, int yOffset,
+                       std::vector<AnimatedRegion> *regions) override;
     int getMouseOverIndex(const QPoint &abs) const override;
     int getXFromIndex(size_t index) override;
 
@@ -126,7 +132,8 @@ protected:
                              uint32_t to = UINT32_MAX) const override;
     size_t getSelectionIndexCount() const override;
     void paint(QPainter &painter, const MessageColors &messageColors) override;
-    bool paintAnimated(QPainter &painter, int yOffset) override;
+    bool paintAnimated(QPainter &painter, int yOffset,
+                       std::vector<AnimatedRegion> *regions) override;
     int getMouseOverIndex(const QPoint &abs) const override;
     int getXFromIndex(size_t index) override;
 
@@ -177,7 +184,8 @@ protected:
                              uint32_t to = UINT32_MAX) const override;
     size_t getSelectionIndexCount() const override;
     void paint(QPainter &painter, const MessageColors &messageColors) override;
-    bool paintAnimated(QPainter &painter, int yOffset) override;
+    bool paintAnimated(QPainter &painter, int yOffset,
+                       std::vector<AnimatedRegion> *regions) override;
     int getMouseOverIndex(const QPoint &abs) const override;
     int getXFromIndex(size_t index) override;
 
@@ -199,7 +207,8 @@ protected:
                              uint32_t to = UINT32_MAX) const override;
     size_t getSelectionIndexCount() const override;
     void paint(QPainter &painter, const MessageColors &messageColors) override;
-    bool paintAnimated(QPainter &painter, int yOffset) override;
+    bool paintAnimated(QPainter &painter, int yOffset,
+                       std::vector<AnimatedRegion> *regions) override;
     int getMouseOverIndex(const QPoint &abs) const override;
     int getXFromIndex(size_t index) override;
 
@@ -217,7 +226,8 @@ public:
 
 protected:
     void paint(QPainter &painter, const MessageColors &messageColors) override;
-    bool paintAnimated(QPainter &painter, int yOffset) override;
+    bool paintAnimated(QPainter &painter, int yOffset,
+                       std::vector<AnimatedRegion> *regions) override;
     int getMouseOverIndex(const QPoint &abs) const override;
     int getXFromIndex(size_t index) override;
     void addCopyTextToString(QString &str, uint32_t from = 0,
@@ -0,0 +1,283 @@
+#include "messages/layouts/MessageLayoutWorker.hpp"
+
+#include "Application.hpp"
+#include "debug/AssertInGuiThread.hpp"
+#include "messages/layouts/MessageLayout.hpp"
+#include "messages/Message.hpp"
+#include "messages/MessageElement.hpp"
+#include "util/DebugCount.hpp"
+#include "util/PostToThread.hpp"
+
+#include <QFontMetrics>
+#include <QtConcurrent>
+#include <QThread>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <array>
+#include <optional>
+
+namespace {
+
+using namespace chatterino;
+
+QThreadPool &layoutPool()
+{
+    static auto *pool = [] {
+        auto *pool = new QThreadPool;
+        // Image decoding already takes half of the cores
+        pool->setMaxThreadCount(std::max(1, QThread::idealThreadCount() / 4));
+        return pool;
+    }();
+    return *pool;
+}
+
+}  // namespace
+
+namespace chatterino {
+
+MessageTextMetrics::MessageTextMetrics(float scale, int fontGeneration)
+    : scale_(scale)
+    , fontGeneration_(fontGeneration)
+{
+}
+
+bool MessageTextMetrics::matches(float scale, int fontGeneration) const
+{
+    return this->scale_ == scale && this->fontGeneration_ == fontGeneration;
+}
+
+const std::vector<int> *MessageTextMetrics::wordWidths(
+    const TextElement &element) const
+{
+    auto it = this->entries_.find(&element);
+    if (it == this->entries_.end())
+    {
+        return nullptr;
+    }
+
+    const auto &entry = it->second;
+    if (entry.style != element.style() || entry.words != element.words())
+    {
+        return nullptr;
+    }
+
+    return &entry.widths;
+}
+
+/// Words and style of a text element, captured in the GUI thread since
+/// elements may change them while they're added to a container
+struct MessageLayoutWorker::TextRequest {
+    struct Text {
+        const MessageElement *element;
+        FontStyle style;
+        QStringList words;
+    };
+
+    float scale;
+    int fontGeneration;
+    std::vector<Text> texts;
+    /// QFonts are created from settings in the GUI thread, copies of them can
+    /// be used in any thread
+    std::array<std::optional<QFont>, size_t(FontStyle::EndType)> fonts;
+};
+
+MessageLayoutWorker &MessageLayoutWorker::instance()
+{
+    static auto *instance = new MessageLayoutWorker;
+    return *instance;
+}
+
+void MessageLayoutWorker::measure(const std::shared_ptr<MessageLayout> &layout,
+                                  float scale)
+{
+    assertInGuiThread();
+
+    const auto fontGeneration = getIApp()->getFonts()->getGeneration();
+    if (!layout->beginMeasuring(scale, fontGeneration))
+    {
+        return;
+    }
+
+    const auto &message = layout->getMessagePtr();
+    auto &entry = this->entry(message, scale, fontGeneration);
+    if (auto metrics = entry.metrics.lock())
+    {
+        // Measured for another view already
+        layout->setTextMetrics(std::move(metrics));
+        return;
+    }
+
+    entry.waiting.emplace_back(layout);
+    if (entry.pending != 0)
+    {
+        return;
+    }
+    entry.pending = ++this->lastRequest_;
+
+    DebugCount::increase("text measurements");
+    std::ignore = QtConcurrent::run(
+        &layoutPool(),
+        [this, key = Key{message.get(), scale, fontGeneration},
+         id = entry.pending,
+         request = captureText(*message, scale, fontGeneration)] {
+            postToThread(
+                [this, key, id, metrics = measureText(request)]() mutable {
+                    this->deliver(key, id, std::move(metrics));
+                });
+        });
+}
+
+std::shared_ptr<const MessageTextMetrics> MessageLayoutWorker::measureNow(
+    const MessagePtr &message, float scale)
+{
+    assertInGuiThread();
+
+    const auto fontGeneration = getIApp()->getFonts()->getGeneration();
+    auto &entry = this->entry(message, scale, fontGeneration);
+    if (auto metrics = entry.metrics.lock())
+    {
+        return metrics;
+    }
+
+    DebugCount::increase("text measurements");
+    auto metrics = measureText(captureText(*message, scale, fontGeneration));
+    entry.metrics = metrics;
+    return metrics;
+}
+
+MessageLayoutWorker::TextRequest MessageLayoutWorker::captureText(
+    const Message &message, float scale, int fontGeneration)
+{
+    auto *fonts = getIApp()->getFonts();
+
+    TextRequest request{
+        .scale = scale,
+        .fontGeneration = fontGeneration,
+    };
+    for (const auto &element : message.elements)
+    {
+        const auto *text = dynamic_cast<const TextElement *>(element.get());
+        if (text == nullptr)
+        {
+            continue;
+        }
+
+        auto style = text->layoutStyle();
+        auto &font = request.fonts[size_t(style)];
+        if (!font)
+        {
+            font = fonts->getFont(style, scale);
+        }
+        request.texts.push_back({text, style, text->layoutWords()});
+    }
+
+    return request;
+}
+
+std::shared_ptr<const MessageTextMetrics> MessageLayoutWorker::measureText(
+    const TextRequest &request)
+{
+    auto metrics = std::make_shared<MessageTextMetrics>(request.scale,
+                                                        request.fontGeneration);
+
+    std::array<std::optional<QFontMetrics>, size_t(FontStyle::EndType)>
+        metricsByStyle;
+    for (const auto &text : request.texts)
+    {
+        auto &fontMetrics = metricsByStyle[size_t(text.style)];
+        if (!fontMetrics)
+        {
+            fontMetrics.emplace(*request.fonts[size_t(text.style)]);
+        }
+
+        std::vector<int> widths;
+        widths.reserve(text.words.size());
+        for (const auto &word : text.words)
+        {
+            widths.push_back(fontMetrics->horizontalAdvance(word));
+        }
+
+        metrics->entries_.emplace(
+            text.element, MessageTextMetrics::Entry{text.style, text.words,
+                                                    std::move(widths)});
+    }
+
+    return metrics;
+}
+
+MessageLayoutWorker::Entry &MessageLayoutWorker::entry(
+    const MessagePtr &message, float scale, int fontGeneration)
+{
+    if (this->entries_.size() >= this->pruneThreshold_)
+    {
+        this->prune();
+    }
+
+    auto &entry = this->entries_[Key{message.get(), scale, fontGeneration}];
+    if (entry.message.lock() != message)
+    {
+        // Results for the deleted message are dropped in deliver(), since
+        // the request doesn't match anymore
+        entry = Entry{.message = message};
+    }
+    return entry;
+}
+
+void MessageLayoutWorker::deliver(
+    const Key &key, uint64_t request,
+    std::shared_ptr<const MessageTextMetrics> metrics)
+{
+    auto it = this->entries_.find(key);
+    if (it == this->entries_.end() || it->second.pending != request)
+    {
+        return;
+    }
+
+    auto &entry = it->second;
+    entry.pending = 0;
+    entry.metrics = metrics;
+
+    bool relayout = false;
+    for (const auto &weak : entry.waiting)
+    {
+        if (auto layout = weak.lock())
+        {
+            relayout |= layout->setTextMetrics(metrics);
+        }
+    }
+    entry.waiting.clear();
+
+    if (relayout)
+    {
+        this->scheduleMeasured();
+    }
+}
+
+void MessageLayoutWorker::prune()
+{
+    std::erase_if(this->entries_, [](const auto &item) {
+        const auto &entry = item.second;
+        return entry.pending == 0 &&
+               (entry.metrics.expired() || entry.message.expired());
+    });
+    this->pruneThreshold_ = std::max<size_t>(1024, this->entries_.size() * 2);
+}
+
+void MessageLayoutWorker::scheduleMeasured()
+{
+    if (this->measuredScheduled_)
+    {
+        return;
+    }
+    this->measuredScheduled_ = true;
+
+    // Queued behind the results that were already delivered, so views only
+    // lay out once for all of them
+    postToThread([this] {
+        this->measuredScheduled_ = false;
+        this->measured.invoke();
+    });
+}
+
+}  // namespace chatterino
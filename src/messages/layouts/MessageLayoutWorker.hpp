@@ -0,0 +1,142 @@
+#pragma once
+
+#include "singletons/Fonts.hpp"
+
+#include <pajlada/signals/signal.hpp>
+#include <QStringList>
+
+#include <compare>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace chatterino {
+
+struct Message;
+using MessagePtr = std::shared_ptr<const Message>;
+class MessageElement;
+class MessageLayout;
+class TextElement;
+
+/**
+ * @brief Widths of the words of all text elements in a message
+ *
+ * Measured by the MessageLayoutWorker for one scale and font generation and
+ * never modified once it's handed to a MessageLayout.
+ */
+class MessageTextMetrics
+{
+public:
+    MessageTextMetrics(float scale, int fontGeneration);
+
+    /// Returns true if these metrics were measured with the given parameters
+    bool matches(float scale, int fontGeneration) const;
+
+    /**
+     * Returns the width of each word of `element` in the order of
+     * TextElement::words(), or nullptr if the element wasn't measured with
+     * its current words and style
+     */
+    const std::vector<int> *wordWidths(const TextElement &element) const;
+
+private:
+    friend class MessageLayoutWorker;
+
+    struct Entry {
+        FontStyle style;
+        QStringList words;
+        std::vector<int> widths;
+    };
+
+    float scale_;
+    int fontGeneration_;
+    std::unordered_map<const MessageElement *, Entry> entries_;
+};
+
+/**
+ * @brief Measures the text of messages on background threads
+ *
+ * Measuring every word of a message is the most expensive part of laying it
+ * out. The worker does this on a thread pool with copies of the chat fonts,
+ * so the GUI thread only has to place words that are already measured.
+ * Placing elements and breaking lines stays on the GUI thread since it
+ * depends on images and settings which can only be read there.
+ *
+ * A message is measured once per scale and font generation, no matter how
+ * many views show it. The metrics are kept for as long as a layout uses them.
+ *
+ * Must only be used in the GUI thread, results are delivered there as well.
+ */
+class MessageLayoutWorker
+{
+public:
+    static MessageLayoutWorker &instance();
+
+    /**
+     * @brief Queues the text of `layout` to be measured at `scale`
+     *
+     * Does nothing if the layout already has or awaits metrics for this scale
+     * and the current fonts. If another layout of the same message has them,
+     * they're set on `layout` right away. Otherwise, they're set once
+     * measured and `measured` is invoked.
+     */
+    void measure(const std::shared_ptr<MessageLayout> &layout, float scale);
+
+    /**
+     * @brief Returns the metrics of the text of `message` at `scale`
+     *
+     * Measures the text in the GUI thread unless another layout of the same
+     * message has the metrics already.
+     */
+    std::shared_ptr<const MessageTextMetrics> measureNow(
+        const MessagePtr &message, float scale);
+
+    /// Invoked at most once per event loop iteration after layouts received
+    /// new metrics
+    pajlada::Signals::NoArgSignal measured;
+
+private:
+    struct Key {
+        const Message *message;
+        float scale;
+        int fontGeneration;
+
+        auto operator<=>(const Key &other) const = default;
+    };
+
+    struct Entry {
+        /// Guards against a new message at the address of a deleted one
+        std::weak_ptr<const Message> message;
+        std::weak_ptr<const MessageTextMetrics> metrics;
+        /// Layouts waiting for the metrics that are being measured
+        std::vector<std::weak_ptr<MessageLayout>> waiting;
+        /// The request that's being measured, 0 if there's none
+        uint64_t pending = 0;
+    };
+
+    /// The text of a message and the fonts to measure it with
+    struct TextRequest;
+
+    MessageLayoutWorker() = default;
+
+    static TextRequest captureText(const Message &message, float scale,
+                                   int fontGeneration);
+    static std::shared_ptr<const MessageTextMetrics> measureText(
+        const TextRequest &request);
+
+    Entry &entry(const MessagePtr &message, float scale, int fontGeneration);
+    void deliver(const Key &key, uint64_t request,
+                 std::shared_ptr<const MessageTextMetrics> metrics);
+    /// Forgets metrics that no layout uses anymore
+    void prune();
+    void scheduleMeasured();
+
+    std::map<Key, Entry> entries_;
+    uint64_t lastRequest_ = 0;
+    size_t pruneThreshold_ = 1024;
+    bool measuredScheduled_ = false;
+};
+
+}  // namespace chatterino
@@ -0,0 +1,114 @@
+#include "messages/layouts/SharedMessageLayout.hpp"
+
+#include "messages/MessageElement.hpp"
+#include "util/DebugCount.hpp"
+
+#include <functional>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+
+namespace {
+
+using namespace chatterino;
+
+struct KeyHash {
+    size_t operator()(const SharedMessageLayout::Key &key) const
+    {
+        size_t hash = std::hash<const void *>{}(key.message);
+        auto combine = [&hash](size_t value) {
+            hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        };
+
+        combine(std::hash<int>{}(key.width));
+        combine(std::hash<float>{}(key.scale));
+        combine(std::hash<float>{}(key.imageScale));
+        combine(std::hash<int64_t>{}(
+            static_cast<std::underlying_type_t<MessageElementFlag>>(
+                key.elementFlags.value())));
+        combine(std::hash<int>{}(key.layoutFlags));
+        combine(std::hash<int>{}(key.generation));
+        return hash;
+    }
+};
+
+struct Entry {
+    // Used to identify the layout in its destructor, where `weak` is
+    // already expired
+    const SharedMessageLayout *layout;
+    std::weak_ptr<SharedMessageLayout> weak;
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::unordered_map<SharedMessageLayout::Key, Entry, KeyHash> entries;
+};
+
+Registry &registry()
+{
+    static auto *instance = new Registry;
+    return *instance;
+}
+
+}  // namespace
+
+namespace chatterino {
+
+SharedMessageLayout::~SharedMessageLayout()
+{
+    this->deleteBuffer();
+
+    if (this->key_)
+    {
+        auto &reg = registry();
+        std::lock_guard lock(reg.mutex);
+        auto it = reg.entries.find(*this->key_);
+        if (it != reg.entries.end() && it->second.layout == this)
+        {
+            reg.entries.erase(it);
+        }
+    }
+}
+
+std::shared_ptr<SharedMessageLayout> SharedMessageLayout::find(const Key &key)
+{
+    auto &reg = registry();
+    std::lock_guard lock(reg.mutex);
+    auto it = reg.entries.find(key);
+    if (it == reg.entries.end())
+    {
+        return nullptr;
+    }
+    return it->second.weak.lock();
+}
+
+void SharedMessageLayout::publish(
+    const std::shared_ptr<SharedMessageLayout> &layout, const Key &key)
+{
+    auto &reg = registry();
+    std::lock_guard lock(reg.mutex);
+
+    if (layout->key_ && *layout->key_ != key)
+    {
+        auto it = reg.entries.find(*layout->key_);
+        if (it != reg.entries.end() && it->second.layout == layout.get())
+        {
+            reg.entries.erase(it);
+        }
+    }
+
+    reg.entries.insert_or_assign(key, Entry{layout.get(), layout});
+    layout->key_ = key;
+}
+
+void SharedMessageLayout::deleteBuffer()
+{
+    if (this->buffer != nullptr)
+    {
+        DebugCount::decrease("message drawing buffers");
+
+        this->buffer = nullptr;
+    }
+}
+
+}  // namespace chatterino
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "common/FlagsEnum.hpp"
+#include "messages/layouts/MessageLayoutContainer.hpp"
+
+#include <QPixmap>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace chatterino {
+
+struct Message;
+
+enum class MessageElementFlag : int64_t;
+using MessageElementFlags = FlagsEnum<MessageElementFlag>;
+
+/**
+ * @brief The laid out elements and the paint buffer of a message
+ *
+ * Views showing the same message with the same width, scale and element
+ * flags (e.g. the same channel in two splits) find each other's
+ * SharedMessageLayout through its Key and reuse it, so the message is only
+ * laid out and painted once.
+ *
+ * A SharedMessageLayout is never laid out again while multiple
+ * MessageLayouts use it. A MessageLayout that needs different parameters
+ * lays out into a new one instead.
+ *
+ * Only used from the GUI thread.
+ */
+class SharedMessageLayout
+{
+public:
+    struct Key {
+        const Message *message = nullptr;
+        int width = -1;
+        float scale = -1.F;
+        float imageScale = -1.F;
+        MessageElementFlags elementFlags;
+        /// The MessageLayoutFlags that affect the layout or the buffer
+        uint8_t layoutFlags = 0;
+        /// WindowManager::getGeneration() at the time of the layout
+        int generation = -1;
+
+        bool operator==(const Key &other) const = default;
+    };
+
+    SharedMessageLayout() = default;
+    ~SharedMessageLayout();
+
+    SharedMessageLayout(const SharedMessageLayout &) = delete;
+    SharedMessageLayout &operator=(const SharedMessageLayout &) = delete;
+    SharedMessageLayout(SharedMessageLayout &&) = delete;
+    SharedMessageLayout &operator=(SharedMessageLayout &&) = delete;
+
+    /// Returns the layout that was last published with `key` if it's alive
+    static std::shared_ptr<SharedMessageLayout> find(const Key &key);
+
+    /// Makes `layout` findable with `key`, replacing the previous layout
+    /// published with that key
+    static void publish(const std::shared_ptr<SharedMessageLayout> &layout,
+                        const Key &key);
+
+    void deleteBuffer();
+
+    MessageLayoutContainer container;
+    std::unique_ptr<QPixmap> buffer;
+    bool bufferValid = false;
+    int height = 0;
+    bool collapsed = false;
+
+    /// Number of MessageLayouts that painted the buffer and didn't release
+    /// it yet. The buffer is deleted once nobody uses it anymore.
+    int bufferUsers = 0;
+
+private:
+    std::optional<Key> key_;
+};
+
+}  // namespace chatterino
@@ -1,6 +1,7 @@
 #include "messages/search/AuthorPredicate.hpp"
 
 #include "messages/Message.hpp"
+#include "messages/MessageIndex.hpp"
 #include "util/Qt.hpp"
 
 namespace chatterino {
@@ -22,4 +23,16 @@ bool AuthorPredicate::appliesToImpl(const Message &message)
            authors_.contains(message.loginName, Qt::CaseInsensitive);
 }
 
+std::optional<std::vector<MessagePtr>> AuthorPredicate::candidatesImpl(
+    const MessageIndex &index) const
+{
+    std::vector<MessagePtr> candidates;
+    for (const auto &author : this->authors_)
+    {
+        auto messages = index.findByAuthorName(author);
+        candidates.insert(candidates.end(), messages.begin(), messages.end());
+    }
+    return candidates;
+}
+
 }  // namespace chatterino
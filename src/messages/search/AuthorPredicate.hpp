@@ -35,6 +35,9 @@ protected:
      */
     bool appliesToImpl(const Message &message) override;
 
+    std::optional<std::vector<MessagePtr>> candidatesImpl(
+        const MessageIndex &index) const override;
+
 private:
     /// Holds the user names that will be searched for
     QStringList authors_;
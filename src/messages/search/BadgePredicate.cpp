@@ -1,6 +1,7 @@
 #include "messages/search/BadgePredicate.hpp"
 
 #include "messages/Message.hpp"
+#include "messages/MessageIndex.hpp"
 #include "providers/twitch/TwitchBadge.hpp"
 #include "util/Qt.hpp"
 
@@ -45,4 +46,16 @@ bool BadgePredicate::appliesToImpl(const Message &message)
     return false;
 }
 
+std::optional<std::vector<MessagePtr>> BadgePredicate::candidatesImpl(
+    const MessageIndex &index) const
+{
+    std::vector<MessagePtr> candidates;
+    for (const auto &badge : this->badges_)
+    {
+        auto messages = index.findByBadge(badge);
+        candidates.insert(candidates.end(), messages.begin(), messages.end());
+    }
+    return candidates;
+}
+
 }  // namespace chatterino
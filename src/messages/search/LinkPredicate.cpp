@@ -2,6 +2,7 @@
 
 #include "common/LinkParser.hpp"
 #include "messages/Message.hpp"
+#include "messages/MessageIndex.hpp"
 #include "util/Qt.hpp"
 
 namespace chatterino {
@@ -24,4 +25,10 @@ bool LinkPredicate::appliesToImpl(const Message &message)
     return false;
 }
 
+std::optional<std::vector<MessagePtr>> LinkPredicate::candidatesImpl(
+    const MessageIndex &index) const
+{
+    return index.findWithLinks();
+}
+
 }  // namespace chatterino
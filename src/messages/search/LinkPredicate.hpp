@@ -29,6 +29,9 @@ protected:
      * @return true if the message contains a link, false otherwise
      */
     bool appliesToImpl(const Message &message) override;
+
+    std::optional<std::vector<MessagePtr>> candidatesImpl(
+        const MessageIndex &index) const override;
 };
 
 }  // namespace chatterino
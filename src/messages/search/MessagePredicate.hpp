@@ -1,10 +1,14 @@
 #pragma once
 
 #include <memory>
+#include <optional>
+#include <vector>
 
 namespace chatterino {
 
 struct Message;
+using MessagePtr = std::shared_ptr<const Message>;
+class MessageIndex;
 
 /**
  * @brief Abstract base class for message predicates.
@@ -38,6 +42,26 @@ public:
         return result;
     }
 
+    /**
+     * @brief Looks up the messages this predicate can apply to in a channel's
+     *        MessageIndex
+     *
+     * The result can contain messages this predicate doesn't apply to and
+     * duplicates, so appliesTo still has to be checked.
+     *
+     * @return the candidates, or std::nullopt if this predicate can't use
+     *         the index and has to be checked on every message
+     */
+    std::optional<std::vector<MessagePtr>> candidates(
+        const MessageIndex &index) const
+    {
+        if (this->isNegated_)
+        {
+            return std::nullopt;
+        }
+        return this->candidatesImpl(index);
+    }
+
 protected:
     explicit MessagePredicate(bool negate)
         : isNegated_(negate)
@@ -55,6 +79,17 @@ protected:
      */
     virtual bool appliesToImpl(const Message &message) = 0;
 
+    /**
+     * @brief Looks up the candidates for this (non-negated) predicate
+     *
+     * Predicates that aren't backed by the MessageIndex don't override this.
+     */
+    virtual std::optional<std::vector<MessagePtr>> candidatesImpl(
+        const MessageIndex & /*index*/) const
+    {
+        return std::nullopt;
+    }
+
 private:
     const bool isNegated_ = false;
 };
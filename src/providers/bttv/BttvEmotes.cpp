@@ -7,6 +7,7 @@
 #include "messages/Emote.hpp"
 #include "messages/Image.hpp"
 #include "messages/ImageSet.hpp"
+#include "messages/MergedEmoteMap.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "providers/bttv/liveupdates/BttvLiveUpdateMessages.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
@@ -227,6 +228,7 @@ void BttvEmotes::loadEmotes()
 void BttvEmotes::setEmotes(std::shared_ptr<const EmoteMap> emotes)
 {
     this->global_.set(std::move(emotes));
+    MergedEmoteMap::globalsChanged();
 }
 
 void BttvEmotes::loadChannel(std::weak_ptr<Channel> channel,
@@ -60,6 +60,7 @@ void FfzBadges::load()
     static QUrl url("https://api.frankerfacez.com/v1/badges/ids");
 
     NetworkRequest(url)
+        .priority(QNetworkRequest::LowPriority)
         .onSuccess([this](auto result) {
             std::unique_lock lock(this->mutex_);
 
@@ -5,6 +5,7 @@
 #include "common/QLogging.hpp"
 #include "messages/Emote.hpp"
 #include "messages/Image.hpp"
+#include "messages/MergedEmoteMap.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "providers/ffz/FfzUtil.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
@@ -247,6 +248,7 @@ void FfzEmotes::loadEmotes()
 void FfzEmotes::setEmotes(std::shared_ptr<const EmoteMap> emotes)
 {
     this->global_.set(std::move(emotes));
+    MergedEmoteMap::globalsChanged();
 }
 
 void FfzEmotes::loadChannel(
@@ -0,0 +1,269 @@
+#include "providers/irc/IrcLine.hpp"
+
+#include <string>
+
+namespace {
+
+using namespace std::string_view_literals;
+
+std::string_view trimLineEnding(std::string_view data)
+{
+    while (!data.empty() && (data.back() == '\r' || data.back() == '\n'))
+    {
+        data.remove_suffix(1);
+    }
+    return data;
+}
+
+}  // namespace
+
+namespace chatterino {
+
+std::optional<IrcLine> IrcLine::parse(QByteArray line)
+{
+    IrcLine result;
+    result.data_ = std::move(line);
+
+    const auto data = trimLineEnding(std::string_view(
+        result.data_.constData(), static_cast<size_t>(result.data_.size())));
+
+    size_t pos = 0;
+    auto range = [](size_t begin, size_t end) {
+        return Range{static_cast<uint32_t>(begin),
+                     static_cast<uint32_t>(end - begin)};
+    };
+    auto skipSpaces = [&] {
+        while (pos < data.size() && data[pos] == ' ')
+        {
+            ++pos;
+        }
+    };
+    auto tokenEnd = [&] {
+        auto end = data.find(' ', pos);
+        return end == std::string_view::npos ? data.size() : end;
+    };
+
+    skipSpaces();
+
+    // @key=value;key2=value2
+    if (pos < data.size() && data[pos] == '@')
+    {
+        ++pos;
+        const auto end = tokenEnd();
+        while (pos < end)
+        {
+            auto tagEnd = data.find(';', pos);
+            if (tagEnd == std::string_view::npos || tagEnd > end)
+            {
+                tagEnd = end;
+            }
+
+            Tag tag;
+            auto equals = data.find('=', pos);
+            if (equals != std::string_view::npos && equals < tagEnd)
+            {
+                tag.key = range(pos, equals);
+                tag.value = range(equals + 1, tagEnd);
+            }
+            else
+            {
+                // A tag without a value
+                tag.key = range(pos, tagEnd);
+                tag.value = range(tagEnd, tagEnd);
+            }
+
+            if (tag.key.length > 0)
+            {
+                result.tags_.push_back(tag);
+            }
+            pos = tagEnd + 1;
+        }
+        pos = end;
+        skipSpaces();
+    }
+
+    // :nick!user@host
+    if (pos < data.size() && data[pos] == ':')
+    {
+        ++pos;
+        const auto end = tokenEnd();
+        result.prefix_ = range(pos, end);
+
+        auto nickEnd = data.substr(pos, end - pos).find_first_of("!@"sv);
+        result.nick_ = nickEnd == std::string_view::npos
+                           ? result.prefix_
+                           : range(pos, pos + nickEnd);
+
+        pos = end;
+        skipSpaces();
+    }
+
+    const auto commandEnd = tokenEnd();
+    if (pos == commandEnd)
+    {
+        return std::nullopt;
+    }
+    result.command_ = range(pos, commandEnd);
+    pos = commandEnd;
+    skipSpaces();
+
+    while (pos < data.size())
+    {
+        if (data[pos] == ':')
+        {
+            result.parameters_.push_back(range(pos + 1, data.size()));
+            break;
+        }
+
+        const auto end = tokenEnd();
+        result.parameters_.push_back(range(pos, end));
+        pos = end;
+        skipSpaces();
+    }
+
+    return result;
+}
+
+QString IrcLine::unescapeTagValue(std::string_view value)
+{
+    if (value.find('\\') == std::string_view::npos)
+    {
+        return QString::fromUtf8(value.data(),
+                                 static_cast<qsizetype>(value.size()));
+    }
+
+    std::string unescaped;
+    unescaped.reserve(value.size());
+    for (size_t i = 0; i < value.size(); i++)
+    {
+        if (value[i] != '\\')
+        {
+            unescaped.push_back(value[i]);
+            continue;
+        }
+
+        // A trailing backslash is dropped
+        if (++i == value.size())
+        {
+            break;
+        }
+
+        switch (value[i])
+        {
+            case ':':
+                unescaped.push_back(';');
+                break;
+            case 's':
+                unescaped.push_back(' ');
+                break;
+            case 'r':
+                unescaped.push_back('\r');
+                break;
+            case 'n':
+                unescaped.push_back('\n');
+                break;
+            default:
+                // Includes the escaped backslash
+                unescaped.push_back(value[i]);
+                break;
+        }
+    }
+
+    return QString::fromUtf8(unescaped.data(),
+                             static_cast<qsizetype>(unescaped.size()));
+}
+
+const QByteArray &IrcLine::data() const
+{
+    return this->data_;
+}
+
+std::string_view IrcLine::prefix() const
+{
+    return this->view(this->prefix_);
+}
+
+std::string_view IrcLine::nick() const
+{
+    return this->view(this->nick_);
+}
+
+std::string_view IrcLine::command() const
+{
+    return this->view(this->command_);
+}
+
+size_t IrcLine::parameterCount() const
+{
+    return this->parameters_.size();
+}
+
+std::string_view IrcLine::parameter(size_t index) const
+{
+    if (index >= this->parameters_.size())
+    {
+        return {};
+    }
+
+    return this->view(this->parameters_[index]);
+}
+
+bool IrcLine::hasTag(std::string_view key) const
+{
+    return this->findTag(key) != nullptr;
+}
+
+std::optional<std::string_view> IrcLine::rawTag(std::string_view key) const
+{
+    const auto *tag = this->findTag(key);
+    if (tag == nullptr)
+    {
+        return std::nullopt;
+    }
+
+    return this->view(tag->value);
+}
+
+QString IrcLine::tag(std::string_view key) const
+{
+    const auto *tag = this->findTag(key);
+    if (tag == nullptr)
+    {
+        return {};
+    }
+
+    return IrcLine::unescapeTagValue(this->view(tag->value));
+}
+
+QVariantMap IrcLine::tags() const
+{
+    QVariantMap map;
+    for (const auto &tag : this->tags_)
+    {
+        auto key = this->view(tag.key);
+        map.insert(QString::fromLatin1(key.data(),
+                                       static_cast<qsizetype>(key.size())),
+                   IrcLine::unescapeTagValue(this->view(tag.value)));
+    }
+    return map;
+}
+
+std::string_view IrcLine::view(Range range) const
+{
+    return {this->data_.constData() + range.offset, range.length};
+}
+
+const IrcLine::Tag *IrcLine::findTag(std::string_view key) const
+{
+    // Later tags override earlier ones with the same key
+    for (auto it = this->tags_.rbegin(); it != this->tags_.rend(); ++it)
+    {
+        if (this->view(it->key) == key)
+        {
+            return &*it;
+        }
+    }
+    return nullptr;
+}
+
+}  // namespace chatterino
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <boost/container/small_vector.hpp>
+#include <QByteArray>
+#include <QString>
+#include <QVariantMap>
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace chatterino {
+
+/**
+ * @brief An IRCv3 line that's tokenized without copying
+ *
+ * The tags, prefix, command and parameters are stored as ranges of the
+ * UTF-8 buffer passed to parse(), which the line keeps alive. Tag values are
+ * only unescaped and decoded once they're read.
+ *
+ * Unlike Communi::IrcMessage, this doesn't allocate a QObject or a
+ * QVariantMap per line.
+ */
+class IrcLine
+{
+public:
+    /**
+     * @brief Tokenizes a single line without its line ending
+     *
+     * @return the line, or std::nullopt if it doesn't contain a command
+     */
+    static std::optional<IrcLine> parse(QByteArray line);
+
+    /// Unescapes an IRCv3 tag value (e.g. `\s` becomes a space)
+    static QString unescapeTagValue(std::string_view value);
+
+    /// The whole line as it was passed to parse()
+    const QByteArray &data() const;
+
+    /// The prefix without the leading colon, empty if there's none
+    std::string_view prefix() const;
+    /// The part of the prefix before the `!`
+    std::string_view nick() const;
+    std::string_view command() const;
+
+    size_t parameterCount() const;
+    /// The parameter at `index`, the trailing parameter is included without
+    /// its colon. Returns an empty view if there's no such parameter.
+    std::string_view parameter(size_t index) const;
+
+    bool hasTag(std::string_view key) const;
+    /// The escaped value of the tag, std::nullopt if it's not present
+    std::optional<std::string_view> rawTag(std::string_view key) const;
+    /// The unescaped value of the tag, an empty string if it's not present
+    QString tag(std::string_view key) const;
+
+    /// All tags with unescaped values, like Communi::IrcMessage::tags()
+    QVariantMap tags() const;
+
+private:
+    struct Range {
+        uint32_t offset = 0;
+        uint32_t length = 0;
+    };
+
+    struct Tag {
+        Range key;
+        Range value;
+    };
+
+    IrcLine() = default;
+
+    std::string_view view(Range range) const;
+    const Tag *findTag(std::string_view key) const;
+
+    QByteArray data_;
+    Range prefix_;
+    Range nick_;
+    Range command_;
+    // Twitch sends up to ~20 tags on chat messages
+    boost::container::small_vector<Tag, 24> tags_;
+    boost::container::small_vector<Range, 4> parameters_;
+};
+
+}  // namespace chatterino
@@ -51,12 +51,12 @@ MessagePtr IrcMessageBuilder::build()
 {
     // PARSE
     this->parse();
-    this->usernameColor_ = getRandomColor(this->ircMessage->nick());
+    this->usernameColor_ = getRandomColor(this->nick_);
 
     // PUSH ELEMENTS
     this->appendChannelName();
 
-    this->message().serverReceivedTime = calculateMessageTime(this->ircMessage);
+    this->message().serverReceivedTime = calculateMessageTime(this->tags);
     this->emplace<TimestampElement>(this->message().serverReceivedTime.time());
 
     this->appendUsername();
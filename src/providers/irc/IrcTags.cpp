@@ -0,0 +1,48 @@
+#include "providers/irc/IrcTags.hpp"
+
+namespace {
+
+QString toKey(std::string_view key)
+{
+    return QString::fromLatin1(key.data(), static_cast<qsizetype>(key.size()));
+}
+
+}  // namespace
+
+namespace chatterino {
+
+IrcTags::IrcTags(QVariantMap tags)
+    : tags_(std::move(tags))
+{
+}
+
+IrcTags::IrcTags(IrcLine line)
+    : tags_(std::move(line))
+{
+}
+
+bool IrcTags::contains(std::string_view key) const
+{
+    if (const auto *map = std::get_if<QVariantMap>(&this->tags_))
+    {
+        return map->contains(toKey(key));
+    }
+    return std::get<IrcLine>(this->tags_).hasTag(key);
+}
+
+QVariant IrcTags::value(std::string_view key) const
+{
+    if (const auto *map = std::get_if<QVariantMap>(&this->tags_))
+    {
+        return map->value(toKey(key));
+    }
+
+    auto raw = std::get<IrcLine>(this->tags_).rawTag(key);
+    if (!raw)
+    {
+        return {};
+    }
+    return IrcLine::unescapeTagValue(*raw);
+}
+
+}  // namespace chatterino
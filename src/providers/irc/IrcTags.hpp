@@ -0,0 +1,35 @@
+#pragma once
+
+#include "providers/irc/IrcLine.hpp"
+
+#include <QString>
+#include <QVariant>
+#include <QVariantMap>
+
+#include <string_view>
+#include <variant>
+
+namespace chatterino {
+
+/**
+ * @brief Read-only view of the tags of an IRC message
+ *
+ * The tags either come from a QVariantMap (like Communi::IrcMessage::tags())
+ * or are read from an IrcLine, where each value is only unescaped once it's
+ * looked up.
+ */
+class IrcTags
+{
+public:
+    IrcTags(QVariantMap tags);
+    IrcTags(IrcLine line);
+
+    bool contains(std::string_view key) const;
+    /// The value of the tag, an invalid QVariant if it's not present
+    QVariant value(std::string_view key) const;
+
+private:
+    std::variant<QVariantMap, IrcLine> tags_;
+};
+
+}  // namespace chatterino
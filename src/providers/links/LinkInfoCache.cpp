@@ -0,0 +1,183 @@
+#include "providers/links/LinkInfoCache.hpp"
+
+#include "messages/Image.hpp"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QUrl>
+
+namespace {
+
+/// Rough overhead of an entry besides its strings
+constexpr int64_t ENTRY_OVERHEAD = 128;
+
+int64_t stringBytes(const QString &string)
+{
+    return string.size() * static_cast<int64_t>(sizeof(QChar));
+}
+
+}  // namespace
+
+namespace chatterino {
+
+LinkInfoCache::LinkInfoCache(int64_t byteBudget)
+    : byteBudget_(byteBudget)
+{
+}
+
+QString LinkInfoCache::normalizeUrl(const QString &url)
+{
+    // fromUserInput adds a missing scheme, QUrl lowercases the scheme
+    // and host
+    auto parsed = QUrl::fromUserInput(url.trimmed());
+    if (!parsed.isValid())
+    {
+        return url;
+    }
+
+    parsed = parsed.adjusted(QUrl::NormalizePathSegments |
+                             QUrl::StripTrailingSlash);
+    // StripTrailingSlash keeps the slash of the root path
+    if (parsed.path() == u"/")
+    {
+        parsed.setPath({});
+    }
+
+    return parsed.toString(QUrl::FullyEncoded);
+}
+
+ResolvedLinkInfo *LinkInfoCache::find(const QString &key, const QDateTime &now)
+{
+    auto it = this->index_.find(key);
+    if (it == this->index_.end())
+    {
+        return nullptr;
+    }
+
+    if (it->second->second.expiresAt <= now)
+    {
+        this->entries_.erase(it->second);
+        this->index_.erase(it);
+        return nullptr;
+    }
+
+    this->entries_.splice(this->entries_.begin(), this->entries_, it->second);
+    return &it->second->second;
+}
+
+void LinkInfoCache::insert(const QString &key, ResolvedLinkInfo info)
+{
+    auto it = this->index_.find(key);
+    if (it != this->index_.end())
+    {
+        this->entries_.erase(it->second);
+        this->index_.erase(it);
+    }
+
+    this->entries_.emplace_front(key, std::move(info));
+    this->index_.emplace(key, this->entries_.begin());
+
+    this->trim();
+}
+
+void LinkInfoCache::trim()
+{
+    // Thumbnails load after their entry was added, so the usage is
+    // recalculated instead of being tracked
+    auto usage = this->memoryUsage();
+    while (usage > this->byteBudget_ && this->entries_.size() > 1)
+    {
+        const auto &last = this->entries_.back();
+        usage -= LinkInfoCache::memoryUsage(last);
+        this->index_.erase(last.first);
+        this->entries_.pop_back();
+    }
+}
+
+size_t LinkInfoCache::size() const
+{
+    return this->entries_.size();
+}
+
+int64_t LinkInfoCache::memoryUsage() const
+{
+    int64_t usage = 0;
+    for (const auto &entry : this->entries_)
+    {
+        usage += LinkInfoCache::memoryUsage(entry);
+    }
+    return usage;
+}
+
+int64_t LinkInfoCache::memoryUsage(const Entry &entry)
+{
+    const auto &[key, info] = entry;
+    int64_t usage = ENTRY_OVERHEAD + stringBytes(key) +
+                    stringBytes(info.tooltip) + stringBytes(info.resolvedUrl) +
+                    stringBytes(info.thumbnailUrl);
+
+    if (info.thumbnail && info.thumbnail->loaded())
+    {
+        usage += static_cast<int64_t>(info.thumbnail->width()) *
+                 info.thumbnail->height() * 4;
+    }
+
+    return usage;
+}
+
+QByteArray LinkInfoCache::serialize(size_t maxEntries) const
+{
+    QJsonArray array;
+    for (const auto &[key, info] : this->entries_)
+    {
+        if (static_cast<size_t>(array.size()) >= maxEntries)
+        {
+            break;
+        }
+
+        array.append(QJsonObject{
+            {"url", key},
+            {"tooltip", info.tooltip},
+            {"resolvedUrl", info.resolvedUrl},
+            {"thumbnailUrl", info.thumbnailUrl},
+            {"expiresAt", info.expiresAt.toMSecsSinceEpoch()},
+        });
+    }
+
+    return QJsonDocument(array).toJson(QJsonDocument::Compact);
+}
+
+void LinkInfoCache::deserialize(const QByteArray &data, const QDateTime &now)
+{
+    const auto array = QJsonDocument::fromJson(data).array();
+
+    // The file is ordered by most recently used. Entries resolved in the
+    // meantime stay ahead of the loaded ones.
+    for (const auto &value : array)
+    {
+        const auto object = value.toObject();
+        const auto key = object["url"].toString();
+        const auto expiresAt = QDateTime::fromMSecsSinceEpoch(
+            static_cast<qint64>(object["expiresAt"].toDouble()));
+
+        if (key.isEmpty() || expiresAt <= now || this->index_.contains(key))
+        {
+            continue;
+        }
+
+        ResolvedLinkInfo info{
+            .tooltip = object["tooltip"].toString(),
+            .resolvedUrl = object["resolvedUrl"].toString(),
+            .thumbnailUrl = object["thumbnailUrl"].toString(),
+            .thumbnail = nullptr,
+            .expiresAt = expiresAt,
+        };
+        this->entries_.emplace_back(key, std::move(info));
+        this->index_.emplace(key, std::prev(this->entries_.end()));
+    }
+
+    this->trim();
+}
+
+}  // namespace chatterino
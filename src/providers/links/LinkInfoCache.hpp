@@ -0,0 +1,79 @@
+#pragma once
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QString>
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+namespace chatterino {
+
+class Image;
+using ImagePtr = std::shared_ptr<Image>;
+
+/// The response of the link resolver for one URL
+struct ResolvedLinkInfo {
+    QString tooltip;
+    /// The unshortened URL, empty if the resolver didn't provide one
+    QString resolvedUrl;
+    QString thumbnailUrl;
+    /// Created from #thumbnailUrl once the info is shown.
+    /// Its memory counts towards the budget of the cache.
+    ImagePtr thumbnail;
+
+    QDateTime expiresAt;
+};
+
+/**
+ * @brief LRU cache of resolved link infos
+ *
+ * Entries are keyed by their normalized URL and expire after a fixed time.
+ * The least recently used entries are dropped once the estimated memory of
+ * all entries, including their loaded thumbnails, exceeds the budget.
+ *
+ * Must only be used from the GUI thread.
+ */
+class LinkInfoCache
+{
+public:
+    LinkInfoCache(int64_t byteBudget);
+
+    /// Normalizes @a url so different spellings of it share one entry
+    static QString normalizeUrl(const QString &url);
+
+    /// @returns the entry for @a key or nullptr if there's none or it expired
+    ResolvedLinkInfo *find(
+        const QString &key,
+        const QDateTime &now = QDateTime::currentDateTimeUtc());
+
+    void insert(const QString &key, ResolvedLinkInfo info);
+
+    /// Drops the least recently used entries that exceed the budget
+    void trim();
+
+    size_t size() const;
+    int64_t memoryUsage() const;
+
+    /// Serializes up to @a maxEntries of the most recently used entries
+    QByteArray serialize(size_t maxEntries) const;
+
+    /// Adds the unexpired entries of @a data that aren't in the cache yet
+    void deserialize(const QByteArray &data,
+                     const QDateTime &now = QDateTime::currentDateTimeUtc());
+
+private:
+    using Entry = std::pair<QString, ResolvedLinkInfo>;
+
+    static int64_t memoryUsage(const Entry &entry);
+
+    const int64_t byteBudget_;
+
+    // most recently used first
+    std::list<Entry> entries_;
+    std::unordered_map<QString, std::list<Entry>::iterator> index_;
+};
+
+}  // namespace chatterino
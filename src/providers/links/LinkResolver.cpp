@@ -1,20 +1,55 @@
 #include "providers/links/LinkResolver.hpp"
 
+#include "Application.hpp"
 #include "common/Env.hpp"
 #include "common/network/NetworkRequest.hpp"
 #include "common/network/NetworkResult.hpp"
+#include "debug/AssertInGuiThread.hpp"
+#include "messages/Image.hpp"
 #include "providers/links/LinkInfo.hpp"
+#include "singletons/Paths.hpp"
 #include "singletons/Settings.hpp"
+#include "singletons/WindowManager.hpp"
+#include "util/BackgroundSaver.hpp"
+#include "util/BinarySnapshot.hpp"
+#include "util/PostToThread.hpp"
 
+#include <QFile>
 #include <QStringBuilder>
+#include <QtConcurrent>
+
+namespace {
+
+using namespace std::chrono_literals;
+
+/// Includes the memory of loaded thumbnails
+constexpr int64_t CACHE_BUDGET = 16 * 1024 * 1024;
+constexpr qint64 CACHE_TTL_SECONDS = 12 * 60 * 60;
+/// Only the most recently used entries are written to disk
+constexpr size_t PERSISTED_ENTRIES = 1000;
+/// Resolves in quick succession are written once
+constexpr auto SAVE_DELAY = 10s;
+
+}  // namespace
 
 namespace chatterino {
 
+LinkResolver::LinkResolver()
+    : cache_(CACHE_BUDGET)
+{
+    this->saveTimer_.setSingleShot(true);
+    this->saveTimer_.setInterval(SAVE_DELAY);
+    QObject::connect(&this->saveTimer_, &QTimer::timeout, [this] {
+        this->saveCache();
+    });
+}
+
 void LinkResolver::resolve(LinkInfo *info)
 {
     using State = LinkInfo::State;
 
     assert(info);
+    assertInGuiThread();
 
     if (info->state() != State::Created)
     {
@@ -27,46 +62,176 @@ void LinkResolver::resolve(LinkInfo *info)
         return;
     }
 
+    this->loadCache();
+
+    auto key = LinkInfoCache::normalizeUrl(info->originalUrl());
+    if (auto *cached = this->cache_.find(key))
+    {
+        this->apply(info, *cached);
+        return;
+    }
+
     info->setTooltip("Loading...");
     info->setState(State::Loading);
 
+    auto [pending, inserted] = this->pending_.try_emplace(key);
+    pending->second.emplace_back(info);
+    if (!inserted)
+    {
+        // The same URL is already being resolved
+        return;
+    }
+
     NetworkRequest(Env::get().linkResolverUrl.arg(QString::fromUtf8(
                        QUrl::toPercentEncoding(info->originalUrl(), {}, "/:"))))
-        .caller(info)
         .timeout(30000)
-        .onSuccess([info](const NetworkResult &result) {
+        .onSuccess([this, key](const NetworkResult &result) {
             const auto root = result.parseJson();
-            QString response;
-            QString url;
-            ImagePtr thumbnail = nullptr;
-            if (root["status"].toInt() == 200)
+            ResolvedLinkInfo resolved;
+            const bool ok = root["status"].toInt() == 200;
+            if (ok)
             {
-                response = root["tooltip"].toString();
+                resolved.tooltip = root["tooltip"].toString();
+                resolved.thumbnailUrl = root["thumbnail"].toString();
+                resolved.resolvedUrl = root["link"].toString();
+            }
+            else
+            {
+                resolved.tooltip = root["message"].toString();
+            }
+            resolved.tooltip =
+                QUrl::fromPercentEncoding(resolved.tooltip.toUtf8());
+            resolved.expiresAt =
+                QDateTime::currentDateTimeUtc().addSecs(CACHE_TTL_SECONDS);
+
+            auto infos = std::move(this->pending_[key]);
+            this->pending_.erase(key);
 
-                if (root.contains("thumbnail"))
+            // Errors (e.g. timeouts on the resolver's side) are often
+            // temporary, so only successful responses are cached
+            ResolvedLinkInfo *applied = &resolved;
+            if (ok)
+            {
+                this->cache_.insert(key, std::move(resolved));
+                this->saveTimer_.start();
+                applied = this->cache_.find(key);
+            }
+
+            for (const auto &waiting : infos)
+            {
+                if (waiting && applied)
                 {
-                    info->setThumbnail(
-                        Image::fromUrl({root["thumbnail"].toString()}));
+                    this->apply(waiting, *applied);
                 }
-                if (getSettings()->unshortLinks && root.contains("link"))
+            }
+        })
+        .onError([this, key](const NetworkResult &result) {
+            auto infos = std::move(this->pending_[key]);
+            this->pending_.erase(key);
+
+            for (const auto &waiting : infos)
+            {
+                if (!waiting)
                 {
-                    info->setResolvedUrl(root["link"].toString());
+                    continue;
                 }
+                waiting->setTooltip(u"No link info found (" %
+                                    result.formatError() % u')');
+                waiting->setState(State::Errored);
             }
-            else
+        })
+        .execute();
+}
+
+void LinkResolver::apply(LinkInfo *info, ResolvedLinkInfo &resolved)
+{
+    if (!resolved.thumbnailUrl.isEmpty())
+    {
+        if (!resolved.thumbnail)
+        {
+            resolved.thumbnail = Image::fromUrl({resolved.thumbnailUrl});
+            this->watchThumbnail(resolved.thumbnail);
+        }
+        info->setThumbnail(resolved.thumbnail);
+    }
+    if (getSettings()->unshortLinks && !resolved.resolvedUrl.isEmpty())
+    {
+        info->setResolvedUrl(resolved.resolvedUrl);
+    }
+
+    info->setTooltip(resolved.tooltip);
+    info->setState(LinkInfo::State::Resolved);
+}
+
+void LinkResolver::watchThumbnail(const ImagePtr &thumbnail)
+{
+    this->loadingThumbnails_.emplace_back(thumbnail);
+    if (this->watchingLayouts_)
+    {
+        return;
+    }
+    this->watchingLayouts_ = true;
+
+    // Loaded images request a layout of all channel views
+    this->connections_.managedConnect(
+        getIApp()->getWindows()->layoutRequested, [this](Channel *channel) {
+            if (channel != nullptr || this->loadingThumbnails_.empty())
             {
-                response = root["message"].toString();
+                return;
             }
 
-            info->setTooltip(QUrl::fromPercentEncoding(response.toUtf8()));
-            info->setState(State::Resolved);
-        })
-        .onError([info](const auto &result) {
-            info->setTooltip(u"No link info found (" % result.formatError() %
-                             u')');
-            info->setState(State::Errored);
-        })
-        .execute();
+            // Thumbnails of evicted entries are gone and don't need a trim
+            bool anyLoaded = false;
+            std::erase_if(this->loadingThumbnails_, [&](const auto &weak) {
+                auto thumbnail = weak.lock();
+                if (thumbnail && thumbnail->loaded())
+                {
+                    anyLoaded = true;
+                    return true;
+                }
+                return !thumbnail;
+            });
+
+            if (anyLoaded)
+            {
+                this->cache_.trim();
+            }
+        });
+}
+
+QString LinkResolver::cachePath() const
+{
+    return getIApp()->getPaths().cacheDirectory() % u"/linkinfo.json";
+}
+
+void LinkResolver::loadCache()
+{
+    if (this->cacheLoaded_)
+    {
+        return;
+    }
+    this->cacheLoaded_ = true;
+
+    std::ignore = QtConcurrent::run([this, path = this->cachePath()] {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            return;
+        }
+
+        postToThread([this, data = file.readAll()] {
+            this->cache_.deserialize(data);
+        });
+    });
+}
+
+void LinkResolver::saveCache()
+{
+    auto path = this->cachePath();
+    BackgroundSaver::instance().run(
+        path, [path, data = this->cache_.serialize(PERSISTED_ENTRIES)] {
+            writeFileAtomically(path, data);
+        });
 }
 
 }  // namespace chatterino
@@ -1,5 +1,15 @@
 #pragma once
 
+#include "providers/links/LinkInfoCache.hpp"
+
+#include <pajlada/signals/signalholder.hpp>
+#include <QPointer>
+#include <QTimer>
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
 namespace chatterino {
 
 class LinkInfo;
@@ -20,7 +30,7 @@ public:
 class LinkResolver : public ILinkResolver
 {
 public:
-    LinkResolver() = default;
+    LinkResolver();
 
     /// @brief Loads and updates the link info
     ///
@@ -29,8 +39,37 @@ public:
     /// setting. URLs will be unshortened if the "unshortLinks" setting is
     /// enabled. The resolver is set through Env::linkResolverUrl.
     ///
+    /// Successful responses are cached by their normalized URL in memory and
+    /// on disk. Infos for a URL that's currently being resolved wait for
+    /// that request.
+    ///
     /// @pre @a info must not be nullptr
     void resolve(LinkInfo *info) override;
+
+private:
+    /// Reads the cache file once, in the background
+    void loadCache();
+    void saveCache();
+
+    void apply(LinkInfo *info, ResolvedLinkInfo &resolved);
+
+    /// Trims the cache once @a thumbnail has loaded, as that grows the
+    /// memory usage of its entry
+    void watchThumbnail(const ImagePtr &thumbnail);
+
+    QString cachePath() const;
+
+    LinkInfoCache cache_;
+    bool cacheLoaded_ = false;
+
+    /// Infos waiting for a request, by the normalized URL
+    std::unordered_map<QString, std::vector<QPointer<LinkInfo>>> pending_;
+
+    QTimer saveTimer_;
+
+    std::vector<std::weak_ptr<Image>> loadingThumbnails_;
+    bool watchingLayouts_ = false;
+    pajlada::Signals::SignalHolder connections_;
 };
 
 }  // namespace chatterino
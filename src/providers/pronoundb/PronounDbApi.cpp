@@ -1,231 +1,235 @@
-#include "providers/pronoundb/PronounDbPronouns.hpp"
 #include "providers/pronoundb/PronounDbApi.hpp"
-#include "providers/twitch/api/Helix.hpp"
-#include "common/Common.hpp"
+
 #include "common/network/NetworkRequest.hpp"
 #include "common/network/NetworkResult.hpp"
-#include <string>
-#include <vector>
-#include <sstream>
-#include <unordered_map>
+#include "common/QLogging.hpp"
+#include "debug/AssertInGuiThread.hpp"
+#include "providers/twitch/api/Helix.hpp"
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QUrl>
 
 namespace chatterino {
 
-std::string PronounDbApi::endpoint(std::string endpoint_) {
-  return PronounDb::ApiUrl + endpoint_;
+PronounDbApi::PronounDbApi(std::chrono::milliseconds batchInterval,
+                           Clock clock)
+    : clock_(clock ? std::move(clock) : [] {
+        return std::chrono::steady_clock::now();
+    })
+    , cache_(CACHE_SIZE)
+{
+    this->batchTimer_.setSingleShot(true);
+    this->batchTimer_.setInterval(batchInterval);
+    QObject::connect(&this->batchTimer_, &QTimer::timeout, [this] {
+        this->flush();
+    });
 }
 
-std::string PronounDbApi::alejo_endpoint(std::string endpoint_) {
-  return PronounDb::AlejoApiUrl + endpoint_;
+void PronounDbApi::getFromMessage(const MessagePtr &message)
+{
+    this->getFromUsernames({message->loginName});
 }
 
-std::string PronounDbApi::lookup(std::string platform, std::vector<std::string> ids) {
-  std::stringstream s;
-  s << "api/v2/lookup?platform=" << platform << "&ids=";
-  for (std::size_t i {0} ; i < ids.size(); ++i) {
-    s << ids[i];
-    if (i != ids.size()) {
-      s << ",";
+void PronounDbApi::getFromMessages(const std::vector<MessagePtr> &messages)
+{
+    QStringList usernames;
+    for (const auto &message : messages)
+    {
+        usernames.append(message->loginName);
     }
-  }
-  return s.str();
-}
-
-std::string PronounDbApi::alejo_user(std::string username) {
-  return std::string("api/users/") + username;
-}
-
-void PronounDbApi::getForUser(std::string userName, std::string userId) {
-  std::unordered_map<std::string, std::string> userNameToId;
-  userNameToId[userName] = userId;
-  getForUsers(userNameToId);
+    this->getFromUsernames(usernames);
 }
 
-void PronounDbApi::alejoGetForUser(std::string username) {
-  NetworkRequest(PronounDbApi::alejo_endpoint(PronounDbApi::alejo_user(username)))
-    .concurrent()
-    // .cache()
-    .onSuccess([this, username](auto result) {
-      auto json = result.parseJsonArray();
-      if (json.size() == 0) {
-        return;
-      }
-
-      auto first = json.first();
-      
-      if (!first.isObject()) {
-        return;
-      }
+void PronounDbApi::getFromUsernames(const QStringList &usernames)
+{
+    assertInGuiThread();
 
-      auto pronoun = first.toObject()["pronoun_id"];
+    std::lock_guard lock(this->mutex_);
 
-      if (pronoun.isUndefined()) {
-        return;
-      }
+    auto now = this->clock_();
+    for (const auto &username : usernames)
+    {
+        if (username.isEmpty() || this->pending_.contains(username))
+        {
+            continue;
+        }
+        if (this->cache_.exists(username) &&
+            this->cache_.get(username).expiresAt > now)
+        {
+            continue;
+        }
 
-      if (!pronoun.isString()) {
-        return;
-      }
+        this->pending_.insert(username);
+        this->queue_.append(username);
+    }
 
-      if (pronoun.isString()) {
-        auto pronounStr = pronoun.toString();
-        auto alejoPronoun = PronounDbPronouns::fromAlejo(pronounStr.toStdString());
-        pronouns[username] = alejoPronoun;
-      }
-    })
-    .execute();
+    if (!this->queue_.isEmpty() && !this->batchTimer_.isActive())
+    {
+        this->batchTimer_.start();
+    }
 }
 
-// This function does the heavy lifting.
-void PronounDbApi::getForUsers(std::unordered_map<std::string, std::string> userNameToId) {
-  // PronounDb only supports up to 50 ids in a single request.
-  if (userNameToId.size() > 50) {
-    std::vector<std::unordered_map<std::string, std::string>> maps;
-    std::size_t i {0};
-    for (auto const & kv : userNameToId) {
-      if (i % 50 == 0) {
-        maps.push_back(std::unordered_map<std::string, std::string>());
-      }
-      maps.back()[kv.first] = kv.second;
-      ++i;
-    }
-    for (auto const & map : maps) {
-      getForUsers(map);
-    }
-    // Don't continue. The above calls have already done the work.
-    return;
-  }
-
-  std::unordered_map<std::string, std::string> userIdToName;
-  std::vector<std::string> userIds;
-  for (auto const & kv : userNameToId) {
-    if (pronouns.find(kv.first) == pronouns.end()) {
-      userIds.push_back(kv.second);
-      userIdToName[kv.second] = kv.first;
-      pronouns[kv.first] = PronounDbPronouns();
-      std::cout << "checking pronouns for " << kv.first << "(" << kv.second << ")" << std::endl;
+std::optional<QString> PronounDbApi::getPronounsForUsername(
+    const QString &username)
+{
+    std::lock_guard lock(this->mutex_);
+
+    // Expired entries are still shown until the user is looked up again
+    if (!this->cache_.exists(username))
+    {
+        return std::nullopt;
     }
-  }
-
-  // Up to 50 ids in a request, send request.
-  NetworkRequest(PronounDbApi::endpoint(PronounDbApi::lookup("twitch", userIds)))
-    .concurrent()
-    // .cache()
-    .onSuccess([this, userIdToName](auto result) {
-      auto json = result.parseJson();
-
-      if (json.isEmpty()) {
-        for (auto const & kv : userIdToName) {
-          alejoGetForUser(kv.second);
-        }
-        return;
-      }
 
-      // Json object looks like: { "USER_ID1": { "sets": { "set_id": ["my", "pronoun", "sets"] } }, "USER_ID2": ... }
-      for (const QString & user : json.keys()) {
-        std::string name = userIdToName.at(user.toStdString());
+    const auto &pronouns = this->cache_.get(username).pronouns;
+    if (!pronouns.isSpecified())
+    {
+        return std::nullopt;
+    }
+    return pronouns.display;
+}
 
-        if (!json[user].isObject()) {
-          // Fallback to Alejo.
-          alejoGetForUser(name);
-          continue;
-        }
+void PronounDbApi::flush()
+{
+    QStringList batch;
+    {
+        std::lock_guard lock(this->mutex_);
 
-        // user = USER_ID
-        auto sets = json[user].toObject()["sets"];
-        if (!sets.isObject()) {
-          // Fallback to Alejo.
-          alejoGetForUser(name);
-          continue;
-        }
+        batch = this->queue_.mid(0, HELIX_BATCH_SIZE);
+        this->queue_.erase(this->queue_.begin(),
+                           this->queue_.begin() + batch.size());
 
-        // Only "en" set is currently supported.
-        auto set = sets.toObject()["en"];
-        if (set.isUndefined()) {
-          // Fallback to Alejo.
-          alejoGetForUser(name);
-          continue;
-        } else if (!set.isArray()) {
-          // Fallback to Alejo.
-          alejoGetForUser(name);
-          continue;
+        if (!this->queue_.isEmpty())
+        {
+            this->batchTimer_.start();
         }
+    }
 
-        QJsonArray jsonPronouns = set.toArray();
-        if (jsonPronouns.count() == 0) {
-          // Fallback to Alejo.
-          alejoGetForUser(name);
-          continue;
-        }
+    if (batch.isEmpty())
+    {
+        return;
+    }
 
-        std::vector<std::string> pronounSets;
-        for (auto const pronoun : jsonPronouns) {
-          if (!pronoun.isString()) {
-            continue;
-          }
+    getHelix()->fetchUsers(
+        {}, batch,
+        [this, batch](const std::vector<HelixUser> &users) {
+            std::unordered_set<QString> found;
+            std::vector<std::unordered_map<QString, QString>> chunks;
+            for (const auto &user : users)
+            {
+                found.insert(user.login);
+                if (chunks.empty() ||
+                    chunks.back().size() >= PRONOUNDB_BATCH_SIZE)
+                {
+                    chunks.emplace_back();
+                }
+                chunks.back()[user.id] = user.login;
+            }
+
+            // Banned or renamed users
+            for (const auto &username : batch)
+            {
+                if (!found.contains(username))
+                {
+                    this->store(username, {});
+                }
+            }
+
+            for (auto &chunk : chunks)
+            {
+                this->lookupPronounDb(std::move(chunk));
+            }
+        },
+        [this, batch] {
+            qCDebug(chatterinoTwitch)
+                << "Failed to look up user IDs for pronouns";
+            for (const auto &username : batch)
+            {
+                this->store(username, {});
+            }
+        });
+}
 
-          pronounSets.push_back(pronoun.toString().toStdString());
-        }
+void PronounDbApi::lookupPronounDb(
+    std::unordered_map<QString, QString> idToName)
+{
+    QStringList ids;
+    for (const auto &[id, name] : idToName)
+    {
+        ids.append(id);
+    }
 
-        // Assign pronouns to user!
-        pronouns[name] = PronounDbPronouns::fromSets(pronounSets);
-        std::cout << "Adding pronouns for " << name << ": " << pronouns[name].display << std::endl;
-      }
-    })
-    .execute();
+    QUrl url(QString(PronounDb::ApiUrl) +
+             "api/v2/lookup?platform=twitch&ids=" + ids.join(','));
+
+    // Not concurrent, so the callbacks run in order on the GUI thread
+    NetworkRequest(url)
+        .priority(QNetworkRequest::LowPriority)
+        .onSuccess([this, idToName](const NetworkResult &result) {
+            // { "USER_ID": { "sets": { "en": ["they", "them"] } }, ... }
+            auto root = result.parseJson();
+
+            for (const auto &[id, name] : idToName)
+            {
+                auto sets = root.value(id)
+                                .toObject()
+                                .value("sets")
+                                .toObject()
+                                .value("en")
+                                .toArray();
+
+                QStringList pronounSets;
+                for (const auto &set : sets)
+                {
+                    if (set.isString())
+                    {
+                        pronounSets.append(set.toString());
+                    }
+                }
+
+                this->store(name, PronounDbPronouns::fromSets(pronounSets));
+            }
+        })
+        .onError([this, idToName](const NetworkResult &result) {
+            qCDebug(chatterinoTwitch)
+                << "Failed to look up pronouns:" << result.formatError();
+            for (const auto &[id, name] : idToName)
+            {
+                this->store(name, {});
+            }
+        })
+        .finally([this, idToName] {
+            // Users the callbacks didn't get to must not stay pending forever
+            QStringList done;
+            for (const auto &[id, name] : idToName)
+            {
+                done.append(name);
+            }
+            this->release(done);
+        })
+        .execute();
 }
 
-void PronounDbApi::getFromMessage(MessagePtr message) {
-  getFromMessages({message});
-}
+void PronounDbApi::store(const QString &username, PronounDbPronouns pronouns)
+{
+    auto ttl = pronouns.isSpecified()
+                   ? std::chrono::steady_clock::duration(PRONOUNS_TTL)
+                   : std::chrono::steady_clock::duration(NO_PRONOUNS_TTL);
 
-void PronounDbApi::getFromMessages(std::vector<MessagePtr> messages) {
-  std::vector<std::string> usernames;
-  for (auto const & messagePtr : messages) {
-    usernames.push_back(messagePtr->loginName.toStdString());
-  }
+    Entry entry{std::move(pronouns), this->clock_() + ttl};
 
-  getFromUsernames(usernames);
+    std::lock_guard lock(this->mutex_);
+    this->cache_.put(username, entry);
+    this->pending_.erase(username);
 }
 
-void PronounDbApi::getFromUsernames(std::vector<std::string> usernames_) {
-  QStringList usernames;
-  for (auto const & username : usernames_) {
-    auto iter = pronouns.find(username);
-    if (iter != pronouns.end()) {
-      // Already got the pronouns!
-      continue;
+void PronounDbApi::release(const QStringList &usernames)
+{
+    std::lock_guard lock(this->mutex_);
+    for (const auto &username : usernames)
+    {
+        this->pending_.erase(username);
     }
-    usernames.append(QString::fromStdString(username));
-    std::cout << "fetching ids for " << username << std::endl;
-  }
-
-  if (usernames.empty()) {
-    return;
-  }
-
-  getHelix()->fetchUsers(QStringList(), usernames, [this](std::vector<HelixUser> users) {
-    std::vector<std::string> userIds;
-    std::unordered_map<std::string, std::string> userNameToId;
-    for (const HelixUser & user : users) {
-      auto name = user.login.toStdString();
-      userNameToId[name] = user.id.toStdString();
-    }
-
-    getForUsers(userNameToId);
-  }, [](){});
-}
-
-std::optional<std::string> PronounDbApi::getPronounsForUsername(std::string username) {
-  auto iter = pronouns.find(username);
-  if (iter != pronouns.end()) {
-    return {iter->second.display};
-  }
-  
-  // Fetch for next message...
-  // getFromUsernames({username});
-
-  return {};
 }
 
-}
\ No newline at end of file
+}  // namespace chatterino
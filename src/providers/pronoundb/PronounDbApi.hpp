@@ -1,37 +1,99 @@
 #pragma once
 
-#include <vector>
-#include <unordered_map>
-#include <optional>
-#include "providers/twitch/TwitchUser.hpp"
-#include "providers/pronoundb/PronounDbPronouns.hpp"
 #include "messages/Message.hpp"
+#include "providers/pronoundb/PronounDbPronouns.hpp"
+
+#include <lrucache/lrucache.hpp>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace chatterino {
 
 namespace PronounDb {
 constexpr const char *ApiUrl = "https://pronoundb.org/";
-constexpr const char *AlejoApiUrl = "https://pronouns.alejo.io/";
-}
+}  // namespace PronounDb
+
+/**
+ * @brief Looks up and caches the pronouns of chatters
+ *
+ * Unknown users are collected for a short time and then looked up
+ * together: one Helix request resolves their IDs and one pronoundb.org
+ * request per 50 users fetches their pronouns. pronouns.alejo.io is no
+ * longer asked as a fallback since it can only look up one user per
+ * request.
+ *
+ * Results, including users without pronouns, are kept in a bounded LRU
+ * cache and looked up again once they expire.
+ */
+class PronounDbApi
+{
+public:
+    using Clock = std::function<std::chrono::steady_clock::time_point()>;
+
+    /// How long unknown users are collected before they're looked up
+    static constexpr std::chrono::milliseconds BATCH_INTERVAL{500};
+    /// Helix accepts up to 100 logins per request
+    static constexpr qsizetype HELIX_BATCH_SIZE = 100;
+    /// pronoundb.org accepts up to 50 IDs per request
+    static constexpr size_t PRONOUNDB_BATCH_SIZE = 50;
+
+    static constexpr size_t CACHE_SIZE = 5000;
+    static constexpr std::chrono::minutes PRONOUNS_TTL{60};
+    /// Most chatters have no pronouns set, so they're looked up again less
+    /// often than users who have
+    static constexpr std::chrono::minutes NO_PRONOUNS_TTL{180};
+
+    /// @param clock Returns the time for cache expiry, defaults to
+    ///              std::chrono::steady_clock
+    explicit PronounDbApi(
+        std::chrono::milliseconds batchInterval = BATCH_INTERVAL,
+        Clock clock = {});
+
+    /// Queues a lookup for the authors of the messages whose pronouns
+    /// aren't known yet. Must be called from the GUI thread.
+    void getFromMessage(const MessagePtr &message);
+    void getFromMessages(const std::vector<MessagePtr> &messages);
+    void getFromUsernames(const QStringList &usernames);
+
+    /// @returns the pronouns of @a username (a login name) if they're known
+    ///          and specified. Safe to call from any thread.
+    std::optional<QString> getPronounsForUsername(const QString &username);
 
-class PronounDbApi : public std::enable_shared_from_this<PronounDbApi> {
 private:
-  std::unordered_map<std::string, PronounDbPronouns> pronouns;
+    struct Entry {
+        PronounDbPronouns pronouns;
+        std::chrono::steady_clock::time_point expiresAt;
+    };
 
-  std::string endpoint(std::string endpoint_);
-  std::string lookup(std::string platform, std::vector<std::string> ids);
+    /// Looks up the queued users
+    void flush();
+    void lookupPronounDb(std::unordered_map<QString, QString> idToName);
 
-  std::string alejo_endpoint(std::string endpoint_);
-  std::string alejo_user(std::string username);
+    /// Caches the pronouns of @a username and marks the lookup as done
+    void store(const QString &username, PronounDbPronouns pronouns);
+    /// Marks the lookups of @a usernames as done without caching anything,
+    /// so they're looked up again when they chat next time
+    void release(const QStringList &usernames);
 
-public:
-  void alejoGetForUser(std::string username);
-  void getForUser(std::string userName, std::string userId);
-  void getForUsers(std::unordered_map<std::string, std::string> userNameToIds);
-  void getFromUsernames(std::vector<std::string> usernames);
-  void getFromMessages(std::vector<MessagePtr> messages);
-  void getFromMessage(MessagePtr message);
-  std::optional<std::string> getPronounsForUsername(std::string username);
+    const Clock clock_;
+
+    std::mutex mutex_;
+    // login name => pronouns
+    cache::lru_cache<QString, Entry> cache_;
+    // login names that are queued or being looked up
+    std::unordered_set<QString> pending_;
+    QStringList queue_;
+
+    QTimer batchTimer_;
 };
 
-}
\ No newline at end of file
+}  // namespace chatterino
@@ -1,83 +1,108 @@
 #include "providers/pronoundb/PronounDbPronouns.hpp"
-#include <vector>
-#include <string>
-#include <algorithm>
-#include <unordered_map>
+
+#include <QHash>
+
+namespace {
+
+const QString UNSPECIFIED = QStringLiteral("unspecified");
+
+const QHash<QString, QString> &alejoPronouns()
+{
+    static const QHash<QString, QString> pronouns{
+        {"aeaer", "ae/aer"},       {"any", "any"},
+        {"eem", "e/em"},           {"faefaer", "fae/faer"},
+        {"hehim", "he/him"},       {"heshe", "he/she"},
+        {"hethem", "he/they"},     {"itits", "it/its"},
+        {"other", "other"},        {"perper", "per/per"},
+        {"sheher", "she/her"},     {"shethem", "she/they"},
+        {"theythem", "they/them"}, {"vever", "ve/ver"},
+        {"xexem", "xe/xem"},       {"ziehir", "zie/hir"},
+    };
+    return pronouns;
+}
+
+}  // namespace
 
 namespace chatterino {
 
-std::unordered_map<std::string, std::string> PronounDbPronouns::alejoPronouns = {
-  {"aeaer", "ae/aer"},
-  {"any", "any"},
-  {"eem", "e/em"},
-  {"faefaer", "fae/faer"},
-  {"hehim", "he/him"},
-  {"heshe", "he/she"},
-  {"hethem", "he/they"},
-  {"itits", "it/its"},
-  {"other", "other"},
-  {"perper", "per/per"},
-  {"sheher", "she/her"},
-  {"shethem", "she/they"},
-  {"theythem", "they/them"},
-  {"vever", "ve/ver"},
-  {"xexem", "xe/xem"},
-  {"ziehir", "zie/hir"},
-};
-
-PronounDbPronouns::PronounDbPronouns() {
-  this->display = "unspecified";
+PronounDbPronouns::PronounDbPronouns()
+    : display(UNSPECIFIED)
+{
+}
+
+PronounDbPronouns::PronounDbPronouns(QString display)
+    : display(std::move(display))
+{
 }
 
-PronounDbPronouns::PronounDbPronouns(std::string display) {
-  this->display = display;
+bool PronounDbPronouns::isSpecified() const
+{
+    return !this->display.isEmpty() && this->display != UNSPECIFIED;
 }
 
-PronounDbPronouns PronounDbPronouns::fromSets(std::vector<std::string> sets) {
-  // This follows the rules of https://pronoundb.org/wiki/legacy-api-docs#apiv2-compatibility .
-  if (std::find(sets.begin(), sets.end(), "any") != sets.end()) {
-    return PronounDbPronouns("any");
-  } else if (std::find(sets.begin(), sets.end(), "ask") != sets.end()) {
-    return PronounDbPronouns("ask");
-  }
-
-  if (sets.size() == 0) {
-    return PronounDbPronouns("unspecified");
-  }
-
-  if (sets[0] == "avoid") {
-    return PronounDbPronouns("avoid");
-  }
-
-  if (sets.size() == 1) {
-    if (sets[0] == "he") {
-      return PronounDbPronouns("he/him");
-    } else if (sets[0] == "she") {
-      return PronounDbPronouns("she/her");
-    } else if (sets[0] == "they") {
-      return PronounDbPronouns("they/them");
-    } else if (sets[0] == "it") {
-      return PronounDbPronouns("it/its");
-    } else {
-      return PronounDbPronouns(sets[0]);
+PronounDbPronouns PronounDbPronouns::fromSets(const QStringList &sets)
+{
+    if (sets.contains("any"))
+    {
+        return {"any"};
     }
-  } else if (sets[0] == "he" || sets[0] == "she" || sets[0] == "they" || sets[0] == "it") {
-    if (sets[0] != sets[1]) {
-      return PronounDbPronouns(sets[0] + "/" + sets[1]);
-    } else {
-      return PronounDbPronouns(sets[0]);
+    if (sets.contains("ask"))
+    {
+        return {"ask"};
     }
-  }
 
-  return PronounDbPronouns("other");
+    if (sets.isEmpty())
+    {
+        return {};
+    }
+
+    if (sets[0] == "avoid")
+    {
+        return {"avoid"};
+    }
+
+    if (sets.size() == 1)
+    {
+        if (sets[0] == "he")
+        {
+            return {"he/him"};
+        }
+        if (sets[0] == "she")
+        {
+            return {"she/her"};
+        }
+        if (sets[0] == "they")
+        {
+            return {"they/them"};
+        }
+        if (sets[0] == "it")
+        {
+            return {"it/its"};
+        }
+        return {sets[0]};
+    }
+
+    if (sets[0] == "he" || sets[0] == "she" || sets[0] == "they" ||
+        sets[0] == "it")
+    {
+        if (sets[0] != sets[1])
+        {
+            return {sets[0] + '/' + sets[1]};
+        }
+        return {sets[0]};
+    }
+
+    return {"other"};
 }
 
-PronounDbPronouns PronounDbPronouns::fromAlejo(std::string s) {
-  auto iter = PronounDbPronouns::alejoPronouns.find(s);
-  if (iter != PronounDbPronouns::alejoPronouns.end()) {
-    return PronounDbPronouns(iter->second);
-  }
-  return PronounDbPronouns();
+PronounDbPronouns PronounDbPronouns::fromAlejo(const QString &id)
+{
+    auto it = alejoPronouns().find(id);
+    if (it != alejoPronouns().end())
+    {
+        return {it.value()};
+    }
+    return {};
 }
 
-}
\ No newline at end of file
+}  // namespace chatterino
@@ -1,18 +1,23 @@
 #pragma once
-#include <string>
-#include <vector>
-#include <unordered_map>
+
+#include <QString>
+#include <QStringList>
 
 namespace chatterino {
 
 struct PronounDbPronouns {
-  std::string display;
-  static PronounDbPronouns fromSets(std::vector<std::string>);
-  static PronounDbPronouns fromAlejo(std::string);
-  PronounDbPronouns();
-  PronounDbPronouns(std::string display);
-private:
-  static std::unordered_map<std::string, std::string> alejoPronouns;
+    QString display;
+
+    /// https://pronoundb.org/wiki/legacy-api-docs#apiv2-compatibility
+    static PronounDbPronouns fromSets(const QStringList &sets);
+    /// Looks up a pronoun id of pronouns.alejo.io
+    static PronounDbPronouns fromAlejo(const QString &id);
+
+    PronounDbPronouns();
+    PronounDbPronouns(QString display);
+
+    /// false if the user didn't specify any pronouns
+    bool isSpecified() const;
 };
 
-}
\ No newline at end of file
+}  // namespace chatterino
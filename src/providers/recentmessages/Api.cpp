@@ -46,54 +46,70 @@ void load(
                              << shared->getName();
 
                 auto root = result.parseJson();
-                auto parsedMessages = parseRecentMessages(root);
-
-                // build the Communi messages into chatterino messages
-                auto builtMessages =
-                    buildRecentMessages(parsedMessages, shared.get());
-
-                postToThread([shared = std::move(shared),
-                              root = std::move(root),
-                              messages = std::move(builtMessages),
-                              onLoaded]() mutable {
-                    // Notify user about a possible gap in logs if it returned some messages
-                    // but isn't currently joined to a channel
-                    const auto errorCode = root.value("error_code").toString();
-                    if (!errorCode.isEmpty())
-                    {
-                        qCDebug(LOG)
-                            << QString("Got error from API: error_code=%1, "
-                                       "channel=%2")
-                                   .arg(errorCode, shared->getName());
-                        if (errorCode == "channel_not_joined" &&
-                            !messages.empty())
-                        {
-                            shared->addMessage(makeSystemMessage(
-                                "Message history service recovering, there may "
-                                "be gaps in the message history."));
-                        }
-                    }
-
-                    onLoaded(messages);
+                auto lines = std::make_shared<const std::vector<IrcLine>>(
+                    parseRecentMessages(root));
+
+                // Channels must be destroyed in the GUI thread
+                postToThread([shared = std::move(shared)] {});
+
+                postToThread([channelPtr, lines = std::move(lines),
+                              root = std::move(root), onLoaded]() mutable {
+                    // build the Communi messages into chatterino messages
+                    buildRecentMessages(
+                        lines, channelPtr,
+                        [channelPtr, root = std::move(root),
+                         onLoaded](std::vector<MessagePtr> &&messages) {
+                            auto shared = channelPtr.lock();
+                            if (!shared)
+                            {
+                                return;
+                            }
+
+                            // Notify user about a possible gap in logs if it returned some messages
+                            // but isn't currently joined to a channel
+                            const auto errorCode =
+                                root.value("error_code").toString();
+                            if (!errorCode.isEmpty())
+                            {
+                                qCDebug(LOG)
+                                    << QString("Got error from API: "
+                                               "error_code=%1, channel=%2")
+                                           .arg(errorCode, shared->getName());
+                                if (errorCode == "channel_not_joined" &&
+                                    !messages.empty())
+                                {
+                                    shared->addMessage(makeSystemMessage(
+                                        "Message history service recovering, "
+                                        "there may be gaps in the message "
+                                        "history."));
+                                }
+                            }
+
+                            onLoaded(messages);
+                        });
                 });
             })
             .onError([channelPtr, onError](const NetworkResult &result) {
-                auto shared = channelPtr.lock();
-                if (!shared)
-                {
-                    return;
-                }
+                postToThread([channelPtr, onError, result] {
+                    auto shared = channelPtr.lock();
+                    if (!shared)
+                    {
+                        return;
+                    }
 
-                qCDebug(LOG) << "Failed to load recent messages for"
-                             << shared->getName();
+                    qCDebug(LOG) << "Failed to load recent messages for"
+                                 << shared->getName();
 
-                shared->addMessage(makeSystemMessage(
-                    QStringLiteral(
-                        "Message history service unavailable (Error: %1)")
-                        .arg(result.formatError())));
+                    shared->addMessage(makeSystemMessage(
+                        QStringLiteral(
+                            "Message history service unavailable (Error: %1)")
+                            .arg(result.formatError())));
 
-                onError();
+                    onError();
+                });
             })
+            // JSON parsing, tokenizing and building happen off the GUI thread
+            .concurrent()
             .execute();
     });
 }
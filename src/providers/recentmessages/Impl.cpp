@@ -5,90 +5,310 @@
 #include "providers/twitch/IrcMessageHandler.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
 #include "providers/twitch/TwitchMessageBuilder.hpp"
+#include "debug/AssertInGuiThread.hpp"
 #include "util/FormatTime.hpp"
+#include "util/PostToThread.hpp"
 
+#include <QFuture>
 #include <QJsonArray>
+#include <QtConcurrent>
+#include <QThread>
+#include <QThreadPool>
 #include <QUrlQuery>
 
+#include <algorithm>
+#include <cassert>
+#include <charconv>
+#include <map>
+
 namespace {
 
+using namespace chatterino;
+
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 const auto &LOG = chatterinoRecentMessages;
 
+/// ESCAPE_TAG encoded as UTF-8
+const QByteArray ESCAPE_TAG_UTF8 = ESCAPE_TAG.toUtf8();
+
+/// Number of lines tokenized by one task of the worker pool
+constexpr qsizetype CHUNK_SIZE = 128;
+
+/// Number of lines built by one task of the worker pool
+constexpr size_t BUILD_CHUNK_SIZE = 64;
+
+QThreadPool &workerPool()
+{
+    static auto *pool = [] {
+        auto *pool = new QThreadPool;
+        pool->setMaxThreadCount(std::max(1, QThread::idealThreadCount() / 2));
+        return pool;
+    }();
+    return *pool;
+}
+
+std::optional<IrcLine> parseLine(const QJsonValue &jsonMessage)
+{
+    auto content = jsonMessage.toString().toUtf8();
+
+    // For explanation of why this exists, see src/providers/twitch/TwitchChannel.hpp,
+    // where these constants are defined.
+    // The regex is only run on the few lines that contain the tag.
+    if (content.contains(ESCAPE_TAG_UTF8))
+    {
+        content = QString::fromUtf8(content)
+                      .replace(COMBINED_FIXER, ZERO_WIDTH_JOINER)
+                      .toUtf8();
+    }
+
+    return IrcLine::parse(std::move(content));
+}
+
+/// The day the recent messages service received `line` on
+std::optional<QDate> receivedDate(const IrcLine &line)
+{
+    int64_t receivedTs = 0;
+    if (auto raw = line.rawTag("rm-received-ts");
+        raw &&
+        std::from_chars(raw->data(), raw->data() + raw->size(), receivedTs)
+                .ec == std::errc())
+    {
+        return QDateTime::fromMSecsSinceEpoch(receivedTs).date();
+    }
+    return std::nullopt;
+}
+
 }  // namespace
 
 namespace chatterino::recentmessages::detail {
 
-// Parse the IRC messages returned in JSON form into Communi messages
-std::vector<Communi::IrcMessage *> parseRecentMessages(
-    const QJsonObject &jsonRoot)
+std::vector<IrcLine> parseRecentMessages(const QJsonObject &jsonRoot)
 {
     const auto jsonMessages = jsonRoot.value("messages").toArray();
-    std::vector<Communi::IrcMessage *> messages;
+    const auto count = jsonMessages.size();
 
-    if (jsonMessages.empty())
+    // Each chunk only writes the entries of its own lines
+    std::vector<std::optional<IrcLine>> parsed(static_cast<size_t>(count));
+    auto parseChunk = [&](qsizetype begin) {
+        const auto end = std::min(begin + CHUNK_SIZE, count);
+        for (auto i = begin; i < end; i++)
+        {
+            parsed[static_cast<size_t>(i)] = parseLine(jsonMessages.at(i));
+        }
+    };
+
+    // The first chunk is tokenized on this thread while the pool does the
+    // rest
+    std::vector<QFuture<void>> chunks;
+    for (qsizetype begin = CHUNK_SIZE; begin < count; begin += CHUNK_SIZE)
     {
-        return messages;
+        chunks.push_back(QtConcurrent::run(&workerPool(), [&parseChunk, begin] {
+            parseChunk(begin);
+        }));
     }
-
-    for (const auto &jsonMessage : jsonMessages)
+    parseChunk(0);
+    for (auto &chunk : chunks)
     {
-        auto content = jsonMessage.toString();
+        chunk.waitForFinished();
+    }
 
-        // For explanation of why this exists, see src/providers/twitch/TwitchChannel.hpp,
-        // where these constants are defined
-        content.replace(COMBINED_FIXER, ZERO_WIDTH_JOINER);
+    std::vector<IrcLine> lines;
+    lines.reserve(parsed.size());
+    for (auto &line : parsed)
+    {
+        if (line)
+        {
+            lines.emplace_back(std::move(*line));
+        }
+    }
 
-        auto *message =
-            Communi::IrcMessage::fromData(content.toUtf8(), nullptr);
+    return lines;
+}
 
-        messages.emplace_back(message);
+bool dependsOnPreviousMessages(const IrcLine &line)
+{
+    // Timeouts are stacked onto previous timeouts
+    if (line.command() == "CLEARCHAT")
+    {
+        return true;
     }
 
-    return messages;
+    // Replies look up the root of their thread
+    return line.command() == "PRIVMSG" &&
+           line.hasTag("reply-thread-parent-msg-id");
 }
 
-// Build Communi messages retrieved from the recent messages API into
-// proper chatterino messages.
-std::vector<MessagePtr> buildRecentMessages(
-    std::vector<Communi::IrcMessage *> &messages, Channel *channel)
+std::vector<PrebuiltLine> prebuildRecentMessages(
+    const std::vector<IrcLine> &lines, size_t begin, size_t end,
+    Channel *channel, QDate lastDate)
 {
-    std::vector<MessagePtr> allBuiltMessages;
+    assert(begin <= end && end <= lines.size());
 
-    for (auto *message : messages)
+    // The day of the message before this chunk
+    for (auto i = begin; i > 0; i--)
     {
-        if (message->tags().contains("rm-received-ts"))
+        if (auto date = receivedDate(lines[i - 1]))
         {
-            const auto msgDate =
-                QDateTime::fromMSecsSinceEpoch(
-                    message->tags().value("rm-received-ts").toLongLong())
-                    .date();
+            lastDate = *date;
+            break;
+        }
+    }
 
-            // Check if we need to insert a message stating that a new day began
-            if (msgDate != channel->lastDate_)
-            {
-                channel->lastDate_ = msgDate;
-                auto msg = makeSystemMessage(
-                    QLocale().toString(msgDate, QLocale::LongFormat),
-                    QTime(0, 0));
-                msg->flags.set(MessageFlag::RecentMessage);
-                allBuiltMessages.emplace_back(msg);
-            }
+    std::vector<PrebuiltLine> built(end - begin);
+    for (auto i = begin; i < end; i++)
+    {
+        const auto &line = lines[i];
+        auto &prebuilt = built[i - begin];
+
+        // Check if we need to insert a message stating that a new day began
+        if (auto date = receivedDate(line); date && *date != lastDate)
+        {
+            lastDate = *date;
+            auto msg = makeSystemMessage(
+                QLocale().toString(lastDate, QLocale::LongFormat),
+                QTime(0, 0));
+            msg->flags.set(MessageFlag::RecentMessage);
+            prebuilt.daySeparator = msg;
+        }
+
+        if (dependsOnPreviousMessages(line))
+        {
+            continue;
+        }
+
+        // Independent lines never look at previous messages
+        std::vector<MessagePtr> none;
+        prebuilt.messages =
+            IrcMessageHandler::parseMessageWithReply(channel, line, none);
+    }
+
+    return built;
+}
+
+void stitchRecentMessages(const std::vector<IrcLine> &lines, size_t begin,
+                          std::vector<PrebuiltLine> &&chunk, Channel *channel,
+                          std::vector<MessagePtr> &messages)
+{
+    assert(begin + chunk.size() <= lines.size());
+
+    for (size_t i = 0; i < chunk.size(); i++)
+    {
+        const auto &line = lines[begin + i];
+        auto &prebuilt = chunk[i];
+
+        if (prebuilt.daySeparator)
+        {
+            channel->lastDate_ = *receivedDate(line);
+            messages.emplace_back(std::move(prebuilt.daySeparator));
         }
 
-        auto builtMessages = IrcMessageHandler::parseMessageWithReply(
-            channel, message, allBuiltMessages);
+        auto builtMessages =
+            prebuilt.messages
+                ? std::move(*prebuilt.messages)
+                : IrcMessageHandler::parseMessageWithReply(channel, line,
+                                                           messages);
 
         for (const auto &builtMessage : builtMessages)
         {
             builtMessage->flags.set(MessageFlag::RecentMessage);
-            allBuiltMessages.emplace_back(builtMessage);
+            messages.emplace_back(builtMessage);
         }
+    }
+}
 
-        message->deleteLater();
+std::vector<MessagePtr> buildRecentMessages(const std::vector<IrcLine> &lines,
+                                            Channel *channel)
+{
+    std::vector<MessagePtr> messages;
+    messages.reserve(lines.size());
+    stitchRecentMessages(
+        lines, 0,
+        prebuildRecentMessages(lines, 0, lines.size(), channel,
+                               channel->lastDate_),
+        channel, messages);
+    return messages;
+}
+
+void buildRecentMessages(
+    std::shared_ptr<const std::vector<IrcLine>> lines,
+    const std::weak_ptr<Channel> &channel,
+    std::function<void(std::vector<MessagePtr> &&)> onBuilt)
+{
+    assertInGuiThread();
+
+    auto shared = channel.lock();
+    if (!shared)
+    {
+        return;
+    }
+
+    if (lines->empty())
+    {
+        onBuilt({});
+        return;
     }
 
-    return allBuiltMessages;
+    struct State {
+        std::shared_ptr<const std::vector<IrcLine>> lines;
+        std::weak_ptr<Channel> channel;
+        std::function<void(std::vector<MessagePtr> &&)> onBuilt;
+
+        // Only accessed in the GUI thread
+        /// Chunks that finished before the ones preceding them, by their
+        /// first line
+        std::map<size_t, std::vector<PrebuiltLine>> waiting;
+        /// The first line that wasn't stitched yet
+        size_t nextLine = 0;
+        std::vector<MessagePtr> messages;
+    };
+
+    auto state = std::make_shared<State>();
+    state->lines = std::move(lines);
+    state->channel = channel;
+    state->onBuilt = std::move(onBuilt);
+    state->messages.reserve(state->lines->size());
+
+    // The workers don't touch the channel's state
+    const auto lastDate = shared->lastDate_;
+    const auto lineCount = state->lines->size();
+
+    for (size_t begin = 0; begin < lineCount; begin += BUILD_CHUNK_SIZE)
+    {
+        const auto end = std::min(begin + BUILD_CHUNK_SIZE, lineCount);
+        std::ignore = QtConcurrent::run(&workerPool(), [state, begin, end,
+                                                        lastDate] {
+            auto shared = state->channel.lock();
+            if (!shared)
+            {
+                return;
+            }
+
+            auto chunk = prebuildRecentMessages(*state->lines, begin, end,
+                                                shared.get(), lastDate);
+
+            // Channels must be destroyed in the GUI thread
+            postToThread([state, begin, chunk = std::move(chunk),
+                          shared = std::move(shared)]() mutable {
+                state->waiting.emplace(begin, std::move(chunk));
+
+                // Chunks are stitched in their original order
+                while (!state->waiting.empty() &&
+                       state->waiting.begin()->first == state->nextLine)
+                {
+                    auto next = state->waiting.extract(state->waiting.begin());
+                    state->nextLine += next.mapped().size();
+                    stitchRecentMessages(*state->lines, next.key(),
+                                         std::move(next.mapped()),
+                                         shared.get(), state->messages);
+                }
+
+                if (state->nextLine == state->lines->size())
+                {
+                    state->onBuilt(std::move(state->messages));
+                }
+            });
+        });
+    }
 }
 
 // Returns the URL to be used for querying the Recent Messages API for the
@@ -2,27 +2,93 @@
 
 #include "common/Channel.hpp"
 #include "messages/Message.hpp"
+#include "providers/irc/IrcLine.hpp"
 
-#include <IrcMessage>
+#include <QDate>
 #include <QJsonObject>
 #include <QString>
 #include <QUrl>
 
 #include <chrono>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <vector>
 
 namespace chatterino::recentmessages::detail {
 
-// Parse the IRC messages returned in JSON form into Communi messages
-std::vector<Communi::IrcMessage *> parseRecentMessages(
-    const QJsonObject &jsonRoot);
+/**
+ * @brief Tokenizes the IRC messages returned in JSON form
+ *
+ * Large responses are split into chunks which are tokenized on a worker
+ * pool. The lines are returned in their original order, lines without a
+ * command are skipped.
+ */
+std::vector<IrcLine> parseRecentMessages(const QJsonObject &jsonRoot);
 
-// Build Communi messages retrieved from the recent messages API into
-// proper chatterino messages.
-std::vector<MessagePtr> buildRecentMessages(
-    std::vector<Communi::IrcMessage *> &messages, Channel *channel);
+/// A line built on the worker pool
+struct PrebuiltLine {
+    /// Inserted before the messages of the line if a new day began with it
+    MessagePtr daySeparator;
+    /// The built messages, std::nullopt if the line depends on previous
+    /// messages and is built by stitchRecentMessages()
+    std::optional<std::vector<MessagePtr>> messages;
+};
+
+/// Returns true if building `line` reads or modifies messages that were
+/// built before it (replies to threads and CLEARCHAT)
+bool dependsOnPreviousMessages(const IrcLine &line);
+
+/**
+ * @brief Builds the lines in [begin, end) that don't depend on previous
+ *        messages
+ *
+ * Doesn't modify the channel, so this can be called from any thread.
+ *
+ * @param lastDate The channel's last date when building started, used if
+ *                 no line before `begin` has a date
+ */
+std::vector<PrebuiltLine> prebuildRecentMessages(
+    const std::vector<IrcLine> &lines, size_t begin, size_t end,
+    Channel *channel, QDate lastDate);
+
+/**
+ * @brief Appends a chunk from prebuildRecentMessages() to `messages`
+ *
+ * Builds the lines that weren't prebuilt. Since those can access the
+ * channel's reply threads, this must be called in the GUI thread.
+ *
+ * @param begin The first line of the chunk
+ */
+void stitchRecentMessages(const std::vector<IrcLine> &lines, size_t begin,
+                          std::vector<PrebuiltLine> &&chunk, Channel *channel,
+                          std::vector<MessagePtr> &messages);
+
+/**
+ * @brief Builds IRC lines retrieved from the recent messages API into proper
+ *        chatterino messages
+ *
+ * Inserts a system message whenever a new day begins.
+ */
+std::vector<MessagePtr> buildRecentMessages(const std::vector<IrcLine> &lines,
+                                            Channel *channel);
+
+/**
+ * @brief Builds IRC lines retrieved from the recent messages API on a worker
+ *        pool
+ *
+ * The lines are split into chunks which are built in parallel from a
+ * snapshot of the channel's last date. Each finished chunk is posted to the
+ * GUI thread, where the chunks are stitched together in order. Once all of
+ * them arrived, `onBuilt` is called with the messages in the GUI thread.
+ * Nothing is called if the channel is destroyed in the meantime.
+ *
+ * Must be called in the GUI thread.
+ */
+void buildRecentMessages(
+    std::shared_ptr<const std::vector<IrcLine>> lines,
+    const std::weak_ptr<Channel> &channel,
+    std::function<void(std::vector<MessagePtr> &&)> onBuilt);
 
 // Returns the URL to be used for querying the Recent Messages API for the
 // given channel.
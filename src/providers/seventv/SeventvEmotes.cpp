@@ -7,6 +7,7 @@
 #include "messages/Emote.hpp"
 #include "messages/Image.hpp"
 #include "messages/ImageSet.hpp"
+#include "messages/MergedEmoteMap.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "providers/seventv/eventapi/Dispatch.hpp"
 #include "providers/seventv/SeventvAPI.hpp"
@@ -284,6 +285,7 @@ void SeventvEmotes::loadGlobalEmotes()
 void SeventvEmotes::setGlobalEmotes(std::shared_ptr<const EmoteMap> emotes)
 {
     this->global_.set(std::move(emotes));
+    MergedEmoteMap::globalsChanged();
 }
 
 void SeventvEmotes::loadChannelEmotes(
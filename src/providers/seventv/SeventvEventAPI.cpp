@@ -118,14 +118,15 @@ void SeventvEventAPI::onMessage(
     websocketpp::connection_hdl hdl,
     BasicPubSubManager<Subscription>::WebsocketMessagePtr msg)
 {
-    const auto &payload = QString::fromStdString(msg->get_payload());
+    const auto &payload = msg->get_payload();
 
     auto pMessage = parseBaseMessage(payload);
 
     if (!pMessage)
     {
         qCDebug(chatterinoSeventvEventAPI)
-            << "Unable to parse incoming event-api message: " << payload;
+            << "Unable to parse incoming event-api message: "
+            << QString::fromStdString(payload);
         return;
     }
     auto message = *pMessage;
@@ -153,14 +154,13 @@ void SeventvEventAPI::onMessage(
         }
         break;
         case Opcode::Dispatch: {
-            auto dispatch = message.toInner<Dispatch>();
-            if (!dispatch)
+            if (!message.dispatch)
             {
                 qCDebug(chatterinoSeventvEventAPI)
-                    << "Malformed dispatch" << payload;
+                    << "Malformed dispatch" << QString::fromStdString(payload);
                 return;
             }
-            this->handleDispatch(*dispatch);
+            this->handleDispatch(*message.dispatch);
         }
         break;
         case Opcode::Reconnect: {
@@ -178,7 +178,8 @@ void SeventvEventAPI::onMessage(
         }
         break;
         default: {
-            qCDebug(chatterinoSeventvEventAPI) << "Unhandled op:" << payload;
+            qCDebug(chatterinoSeventvEventAPI)
+                << "Unhandled op:" << QString::fromStdString(payload);
         }
         break;
     }
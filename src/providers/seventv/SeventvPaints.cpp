@@ -221,6 +221,7 @@ void SeventvPaints::loadSeventvPaints()
     url.setQuery(urlQuery);
 
     NetworkRequest(url)
+        .priority(QNetworkRequest::LowPriority)
         .onSuccess([this](const auto &result) -> Outcome {
             auto root = result.parseJson();
 
@@ -9,9 +9,15 @@
 namespace chatterino::seventv::eventapi {
 
 Dispatch::Dispatch(QJsonObject obj)
-    : type(qmagicenum::enumCast<SubscriptionType>(obj["type"].toString())
-               .value_or(SubscriptionType::INVALID))
-    , body(obj["body"].toObject())
+    : Dispatch(qmagicenum::enumCast<SubscriptionType>(obj["type"].toString())
+                   .value_or(SubscriptionType::INVALID),
+               obj["body"].toObject())
+{
+}
+
+Dispatch::Dispatch(SubscriptionType _type, QJsonObject _body)
+    : type(_type)
+    , body(std::move(_body))
     , id(this->body["id"].toString())
     , actorName(this->body["actor"].toObject()["display_name"].toString())
 {
@@ -17,6 +17,7 @@ struct Dispatch {
     QString actorName;
 
     Dispatch(QJsonObject obj);
+    Dispatch(SubscriptionType _type, QJsonObject _body);
 };
 
 struct EmoteAddDispatch {
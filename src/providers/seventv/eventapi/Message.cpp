@@ -1,23 +1,57 @@
 #include "providers/seventv/eventapi/Message.hpp"
 
-namespace chatterino::seventv::eventapi {
+#include "util/QMagicEnum.hpp"
 
-Message::Message(QJsonObject _json)
-    : data(_json["d"].toObject())
-    , op(Opcode(_json["op"].toInt()))
-{
-}
+#include <QByteArray>
+#include <QJsonDocument>
 
-std::optional<Message> parseBaseMessage(const QString &blob)
+namespace chatterino::seventv::eventapi {
+
+std::optional<Message> parseBaseMessage(std::string_view payload)
 {
-    QJsonDocument jsonDoc(QJsonDocument::fromJson(blob.toUtf8()));
+    // The dispatches read the body as a QJsonObject, so the payload is
+    // parsed into one directly
+    auto document = QJsonDocument::fromJson(QByteArray::fromRawData(
+        payload.data(), static_cast<qsizetype>(payload.size())));
 
-    if (jsonDoc.isNull())
+    if (!document.isObject())
     {
         return std::nullopt;
     }
 
-    return Message(jsonDoc.object());
+    const auto root = document.object();
+
+    Message message;
+    message.op = Opcode::Dispatch;
+
+    auto op = root.value("op");
+    if (op.isDouble())
+    {
+        message.op = Opcode(op.toInt());
+    }
+
+    auto d = root.value("d");
+    if (!d.isObject())
+    {
+        return message;
+    }
+
+    if (message.op != Opcode::Dispatch)
+    {
+        message.data = d.toObject();
+        return message;
+    }
+
+    message.dispatch.emplace(d.toObject());
+
+    return message;
+}
+
+std::optional<Message> parseBaseMessage(const QString &blob)
+{
+    auto utf8 = blob.toUtf8();
+    return parseBaseMessage(
+        std::string_view(utf8.constData(), size_t(utf8.size())));
 }
 
 }  // namespace chatterino::seventv::eventapi
@@ -1,33 +1,30 @@
 #pragma once
 
+#include "providers/seventv/eventapi/Dispatch.hpp"
 #include "providers/seventv/eventapi/Subscription.hpp"
 
 #include <magic_enum/magic_enum.hpp>
-#include <QJsonDocument>
 #include <QJsonObject>
 #include <QString>
 
 #include <optional>
+#include <string_view>
 
 namespace chatterino::seventv::eventapi {
 
 struct Message {
+    /// The payload (`d`) of all messages except dispatches
     QJsonObject data;
 
     Opcode op;
 
-    Message(QJsonObject _json);
-
-    template <class InnerClass>
-    std::optional<InnerClass> toInner();
+    /// The decoded payload of Dispatch messages
+    std::optional<Dispatch> dispatch;
 };
 
-template <class InnerClass>
-std::optional<InnerClass> Message::toInner()
-{
-    return InnerClass{this->data};
-}
-
+/// Decodes an EventAPI message in a single pass.
+/// `payload` is the UTF-8 encoded message as received from the websocket.
+std::optional<Message> parseBaseMessage(std::string_view payload);
 std::optional<Message> parseBaseMessage(const QString &blob);
 
 }  // namespace chatterino::seventv::eventapi
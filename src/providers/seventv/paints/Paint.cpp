@@ -2,29 +2,84 @@
 
 #include "Application.hpp"
 #include "common/Literals.hpp"
+#include "debug/AssertInGuiThread.hpp"
+#include "messages/Image.hpp"
 #include "singletons/Theme.hpp"
 
-#include <QLabel>
+#include <lrucache/lrucache.hpp>
 #include <QPainter>
+#include <QStringBuilder>
+
+namespace {
+
+using namespace chatterino;
+
+/// Enough for a few hundred chatters with paints in view at once
+constexpr size_t PIXMAP_CACHE_SIZE = 512;
+
+cache::lru_cache<QString, QPixmap> &pixmapCache()
+{
+    static cache::lru_cache<QString, QPixmap> cache(PIXMAP_CACHE_SIZE);
+    return cache;
+}
+
+}  // namespace
 
 namespace chatterino {
 
 using namespace literals;
 
+ImagePtr Paint::animationImage() const
+{
+    return nullptr;
+}
+
 QPixmap Paint::getPixmap(const QString &text, const QFont &font,
                          QColor userColor, QSize size, float scale) const
 {
-    QPixmap pixmap(size);
-    pixmap.fill(Qt::transparent);
+    assertInGuiThread();
 
-    QPainter pixmapPainter(&pixmap);
+    auto colonColor = getApp()->getThemes()->messages.textColors.regular;
+    int frame = 0;
+    if (auto image = this->animationImage())
+    {
+        frame = image->frameIndex();
+    }
+
+    QString key = this->id % '\n' % text % '\n' % font.key() % '\n' %
+                  QString::number(userColor.rgba(), 16) % '\n' %
+                  QString::number(colonColor.rgba(), 16) % '\n' %
+                  QString::number(size.width()) % 'x' %
+                  QString::number(size.height()) % '\n' %
+                  QString::number(scale) % '\n' % QString::number(frame);
+
+    auto &cache = pixmapCache();
+    if (cache.exists(key))
+    {
+        return cache.get(key);
+    }
+
+    auto pixmap =
+        this->renderPixmap(text, font, userColor, colonColor, size, scale);
+    cache.put(key, pixmap);
+    return pixmap;
+}
+
+QPixmap Paint::renderPixmap(const QString &text, const QFont &font,
+                            QColor userColor, QColor colonColor, QSize size,
+                            float scale) const
+{
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+
+    QPainter pixmapPainter(&image);
     pixmapPainter.setRenderHint(QPainter::SmoothPixmapTransform);
     pixmapPainter.setFont(font);
 
     // NOTE: draw colon separately from the nametag
     // otherwise the paint would extend onto the colon
     bool drawColon = false;
-    QRectF nametagBoundingRect = pixmap.rect();
+    QRectF nametagBoundingRect = image.rect();
     QString nametagText = text;
     if (nametagText.endsWith(':'))
     {
@@ -44,6 +99,7 @@ QPixmap Paint::getPixmap(const QString &text, const QFont &font,
                            QTextOption(Qt::AlignLeft | Qt::AlignTop));
     pixmapPainter.end();
 
+    // Each shadow is cast by the nametag including the previous shadows
     for (const auto &shadow : this->getDropShadows())
     {
         if (!shadow.isValid())
@@ -51,30 +107,12 @@ QPixmap Paint::getPixmap(const QString &text, const QFont &font,
             continue;
         }
 
-        // HACK: create a QLabel from the pixmap to apply drop shadows
-        QLabel label;
-
-        auto scaledShadow = shadow.scaled(
-            scale / static_cast<float>(label.devicePixelRatioF()));
-
-        // NOTE: avoid scaling issues on high DPI displays
-        pixmap.setDevicePixelRatio(label.devicePixelRatioF());
-
-        label.setPixmap(pixmap);
-
-        QGraphicsDropShadowEffect dropShadow;
-        scaledShadow.apply(dropShadow);
-        label.setGraphicsEffect(&dropShadow);
-
-        pixmap = label.grab();
-        pixmap.setDevicePixelRatio(1);
+        shadow.scaled(scale).apply(image);
     }
 
     if (drawColon)
     {
-        auto colonColor = getApp()->getThemes()->messages.textColors.regular;
-
-        pixmapPainter.begin(&pixmap);
+        pixmapPainter.begin(&image);
 
         pixmapPainter.setPen(QPen(colonColor));
         pixmapPainter.setFont(font);
@@ -85,7 +123,7 @@ QPixmap Paint::getPixmap(const QString &text, const QFont &font,
         pixmapPainter.end();
     }
 
-    return pixmap;
+    return QPixmap::fromImage(std::move(image));
 }
 
 QColor Paint::overlayColors(QColor background, QColor foreground)
@@ -4,11 +4,16 @@
 
 #include <QBrush>
 #include <QFont>
+#include <QPixmap>
 
+#include <memory>
 #include <vector>
 
 namespace chatterino {
 
+class Image;
+using ImagePtr = std::shared_ptr<Image>;
+
 class Paint
 {
 public:
@@ -16,6 +21,12 @@ public:
     virtual const std::vector<PaintDropShadow> &getDropShadows() const = 0;
     virtual bool animated() const = 0;
 
+    /// The image the paint is drawn from if it's animated, nullptr otherwise
+    virtual ImagePtr animationImage() const;
+
+    /// Renders a nametag with this paint.
+    /// Nametags are cached by their text, font, color, scale and the current
+    /// frame of animated paints, so this only renders once per frame.
     QPixmap getPixmap(const QString &text, const QFont &font, QColor userColor,
                       QSize size, float scale) const;
 
@@ -30,6 +41,11 @@ public:
 
     QString id;
 
+private:
+    QPixmap renderPixmap(const QString &text, const QFont &font,
+                         QColor userColor, QColor colonColor, QSize size,
+                         float scale) const;
+
 protected:
     static QColor overlayColors(QColor background, QColor foreground);
     static qreal offsetRepeatingStopPosition(qreal position,
@@ -1,5 +1,10 @@
 #include "providers/seventv/paints/PaintDropShadow.hpp"
 
+#include "util/GaussianBlur.hpp"
+
+#include <QImage>
+#include <QPainter>
+
 namespace chatterino {
 
 PaintDropShadow::PaintDropShadow(float xOffset, float yOffset, float radius,
@@ -22,13 +27,41 @@ PaintDropShadow PaintDropShadow::scaled(float scale) const
             this->radius_ * scale, this->color_};
 }
 
-void PaintDropShadow::apply(QGraphicsDropShadowEffect &effect) const
+void PaintDropShadow::apply(QImage &image) const
 {
-    // We can't move here
-    effect.setXOffset(this->xOffset_);
-    effect.setYOffset(this->yOffset_);
-    effect.setBlurRadius(this->radius_);
-    effect.setColor(this->color_);
+    // The offsets and radius are in logical pixels, the shadow is built and
+    // drawn in the image's device pixels
+    const auto dpr = image.devicePixelRatio();
+    const auto xOffset = this->xOffset_ * dpr;
+    const auto yOffset = this->yOffset_ * dpr;
+    const auto radius = this->radius_ * dpr;
+
+    // The radius is a CSS blur radius, which is twice the standard deviation
+    auto mask = image.convertToFormat(QImage::Format_Alpha8);
+    gaussianBlurAlpha(mask, radius / 2);
+
+    QImage shadow(image.size(), QImage::Format_ARGB32_Premultiplied);
+    const auto color = qPremultiply(this->color_.rgba());
+    for (int y = 0; y < shadow.height(); y++)
+    {
+        const auto *alpha = mask.constScanLine(y);
+        auto *line = reinterpret_cast<QRgb *>(shadow.scanLine(y));
+        for (int x = 0; x < shadow.width(); x++)
+        {
+            const auto a = alpha[x];
+            line[x] = qRgba(qRed(color) * a / 255, qGreen(color) * a / 255,
+                            qBlue(color) * a / 255, qAlpha(color) * a / 255);
+        }
+    }
+
+    // Otherwise QPainter would scale the offset and the shadow by the ratio
+    image.setDevicePixelRatio(1);
+    {
+        QPainter painter(&image);
+        painter.setCompositionMode(QPainter::CompositionMode_DestinationOver);
+        painter.drawImage(QPointF(xOffset, yOffset), shadow);
+    }
+    image.setDevicePixelRatio(dpr);
 }
 
 }  // namespace chatterino
@@ -1,6 +1,8 @@
 #pragma once
 
-#include <QGraphicsDropShadowEffect>
+#include <QColor>
+
+class QImage;
 
 namespace chatterino {
 
@@ -11,7 +13,11 @@ public:
 
     bool isValid() const;
     PaintDropShadow scaled(float scale) const;
-    void apply(QGraphicsDropShadowEffect &effect) const;
+
+    /// Draws the shadow of @a image's contents behind them.
+    /// @a image must be in QImage::Format_ARGB32_Premultiplied. The offsets
+    /// and radius are scaled by its device pixel ratio.
+    void apply(QImage &image) const;
 
 private:
     const float xOffset_;
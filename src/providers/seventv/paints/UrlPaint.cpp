@@ -20,6 +20,15 @@ bool UrlPaint::animated() const
     return image_->animated();
 }
 
+ImagePtr UrlPaint::animationImage() const
+{
+    if (!this->image_->animated())
+    {
+        return nullptr;
+    }
+    return this->image_;
+}
+
 QBrush UrlPaint::asBrush(const QColor userColor, const QRectF drawingRect) const
 {
     if (auto paintPixmap = this->image_->pixmapOrLoad())
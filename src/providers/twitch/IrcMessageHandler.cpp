@@ -13,6 +13,8 @@
 #include "messages/MessageColor.hpp"
 #include "messages/MessageElement.hpp"
 #include "messages/MessageThread.hpp"
+#include "providers/irc/IrcLine.hpp"
+#include "providers/irc/IrcTags.hpp"
 #include "providers/twitch/ChannelPointReward.hpp"
 #include "providers/twitch/TwitchAccount.hpp"
 #include "providers/twitch/TwitchAccountManager.hpp"
@@ -89,7 +91,7 @@ MessagePtr generateBannedMessage(bool confirmedBan)
     return builder.release();
 }
 
-int stripLeadingReplyMention(const QVariantMap &tags, QString &content)
+int stripLeadingReplyMention(const IrcTags &tags, QString &content)
 {
     if (!getSettings()->stripReplyMention)
     {
@@ -101,10 +103,10 @@ int stripLeadingReplyMention(const QVariantMap &tags, QString &content)
         return 0;
     }
 
-    if (const auto it = tags.find("reply-parent-display-name");
-        it != tags.end())
+    if (const auto displayNameTag = tags.value("reply-parent-display-name");
+        displayNameTag.isValid())
     {
-        auto displayName = it.value().toString();
+        auto displayName = displayNameTag.toString();
 
         if (content.length() <= 1 + displayName.length())
         {
@@ -124,7 +126,7 @@ int stripLeadingReplyMention(const QVariantMap &tags, QString &content)
     return 0;
 }
 
-void updateReplyParticipatedStatus(const QVariantMap &tags,
+void updateReplyParticipatedStatus(const IrcTags &tags,
                                    const QString &senderLogin,
                                    TwitchMessageBuilder &builder,
                                    std::shared_ptr<MessageThread> &thread,
@@ -148,10 +150,10 @@ void updateReplyParticipatedStatus(const QVariantMap &tags,
     {
         if (isNew)
         {
-            if (const auto it = tags.find("reply-parent-user-login");
-                it != tags.end())
+            if (const auto login = tags.value("reply-parent-user-login");
+                login.isValid())
             {
-                auto name = it.value().toString();
+                auto name = login.toString();
                 if (name == currentLogin)
                 {
                     thread->markSubscribed();
@@ -243,15 +245,15 @@ QMap<QString, QString> parseBadges(const QString &badgesString)
     return badges;
 }
 
-void populateReply(TwitchChannel *channel, Communi::IrcMessage *message,
+void populateReply(TwitchChannel *channel, const IrcTags &tags,
+                   const QString &nick,
                    const std::vector<MessagePtr> &otherLoaded,
                    TwitchMessageBuilder &builder)
 {
-    const auto &tags = message->tags();
-    if (const auto it = tags.find("reply-thread-parent-msg-id");
-        it != tags.end())
+    if (const auto replyTag = tags.value("reply-thread-parent-msg-id");
+        replyTag.isValid())
     {
-        const QString replyID = it.value().toString();
+        const QString replyID = replyTag.toString();
         auto threadIt = channel->threads().find(replyID);
         std::shared_ptr<MessageThread> rootThread;
         if (threadIt != channel->threads().end())
@@ -260,8 +262,8 @@ void populateReply(TwitchChannel *channel, Communi::IrcMessage *message,
             if (owned)
             {
                 // Thread already exists (has a reply)
-                updateReplyParticipatedStatus(tags, message->nick(), builder,
-                                              owned, false);
+                updateReplyParticipatedStatus(tags, nick, builder, owned,
+                                              false);
                 builder.setThread(owned);
                 rootThread = owned;
             }
@@ -296,8 +298,8 @@ void populateReply(TwitchChannel *channel, Communi::IrcMessage *message,
             {
                 std::shared_ptr<MessageThread> newThread =
                     std::make_shared<MessageThread>(foundMessage);
-                updateReplyParticipatedStatus(tags, message->nick(), builder,
-                                              newThread, true);
+                updateReplyParticipatedStatus(tags, nick, builder, newThread,
+                                              true);
 
                 builder.setThread(newThread);
                 rootThread = newThread;
@@ -306,10 +308,10 @@ void populateReply(TwitchChannel *channel, Communi::IrcMessage *message,
             }
         }
 
-        if (const auto parentIt = tags.find("reply-parent-msg-id");
-            parentIt != tags.end())
+        if (const auto parentTag = tags.value("reply-parent-msg-id");
+            parentTag.isValid())
         {
-            const QString parentID = parentIt.value().toString();
+            const QString parentID = parentTag.toString();
             if (replyID == parentID)
             {
                 if (rootThread)
@@ -633,7 +635,8 @@ std::vector<MessagePtr> IrcMessageHandler::parseMessageWithReply(
                                      privMsg->isAction());
         builder.setMessageOffset(messageOffset);
 
-        populateReply(tc, message, otherLoaded, builder);
+        populateReply(tc, privMsg->tags(), privMsg->nick(), otherLoaded,
+                      builder);
 
         if (!builder.isIgnored())
         {
@@ -678,8 +681,7 @@ std::vector<MessagePtr> IrcMessageHandler::parseMessageWithReply(
                 },
                 [&](auto &&msg) {
                     builtMessages.emplace_back(msg);
-                },
-                false);
+                });
         }
 
         return builtMessages;
@@ -688,6 +690,56 @@ std::vector<MessagePtr> IrcMessageHandler::parseMessageWithReply(
     return builtMessages;
 }
 
+std::vector<MessagePtr> IrcMessageHandler::parseMessageWithReply(
+    Channel *channel, const IrcLine &line, std::vector<MessagePtr> &otherLoaded)
+{
+    auto *tc = dynamic_cast<TwitchChannel *>(channel);
+    if (tc == nullptr || line.command() != "PRIVMSG" ||
+        line.parameterCount() < 2)
+    {
+        std::unique_ptr<Communi::IrcMessage> message(
+            Communi::IrcMessage::fromData(line.data(), nullptr));
+        return parseMessageWithReply(channel, message.get(), otherLoaded);
+    }
+
+    std::vector<MessagePtr> builtMessages;
+
+    // Same as Communi::IrcPrivateMessage::content() and isAction()
+    constexpr std::string_view actionPrefix = "\x01"
+                                              "ACTION ";
+    auto text = line.parameter(1);
+    bool isAction = text.starts_with(actionPrefix);
+    if (isAction)
+    {
+        text.remove_prefix(actionPrefix.size());
+        if (text.ends_with('\x01'))
+        {
+            text.remove_suffix(1);
+        }
+    }
+
+    IrcTags tags(line);
+    auto nick = QString::fromUtf8(line.nick().data(),
+                                  static_cast<qsizetype>(line.nick().size()));
+    auto content =
+        QString::fromUtf8(text.data(), static_cast<qsizetype>(text.size()));
+
+    int messageOffset = stripLeadingReplyMention(tags, content);
+    MessageParseArgs args;
+    TwitchMessageBuilder builder(channel, tags, nick, args, content, isAction);
+    builder.setMessageOffset(messageOffset);
+
+    populateReply(tc, tags, nick, otherLoaded, builder);
+
+    if (!builder.isIgnored())
+    {
+        builtMessages.emplace_back(builder.build());
+        builder.triggerHighlights();
+    }
+
+    return builtMessages;
+}
+
 void IrcMessageHandler::handlePrivMessage(Communi::IrcPrivateMessage *message,
                                           TwitchIrcServer &server)
 {
@@ -16,6 +16,7 @@ struct Message;
 using MessagePtr = std::shared_ptr<const Message>;
 class TwitchChannel;
 class TwitchMessageBuilder;
+class IrcLine;
 
 struct ClearChatMessage {
     MessagePtr message;
@@ -37,6 +38,16 @@ public:
         Channel *channel, Communi::IrcMessage *message,
         std::vector<MessagePtr> &otherLoaded);
 
+    /**
+     * Same as above, but for a line that wasn't parsed by Communi
+     *
+     * PRIVMSGs in Twitch channels are built straight from the line, anything
+     * else goes through a Communi message.
+     **/
+    static std::vector<MessagePtr> parseMessageWithReply(
+        Channel *channel, const IrcLine &line,
+        std::vector<MessagePtr> &otherLoaded);
+
     void handlePrivMessage(Communi::IrcPrivateMessage *message,
                            TwitchIrcServer &server);
 
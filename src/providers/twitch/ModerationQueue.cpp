@@ -0,0 +1,462 @@
+#include "providers/twitch/ModerationQueue.hpp"
+
+#include "common/Channel.hpp"
+#include "common/QLogging.hpp"
+#include "debug/AssertInGuiThread.hpp"
+#include "messages/MessageBuilder.hpp"
+#include "providers/twitch/api/Helix.hpp"
+#include "util/Twitch.hpp"
+
+#include <QDateTime>
+#include <QRegularExpression>
+#include <QSet>
+
+namespace {
+
+using namespace chatterino;
+
+/// Helix accepts up to 100 logins per Get Users request
+constexpr qsizetype USER_LOOKUP_BATCH_SIZE = 100;
+
+QString describe(ModerationRequest::Type type, size_t count)
+{
+    QString noun;
+    switch (type)
+    {
+        case ModerationRequest::Type::Ban:
+            noun = "ban";
+            break;
+        case ModerationRequest::Type::Timeout:
+            noun = "timeout";
+            break;
+        case ModerationRequest::Type::Unban:
+            noun = "unban";
+            break;
+        case ModerationRequest::Type::DeleteMessage:
+            noun = "message deletion";
+            break;
+    }
+
+    return QString("%1 %2%3").arg(count).arg(noun).arg(count == 1 ? "" : "s");
+}
+
+}  // namespace
+
+namespace chatterino {
+
+struct ModerationQueue::Batch {
+    ModerationRequest::Type type;
+    ReportCallback report;
+    size_t total = 0;
+    size_t finished = 0;
+    size_t failed = 0;
+    /// Target and reason of the first MAX_LISTED_FAILURES failures
+    QStringList failures;
+    /// Set if the batch was stopped because all requests would fail
+    QString abortReason;
+};
+
+ModerationQueue::ModerationQueue(std::chrono::milliseconds retryDelay,
+                                 QObject *parent)
+    : QObject(parent)
+    , backoff_(retryDelay)
+{
+    this->resumeTimer_.setSingleShot(true);
+    QObject::connect(&this->resumeTimer_, &QTimer::timeout, this, [this] {
+        this->pump();
+    });
+}
+
+ModerationQueue &ModerationQueue::instance()
+{
+    assertInGuiThread();
+
+    static auto *queue = new ModerationQueue;
+    return *queue;
+}
+
+void ModerationQueue::enqueue(std::vector<ModerationRequest> requests,
+                              ReportCallback report)
+{
+    if (requests.empty())
+    {
+        return;
+    }
+
+    auto batch = std::make_shared<Batch>();
+    batch->type = requests.front().type;
+    batch->report = std::move(report);
+    batch->total = requests.size();
+
+    for (auto &request : requests)
+    {
+        this->queue_.push_back({batch, std::move(request)});
+    }
+
+    batch->report(
+        QString("Queued %1.").arg(describe(batch->type, batch->total)));
+
+    this->pump();
+}
+
+size_t ModerationQueue::pending() const
+{
+    return this->queue_.size();
+}
+
+void ModerationQueue::pump()
+{
+    while (!this->queue_.empty() && this->inFlight_ < MAX_IN_FLIGHT &&
+           !this->resumeTimer_.isActive())
+    {
+        // The headers only tell us about requests that already finished, so
+        // the ones still in flight are subtracted from the bucket as well
+        auto ratelimit = getHelix()->ratelimit();
+        auto untilReset =
+            QDateTime::currentDateTime().msecsTo(ratelimit.reset);
+        if (ratelimit.remaining && untilReset > 0 &&
+            *ratelimit.remaining - this->inFlight_ <= RESERVED_POINTS)
+        {
+            this->pause(std::chrono::milliseconds(untilReset),
+                        *this->queue_.front().batch);
+            return;
+        }
+
+        auto job = std::move(this->queue_.front());
+        this->queue_.pop_front();
+        this->inFlight_++;
+        this->send(std::move(job));
+    }
+}
+
+void ModerationQueue::send(Job job)
+{
+    // Copy the request, the callbacks below take ownership of the job
+    auto request = job.request;
+    auto onSuccess = [this, job] {
+        this->finish(job, {Outcome::Done, {}});
+    };
+    auto onFailure = [this, job](auto error, const auto &message) {
+        this->finish(job, classify(error, message));
+    };
+
+    switch (request.type)
+    {
+        case ModerationRequest::Type::Ban:
+        case ModerationRequest::Type::Timeout: {
+            std::optional<int> duration;
+            if (request.type == ModerationRequest::Type::Timeout)
+            {
+                duration = request.duration;
+            }
+            getHelix()->banUser(request.broadcasterID, request.moderatorID,
+                                request.targetID, duration, request.reason,
+                                onSuccess, onFailure);
+        }
+        break;
+
+        case ModerationRequest::Type::Unban: {
+            getHelix()->unbanUser(request.broadcasterID, request.moderatorID,
+                                  request.targetID, onSuccess, onFailure);
+        }
+        break;
+
+        case ModerationRequest::Type::DeleteMessage: {
+            getHelix()->deleteChatMessages(request.broadcasterID,
+                                           request.moderatorID,
+                                           request.targetID, onSuccess,
+                                           onFailure);
+        }
+        break;
+    }
+}
+
+void ModerationQueue::finish(Job job, const Result &result)
+{
+    this->inFlight_--;
+
+    auto batch = job.batch;
+    auto outcome = result.outcome;
+
+    if (outcome == Outcome::Retry)
+    {
+        job.attempts++;
+        if (job.attempts < MAX_ATTEMPTS)
+        {
+            qCDebug(chatterinoTwitch)
+                << "Retrying moderation request for" << job.request.targetName
+                << "-" << result.error;
+            auto delay = this->backoff_.next();
+            this->queue_.push_front(std::move(job));
+            this->pause(delay, *batch);
+            return;
+        }
+        outcome = Outcome::Failed;
+    }
+    else if (outcome == Outcome::Done)
+    {
+        this->backoff_.reset();
+    }
+
+    batch->finished++;
+    if (outcome != Outcome::Done)
+    {
+        batch->failed++;
+        if (batch->failures.size() < MAX_LISTED_FAILURES)
+        {
+            batch->failures.append(
+                QString("%1 (%2)").arg(job.request.targetName, result.error));
+        }
+    }
+
+    if (outcome == Outcome::Abort && batch->abortReason.isEmpty())
+    {
+        batch->abortReason = result.error;
+        auto dropped = std::erase_if(this->queue_, [&](const auto &queued) {
+            return queued.batch == batch;
+        });
+        batch->finished += dropped;
+        batch->failed += dropped;
+    }
+
+    if (batch->finished == batch->total)
+    {
+        auto summary = QString("Finished %1: %2 succeeded, %3 failed.")
+                           .arg(describe(batch->type, batch->total))
+                           .arg(batch->total - batch->failed)
+                           .arg(batch->failed);
+        if (!batch->abortReason.isEmpty())
+        {
+            summary += QString(" Stopped early: %1.").arg(batch->abortReason);
+        }
+        else if (!batch->failures.isEmpty())
+        {
+            summary += " Failed: " + batch->failures.join(", ");
+            auto unlisted = batch->failed - size_t(batch->failures.size());
+            if (unlisted > 0)
+            {
+                summary += QString(" and %1 more").arg(unlisted);
+            }
+        }
+        batch->report(summary);
+    }
+    else if (batch->finished % PROGRESS_INTERVAL == 0)
+    {
+        batch->report(QString("%1/%2 done.")
+                          .arg(batch->finished)
+                          .arg(describe(batch->type, batch->total)));
+    }
+
+    this->pump();
+}
+
+void ModerationQueue::pause(std::chrono::milliseconds delay, Batch &batch)
+{
+    if (this->resumeTimer_.isActive())
+    {
+        if (this->resumeTimer_.remainingTime() < delay.count())
+        {
+            this->resumeTimer_.start(delay);
+        }
+        return;
+    }
+
+    this->resumeTimer_.start(delay);
+    if (delay >= std::chrono::seconds(1))
+    {
+        auto seconds = (delay.count() + 999) / 1000;
+        batch.report(QString("Waiting %1s for Twitch's rate limit...")
+                         .arg(seconds));
+    }
+}
+
+ModerationQueue::Result ModerationQueue::classify(HelixBanUserError error,
+                                                  const QString &message)
+{
+    using Error = HelixBanUserError;
+
+    switch (error)
+    {
+        case Error::Ratelimited:
+            return {Outcome::Retry, "rate limited"};
+        case Error::ConflictingOperation:
+            return {Outcome::Retry, "conflicting ban operation"};
+        case Error::TargetBanned:
+            // The user is gone either way
+            return {Outcome::Done, {}};
+        case Error::CannotBanUser:
+            return {Outcome::Failed, "can't be banned"};
+        case Error::UserMissingScope:
+            return {Outcome::Abort, "missing required scope, re-login with "
+                                    "your account and try again"};
+        case Error::UserNotAuthorized:
+            return {Outcome::Abort,
+                    "you don't have permission to perform that action"};
+        case Error::Forwarded:
+            return {Outcome::Failed, message};
+        case Error::Unknown:
+        default:
+            return {Outcome::Failed, "unknown error"};
+    }
+}
+
+ModerationQueue::Result ModerationQueue::classify(HelixUnbanUserError error,
+                                                  const QString &message)
+{
+    using Error = HelixUnbanUserError;
+
+    switch (error)
+    {
+        case Error::Ratelimited:
+            return {Outcome::Retry, "rate limited"};
+        case Error::ConflictingOperation:
+            return {Outcome::Retry, "conflicting ban operation"};
+        case Error::TargetNotBanned:
+            return {Outcome::Done, {}};
+        case Error::UserMissingScope:
+            return {Outcome::Abort, "missing required scope, re-login with "
+                                    "your account and try again"};
+        case Error::UserNotAuthorized:
+            return {Outcome::Abort,
+                    "you don't have permission to perform that action"};
+        case Error::Forwarded:
+            return {Outcome::Failed, message};
+        case Error::Unknown:
+        default:
+            return {Outcome::Failed, "unknown error"};
+    }
+}
+
+ModerationQueue::Result ModerationQueue::classify(
+    HelixDeleteChatMessagesError error, const QString &message)
+{
+    using Error = HelixDeleteChatMessagesError;
+
+    switch (error)
+    {
+        case Error::Ratelimited:
+            return {Outcome::Retry, "rate limited"};
+        case Error::MessageUnavailable:
+            // Already deleted or too old, nothing we can do about it
+            return {Outcome::Done, {}};
+        case Error::UserMissingScope:
+            return {Outcome::Abort, "missing required scope, re-login with "
+                                    "your account and try again"};
+        case Error::UserNotAuthorized:
+            return {Outcome::Abort,
+                    "you don't have permission to perform that action"};
+        case Error::UserNotAuthenticated:
+            return {Outcome::Abort, "you need to re-authenticate"};
+        case Error::Forwarded:
+            return {Outcome::Failed, message};
+        case Error::Unknown:
+        default:
+            return {Outcome::Failed, "unknown error"};
+    }
+}
+
+ModerationQueue::ReportCallback reportToChannel(
+    const std::shared_ptr<Channel> &channel)
+{
+    return [weak = std::weak_ptr<Channel>(channel)](const QString &text) {
+        if (auto channel = weak.lock())
+        {
+            channel->addMessage(makeSystemMessage(text));
+        }
+    };
+}
+
+QStringList splitModerationTargets(const QStringList &words)
+{
+    static const QRegularExpression separators(R"([\s,]+)");
+
+    QStringList targets;
+    for (const auto &word : words)
+    {
+        targets.append(word.split(separators, Qt::SkipEmptyParts));
+    }
+    return targets;
+}
+
+void resolveModerationTargets(
+    const QStringList &targets,
+    std::function<void(std::vector<ModerationTarget> users,
+                       QStringList unknown)>
+        callback)
+{
+    struct State {
+        std::vector<ModerationTarget> users;
+        QStringList unknown;
+        size_t pendingLookups = 0;
+        std::function<void(std::vector<ModerationTarget>, QStringList)>
+            callback;
+    };
+    auto state = std::make_shared<State>();
+    state->callback = std::move(callback);
+
+    QStringList names;
+    QSet<QString> seen;
+    for (const auto &target : targets)
+    {
+        auto [name, id] = parseUserNameOrID(target);
+        if (!id.isEmpty())
+        {
+            state->users.push_back({id, id});
+        }
+        else if (!name.isEmpty() && !seen.contains(name.toLower()))
+        {
+            seen.insert(name.toLower());
+            names.append(name);
+        }
+    }
+
+    if (names.isEmpty())
+    {
+        state->callback(std::move(state->users), {});
+        return;
+    }
+
+    std::vector<QStringList> chunks;
+    for (qsizetype i = 0; i < names.size(); i += USER_LOOKUP_BATCH_SIZE)
+    {
+        chunks.push_back(names.mid(i, USER_LOOKUP_BATCH_SIZE));
+    }
+    // All lookups are counted up front since callbacks can run synchronously
+    state->pendingLookups = chunks.size();
+
+    auto finishLookup = [](const std::shared_ptr<State> &current) {
+        if (--current->pendingLookups == 0)
+        {
+            current->callback(std::move(current->users),
+                              std::move(current->unknown));
+        }
+    };
+
+    for (const auto &chunk : chunks)
+    {
+        getHelix()->fetchUsers(
+            {}, chunk,
+            [state, chunk, finishLookup](const auto &users) {
+                QSet<QString> found;
+                for (const auto &user : users)
+                {
+                    state->users.push_back({user.id, user.displayName});
+                    found.insert(user.login.toLower());
+                }
+                for (const auto &name : chunk)
+                {
+                    if (!found.contains(name.toLower()))
+                    {
+                        state->unknown.append(name);
+                    }
+                }
+                finishLookup(state);
+            },
+            [state, chunk, finishLookup] {
+                state->unknown.append(chunk);
+                finishLookup(state);
+            });
+    }
+}
+
+}  // namespace chatterino
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "util/ExponentialBackoff.hpp"
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace chatterino {
+
+class Channel;
+enum class HelixBanUserError;
+enum class HelixUnbanUserError;
+enum class HelixDeleteChatMessagesError;
+
+/// A single Helix moderation call sent through the ModerationQueue
+struct ModerationRequest {
+    enum class Type {
+        Ban,
+        Timeout,
+        Unban,
+        DeleteMessage,
+    };
+
+    Type type = Type::Ban;
+    QString broadcasterID;
+    QString moderatorID;
+    /// The user ID for bans, timeouts and unbans, the message ID for deletions
+    QString targetID;
+    /// Describes the target in progress and error messages
+    QString targetName;
+    /// Timeout duration in seconds
+    int duration = 0;
+    QString reason;
+};
+
+struct ModerationTarget {
+    QString id;
+    QString name;
+};
+
+/**
+ * @brief Sends bulk moderation actions to Helix without running into 429s
+ *
+ * At most MAX_IN_FLIGHT requests are sent at once. When the
+ * Ratelimit-Remaining header of the last response drops to RESERVED_POINTS,
+ * the queue waits for the Ratelimit-Reset time, leaving the rest of the
+ * bucket to chatting and single commands. Requests that were rate limited or
+ * conflicted with another ban are retried with an exponential backoff.
+ *
+ * Must only be used from the GUI thread.
+ */
+class ModerationQueue : public QObject
+{
+public:
+    using ReportCallback = std::function<void(const QString &)>;
+
+    static constexpr int MAX_IN_FLIGHT = 4;
+    static constexpr int MAX_ATTEMPTS = 5;
+    static constexpr int RESERVED_POINTS = 10;
+    /// A batch reports its progress every time this many requests finished
+    static constexpr size_t PROGRESS_INTERVAL = 50;
+    /// The summary of a batch names at most this many failed targets
+    static constexpr int MAX_LISTED_FAILURES = 10;
+
+    explicit ModerationQueue(
+        std::chrono::milliseconds retryDelay = std::chrono::seconds(1),
+        QObject *parent = nullptr);
+
+    static ModerationQueue &instance();
+
+    /// Queues @a requests as one batch. Its progress, pauses and a final
+    /// summary are passed to @a report.
+    void enqueue(std::vector<ModerationRequest> requests,
+                 ReportCallback report);
+
+    /// The number of requests that are queued but not sent yet
+    size_t pending() const;
+
+private:
+    struct Batch;
+    struct Job {
+        std::shared_ptr<Batch> batch;
+        ModerationRequest request;
+        int attempts = 0;
+    };
+    enum class Outcome {
+        Done,
+        /// Sending the request again later can succeed
+        Retry,
+        Failed,
+        /// The other requests of the batch would fail the same way
+        Abort,
+    };
+    struct Result {
+        Outcome outcome;
+        QString error;
+    };
+
+    static Result classify(HelixBanUserError error, const QString &message);
+    static Result classify(HelixUnbanUserError error, const QString &message);
+    static Result classify(HelixDeleteChatMessagesError error,
+                           const QString &message);
+
+    void pump();
+    void send(Job job);
+    void finish(Job job, const Result &result);
+    /// Stops sending requests for at least @a delay
+    void pause(std::chrono::milliseconds delay, Batch &batch);
+
+    std::deque<Job> queue_;
+    int inFlight_ = 0;
+    QTimer resumeTimer_;
+    ExponentialBackoff<5> backoff_;
+};
+
+/// Posts the reports of a batch as system messages to @a channel for as long
+/// as the channel exists
+ModerationQueue::ReportCallback reportToChannel(
+    const std::shared_ptr<Channel> &channel);
+
+/// Splits command arguments into moderation targets. Pasted lists of names
+/// can be separated by whitespace, newlines or commas.
+QStringList splitModerationTargets(const QStringList &words);
+
+/// Looks up the IDs of @a targets in batches of 100 users. Targets are user
+/// names or "id:<user id>" like in /ban. @a callback is called once with the
+/// found users and the names that couldn't be found.
+void resolveModerationTargets(
+    const QStringList &targets,
+    std::function<void(std::vector<ModerationTarget> users,
+                       QStringList unknown)>
+        callback);
+
+}  // namespace chatterino
@@ -773,15 +773,14 @@ void PubSub::onMessage(websocketpp::connection_hdl hdl,
 {
     this->diag.messagesReceived += 1;
 
-    const auto &payload =
-        QString::fromStdString(websocketMessage->get_payload());
+    const auto &payload = websocketMessage->get_payload();
 
     auto oMessage = parsePubSubBaseMessage(payload);
 
     if (!oMessage)
     {
-        qCDebug(chatterinoPubSub)
-            << "Unable to parse incoming pubsub message" << payload;
+        qCDebug(chatterinoPubSub) << "Unable to parse incoming pubsub message"
+                                  << QString::fromStdString(payload);
         this->diag.messagesFailedToParse += 1;
         return;
     }
@@ -809,14 +808,14 @@ void PubSub::onMessage(websocketpp::connection_hdl hdl,
         break;
 
         case PubSubMessage::Type::Message: {
-            auto oMessageMessage = message.toInner<PubSubMessageMessage>();
-            if (!oMessageMessage)
+            if (!message.data)
             {
-                qCDebug(chatterinoPubSub) << "Malformed MESSAGE:" << payload;
+                qCDebug(chatterinoPubSub) << "Malformed MESSAGE:"
+                                          << QString::fromStdString(payload);
                 return;
             }
 
-            this->handleMessageResponse(*oMessageMessage);
+            this->handleMessageResponse(*message.data);
         }
         break;
 
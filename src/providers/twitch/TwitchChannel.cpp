@@ -80,6 +80,43 @@ namespace {
 
     // From Twitch docs - expected size for a badge (1x)
     constexpr QSize BASE_BADGE_SIZE(18, 18);
+
+    // Number of recent messages added to a channel per event loop iteration
+    constexpr size_t RECENT_MESSAGES_CHUNK_SIZE = 100;
+
+    /// Adds messages[0, end) to the start of the channel, the newest chunk
+    /// first. Each older chunk is added in a later event loop iteration so
+    /// large backfills don't block the GUI thread.
+    void addRecentMessagesInChunks(
+        std::weak_ptr<Channel> weak,
+        std::shared_ptr<const std::vector<MessagePtr>> messages, size_t end,
+        std::function<void()> onDone)
+    {
+        auto shared = weak.lock();
+        if (!shared)
+        {
+            return;
+        }
+
+        auto begin = end > RECENT_MESSAGES_CHUNK_SIZE
+                         ? end - RECENT_MESSAGES_CHUNK_SIZE
+                         : 0;
+        shared->addMessagesAtStart(std::vector<MessagePtr>(
+            messages->begin() + begin, messages->begin() + end));
+
+        if (begin == 0)
+        {
+            onDone();
+            return;
+        }
+
+        QTimer::singleShot(0, [weak = std::move(weak),
+                               messages = std::move(messages), begin,
+                               onDone = std::move(onDone)]() mutable {
+            addRecentMessagesInChunks(std::move(weak), std::move(messages),
+                                      begin, std::move(onDone));
+        });
+    }
 }  // namespace
 
 TwitchChannel::TwitchChannel(const QString &name)
@@ -92,6 +129,7 @@ TwitchChannel::TwitchChannel(const QString &name)
     , bttvEmotes_(std::make_shared<EmoteMap>())
     , ffzEmotes_(std::make_shared<EmoteMap>())
     , seventvEmotes_(std::make_shared<EmoteMap>())
+    , mergedEmotes_(std::make_shared<const MergedEmoteMap>())
 {
     qCDebug(chatterinoTwitch) << "[TwitchChannel" << name << "] Opened";
 
@@ -297,6 +335,7 @@ void TwitchChannel::refreshBTTVChannelEmotes(bool manualRefresh)
     if (!Settings::instance().enableBTTVChannelEmotes)
     {
         this->bttvEmotes_.set(EMPTY_EMOTE_MAP);
+        this->updateMergedEmotes(EmoteLayer::BttvChannel);
         return;
     }
 
@@ -316,6 +355,7 @@ void TwitchChannel::refreshFFZChannelEmotes(bool manualRefresh)
     if (!Settings::instance().enableFFZChannelEmotes)
     {
         this->ffzEmotes_.set(EMPTY_EMOTE_MAP);
+        this->updateMergedEmotes(EmoteLayer::FfzChannel);
         return;
     }
 
@@ -357,6 +397,7 @@ void TwitchChannel::refreshSevenTVChannelEmotes(bool manualRefresh)
     if (!Settings::instance().enableSevenTVChannelEmotes)
     {
         this->seventvEmotes_.set(EMPTY_EMOTE_MAP);
+        this->updateMergedEmotes(EmoteLayer::SeventvChannel);
         return;
     }
 
@@ -380,16 +421,19 @@ void TwitchChannel::refreshSevenTVChannelEmotes(bool manualRefresh)
 void TwitchChannel::setBttvEmotes(std::shared_ptr<const EmoteMap> &&map)
 {
     this->bttvEmotes_.set(std::move(map));
+    this->updateMergedEmotes(EmoteLayer::BttvChannel);
 }
 
 void TwitchChannel::setFfzEmotes(std::shared_ptr<const EmoteMap> &&map)
 {
     this->ffzEmotes_.set(std::move(map));
+    this->updateMergedEmotes(EmoteLayer::FfzChannel);
 }
 
 void TwitchChannel::setSeventvEmotes(std::shared_ptr<const EmoteMap> &&map)
 {
     this->seventvEmotes_.set(std::move(map));
+    this->updateMergedEmotes(EmoteLayer::SeventvChannel);
 }
 
 void TwitchChannel::addQueuedRedemption(const QString &rewardId,
@@ -884,6 +928,86 @@ std::shared_ptr<const EmoteMap> TwitchChannel::seventvEmotes() const
     return this->seventvEmotes_.get();
 }
 
+std::optional<MergedEmoteMap::Entry> TwitchChannel::resolveEmote(
+    const EmoteName &name) const
+{
+    auto merged = this->mergedEmotes();
+    const auto *entry = merged->find(name);
+    if (entry == nullptr)
+    {
+        return std::nullopt;
+    }
+    return *entry;
+}
+
+std::shared_ptr<const EmoteMap> TwitchChannel::channelEmoteLayer(
+    EmoteLayer layer) const
+{
+    switch (layer)
+    {
+        case EmoteLayer::FfzChannel:
+            return this->ffzEmotes_.get();
+        case EmoteLayer::BttvChannel:
+            return this->bttvEmotes_.get();
+        case EmoteLayer::SeventvChannel:
+            return this->seventvEmotes_.get();
+        default:
+            assert(false && "Global layers are updated in mergedEmotes()");
+            return EMPTY_EMOTE_MAP;
+    }
+}
+
+void TwitchChannel::updateMergedEmotes(EmoteLayer layer)
+{
+    // The map is read while holding the lock so concurrent updates can't
+    // apply an older map last
+    std::lock_guard lock(this->mergedEmotesMutex_);
+
+    this->mergedEmotes_.set(this->mergedEmotes_.get()->withLayers(
+        {{layer, this->channelEmoteLayer(layer)}}));
+}
+
+void TwitchChannel::updateMergedEmotes(EmoteLayer layer,
+                                       std::initializer_list<EmoteName> names)
+{
+    std::lock_guard lock(this->mergedEmotesMutex_);
+
+    this->mergedEmotes_.set(this->mergedEmotes_.get()->withEmotes(
+        layer, this->channelEmoteLayer(layer), names));
+}
+
+std::shared_ptr<const MergedEmoteMap> TwitchChannel::mergedEmotes() const
+{
+    auto merged = this->mergedEmotes_.get();
+    if (merged->globalsGeneration() == MergedEmoteMap::globalGeneration())
+    {
+        return merged;
+    }
+
+    std::lock_guard lock(this->mergedEmotesMutex_);
+    merged = this->mergedEmotes_.get();
+
+    // Read the generation before the maps, so a change that happens while
+    // they're read will cause another rebuild
+    auto generation = MergedEmoteMap::globalGeneration();
+    if (merged->globalsGeneration() == generation)
+    {
+        return merged;
+    }
+
+    auto *app = getIApp();
+    merged = merged->withGlobals(
+        {
+            {EmoteLayer::FfzGlobal, app->getFfzEmotes()->emotes()},
+            {EmoteLayer::BttvGlobal, app->getBttvEmotes()->emotes()},
+            {EmoteLayer::SeventvGlobal,
+             app->getSeventvEmotes()->globalEmotes()},
+        },
+        generation);
+    this->mergedEmotes_.set(merged);
+    return merged;
+}
+
 const QString &TwitchChannel::seventvUserID() const
 {
     return this->seventvUserID_;
@@ -914,6 +1038,7 @@ void TwitchChannel::addBttvEmote(
 {
     auto emote = BttvEmotes::addEmote(this->getDisplayName(), this->bttvEmotes_,
                                       message);
+    this->updateMergedEmotes(EmoteLayer::BttvChannel, {emote->name});
 
     this->addOrReplaceLiveUpdatesAddRemove(true, "BTTV", QString() /*actor*/,
                                            emote->name.string);
@@ -930,6 +1055,9 @@ void TwitchChannel::updateBttvEmote(
     }
 
     const auto [oldEmote, newEmote] = *updated;
+    this->updateMergedEmotes(EmoteLayer::BttvChannel,
+                             {oldEmote->name, newEmote->name});
+
     if (oldEmote->name == newEmote->name)
     {
         return;  // only the creator changed
@@ -949,6 +1077,7 @@ void TwitchChannel::removeBttvEmote(
     {
         return;
     }
+    this->updateMergedEmotes(EmoteLayer::BttvChannel, {(*removed)->name});
 
     this->addOrReplaceLiveUpdatesAddRemove(false, "BTTV", QString() /*actor*/,
                                            (*removed)->name.string);
@@ -957,10 +1086,12 @@ void TwitchChannel::removeBttvEmote(
 void TwitchChannel::addSeventvEmote(
     const seventv::eventapi::EmoteAddDispatch &dispatch)
 {
-    if (!SeventvEmotes::addEmote(this->seventvEmotes_, dispatch))
+    auto added = SeventvEmotes::addEmote(this->seventvEmotes_, dispatch);
+    if (!added)
     {
         return;
     }
+    this->updateMergedEmotes(EmoteLayer::SeventvChannel, {(*added)->name});
 
     this->addOrReplaceLiveUpdatesAddRemove(
         true, "7TV", dispatch.actorName, dispatch.emoteJson["name"].toString());
@@ -969,10 +1100,14 @@ void TwitchChannel::addSeventvEmote(
 void TwitchChannel::updateSeventvEmote(
     const seventv::eventapi::EmoteUpdateDispatch &dispatch)
 {
-    if (!SeventvEmotes::updateEmote(this->seventvEmotes_, dispatch))
+    auto updated = SeventvEmotes::updateEmote(this->seventvEmotes_, dispatch);
+    if (!updated)
     {
         return;
     }
+    this->updateMergedEmotes(EmoteLayer::SeventvChannel,
+                             {EmoteName{dispatch.oldEmoteName},
+                              EmoteName{dispatch.emoteName}, (*updated)->name});
 
     auto builder =
         MessageBuilder(liveUpdatesUpdateEmoteMessage, "7TV", dispatch.actorName,
@@ -988,6 +1123,7 @@ void TwitchChannel::removeSeventvEmote(
     {
         return;
     }
+    this->updateMergedEmotes(EmoteLayer::SeventvChannel, {(*removed)->name});
 
     this->addOrReplaceLiveUpdatesAddRemove(false, "7TV", dispatch.actorName,
                                            (*removed)->name.string);
@@ -1010,7 +1146,7 @@ void TwitchChannel::updateSeventvUser(
             postToThread([this, weak, dispatch, emotes, name]() {
                 if (auto shared = weak.lock())
                 {
-                    this->seventvEmotes_.set(
+                    this->setSeventvEmotes(
                         std::make_shared<EmoteMap>(emotes));
                     auto builder =
                         MessageBuilder(liveUpdatesUpdateEmoteSetMessage, "7TV",
@@ -1024,6 +1160,7 @@ void TwitchChannel::updateSeventvUser(
                 if (auto shared = weak.lock())
                 {
                     this->seventvEmotes_.set(EMPTY_EMOTE_MAP);
+                    this->updateMergedEmotes(EmoteLayer::SeventvChannel);
                     this->addMessage(makeSystemMessage(
                         QString("Failed updating 7TV emote set (%1).")
                             .arg(reason)));
@@ -1237,10 +1374,7 @@ void TwitchChannel::loadRecentMessages()
                 return;
             }
 
-            // getIApp()->getPronounDb()->getFromMessages(messages);
-            tc->addMessagesAtStart(messages);
-            tc->loadingRecentMessages_.clear();
-
+            getIApp()->getPronounDb()->getFromMessages(messages);
             std::vector<MessagePtr> msgs;
             for (const auto &msg : messages)
             {
@@ -1256,6 +1390,17 @@ void TwitchChannel::loadRecentMessages()
                 tc->addRecentChatter(msg->displayName);
             }
 
+            addRecentMessagesInChunks(
+                weak, std::make_shared<const std::vector<MessagePtr>>(messages),
+                messages.size(), [weak] {
+                    if (auto shared = weak.lock())
+                    {
+                        // Only allow reloading once all messages were added
+                        static_cast<TwitchChannel *>(shared.get())
+                            ->loadingRecentMessages_.clear();
+                    }
+                });
+
             getApp()->twitch->mentionsChannel->fillInMissingMessages(msgs);
         },
         [weak]() {
@@ -1320,7 +1465,7 @@ void TwitchChannel::loadRecentMessagesReconnect()
                 return;
             }
 
-            // getIApp()->getPronounDb()->getFromMessages(messages);
+            getIApp()->getPronounDb()->getFromMessages(messages);
             tc->fillInMissingMessages(messages);
             tc->loadingRecentMessages_.clear();
         },
@@ -6,6 +6,7 @@
 #include "common/ChannelChatters.hpp"
 #include "common/Common.hpp"
 #include "common/UniqueAccess.hpp"
+#include "messages/MergedEmoteMap.hpp"
 #include "providers/ffz/FfzBadges.hpp"
 #include "providers/ffz/FfzEmotes.hpp"
 #include "providers/twitch/TwitchEmotes.hpp"
@@ -164,6 +165,13 @@ public:
     std::shared_ptr<const EmoteMap> ffzEmotes() const;
     std::shared_ptr<const EmoteMap> seventvEmotes() const;
 
+    /**
+     * Resolves a FFZ, BTTV or 7TV emote (channel or global) usable in this
+     * channel with a single lookup. Personal 7TV emotes aren't included.
+     */
+    std::optional<MergedEmoteMap::Entry> resolveEmote(
+        const EmoteName &name) const;
+
     void refreshBTTVChannelEmotes(bool manualRefresh);
     void refreshFFZChannelEmotes(bool manualRefresh);
     void refreshSevenTVChannelEmotes(bool manualRefresh);
@@ -314,6 +322,18 @@ private:
     void cleanUpReplyThreads();
     void showLoginMessage();
 
+    /// Updates the merged emote map after the emote map of `layer` changed
+    void updateMergedEmotes(EmoteLayer layer);
+    /// Updates the merged emote map after the emotes called `names` changed
+    /// in the emote map of `layer`
+    void updateMergedEmotes(EmoteLayer layer,
+                            std::initializer_list<EmoteName> names);
+    /// Returns the current emote map of the channel layer `layer`
+    std::shared_ptr<const EmoteMap> channelEmoteLayer(EmoteLayer layer) const;
+    /// Returns the merged emote map, rebuilding its global layers if any
+    /// global emotes changed since it was built
+    std::shared_ptr<const MergedEmoteMap> mergedEmotes() const;
+
     /// roomIdChanged is called whenever this channel's ID has been changed
     /// This should only happen once per channel, whenever the ID goes from unset to set
     void roomIdChanged();
@@ -402,6 +422,9 @@ protected:
     Atomic<std::shared_ptr<const EmoteMap>> bttvEmotes_;
     Atomic<std::shared_ptr<const EmoteMap>> ffzEmotes_;
     Atomic<std::shared_ptr<const EmoteMap>> seventvEmotes_;
+    mutable Atomic<std::shared_ptr<const MergedEmoteMap>> mergedEmotes_;
+    // Serializes updates of mergedEmotes_, lookups don't lock
+    mutable std::mutex mergedEmotesMutex_;
     Atomic<std::optional<EmotePtr>> ffzCustomModBadge_;
     Atomic<std::optional<EmotePtr>> ffzCustomVipBadge_;
 
@@ -270,7 +270,8 @@ namespace {
         }
 
         builder->message().badges = badges;
-        builder->message().badgeInfos = badgeInfos;
+        builder->message().badgeInfos =
+            BadgeInfos(badgeInfos.begin(), badgeInfos.end());
     }
 
     /**
@@ -413,6 +414,16 @@ TwitchMessageBuilder::TwitchMessageBuilder(
 {
 }
 
+TwitchMessageBuilder::TwitchMessageBuilder(Channel *_channel,
+                                           IrcTags _tags, QString nick,
+                                           const MessageParseArgs &_args,
+                                           QString content, bool isAction)
+    : SharedMessageBuilder(_channel, std::move(_tags), std::move(nick), _args,
+                           std::move(content), isAction)
+    , twitchChannel(dynamic_cast<TwitchChannel *>(_channel))
+{
+}
+
 bool TwitchMessageBuilder::isIgnored() const
 {
     return isIgnoredMessage({
@@ -447,11 +458,10 @@ void TwitchMessageBuilder::triggerHighlights()
 
 MessagePtr TwitchMessageBuilder::build()
 {
-    assert(this->ircMessage != nullptr);
     assert(this->channel != nullptr);
 
     // PARSE
-    this->userId_ = this->ircMessage->tag("user-id").toString();
+    this->userId_ = this->tags.value("user-id").toString();
 
     this->parse();
 
@@ -489,14 +499,14 @@ MessagePtr TwitchMessageBuilder::build()
     this->historicalMessage_ = this->tags.contains("historical");
 
     if (this->tags.contains("msg-id") &&
-        this->tags["msg-id"].toString().split(';').contains(
+        this->tags.value("msg-id").toString().split(';').contains(
             "highlighted-message"))
     {
         this->message().flags.set(MessageFlag::RedeemedHighlight);
     }
 
     if (this->tags.contains("first-msg") &&
-        this->tags["first-msg"].toString() == "1")
+        this->tags.value("first-msg").toString() == "1")
     {
         this->message().flags.set(MessageFlag::FirstMessage);
     }
@@ -515,7 +525,7 @@ MessagePtr TwitchMessageBuilder::build()
     this->parseThread();
 
     // timestamp
-    this->message().serverReceivedTime = calculateMessageTime(this->ircMessage);
+    this->message().serverReceivedTime = calculateMessageTime(this->tags);
     this->emplace<TimestampElement>(this->message().serverReceivedTime.time());
 
     if (this->shouldAddModerationElements())
@@ -532,12 +542,11 @@ MessagePtr TwitchMessageBuilder::build()
     this->appendUsername();
 
     //    QString bits;
-    auto iterator = this->tags.find("bits");
-    if (iterator != this->tags.end())
+    if (auto bitsTag = this->tags.value("bits"); bitsTag.isValid())
     {
         this->hasBits_ = true;
-        this->bitsLeft = iterator.value().toInt();
-        this->bits = iterator.value().toString();
+        this->bitsLeft = bitsTag.toInt();
+        this->bits = bitsTag.toString();
     }
 
     // Twitch emotes
@@ -824,11 +833,9 @@ void TwitchMessageBuilder::addTextOrEmoji(const QString &string_)
 
 void TwitchMessageBuilder::parseMessageID()
 {
-    auto iterator = this->tags.find("id");
-
-    if (iterator != this->tags.end())
+    if (auto id = this->tags.value("id"); id.isValid())
     {
-        this->message().id = iterator.value().toString();
+        this->message().id = id.toString();
     }
 }
 
@@ -839,11 +846,9 @@ void TwitchMessageBuilder::parseRoomID()
         return;
     }
 
-    auto iterator = this->tags.find("room-id");
-
-    if (iterator != std::end(this->tags))
+    if (auto roomID = this->tags.value("room-id"); roomID.isValid())
     {
-        this->roomID_ = iterator.value().toString();
+        this->roomID_ = roomID.toString();
 
         if (this->twitchChannel->roomId().isEmpty())
         {
@@ -904,16 +909,15 @@ void TwitchMessageBuilder::parseThread()
                 color, FontStyle::ChatMediumSmall)
             ->setLink({Link::ViewThread, this->thread_->rootId()});
     }
-    else if (this->tags.find("reply-parent-msg-id") != this->tags.end())
+    else if (this->tags.contains("reply-parent-msg-id"))
     {
         // Message is a reply but we couldn't find the original message.
         // Render the message using the additional reply tags
 
-        auto replyDisplayName = this->tags.find("reply-parent-display-name");
-        auto replyBody = this->tags.find("reply-parent-msg-body");
+        auto replyDisplayName = this->tags.value("reply-parent-display-name");
+        auto replyBody = this->tags.value("reply-parent-msg-body");
 
-        if (replyDisplayName != this->tags.end() &&
-            replyBody != this->tags.end())
+        if (replyDisplayName.isValid() && replyBody.isValid())
         {
             QString body;
 
@@ -928,8 +932,8 @@ void TwitchMessageBuilder::parseThread()
             }
             else
             {
-                auto name = replyDisplayName->toString();
-                body = parseTagString(replyBody->toString());
+                auto name = replyDisplayName.toString();
+                body = parseTagString(replyBody.toString());
 
                 this->emplace<TextElement>(
                         "@" + name + ":", MessageElementFlag::RepliedMessage,
@@ -960,15 +964,12 @@ void TwitchMessageBuilder::parseUsernameColor()
         }
     }
 
-    const auto iterator = this->tags.find("color");
-    if (iterator != this->tags.end())
+    if (const auto color = this->tags.value("color").toString();
+        !color.isEmpty())
     {
-        if (const auto color = iterator.value().toString(); !color.isEmpty())
-        {
-            this->usernameColor_ = QColor(color);
-            this->message().usernameColor = this->usernameColor_;
-            return;
-        }
+        this->usernameColor_ = QColor(color);
+        this->message().usernameColor = this->usernameColor_;
+        return;
     }
 
     if (getSettings()->colorizeNicknames && this->tags.contains("user-id"))
@@ -985,7 +986,7 @@ void TwitchMessageBuilder::parseUsername()
 
     if (this->userName.isEmpty() || this->args.trimSubscriberUsername)
     {
-        this->userName = this->tags.value(QLatin1String("login")).toString();
+        this->userName = this->tags.value("login").toString();
     }
 
     // display name
@@ -1003,7 +1004,7 @@ void TwitchMessageBuilder::parseUsername()
 
     // Update current user color if this is our message
     auto currentUser = getIApp()->getAccounts()->twitch.getCurrent();
-    if (this->ircMessage->nick() == currentUser->getUserName())
+    if (this->nick_ == currentUser->getUserName())
     {
         currentUser->setColor(this->usernameColor_);
     }
@@ -1017,11 +1018,10 @@ void TwitchMessageBuilder::appendUsername()
     this->message().loginName = username;
     QString localizedName;
 
-    auto iterator = this->tags.find("display-name");
-    if (iterator != this->tags.end())
+    if (auto displayNameTag = this->tags.value("display-name");
+        displayNameTag.isValid())
     {
-        QString displayName =
-            parseTagString(iterator.value().toString()).trimmed();
+        QString displayName = parseTagString(displayNameTag.toString()).trimmed();
 
         if (QString::compare(displayName, this->userName,
                              Qt::CaseInsensitive) == 0)
@@ -1041,8 +1041,8 @@ void TwitchMessageBuilder::appendUsername()
 
     if (!this->args.isSentWhisper) {
         // Try getting the user's pronouns.
-        auto pronouns = app->getPronounDb()->getPronounsForUsername(this->message().loginName.toStdString());
-        if (pronouns && *pronouns != "unspecified") {
+        auto pronouns = app->getPronounDb()->getPronounsForUsername(this->message().loginName);
+        if (pronouns) {
             QString pronounsText;
             pronounsText += "(" + *pronouns + ")";
             /* this->emplace<TextElement>(pronounsText, MessageElementFlag::Username,
@@ -1111,8 +1111,8 @@ void TwitchMessageBuilder::appendPronouns()
     QString username = this->userName;
 
     // Try getting the user's pronouns.
-    auto pronouns = app->getPronounDb()->getPronounsForUsername(username.toStdString());
-    if (!pronouns || *pronouns == "unspecified") {
+    auto pronouns = app->getPronounDb()->getPronounsForUsername(username);
+    if (!pronouns) {
         return;
     }
 
@@ -1330,27 +1330,39 @@ Outcome TwitchMessageBuilder::tryAppendEmote(const EmoteName &name)
     //  - FrankerFaceZ Global
     //  - BetterTTV Global
     //  - 7TV Global
+    // Everything after personal emotes is resolved by the channel's merged
+    // emote map (see EmoteLayer).
     if (this->twitchChannel != nullptr &&
         (emote = app->getSeventvPersonalEmotes()->getEmoteForUser(this->userId_,
                                                                   name)))
     {
         flags = MessageElementFlag::SevenTVEmote;
     }
-    else if (this->twitchChannel &&
-             (emote = this->twitchChannel->ffzEmote(name)))
-    {
-        flags = MessageElementFlag::FfzEmote;
-    }
-    else if (this->twitchChannel &&
-             (emote = this->twitchChannel->bttvEmote(name)))
+    else if (this->twitchChannel != nullptr)
     {
-        flags = MessageElementFlag::BttvEmote;
-    }
-    else if (this->twitchChannel != nullptr &&
-             (emote = this->twitchChannel->seventvEmote(name)))
-    {
-        flags = MessageElementFlag::SevenTVEmote;
-        zeroWidth = emote.value()->zeroWidth;
+        if (auto resolved = this->twitchChannel->resolveEmote(name))
+        {
+            emote = resolved->emote;
+            switch (resolved->layer)
+            {
+                case EmoteLayer::FfzChannel:
+                case EmoteLayer::FfzGlobal:
+                    flags = MessageElementFlag::FfzEmote;
+                    break;
+                case EmoteLayer::BttvChannel:
+                    flags = MessageElementFlag::BttvEmote;
+                    break;
+                case EmoteLayer::BttvGlobal:
+                    flags = MessageElementFlag::BttvEmote;
+                    zeroWidth = zeroWidthEmotes.contains(name.string);
+                    break;
+                case EmoteLayer::SeventvChannel:
+                case EmoteLayer::SeventvGlobal:
+                    flags = MessageElementFlag::SevenTVEmote;
+                    zeroWidth = resolved->emote->zeroWidth;
+                    break;
+            }
+        }
     }
     else if ((emote = globalFfzEmotes->emote(name)))
     {
@@ -1409,17 +1421,17 @@ Outcome TwitchMessageBuilder::tryAppendEmote(const EmoteName &name)
 }
 
 std::unordered_map<QString, QString> TwitchMessageBuilder::parseBadgeInfoTag(
-    const QVariantMap &tags)
+    const IrcTags &tags)
 {
     std::unordered_map<QString, QString> infoMap;
 
-    auto infoIt = tags.constFind("badge-info");
-    if (infoIt == tags.end())
+    auto infoTag = tags.value("badge-info");
+    if (!infoTag.isValid())
     {
         return infoMap;
     }
 
-    auto info = infoIt.value().toString().split(',', Qt::SkipEmptyParts);
+    auto info = infoTag.toString().split(',', Qt::SkipEmptyParts);
 
     for (const QString &badge : info)
     {
@@ -1430,19 +1442,19 @@ std::unordered_map<QString, QString> TwitchMessageBuilder::parseBadgeInfoTag(
 }
 
 std::vector<TwitchEmoteOccurrence> TwitchMessageBuilder::parseTwitchEmotes(
-    const QVariantMap &tags, const QString &originalMessage, int messageOffset)
+    const IrcTags &tags, const QString &originalMessage, int messageOffset)
 {
     // Twitch emotes
     std::vector<TwitchEmoteOccurrence> twitchEmotes;
 
-    auto emotesTag = tags.find("emotes");
+    auto emotesTag = tags.value("emotes");
 
-    if (emotesTag == tags.end())
+    if (!emotesTag.isValid())
     {
         return twitchEmotes;
     }
 
-    QStringList emoteString = emotesTag.value().toString().split('/');
+    QStringList emoteString = emotesTag.toString().split('/');
     std::vector<int> correctPositions;
     for (int i = 0; i < originalMessage.size(); ++i)
     {
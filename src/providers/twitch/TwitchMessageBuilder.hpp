@@ -51,6 +51,10 @@ public:
                                   const Communi::IrcMessage *_ircMessage,
                                   const MessageParseArgs &_args,
                                   QString content, bool isAction);
+    /// Builds a message that wasn't parsed by Communi (see IrcLine)
+    explicit TwitchMessageBuilder(Channel *_channel, IrcTags _tags,
+                                  QString nick, const MessageParseArgs &_args,
+                                  QString content, bool isAction);
 
     TwitchChannel *twitchChannel;
 
@@ -103,10 +107,10 @@ public:
 
     // Shares some common logic from SharedMessageBuilder::parseBadgeTag
     static std::unordered_map<QString, QString> parseBadgeInfoTag(
-        const QVariantMap &tags);
+        const IrcTags &tags);
 
     static std::vector<TwitchEmoteOccurrence> parseTwitchEmotes(
-        const QVariantMap &tags, const QString &originalMessage,
+        const IrcTags &tags, const QString &originalMessage,
         int messageOffset);
 
     static void processIgnorePhrases(
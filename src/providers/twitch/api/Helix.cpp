@@ -908,7 +908,8 @@ void Helix::deleteChatMessages(
     }
 
     this->makeDelete("moderation/chat", urlQuery)
-        .onSuccess([successCallback, failureCallback](auto result) {
+        .onSuccess([this, successCallback, failureCallback](auto result) {
+            this->updateRatelimit(result);
             if (result.status() != 204)
             {
                 qCWarning(chatterinoTwitch)
@@ -919,7 +920,8 @@ void Helix::deleteChatMessages(
 
             successCallback();
         })
-        .onError([failureCallback](const auto &result) -> void {
+        .onError([this, failureCallback](const auto &result) -> void {
+            this->updateRatelimit(result);
             if (!result.status())
             {
                 failureCallback(Error::Unknown, result.formatError());
@@ -968,6 +970,11 @@ void Helix::deleteChatMessages(
                 }
                 break;
 
+                case 429: {
+                    failureCallback(Error::Ratelimited, message);
+                }
+                break;
+
                 default: {
                     qCDebug(chatterinoTwitch)
                         << "Unhandled error deleting chat messages:"
@@ -1431,7 +1438,8 @@ void Helix::unbanUser(
     urlQuery.addQueryItem("user_id", userID);
 
     this->makeDelete("moderation/bans", urlQuery)
-        .onSuccess([successCallback, failureCallback](auto result) {
+        .onSuccess([this, successCallback, failureCallback](auto result) {
+            this->updateRatelimit(result);
             if (result.status() != 204)
             {
                 qCWarning(chatterinoTwitch)
@@ -1442,7 +1450,8 @@ void Helix::unbanUser(
 
             successCallback();
         })
-        .onError([failureCallback](const auto &result) -> void {
+        .onError([this, failureCallback](const auto &result) -> void {
+            this->updateRatelimit(result);
             if (!result.status())
             {
                 failureCallback(Error::Unknown, result.formatError());
@@ -2126,7 +2135,8 @@ void Helix::banUser(QString broadcasterID, QString moderatorID, QString userID,
 
     this->makePost("moderation/bans", urlQuery)
         .json(payload)
-        .onSuccess([successCallback](auto result) {
+        .onSuccess([this, successCallback](auto result) {
+            this->updateRatelimit(result);
             if (result.status() != 200)
             {
                 qCWarning(chatterinoTwitch)
@@ -2136,7 +2146,8 @@ void Helix::banUser(QString broadcasterID, QString moderatorID, QString userID,
             // we don't care about the response
             successCallback();
         })
-        .onError([failureCallback](const auto &result) -> void {
+        .onError([this, failureCallback](const auto &result) -> void {
+            this->updateRatelimit(result);
             if (!result.status())
             {
                 failureCallback(Error::Unknown, result.formatError());
@@ -3035,6 +3046,27 @@ void Helix::paginate(const QString &url, const QUrlQuery &baseQuery,
         .execute();
 }
 
+void Helix::updateRatelimit(const NetworkResult &result)
+{
+    bool remainingOk = false;
+    bool resetOk = false;
+    auto remaining =
+        result.rawHeader("Ratelimit-Remaining").toInt(&remainingOk);
+    auto reset = result.rawHeader("Ratelimit-Reset").toLongLong(&resetOk);
+    if (!remainingOk || !resetOk)
+    {
+        return;
+    }
+
+    this->ratelimit_.remaining = remaining;
+    this->ratelimit_.reset = QDateTime::fromSecsSinceEpoch(reset);
+}
+
+HelixRatelimit Helix::ratelimit() const
+{
+    return this->ratelimit_;
+}
+
 void Helix::update(QString clientId, QString oauthToken)
 {
     this->clientId = std::move(clientId);
@@ -492,6 +492,7 @@ enum class HelixDeleteChatMessagesError {
     UserNotAuthenticated,
     UserNotAuthorized,
     MessageUnavailable,
+    Ratelimited,
 
     // The error message is forwarded directly from the Twitch API
     Forwarded,
@@ -762,6 +763,16 @@ struct HelixError {
 
 using HelixGetChannelBadgesError = HelixGetGlobalBadgesError;
 
+/// The user's Helix rate limit bucket, as reported by the Ratelimit-Remaining
+/// and Ratelimit-Reset headers of the last moderation response
+/// https://dev.twitch.tv/docs/api/guide#twitch-rate-limits
+struct HelixRatelimit {
+    /// Points left in the bucket or std::nullopt if no response was seen yet
+    std::optional<int> remaining;
+    /// When the bucket is refilled
+    QDateTime reset;
+};
+
 class IHelix
 {
 public:
@@ -1081,6 +1092,10 @@ public:
         ResultCallback<HelixSentMessage> successCallback,
         FailureCallback<HelixSendMessageError, QString> failureCallback) = 0;
 
+    /// The rate limit state reported by the last ban, unban or message
+    /// deletion response
+    virtual HelixRatelimit ratelimit() const = 0;
+
     virtual void update(QString clientId, QString oauthToken) = 0;
 
 protected:
@@ -1401,6 +1416,8 @@ public:
         ResultCallback<HelixSentMessage> successCallback,
         FailureCallback<HelixSendMessageError, QString> failureCallback) final;
 
+    HelixRatelimit ratelimit() const final;
+
     void update(QString clientId, QString oauthToken) final;
 
     static void initialize();
@@ -1459,8 +1476,12 @@ private:
                   std::function<void(NetworkResult)> onError,
                   CancellationToken &&token);
 
+    /// Remembers the Ratelimit-* headers of @a result if it has them
+    void updateRatelimit(const NetworkResult &result);
+
     QString clientId;
     QString oauthToken;
+    HelixRatelimit ratelimit_;
 };
 
 // initializeHelix sets the helix instance to _instance
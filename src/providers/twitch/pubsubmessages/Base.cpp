@@ -1,33 +1,91 @@
 #include "providers/twitch/pubsubmessages/Base.hpp"
 
+#include "common/QLogging.hpp"
 #include "util/QMagicEnum.hpp"
+#include "util/RapidjsonHelpers.hpp"
 
-namespace chatterino {
+#include <QByteArray>
+#include <QJsonDocument>
+#include <rapidjson/document.h>
+
+namespace {
 
-PubSubMessage::PubSubMessage(QJsonObject _object)
+using namespace chatterino;
 
-    : object(std::move(_object))
-    , nonce(this->object.value("nonce").toString())
-    , error(this->object.value("error").toString())
-    , typeString(this->object.value("type").toString())
+PubSubMessageMessage parseMessageData(const QString &nonce,
+                                      const rapidjson::Value &data)
 {
-    auto oType = qmagicenum::enumCast<Type>(this->typeString);
-    if (oType.has_value())
+    PubSubMessageMessage message(nonce, rj::getString(data, "topic"));
+
+    // The payload is JSON inside a string, which rapidjson already
+    // unescaped, so it can be parsed straight from the outer document.
+    // The typed messages read a QJsonObject, so it's parsed into one
+    // directly instead of converting a rapidjson document.
+    auto payload = data.FindMember("message");
+    if (payload == data.MemberEnd() || !payload->value.IsString())
+    {
+        qCWarning(chatterinoPubSub) << "PubSub message (type MESSAGE) "
+                                       "missing inner message payload";
+        return message;
+    }
+
+    auto inner = QJsonDocument::fromJson(QByteArray::fromRawData(
+        payload->value.GetString(),
+        static_cast<qsizetype>(payload->value.GetStringLength())));
+    if (inner.isNull())
     {
-        this->type = oType.value();
+        qCWarning(chatterinoPubSub) << "PubSub message (type MESSAGE) inner "
+                                       "message payload is not valid JSON";
+        return message;
     }
+
+    if (!inner.isObject())
+    {
+        qCWarning(chatterinoPubSub)
+            << "PubSub message (type MESSAGE) inner message payload is not "
+               "an object";
+        return message;
+    }
+
+    message.messageObject = inner.object();
+    return message;
 }
 
-std::optional<PubSubMessage> parsePubSubBaseMessage(const QString &blob)
+}  // namespace
+
+namespace chatterino {
+
+std::optional<PubSubMessage> parsePubSubBaseMessage(std::string_view payload)
 {
-    QJsonDocument jsonDoc(QJsonDocument::fromJson(blob.toUtf8()));
+    rapidjson::Document document;
+    document.Parse(payload.data(), payload.size());
 
-    if (jsonDoc.isNull())
+    if (document.HasParseError() || !document.IsObject())
     {
         return std::nullopt;
     }
 
-    return PubSubMessage(jsonDoc.object());
+    PubSubMessage message;
+    message.nonce = rj::getString(document, "nonce");
+    message.error = rj::getString(document, "error");
+    message.typeString = rj::getString(document, "type");
+    message.type = qmagicenum::enumCast<PubSubMessage::Type>(message.typeString)
+                       .value_or(PubSubMessage::Type::INVALID);
+
+    auto data = document.FindMember("data");
+    if (data != document.MemberEnd() && data->value.IsObject())
+    {
+        message.data = parseMessageData(message.nonce, data->value);
+    }
+
+    return message;
+}
+
+std::optional<PubSubMessage> parsePubSubBaseMessage(const QString &blob)
+{
+    auto utf8 = blob.toUtf8();
+    return parsePubSubBaseMessage(
+        std::string_view(utf8.constData(), size_t(utf8.size())));
 }
 
 }  // namespace chatterino
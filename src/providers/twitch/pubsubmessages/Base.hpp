@@ -1,11 +1,12 @@
 #pragma once
 
+#include "providers/twitch/pubsubmessages/Message.hpp"
+
 #include <magic_enum/magic_enum.hpp>
-#include <QJsonDocument>
-#include <QJsonObject>
 #include <QString>
 
 #include <optional>
+#include <string_view>
 
 namespace chatterino {
 
@@ -18,33 +19,20 @@ struct PubSubMessage {
         INVALID,
     };
 
-    QJsonObject object;
-
     QString nonce;
     QString error;
     QString typeString;
-    Type type;
-
-    PubSubMessage(QJsonObject _object);
+    Type type = Type::INVALID;
 
-    template <class InnerClass>
-    std::optional<InnerClass> toInner();
+    /// The topic and decoded payload of MESSAGE messages, std::nullopt if
+    /// the message has no `data` object
+    std::optional<PubSubMessageMessage> data;
 };
 
-template <class InnerClass>
-std::optional<InnerClass> PubSubMessage::toInner()
-{
-    auto dataValue = this->object.value("data");
-    if (!dataValue.isObject())
-    {
-        return std::nullopt;
-    }
-
-    auto data = dataValue.toObject();
-
-    return InnerClass{this->nonce, data};
-}
-
+/// Decodes a PubSub message including the payload of MESSAGE messages,
+/// which is sent as a string containing JSON.
+/// `payload` is the UTF-8 encoded message as received from the websocket.
+std::optional<PubSubMessage> parsePubSubBaseMessage(std::string_view payload);
 std::optional<PubSubMessage> parsePubSubBaseMessage(const QString &blob);
 
 }  // namespace chatterino
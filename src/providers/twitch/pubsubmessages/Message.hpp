@@ -1,8 +1,5 @@
 #pragma once
 
-#include "common/QLogging.hpp"
-
-#include <QJsonDocument>
 #include <QJsonObject>
 #include <QString>
 
@@ -14,32 +11,13 @@ struct PubSubMessageMessage {
     QString nonce;
     QString topic;
 
+    /// Empty if the payload is missing or isn't an object
     QJsonObject messageObject;
 
-    PubSubMessageMessage(QString _nonce, const QJsonObject &data)
+    PubSubMessageMessage(QString _nonce, QString _topic)
         : nonce(std::move(_nonce))
-        , topic(data.value("topic").toString())
+        , topic(std::move(_topic))
     {
-        auto messagePayload = data.value("message").toString().toUtf8();
-
-        auto messageDoc = QJsonDocument::fromJson(messagePayload);
-
-        if (messageDoc.isNull())
-        {
-            qCWarning(chatterinoPubSub) << "PubSub message (type MESSAGE) "
-                                           "missing inner message payload";
-            return;
-        }
-
-        if (!messageDoc.isObject())
-        {
-            qCWarning(chatterinoPubSub)
-                << "PubSub message (type MESSAGE) inner message payload is not "
-                   "an object";
-            return;
-        }
-
-        this->messageObject = messageDoc.object();
     }
 
     template <class InnerClass>
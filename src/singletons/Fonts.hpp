@@ -46,6 +46,9 @@ public:
     QFont getFont(FontStyle type, float scale);
     QFontMetrics getFontMetrics(FontStyle type, float scale);
 
+    /// Incremented whenever the fonts change, before fontChanged is invoked
+    int getGeneration() const;
+
     pajlada::Signals::NoArgSignal fontChanged;
 
 private:
@@ -77,6 +80,7 @@ private:
     FontData createFontData(FontStyle type, float scale);
 
     std::vector<std::unordered_map<float, FontData>> fontsByType_;
+    int generation_ = 0;
 
     pajlada::SettingListener fontChangedListener;
 };
@@ -1,6 +1,7 @@
 #include "singletons/Logging.hpp"
 
 #include "singletons/helper/LoggingChannel.hpp"
+#include "singletons/helper/LogWriter.hpp"
 #include "singletons/Paths.hpp"
 #include "singletons/Settings.hpp"
 
@@ -13,7 +14,16 @@
 namespace chatterino {
 
 Logging::Logging(Settings &settings)
+    : writer_(std::make_unique<LogWriter>())
 {
+    // NOTE: SETTINGS_LIFETIME
+    settings.logFlushInterval.connect([this](const int &interval, auto) {
+        this->writer_->setFlushInterval(std::chrono::milliseconds(interval));
+    });
+    settings.logFlushThreshold.connect([this](const int &threshold, auto) {
+        this->writer_->setFlushThreshold(threshold);
+    });
+
     // We can safely ignore this signal connection since settings are only-ever destroyed
     // on application exit
     // NOTE: SETTINGS_LIFETIME
@@ -31,6 +41,17 @@ Logging::Logging(Settings &settings)
         });
 }
 
+Logging::~Logging() = default;
+
+void Logging::flushAll()
+{
+    this->threadGuard.guard();
+
+    // Queues the closing lines of every channel
+    this->loggingChannels_.clear();
+    this->writer_->stop();
+}
+
 void Logging::addMessage(const QString &channelName, MessagePtr message,
                          const QString &platformName)
 {
@@ -52,7 +73,8 @@ void Logging::addMessage(const QString &channelName, MessagePtr message,
     auto platIt = this->loggingChannels_.find(platformName);
     if (platIt == this->loggingChannels_.end())
     {
-        auto *channel = new LoggingChannel(channelName, platformName);
+        auto *channel = new LoggingChannel(channelName, platformName,
+                                           *this->writer_);
         channel->addMessage(message);
         auto map = std::map<QString, std::unique_ptr<LoggingChannel>>();
         this->loggingChannels_[platformName] = std::move(map);
@@ -63,7 +85,8 @@ void Logging::addMessage(const QString &channelName, MessagePtr message,
     auto chanIt = platIt->second.find(channelName);
     if (chanIt == platIt->second.end())
     {
-        auto *channel = new LoggingChannel(channelName, platformName);
+        auto *channel = new LoggingChannel(channelName, platformName,
+                                           *this->writer_);
         channel->addMessage(message);
         platIt->second.emplace(channelName, std::move(channel));
     }
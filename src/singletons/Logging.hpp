@@ -15,16 +15,27 @@ class Settings;
 struct Message;
 using MessagePtr = std::shared_ptr<const Message>;
 class LoggingChannel;
+class LogWriter;
 
 class Logging
 {
 public:
     Logging(Settings &settings);
+    ~Logging();
 
     void addMessage(const QString &channelName, MessagePtr message,
                     const QString &platformName);
 
+    /// Closes all logs and waits until everything was written. Messages
+    /// added afterwards aren't logged. Used on exit, where the Logging isn't
+    /// destroyed.
+    void flushAll();
+
 private:
+    // Declared first so it outlives the channels, which write their closing
+    // lines when they're destroyed
+    std::unique_ptr<LogWriter> writer_;
+
     using PlatformName = QString;
     using ChannelName = QString;
     std::map<PlatformName,
@@ -8,13 +8,19 @@
 #include "controllers/ignores/IgnorePhrase.hpp"
 #include "controllers/moderationactions/ModerationAction.hpp"
 #include "controllers/nicknames/Nickname.hpp"
+#include "common/QLogging.hpp"
+#include "debug/AssertInGuiThread.hpp"
 #include "debug/Benchmark.hpp"
 #include "pajlada/settings/signalargs.hpp"
+#include "util/BackgroundSaver.hpp"
+#include "util/BinarySnapshot.hpp"
 #include "util/Clamp.hpp"
 #include "util/PersistSignalVector.hpp"
 #include "util/WindowsHelper.hpp"
 
 #include <pajlada/signals/scoped-connection.hpp>
+#include <QFile>
+#include <rapidjson/pointer.h>
 
 namespace {
 
@@ -37,6 +43,10 @@ void initializeSignalVector(pajlada::Signals::SignalHolder &signalHolder,
     });
 }
 
+/// Number of previous settings files the settings library keeps as
+/// "settings.json.bkp-<n>"
+constexpr int BACKUP_SLOTS = 9;
+
 }  // namespace
 
 namespace chatterino {
@@ -145,15 +155,19 @@ Settings *Settings::instance_ = nullptr;
 Settings::Settings(const QString &settingsDirectory)
     : prevInstance_(Settings::instance_)
 {
-    QString settingsPath = settingsDirectory + "/settings.json";
+    this->settingsPath_ = settingsDirectory + "/settings.json";
+    this->binaryPath_ = settingsDirectory + "/settings.bin";
 
     // get global instance of the settings library
     auto settingsInstance = pajlada::Settings::SettingManager::getInstance();
 
-    settingsInstance->load(qPrintable(settingsPath));
+    if (!this->loadBinarySnapshot())
+    {
+        settingsInstance->load(qPrintable(this->settingsPath_));
+    }
 
     settingsInstance->setBackupEnabled(true);
-    settingsInstance->setBackupSlots(9);
+    settingsInstance->setBackupSlots(BACKUP_SLOTS);
     settingsInstance->saveMethod =
         pajlada::Settings::SettingManager::SaveMethod::SaveOnExit;
 
@@ -273,6 +287,91 @@ void Settings::restoreSnapshot()
     }
 }
 
+bool Settings::loadBinarySnapshot()
+{
+    BenchmarkGuard benchmark("Settings::loadBinarySnapshot");
+
+    rapidjson::Document document;
+    if (!readBinarySnapshot(this->binaryPath_,
+                            SnapshotSource::of(this->settingsPath_),
+                            document) ||
+        !document.IsObject())
+    {
+        return false;
+    }
+
+    auto settingsInstance = pajlada::Settings::SettingManager::getInstance();
+    settingsInstance->setPath(qPrintable(this->settingsPath_));
+
+    // Settings constructed before the document is loaded have to be told
+    // about their values, like a JSON load would
+    for (const auto &weakSetting : _settings)
+    {
+        auto setting = weakSetting.lock();
+        if (!setting)
+        {
+            continue;
+        }
+
+        const auto *value =
+            rapidjson::Pointer(setting->getPath().c_str()).Get(document);
+        if (value != nullptr)
+        {
+            setting->marshalJSON(*value, pajlada::Settings::SignalArgs());
+        }
+    }
+
+    for (auto &member : document.GetObject())
+    {
+        auto path = std::string("/") + member.name.GetString();
+        settingsInstance->set(path.c_str(), std::move(member.value));
+    }
+
+    qCDebug(chatterinoSettings) << "Loaded settings from" << this->binaryPath_;
+    return true;
+}
+
+void Settings::requestSave()
+{
+    // Settings are only changed on the GUI thread, so they're written and
+    // encoded here. Only writing the binary copy happens in the background.
+    assertInGuiThread();
+
+    // The settings library writes settings.json and rotates its backups
+    pajlada::Settings::SettingManager::gSave();
+
+    if (!this->binarySettingsSnapshot)
+    {
+        BackgroundSaver::instance().run(
+            this->binaryPath_, [binaryPath = this->binaryPath_] {
+                QFile::remove(binaryPath);
+            });
+        return;
+    }
+
+    const auto *root =
+        pajlada::Settings::SettingManager::getInstance()->get("");
+    if (root == nullptr)
+    {
+        return;
+    }
+
+    // The binary copy is stamped with the JSON file that was just written
+    BackgroundSaver::instance().run(
+        this->binaryPath_,
+        [binaryPath = this->binaryPath_,
+         data = encodeBinarySnapshot(*root,
+                                     SnapshotSource::of(this->settingsPath_))] {
+            writeFileAtomically(binaryPath, data);
+        });
+}
+
+void Settings::save()
+{
+    this->requestSave();
+    BackgroundSaver::instance().flush();
+}
+
 float Settings::getClampedUiScale() const
 {
     return clamp<float>(this->uiScale.getValue(), 0.2f, 10);
@@ -102,6 +102,12 @@ public:
     void saveSnapshot();
     void restoreSnapshot();
 
+    /// Saves the settings, their binary snapshot is written on a
+    /// background thread
+    void requestSave();
+    /// Saves the settings and waits until all queued saves were written
+    void save();
+
     FloatSetting uiScale = {"/appearance/uiScale2", 1};
     BoolSetting windowTopMost = {"/appearance/windowAlwaysOnTop", false};
 
@@ -473,6 +479,10 @@ public:
                                          false};
 
     QStringSetting logPath = {"/logging/path", ""};
+    /// Interval in milliseconds in which queued log lines are written
+    IntSetting logFlushInterval = {"/logging/flushInterval", 1000};
+    /// Number of queued bytes after which log lines are written immediately
+    IntSetting logFlushThreshold = {"/logging/flushThreshold", 64 * 1024};
 
     QStringSetting pathHighlightSound = {"/highlighting/highlightSoundPath",
                                          ""};
@@ -584,6 +594,13 @@ public:
         ThumbnailPreviewMode::AlwaysShow,
     };
     QStringSetting cachePath = {"/cache/path", ""};
+    /// Disk budget of the decoded image cache in MiB, 0 disables it
+    IntSetting imageCacheBudgetMb = {"/cache/imageBudgetMb", 512};
+    BoolSetting useImageAtlas = {"/misc/useImageAtlas", false};
+    /// Also keeps binary copies of the settings and the window layout, which
+    /// are used at startup as long as the JSON files weren't changed
+    BoolSetting binarySettingsSnapshot = {"/misc/binarySettingsSnapshot",
+                                          false};
     BoolSetting attachExtensionToAnyProcess = {
         "/misc/attachExtensionToAnyProcess", false};
     BoolSetting askOnImageUpload = {"/misc/askOnImageUpload", true};
@@ -594,6 +611,7 @@ public:
     /// Debug
     BoolSetting showUnhandledIrcMessages = {"/debug/showUnhandledIrcMessages",
                                             false};
+    BoolSetting showPaintTimes = {"/debug/showPaintTimes", false};
 
     /// UI
     // Purely QOL settings are here (like last item in a list).
@@ -686,8 +704,14 @@ private:
 
     void updateModerationActions();
 
+    /// Loads the settings from the binary snapshot if it's up to date
+    bool loadBinarySnapshot();
+
     std::unique_ptr<rapidjson::Document> snapshot_;
 
+    QString settingsPath_;
+    QString binaryPath_;
+
     pajlada::Signals::SignalHolder signalHolder;
 };
 
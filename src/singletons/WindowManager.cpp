@@ -12,6 +12,8 @@
 #include "singletons/Paths.hpp"
 #include "singletons/Settings.hpp"
 #include "singletons/Theme.hpp"
+#include "util/BackgroundSaver.hpp"
+#include "util/BinarySnapshot.hpp"
 #include "util/Clamp.hpp"
 #include "util/CombinePath.hpp"
 #include "widgets/AccountSwitchPopup.hpp"
@@ -24,11 +26,11 @@
 #include "widgets/Window.hpp"
 
 #include <QDebug>
+#include <QFile>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QMessageBox>
-#include <QSaveFile>
 #include <QScreen>
 
 #include <chrono>
@@ -513,19 +515,35 @@ void WindowManager::save()
     document.setObject(obj);
 
     // save file
-    QSaveFile file(this->windowLayoutFilePath);
-    file.open(QIODevice::WriteOnly | QIODevice::Truncate);
-
-    QJsonDocument::JsonFormat format =
+    BackgroundSaver::instance().run(
+        this->windowLayoutFilePath,
+        [path = this->windowLayoutFilePath, document = std::move(document),
+         writeBinary = getSettings()->binarySettingsSnapshot.getValue()] {
+            QJsonDocument::JsonFormat format =
 #ifdef _DEBUG
-        QJsonDocument::JsonFormat::Compact
+                QJsonDocument::JsonFormat::Compact
 #else
-        (QJsonDocument::JsonFormat)0
+                (QJsonDocument::JsonFormat)0
 #endif
-        ;
+                ;
+
+            writeFileAtomically(path, document.toJson(format));
 
-    file.write(document.toJson(format));
-    file.commit();
+            // The JSON file stays the format that's imported and exported,
+            // the binary copy is only used while it matches it
+            auto binaryPath = WindowLayout::binaryPathOf(path);
+            if (writeBinary)
+            {
+                writeFileAtomically(
+                    binaryPath,
+                    encodeBinarySnapshot(QJsonValue(document.object()),
+                                         SnapshotSource::of(path)));
+            }
+            else
+            {
+                QFile::remove(binaryPath);
+            }
+        });
 }
 
 void WindowManager::sendAlert()
@@ -0,0 +1,244 @@
+#include "singletons/helper/LogWriter.hpp"
+
+#include "common/QLogging.hpp"
+#include "util/QStringHash.hpp"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+constexpr std::chrono::milliseconds DEFAULT_FLUSH_INTERVAL{1000};
+constexpr qsizetype DEFAULT_FLUSH_THRESHOLD = 64 * 1024;
+
+}  // namespace
+
+namespace chatterino {
+
+struct LogWriter::Files {
+    std::unordered_map<QString, std::unique_ptr<QFile>> open;
+
+    QFile *get(const QString &fileName)
+    {
+        auto it = this->open.find(fileName);
+        if (it != this->open.end())
+        {
+            return it->second.get();
+        }
+
+        if (!QDir().mkpath(QFileInfo(fileName).absolutePath()))
+        {
+            qCDebug(chatterinoHelper) << "Unable to create logging path";
+            return nullptr;
+        }
+
+        qCDebug(chatterinoHelper) << "Logging to" << fileName;
+        auto file = std::make_unique<QFile>(fileName);
+        if (!file->open(QIODevice::Append))
+        {
+            qCWarning(chatterinoHelper)
+                << "Unable to open log file" << fileName << file->errorString();
+            return nullptr;
+        }
+
+        return this->open.emplace(fileName, std::move(file))
+            .first->second.get();
+    }
+
+    void write(const QString &fileName, const QByteArray &data)
+    {
+        if (data.isEmpty())
+        {
+            return;
+        }
+
+        auto *file = this->get(fileName);
+        if (file == nullptr)
+        {
+            return;
+        }
+
+        file->write(data);
+        file->flush();
+    }
+
+    void close(const QString &fileName)
+    {
+        this->open.erase(fileName);
+    }
+};
+
+LogWriter::LogWriter()
+    : flushInterval_(DEFAULT_FLUSH_INTERVAL.count())
+    , flushThreshold_(DEFAULT_FLUSH_THRESHOLD)
+    , files_(std::make_unique<Files>())
+{
+    this->thread_ = std::thread([this] {
+        this->run();
+    });
+}
+
+LogWriter::~LogWriter()
+{
+    this->stop();
+    // Writes that raced with stop() are still queued
+    this->drain();
+}
+
+void LogWriter::stop()
+{
+    if (!this->thread_.joinable())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard lock(this->wakeMutex_);
+        this->stopping_ = true;
+    }
+    this->wake_.notify_one();
+    this->thread_.join();
+
+    // Writes that raced with stopping were queued after the last drain
+    this->stopped_ = true;
+    this->drain();
+    this->files_->open.clear();
+}
+
+void LogWriter::write(const QString &fileName, QByteArray data)
+{
+    if (data.isEmpty() || this->stopped_)
+    {
+        return;
+    }
+
+    auto size = data.size();
+    this->push(new Entry{fileName, std::move(data)});
+
+    // Only wake the writer when this write crosses the threshold, everything
+    // else is picked up at the next interval
+    auto threshold = this->flushThreshold_.load(std::memory_order_relaxed);
+    auto before = this->pendingBytes_.fetch_add(size, std::memory_order_relaxed);
+    if (before < threshold && before + size >= threshold)
+    {
+        std::lock_guard lock(this->wakeMutex_);
+        this->wake_.notify_one();
+    }
+}
+
+void LogWriter::close(const QString &fileName)
+{
+    if (this->stopped_)
+    {
+        return;
+    }
+    this->push(new Entry{fileName, {}, true});
+}
+
+void LogWriter::setFlushInterval(std::chrono::milliseconds interval)
+{
+    this->flushInterval_.store(std::max<std::chrono::milliseconds::rep>(
+                                   interval.count(), 1),
+                               std::memory_order_relaxed);
+}
+
+void LogWriter::setFlushThreshold(qsizetype bytes)
+{
+    this->flushThreshold_.store(std::max<qsizetype>(bytes, 1),
+                                std::memory_order_relaxed);
+}
+
+void LogWriter::push(Entry *entry)
+{
+    // The writer only ever takes the whole list, so there's no ABA problem
+    entry->next = this->head_.load(std::memory_order_relaxed);
+    while (!this->head_.compare_exchange_weak(entry->next, entry,
+                                              std::memory_order_release,
+                                              std::memory_order_relaxed))
+    {
+    }
+}
+
+void LogWriter::run()
+{
+    while (true)
+    {
+        bool stopping = false;
+        {
+            std::unique_lock lock(this->wakeMutex_);
+            this->wake_.wait_for(
+                lock,
+                std::chrono::milliseconds(
+                    this->flushInterval_.load(std::memory_order_relaxed)),
+                [this] {
+                    return this->stopping_ ||
+                           this->pendingBytes_.load(
+                               std::memory_order_relaxed) >=
+                               this->flushThreshold_.load(
+                                   std::memory_order_relaxed);
+                });
+            stopping = this->stopping_;
+        }
+
+        this->drain();
+
+        if (stopping)
+        {
+            break;
+        }
+    }
+
+    this->files_->open.clear();
+}
+
+void LogWriter::drain()
+{
+    auto *head = this->head_.exchange(nullptr, std::memory_order_acquire);
+    if (head == nullptr)
+    {
+        return;
+    }
+
+    // The list is in reverse order of pushes
+    std::vector<std::unique_ptr<Entry>> entries;
+    for (auto *entry = head; entry != nullptr; entry = entry->next)
+    {
+        entries.emplace_back(entry);
+    }
+
+    qsizetype drainedBytes = 0;
+    std::unordered_map<QString, QByteArray> batches;
+    for (auto it = entries.rbegin(); it != entries.rend(); ++it)
+    {
+        auto &entry = **it;
+        drainedBytes += entry.data.size();
+
+        if (entry.close)
+        {
+            auto batch = batches.find(entry.fileName);
+            if (batch != batches.end())
+            {
+                this->files_->write(entry.fileName, batch->second);
+                batches.erase(batch);
+            }
+            this->files_->close(entry.fileName);
+            continue;
+        }
+
+        batches[entry.fileName].append(entry.data);
+    }
+
+    for (const auto &[fileName, data] : batches)
+    {
+        this->files_->write(fileName, data);
+    }
+
+    this->pendingBytes_.fetch_sub(drainedBytes, std::memory_order_relaxed);
+}
+
+}  // namespace chatterino
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace chatterino {
+
+/**
+ * @brief Writes log lines to files on a dedicated thread
+ *
+ * Producers push already formatted data onto a lock-free list. The writer
+ * thread wakes up every flush interval, or as soon as the queued data
+ * exceeds the flush threshold, and writes everything that was queued for a
+ * file with a single write.
+ *
+ * Files are opened on demand (creating their directory) and stay open until
+ * they're closed with close() or the writer is stopped. Stopping or
+ * destroying the writer writes all queued data before returning.
+ */
+class LogWriter
+{
+public:
+    LogWriter();
+    ~LogWriter();
+
+    LogWriter(const LogWriter &) = delete;
+    LogWriter &operator=(const LogWriter &) = delete;
+    LogWriter(LogWriter &&) = delete;
+    LogWriter &operator=(LogWriter &&) = delete;
+
+    /// Appends `data` to the file at `fileName`. Can be called from any thread.
+    void write(const QString &fileName, QByteArray data);
+
+    /// Closes the file at `fileName` after everything queued for it before
+    /// was written. Can be called from any thread.
+    void close(const QString &fileName);
+
+    /// Writes everything that was queued, closes all files and stops the
+    /// writer thread. Data written afterwards is dropped.
+    void stop();
+
+    void setFlushInterval(std::chrono::milliseconds interval);
+    void setFlushThreshold(qsizetype bytes);
+
+private:
+    struct Entry {
+        QString fileName;
+        QByteArray data;
+        bool close = false;
+        Entry *next = nullptr;
+    };
+
+    void push(Entry *entry);
+    void run();
+
+    /// Writes all queued entries, only called from the writer thread
+    void drain();
+
+    std::atomic<Entry *> head_{nullptr};
+    std::atomic<qsizetype> pendingBytes_{0};
+
+    std::atomic<std::chrono::milliseconds::rep> flushInterval_;
+    std::atomic<qsizetype> flushThreshold_;
+
+    std::mutex wakeMutex_;
+    std::condition_variable wake_;
+    bool stopping_ = false;
+    std::atomic<bool> stopped_{false};
+
+    struct Files;
+    // Only accessed from the writer thread
+    std::unique_ptr<Files> files_;
+
+    std::thread thread_;
+};
+
+}  // namespace chatterino
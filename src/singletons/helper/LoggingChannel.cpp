@@ -4,6 +4,7 @@
 #include "common/QLogging.hpp"
 #include "messages/Message.hpp"
 #include "messages/MessageThread.hpp"
+#include "singletons/helper/LogWriter.hpp"
 #include "singletons/Paths.hpp"
 #include "singletons/Settings.hpp"
 
@@ -14,9 +15,11 @@ namespace chatterino {
 QByteArray endline("\n");
 
 LoggingChannel::LoggingChannel(const QString &_channelName,
-                               const QString &_platform)
+                               const QString &_platform,
+                               LogWriter &writer)
     : channelName(_channelName)
     , platform(_platform)
+    , writer(writer)
 {
     if (this->channelName.startsWith("/whispers"))
     {
@@ -55,7 +58,7 @@ LoggingChannel::LoggingChannel(const QString &_channelName,
 LoggingChannel::~LoggingChannel()
 {
     this->appendLine(this->generateClosingString());
-    this->fileHandle.close();
+    this->writer.close(this->fileName);
 }
 
 void LoggingChannel::openLogFile()
@@ -63,29 +66,16 @@ void LoggingChannel::openLogFile()
     QDateTime now = QDateTime::currentDateTime();
     this->dateString = this->generateDateString(now);
 
-    if (this->fileHandle.isOpen())
+    if (!this->fileName.isEmpty())
     {
-        this->fileHandle.flush();
-        this->fileHandle.close();
+        this->writer.close(this->fileName);
     }
 
     QString baseFileName = this->channelName + "-" + this->dateString + ".log";
 
-    QString directory =
-        this->baseDirectory + QDir::separator() + this->subDirectory;
-
-    if (!QDir().mkpath(directory))
-    {
-        qCDebug(chatterinoHelper) << "Unable to create logging path";
-        return;
-    }
-
-    // Open file handle to log file of current date
-    QString fileName = directory + QDir::separator() + baseFileName;
-    qCDebug(chatterinoHelper) << "Logging to" << fileName;
-    this->fileHandle.setFileName(fileName);
-
-    this->fileHandle.open(QIODevice::Append);
+    // The directory is created by the writer once it opens the file
+    this->fileName = this->baseDirectory + QDir::separator() +
+                     this->subDirectory + QDir::separator() + baseFileName;
 
     this->appendLine(this->generateOpeningString(now));
 }
@@ -183,8 +173,12 @@ QString LoggingChannel::generateClosingString(const QDateTime &now) const
 
 void LoggingChannel::appendLine(const QString &line)
 {
-    this->fileHandle.write(line.toUtf8());
-    this->fileHandle.flush();
+    if (this->fileName.isEmpty())
+    {
+        return;
+    }
+
+    this->writer.write(this->fileName, line.toUtf8());
 }
 
 QString LoggingChannel::generateDateString(const QDateTime &now)
@@ -1,7 +1,6 @@
 #pragma once
 
 #include <QDateTime>
-#include <QFile>
 #include <QString>
 
 #include <memory>
@@ -9,13 +8,14 @@
 namespace chatterino {
 
 class Logging;
+class LogWriter;
 struct Message;
 using MessagePtr = std::shared_ptr<const Message>;
 
 class LoggingChannel
 {
     explicit LoggingChannel(const QString &_channelName,
-                            const QString &platform);
+                            const QString &platform, LogWriter &writer);
 
 public:
     ~LoggingChannel();
@@ -45,7 +45,9 @@ private:
     QString baseDirectory;
     QString subDirectory;
 
-    QFile fileHandle;
+    LogWriter &writer;
+    /// The file currently logged to, empty if none was opened yet
+    QString fileName;
 
     QString dateString;
 
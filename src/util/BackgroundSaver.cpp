@@ -0,0 +1,56 @@
+#include "util/BackgroundSaver.hpp"
+
+#include <QtConcurrent>
+
+#include <tuple>
+
+namespace chatterino {
+
+BackgroundSaver &BackgroundSaver::instance()
+{
+    static auto *instance = new BackgroundSaver;
+    return *instance;
+}
+
+BackgroundSaver::BackgroundSaver()
+{
+    this->pool_.setMaxThreadCount(1);
+    // Keep the thread around, saves come in bursts
+    this->pool_.setExpiryTimeout(-1);
+}
+
+void BackgroundSaver::run(const QString &key, std::function<void()> task)
+{
+    {
+        std::lock_guard lock(this->mutex_);
+        auto [it, inserted] = this->pending_.try_emplace(key, std::move(task));
+        if (!inserted)
+        {
+            // The queued runner picks up the newer task
+            it->second = std::move(task);
+            return;
+        }
+    }
+
+    std::ignore = QtConcurrent::run(&this->pool_, [this, key] {
+        std::function<void()> task;
+        {
+            std::lock_guard lock(this->mutex_);
+            auto node = this->pending_.extract(key);
+            if (node.empty())
+            {
+                return;
+            }
+            task = std::move(node.mapped());
+        }
+
+        task();
+    });
+}
+
+void BackgroundSaver::flush()
+{
+    this->pool_.waitForDone();
+}
+
+}  // namespace chatterino
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "util/QStringHash.hpp"
+
+#include <QString>
+#include <QThreadPool>
+
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+namespace chatterino {
+
+/**
+ * @brief Runs save tasks on a single background thread
+ *
+ * Tasks run one after another in the order they were queued. A task that is
+ * queued under the same key as a task that didn't start yet replaces it, so
+ * saves requested in quick succession only write the latest state once.
+ */
+class BackgroundSaver
+{
+public:
+    static BackgroundSaver &instance();
+
+    BackgroundSaver();
+
+    /// Queues `task`, replacing a pending task with the same key
+    void run(const QString &key, std::function<void()> task);
+
+    /// Blocks until all queued tasks finished
+    void flush();
+
+private:
+    QThreadPool pool_;
+
+    std::mutex mutex_;
+    std::unordered_map<QString, std::function<void()>> pending_;
+};
+
+}  // namespace chatterino
@@ -0,0 +1,635 @@
+#include "util/BinarySnapshot.hpp"
+
+#include "common/QLogging.hpp"
+
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QtEndian>
+
+#include <cmath>
+#include <cstring>
+#include <optional>
+
+namespace {
+
+using namespace chatterino;
+
+constexpr char MAGIC[4] = {'C', '7', 'B', 'S'};
+constexpr uint32_t VERSION = 1;
+constexpr size_t HEADER_SIZE = 4 + 4 + 8 + 8 + 8;
+
+/// Corrupted files must not be able to overflow the stack
+constexpr int MAX_DEPTH = 512;
+
+enum class Tag : uint8_t {
+    Null,
+    False,
+    True,
+    Int,
+    Uint,
+    Double,
+    String,
+    Array,
+    Object,
+};
+
+class Writer
+{
+public:
+    explicit Writer(QByteArray &out)
+        : out_(out)
+    {
+    }
+
+    void tag(Tag tag)
+    {
+        this->out_.append(char(tag));
+    }
+
+    template <typename T>
+    void number(T value)
+    {
+        char buffer[sizeof(T)];
+        qToLittleEndian(value, buffer);
+        this->out_.append(buffer, sizeof(T));
+    }
+
+    void string(const char *data, size_t length)
+    {
+        this->number(uint32_t(length));
+        this->out_.append(data, qsizetype(length));
+    }
+
+private:
+    QByteArray &out_;
+};
+
+class Reader
+{
+public:
+    Reader(const char *data, size_t size)
+        : data_(data)
+        , size_(size)
+    {
+    }
+
+    bool tag(Tag &tag)
+    {
+        if (this->pos_ >= this->size_)
+        {
+            return false;
+        }
+        auto value = uint8_t(this->data_[this->pos_++]);
+        if (value > uint8_t(Tag::Object))
+        {
+            return false;
+        }
+        tag = Tag(value);
+        return true;
+    }
+
+    template <typename T>
+    bool number(T &value)
+    {
+        if (this->size_ - this->pos_ < sizeof(T))
+        {
+            return false;
+        }
+        value = qFromLittleEndian<T>(this->data_ + this->pos_);
+        this->pos_ += sizeof(T);
+        return true;
+    }
+
+    bool string(const char *&data, uint32_t &length)
+    {
+        if (!this->number(length) || this->size_ - this->pos_ < length)
+        {
+            return false;
+        }
+        data = this->data_ + this->pos_;
+        this->pos_ += length;
+        return true;
+    }
+
+    /// Containers need at least one byte per element, larger counts can only
+    /// come from corrupted data
+    bool count(uint32_t &count)
+    {
+        return this->number(count) && count <= this->size_ - this->pos_;
+    }
+
+    bool atEnd() const
+    {
+        return this->pos_ == this->size_;
+    }
+
+private:
+    const char *data_;
+    size_t size_;
+    size_t pos_ = 0;
+};
+
+void writeValue(Writer &writer, const rapidjson::Value &value)
+{
+    switch (value.GetType())
+    {
+        case rapidjson::kNullType:
+            writer.tag(Tag::Null);
+            break;
+        case rapidjson::kFalseType:
+            writer.tag(Tag::False);
+            break;
+        case rapidjson::kTrueType:
+            writer.tag(Tag::True);
+            break;
+        case rapidjson::kNumberType:
+            if (value.IsInt64())
+            {
+                writer.tag(Tag::Int);
+                writer.number(value.GetInt64());
+            }
+            else if (value.IsUint64())
+            {
+                writer.tag(Tag::Uint);
+                writer.number(value.GetUint64());
+            }
+            else
+            {
+                writer.tag(Tag::Double);
+                writer.number(value.GetDouble());
+            }
+            break;
+        case rapidjson::kStringType:
+            writer.tag(Tag::String);
+            writer.string(value.GetString(), value.GetStringLength());
+            break;
+        case rapidjson::kArrayType:
+            writer.tag(Tag::Array);
+            writer.number(uint32_t(value.Size()));
+            for (const auto &item : value.GetArray())
+            {
+                writeValue(writer, item);
+            }
+            break;
+        case rapidjson::kObjectType:
+            writer.tag(Tag::Object);
+            writer.number(uint32_t(value.MemberCount()));
+            for (const auto &member : value.GetObject())
+            {
+                writer.string(member.name.GetString(),
+                              member.name.GetStringLength());
+                writeValue(writer, member.value);
+            }
+            break;
+    }
+}
+
+void writeValue(Writer &writer, const QJsonValue &value)
+{
+    switch (value.type())
+    {
+        case QJsonValue::Null:
+        case QJsonValue::Undefined:
+            writer.tag(Tag::Null);
+            break;
+        case QJsonValue::Bool:
+            writer.tag(value.toBool() ? Tag::True : Tag::False);
+            break;
+        case QJsonValue::Double: {
+            // QJsonValue stores numbers as doubles, keep integers exact
+            auto number = value.toDouble();
+            if (std::trunc(number) == number && std::abs(number) < 0x1p53)
+            {
+                writer.tag(Tag::Int);
+                writer.number(int64_t(number));
+            }
+            else
+            {
+                writer.tag(Tag::Double);
+                writer.number(number);
+            }
+        }
+        break;
+        case QJsonValue::String: {
+            auto utf8 = value.toString().toUtf8();
+            writer.tag(Tag::String);
+            writer.string(utf8.constData(), size_t(utf8.size()));
+        }
+        break;
+        case QJsonValue::Array: {
+            auto array = value.toArray();
+            writer.tag(Tag::Array);
+            writer.number(uint32_t(array.size()));
+            for (const auto &item : array)
+            {
+                writeValue(writer, item);
+            }
+        }
+        break;
+        case QJsonValue::Object: {
+            auto object = value.toObject();
+            writer.tag(Tag::Object);
+            writer.number(uint32_t(object.size()));
+            for (auto it = object.begin(); it != object.end(); ++it)
+            {
+                auto key = it.key().toUtf8();
+                writer.string(key.constData(), size_t(key.size()));
+                writeValue(writer, it.value());
+            }
+        }
+        break;
+    }
+}
+
+bool readValue(Reader &reader, rapidjson::Value &out,
+               rapidjson::Document::AllocatorType &a, int depth)
+{
+    Tag tag{};
+    if (depth > MAX_DEPTH || !reader.tag(tag))
+    {
+        return false;
+    }
+
+    switch (tag)
+    {
+        case Tag::Null:
+            out.SetNull();
+            return true;
+        case Tag::False:
+            out.SetBool(false);
+            return true;
+        case Tag::True:
+            out.SetBool(true);
+            return true;
+        case Tag::Int: {
+            int64_t value{};
+            if (!reader.number(value))
+            {
+                return false;
+            }
+            out.SetInt64(value);
+            return true;
+        }
+        case Tag::Uint: {
+            uint64_t value{};
+            if (!reader.number(value))
+            {
+                return false;
+            }
+            out.SetUint64(value);
+            return true;
+        }
+        case Tag::Double: {
+            double value{};
+            if (!reader.number(value))
+            {
+                return false;
+            }
+            out.SetDouble(value);
+            return true;
+        }
+        case Tag::String: {
+            const char *data{};
+            uint32_t length{};
+            if (!reader.string(data, length))
+            {
+                return false;
+            }
+            // The mapping goes away after reading, so strings are copied
+            out.SetString(data, length, a);
+            return true;
+        }
+        case Tag::Array: {
+            uint32_t count{};
+            if (!reader.count(count))
+            {
+                return false;
+            }
+            out.SetArray();
+            out.Reserve(count, a);
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                rapidjson::Value item;
+                if (!readValue(reader, item, a, depth + 1))
+                {
+                    return false;
+                }
+                out.PushBack(item, a);
+            }
+            return true;
+        }
+        case Tag::Object: {
+            uint32_t count{};
+            if (!reader.count(count))
+            {
+                return false;
+            }
+            out.SetObject();
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                const char *key{};
+                uint32_t length{};
+                rapidjson::Value value;
+                if (!reader.string(key, length) ||
+                    !readValue(reader, value, a, depth + 1))
+                {
+                    return false;
+                }
+                out.AddMember(rapidjson::Value(key, length, a), value, a);
+            }
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool readValue(Reader &reader, QJsonValue &out, int depth)
+{
+    Tag tag{};
+    if (depth > MAX_DEPTH || !reader.tag(tag))
+    {
+        return false;
+    }
+
+    switch (tag)
+    {
+        case Tag::Null:
+            out = QJsonValue();
+            return true;
+        case Tag::False:
+            out = false;
+            return true;
+        case Tag::True:
+            out = true;
+            return true;
+        case Tag::Int: {
+            int64_t value{};
+            if (!reader.number(value))
+            {
+                return false;
+            }
+            out = qint64(value);
+            return true;
+        }
+        case Tag::Uint: {
+            uint64_t value{};
+            if (!reader.number(value))
+            {
+                return false;
+            }
+            out = double(value);
+            return true;
+        }
+        case Tag::Double: {
+            double value{};
+            if (!reader.number(value))
+            {
+                return false;
+            }
+            out = value;
+            return true;
+        }
+        case Tag::String: {
+            const char *data{};
+            uint32_t length{};
+            if (!reader.string(data, length))
+            {
+                return false;
+            }
+            out = QString::fromUtf8(data, qsizetype(length));
+            return true;
+        }
+        case Tag::Array: {
+            uint32_t count{};
+            if (!reader.count(count))
+            {
+                return false;
+            }
+            QJsonArray array;
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                QJsonValue item;
+                if (!readValue(reader, item, depth + 1))
+                {
+                    return false;
+                }
+                array.append(item);
+            }
+            out = array;
+            return true;
+        }
+        case Tag::Object: {
+            uint32_t count{};
+            if (!reader.count(count))
+            {
+                return false;
+            }
+            QJsonObject object;
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                const char *key{};
+                uint32_t length{};
+                QJsonValue value;
+                if (!reader.string(key, length) ||
+                    !readValue(reader, value, depth + 1))
+                {
+                    return false;
+                }
+                object.insert(QString::fromUtf8(key, qsizetype(length)),
+                              value);
+            }
+            out = object;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+template <typename T>
+QByteArray encode(const T &value, const SnapshotSource &source)
+{
+    QByteArray out;
+    out.reserve(4096);
+    out.append(MAGIC, sizeof(MAGIC));
+
+    Writer writer(out);
+    writer.number(VERSION);
+    writer.number(source.size);
+    writer.number(source.modified);
+    // payload size, filled in below
+    writer.number(uint64_t(0));
+
+    writeValue(writer, value);
+
+    char payloadSize[8];
+    qToLittleEndian(uint64_t(out.size() - HEADER_SIZE), payloadSize);
+    std::memcpy(out.data() + HEADER_SIZE - 8, payloadSize, 8);
+
+    return out;
+}
+
+/// Checks the header and returns a reader for the payload
+std::optional<Reader> payloadOf(const char *data, size_t size,
+                                const SnapshotSource &source)
+{
+    if (source.size < 0 || size < HEADER_SIZE ||
+        std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0)
+    {
+        return std::nullopt;
+    }
+
+    Reader header(data + sizeof(MAGIC), HEADER_SIZE - sizeof(MAGIC));
+    uint32_t version{};
+    SnapshotSource snapshotSource;
+    uint64_t payloadSize{};
+    header.number(version);
+    header.number(snapshotSource.size);
+    header.number(snapshotSource.modified);
+    header.number(payloadSize);
+
+    if (version != VERSION || snapshotSource != source ||
+        payloadSize != size - HEADER_SIZE)
+    {
+        return std::nullopt;
+    }
+
+    return Reader(data + HEADER_SIZE, size - HEADER_SIZE);
+}
+
+template <typename Decode>
+bool readMapped(const QString &path, Decode &&decode)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly) || file.size() == 0)
+    {
+        return false;
+    }
+
+    const auto size = size_t(file.size());
+    auto *data = file.map(0, file.size());
+    if (data == nullptr)
+    {
+        qCWarning(chatterinoApp)
+            << "Failed to map" << path << file.errorString();
+        return false;
+    }
+
+    bool ok = decode(reinterpret_cast<const char *>(data), size);
+    file.unmap(data);
+    return ok;
+}
+
+}  // namespace
+
+namespace chatterino {
+
+SnapshotSource SnapshotSource::of(const QString &jsonPath)
+{
+    QFileInfo info(jsonPath);
+    if (!info.exists())
+    {
+        return {};
+    }
+
+    return {
+        .size = info.size(),
+        .modified = info.lastModified().toMSecsSinceEpoch(),
+    };
+}
+
+QByteArray encodeBinarySnapshot(const rapidjson::Value &value,
+                                const SnapshotSource &source)
+{
+    return encode(value, source);
+}
+
+QByteArray encodeBinarySnapshot(const QJsonValue &value,
+                                const SnapshotSource &source)
+{
+    return encode(value, source);
+}
+
+bool decodeBinarySnapshot(const char *data, size_t size,
+                          const SnapshotSource &source,
+                          rapidjson::Document &out)
+{
+    auto reader = payloadOf(data, size, source);
+    if (!reader)
+    {
+        return false;
+    }
+
+    rapidjson::Document document;
+    if (!readValue(*reader, document, document.GetAllocator(), 0) ||
+        !reader->atEnd())
+    {
+        return false;
+    }
+
+    out.Swap(document);
+    return true;
+}
+
+bool decodeBinarySnapshot(const char *data, size_t size,
+                          const SnapshotSource &source, QJsonValue &out)
+{
+    auto reader = payloadOf(data, size, source);
+    if (!reader)
+    {
+        return false;
+    }
+
+    QJsonValue value;
+    if (!readValue(*reader, value, 0) || !reader->atEnd())
+    {
+        return false;
+    }
+
+    out = value;
+    return true;
+}
+
+bool readBinarySnapshot(const QString &path, const SnapshotSource &source,
+                        rapidjson::Document &out)
+{
+    return readMapped(path, [&](const char *data, size_t size) {
+        return decodeBinarySnapshot(data, size, source, out);
+    });
+}
+
+bool readBinarySnapshot(const QString &path, const SnapshotSource &source,
+                        QJsonValue &out)
+{
+    return readMapped(path, [&](const char *data, size_t size) {
+        return decodeBinarySnapshot(data, size, source, out);
+    });
+}
+
+bool writeFileAtomically(const QString &path, const QByteArray &data)
+{
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qCWarning(chatterinoApp)
+            << "Failed to open" << path << file.errorString();
+        return false;
+    }
+
+    file.write(data);
+    if (!file.commit())
+    {
+        qCWarning(chatterinoApp)
+            << "Failed to write" << path << file.errorString();
+        return false;
+    }
+
+    return true;
+}
+
+}  // namespace chatterino
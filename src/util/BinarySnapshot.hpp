@@ -0,0 +1,55 @@
+#pragma once
+
+#include <QByteArray>
+#include <QJsonValue>
+#include <QString>
+#include <rapidjson/document.h>
+
+#include <cstdint>
+
+namespace chatterino {
+
+/// Identifies the state of the JSON file a binary snapshot was created from.
+/// A snapshot is only used while its JSON file is unchanged, so editing or
+/// importing the JSON file always takes precedence.
+struct SnapshotSource {
+    int64_t size = -1;
+    int64_t modified = 0;
+
+    static SnapshotSource of(const QString &jsonPath);
+
+    bool operator==(const SnapshotSource &other) const = default;
+};
+
+/**
+ * @brief Compact binary copy of a JSON document
+ *
+ * Values are stored with a type tag, numbers in binary and strings,
+ * arrays and objects with their length up front. Reading one doesn't have
+ * to unescape strings, parse numbers or grow containers, and decodes
+ * straight from the memory mapped file.
+ */
+QByteArray encodeBinarySnapshot(const rapidjson::Value &value,
+                                const SnapshotSource &source);
+QByteArray encodeBinarySnapshot(const QJsonValue &value,
+                                const SnapshotSource &source);
+
+/// Decodes a snapshot created by encodeBinarySnapshot.
+/// @returns false if the data is invalid or wasn't created from @a source
+bool decodeBinarySnapshot(const char *data, size_t size,
+                          const SnapshotSource &source,
+                          rapidjson::Document &out);
+bool decodeBinarySnapshot(const char *data, size_t size,
+                          const SnapshotSource &source, QJsonValue &out);
+
+/// Memory maps the snapshot at @a path and decodes it
+/// @returns false if there is no valid snapshot for @a source
+bool readBinarySnapshot(const QString &path, const SnapshotSource &source,
+                        rapidjson::Document &out);
+bool readBinarySnapshot(const QString &path, const SnapshotSource &source,
+                        QJsonValue &out);
+
+/// Atomically replaces the file at @a path with @a data
+bool writeFileAtomically(const QString &path, const QByteArray &data);
+
+}  // namespace chatterino
@@ -83,6 +83,18 @@ void DebugCount::decrease(const QString &name, const int64_t &amount)
     }
 }
 
+int64_t DebugCount::get(const QString &name)
+{
+    auto counts = COUNTS.access();
+
+    auto it = counts->find(name);
+    if (it == counts->end())
+    {
+        return 0;
+    }
+    return it->second.value;
+}
+
 QString DebugCount::getDebugText()
 {
 #if QT_VERSION > QT_VERSION_CHECK(5, 13, 0)
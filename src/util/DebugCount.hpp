@@ -32,6 +32,10 @@ public:
         DebugCount::decrease(name, 1);
     }
 
+    /// Returns the current value of the counter @a name, 0 if it was never
+    /// changed
+    static int64_t get(const QString &name);
+
     static QString getDebugText();
 };
 
@@ -0,0 +1,112 @@
+#include "util/GaussianBlur.hpp"
+
+#include <QImage>
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+constexpr int BOX_PASSES = 3;
+
+/// Radii of the box blurs that together approximate a gaussian with the
+/// standard deviation @a sigma
+std::array<int, BOX_PASSES> boxRadii(qreal sigma)
+{
+    constexpr qreal n = BOX_PASSES;
+
+    auto lower =
+        static_cast<int>(std::floor(std::sqrt(12 * sigma * sigma / n + 1)));
+    if (lower % 2 == 0)
+    {
+        lower--;
+    }
+    auto upper = lower + 2;
+
+    // number of passes using the lower width
+    auto lowerPasses = static_cast<int>(
+        std::round((12 * sigma * sigma - n * lower * lower - 4 * n * lower -
+                    3 * n) /
+                   (-4 * lower - 4)));
+
+    std::array<int, BOX_PASSES> radii{};
+    for (int i = 0; i < BOX_PASSES; i++)
+    {
+        auto width = i < lowerPasses ? lower : upper;
+        radii[i] = (width - 1) / 2;
+    }
+    return radii;
+}
+
+/// Blurs @a length values that are @a step bytes apart
+void boxBlurLine(const uint8_t *src, uint8_t *dst, int length, qsizetype step,
+                 int radius)
+{
+    const int window = 2 * radius + 1;
+    int sum = 0;
+
+    // values before the start are transparent
+    for (int i = 0; i < radius && i < length; i++)
+    {
+        sum += src[i * step];
+    }
+
+    for (int i = 0; i < length; i++)
+    {
+        auto entering = i + radius;
+        if (entering < length)
+        {
+            sum += src[entering * step];
+        }
+        auto leaving = i - radius - 1;
+        if (leaving >= 0)
+        {
+            sum -= src[leaving * step];
+        }
+
+        dst[i * step] = static_cast<uint8_t>((sum + window / 2) / window);
+    }
+}
+
+}  // namespace
+
+namespace chatterino {
+
+void gaussianBlurAlpha(QImage &mask, qreal sigma)
+{
+    Q_ASSERT(mask.format() == QImage::Format_Alpha8);
+
+    if (sigma <= 0 || mask.isNull())
+    {
+        return;
+    }
+
+    const int width = mask.width();
+    const int height = mask.height();
+    const auto stride = mask.bytesPerLine();
+
+    uint8_t *data = mask.bits();
+    std::vector<uint8_t> scratch(static_cast<size_t>(stride * height));
+
+    for (auto radius : boxRadii(sigma))
+    {
+        if (radius <= 0)
+        {
+            continue;
+        }
+
+        for (int y = 0; y < height; y++)
+        {
+            boxBlurLine(data + y * stride, scratch.data() + y * stride, width,
+                        1, radius);
+        }
+        for (int x = 0; x < width; x++)
+        {
+            boxBlurLine(scratch.data() + x, data + x, height, stride, radius);
+        }
+    }
+}
+
+}  // namespace chatterino
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <QtGlobal>
+
+class QImage;
+
+namespace chatterino {
+
+/// Blurs an alpha mask (QImage::Format_Alpha8) in place.
+///
+/// The gaussian is approximated by three box blurs, each run separately
+/// along the rows and the columns, so the cost doesn't depend on
+/// @a sigma. Pixels outside the image are treated as transparent.
+void gaussianBlurAlpha(QImage &mask, qreal sigma);
+
+}  // namespace chatterino
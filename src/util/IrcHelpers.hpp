@@ -1,5 +1,7 @@
 #pragma once
 
+#include "providers/irc/IrcTags.hpp"
+
 #include <IrcMessage>
 #include <QString>
 
@@ -58,34 +60,33 @@ inline QString parseTagString(const QString &input)
     return output;
 }
 
-inline QDateTime calculateMessageTime(const Communi::IrcMessage *message)
+inline QDateTime calculateMessageTime(const IrcTags &tags)
 {
     // Check if message is from recent-messages API
-    if (message->tags().contains("historical"))
+    if (tags.contains("historical"))
     {
         bool customReceived = false;
-        auto ts =
-            message->tags().value("rm-received-ts").toLongLong(&customReceived);
+        auto ts = tags.value("rm-received-ts").toLongLong(&customReceived);
         if (!customReceived)
         {
-            ts = message->tags().value("tmi-sent-ts").toLongLong();
+            ts = tags.value("tmi-sent-ts").toLongLong();
         }
 
         return QDateTime::fromMSecsSinceEpoch(ts);
     }
 
     // If present, handle tmi-sent-ts tag and use it as timestamp
-    if (message->tags().contains("tmi-sent-ts"))
+    if (tags.contains("tmi-sent-ts"))
     {
-        auto ts = message->tags().value("tmi-sent-ts").toLongLong();
+        auto ts = tags.value("tmi-sent-ts").toLongLong();
         return QDateTime::fromMSecsSinceEpoch(ts);
     }
 
     // Some IRC Servers might have server-time tag containing UTC date in ISO format, use it as timestamp
     // See: https://ircv3.net/irc/#server-time
-    if (message->tags().contains("time"))
+    if (tags.contains("time"))
     {
-        QString timedate = message->tags().value("time").toString();
+        QString timedate = tags.value("time").toString();
 
         auto date = QDateTime::fromString(timedate, Qt::ISODate);
         date.setTimeSpec(Qt::TimeSpec::UTC);
@@ -96,4 +97,9 @@ inline QDateTime calculateMessageTime(const Communi::IrcMessage *message)
     return QDateTime::currentDateTime();
 }
 
+inline QDateTime calculateMessageTime(const Communi::IrcMessage *message)
+{
+    return calculateMessageTime(message->tags());
+}
+
 }  // namespace chatterino
@@ -45,5 +45,22 @@ namespace rj {
         return obj.IsObject() && !obj.IsNull() && obj.HasMember(key);
     }
 
+    QString getString(const rapidjson::Value &obj, const char *key)
+    {
+        if (!obj.IsObject())
+        {
+            return {};
+        }
+
+        auto it = obj.FindMember(key);
+        if (it == obj.MemberEnd() || !it->value.IsString())
+        {
+            return {};
+        }
+
+        return QString::fromUtf8(it->value.GetString(),
+                                 int(it->value.GetStringLength()));
+    }
+
 }  // namespace rj
 }  // namespace chatterino
@@ -97,5 +97,9 @@ namespace rj {
 
     QString stringify(const rapidjson::Value &value);
 
+    /// Returns the string member `key` of `obj`, or an empty string if there
+    /// is none
+    QString getString(const rapidjson::Value &obj, const char *key);
+
 }  // namespace rj
 }  // namespace chatterino
@@ -0,0 +1,90 @@
+#include "util/SlabAllocator.hpp"
+
+#include <new>
+
+namespace chatterino {
+
+SlabAllocator::~SlabAllocator()
+{
+    for (auto &sizeClass : this->classes_)
+    {
+        for (void *slab : sizeClass.slabs)
+        {
+            ::operator delete(slab);
+        }
+    }
+}
+
+void *SlabAllocator::allocate(size_t size)
+{
+    if (size == 0 || size > MAX_BLOCK_SIZE)
+    {
+        return ::operator new(size);
+    }
+
+    const size_t index = (size - 1) / GRANULARITY;
+    const size_t blockSize = (index + 1) * GRANULARITY;
+    auto &sizeClass = this->classes_[index];
+
+    std::lock_guard lock(sizeClass.mutex);
+    this->allocatedBytes_ += blockSize;
+
+    if (sizeClass.freeList != nullptr)
+    {
+        auto *block = sizeClass.freeList;
+        sizeClass.freeList = block->next;
+        return block;
+    }
+
+    if (sizeClass.bump == nullptr ||
+        sizeClass.bump + blockSize > sizeClass.bumpEnd)
+    {
+        // ::operator new is aligned to __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+        // blocks stay aligned since they're multiples of GRANULARITY
+        auto *slab = static_cast<std::byte *>(::operator new(SLAB_SIZE));
+        sizeClass.slabs.push_back(slab);
+        sizeClass.bump = slab;
+        sizeClass.bumpEnd = slab + SLAB_SIZE;
+        this->reservedBytes_ += SLAB_SIZE;
+    }
+
+    auto *block = sizeClass.bump;
+    sizeClass.bump += blockSize;
+    return block;
+}
+
+void SlabAllocator::deallocate(void *ptr, size_t size) noexcept
+{
+    if (ptr == nullptr)
+    {
+        return;
+    }
+
+    if (size == 0 || size > MAX_BLOCK_SIZE)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    const size_t index = (size - 1) / GRANULARITY;
+    auto &sizeClass = this->classes_[index];
+
+    std::lock_guard lock(sizeClass.mutex);
+    this->allocatedBytes_ -= (index + 1) * GRANULARITY;
+
+    auto *block = static_cast<FreeBlock *>(ptr);
+    block->next = sizeClass.freeList;
+    sizeClass.freeList = block;
+}
+
+size_t SlabAllocator::allocatedBytes() const
+{
+    return this->allocatedBytes_;
+}
+
+size_t SlabAllocator::reservedBytes() const
+{
+    return this->reservedBytes_;
+}
+
+}  // namespace chatterino
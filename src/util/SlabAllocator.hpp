@@ -0,0 +1,74 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace chatterino {
+
+/**
+ * @brief Allocator for many small, short-lived objects of varying size
+ *
+ * Blocks are grouped into size classes of GRANULARITY bytes and carved out of
+ * SLAB_SIZE sized slabs. Freed blocks are kept on a free list per size class
+ * and reused by later allocations of the same class, so there is no
+ * per-allocation header and no trip to the system allocator in the common
+ * case.
+ *
+ * Slabs are only released when the allocator is destroyed. The reserved
+ * memory of a size class is therefore bounded by the most bytes that were
+ * ever handed out in it at once, plus one partially used slab. For message
+ * elements that peak is bounded by the message limit of the open channels.
+ *
+ * Allocations larger than MAX_BLOCK_SIZE are forwarded to ::operator new.
+ *
+ * This class is thread safe.
+ */
+class SlabAllocator
+{
+public:
+    static constexpr size_t GRANULARITY = 16;
+    static constexpr size_t MAX_BLOCK_SIZE = 512;
+    static constexpr size_t SLAB_SIZE = 16 * 1024;
+
+    SlabAllocator() = default;
+    ~SlabAllocator();
+
+    SlabAllocator(const SlabAllocator &) = delete;
+    SlabAllocator &operator=(const SlabAllocator &) = delete;
+
+    SlabAllocator(SlabAllocator &&) = delete;
+    SlabAllocator &operator=(SlabAllocator &&) = delete;
+
+    void *allocate(size_t size);
+    /// `size` must be the size passed to allocate, null pointers are ignored
+    void deallocate(void *ptr, size_t size) noexcept;
+
+    /// Bytes of blocks that are currently handed out
+    size_t allocatedBytes() const;
+    /// Bytes reserved in slabs, including free blocks
+    size_t reservedBytes() const;
+
+private:
+    struct FreeBlock {
+        FreeBlock *next;
+    };
+
+    struct SizeClass {
+        std::mutex mutex;
+        FreeBlock *freeList = nullptr;
+        std::byte *bump = nullptr;
+        std::byte *bumpEnd = nullptr;
+        std::vector<void *> slabs;
+    };
+
+    static constexpr size_t CLASS_COUNT = MAX_BLOCK_SIZE / GRANULARITY;
+
+    std::array<SizeClass, CLASS_COUNT> classes_;
+    std::atomic<size_t> allocatedBytes_{0};
+    std::atomic<size_t> reservedBytes_{0};
+};
+
+}  // namespace chatterino
@@ -0,0 +1,49 @@
+#include "util/StringInterner.hpp"
+
+#include "util/QStringHash.hpp"
+
+namespace chatterino {
+
+StringInterner &StringInterner::instance()
+{
+    static auto *instance = new StringInterner;
+    return *instance;
+}
+
+QString StringInterner::intern(const QString &str)
+{
+    if (str.isEmpty())
+    {
+        return {};
+    }
+
+    auto &shard = this->shards_[qHash(str) % SHARD_COUNT];
+    std::lock_guard lock(shard.mutex);
+
+    auto it = shard.strings.find(str);
+    if (it != shard.strings.end())
+    {
+        return *it;
+    }
+
+    if (shard.strings.size() >= MAX_SHARD_SIZE)
+    {
+        shard.strings.clear();
+    }
+
+    shard.strings.insert(str);
+    return str;
+}
+
+size_t StringInterner::size()
+{
+    size_t total = 0;
+    for (auto &shard : this->shards_)
+    {
+        std::lock_guard lock(shard.mutex);
+        total += shard.strings.size();
+    }
+    return total;
+}
+
+}  // namespace chatterino
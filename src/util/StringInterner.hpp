@@ -0,0 +1,52 @@
+#pragma once
+
+#include <QString>
+
+#include <array>
+#include <mutex>
+#include <unordered_set>
+
+namespace chatterino {
+
+/**
+ * @brief Deduplicates frequently repeated strings
+ *
+ * Interned strings share their buffer with every other string of the same
+ * contents that went through the interner, which saves one allocation per
+ * copy for things like user and channel names that are stored on every
+ * message.
+ *
+ * The pool is bounded: once a shard is full it's cleared. Strings that were
+ * handed out before keep their buffer, they just won't be shared with newer
+ * ones anymore.
+ *
+ * This class is thread safe.
+ */
+class StringInterner
+{
+public:
+    static constexpr size_t SHARD_COUNT = 16;
+    static constexpr size_t MAX_SHARD_SIZE = 4096;
+
+    static StringInterner &instance();
+
+    /// Returns a string equal to `str` that shares its buffer with previous
+    /// interned strings of the same contents. Null and empty strings aren't
+    /// pooled, they're returned as a null string.
+    QString intern(const QString &str);
+
+    /// Number of strings currently in the pool
+    size_t size();
+
+private:
+    StringInterner() = default;
+
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_set<QString> strings;
+    };
+
+    std::array<Shard, SHARD_COUNT> shards_;
+};
+
+}  // namespace chatterino
@@ -283,7 +283,7 @@ void Window::addDebugStuff(HotkeyController::HotkeyMap &actions)
             auto oMessage =
                 parsePubSubBaseMessage(getSampleChannelRewardMessage());
             auto oInnerMessage =
-                oMessage->toInner<PubSubMessageMessage>()
+                oMessage->data
                     ->toInner<PubSubCommunityPointsChannelV1Message>();
 
             app->twitch->addFakeMessage(getSampleChannelRewardIRCMessage());
@@ -296,7 +296,7 @@ void Window::addDebugStuff(HotkeyController::HotkeyMap &actions)
             auto oMessage =
                 parsePubSubBaseMessage(getSampleChannelRewardMessage2());
             auto oInnerMessage =
-                oMessage->toInner<PubSubMessageMessage>()
+                oMessage->data
                     ->toInner<PubSubCommunityPointsChannelV1Message>();
             getIApp()->getTwitchPubSub()->pointReward.redeemed.invoke(
                 oInnerMessage->data.value("redemption").toObject());
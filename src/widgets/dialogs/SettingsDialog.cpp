@@ -435,7 +435,7 @@ void SettingsDialog::onOkClicked()
     if (!getApp()->getArgs().dontSaveSettings)
     {
         getIApp()->getCommands()->save();
-        pajlada::Settings::SettingManager::gSave();
+        getSettings()->requestSave();
     }
     this->close();
 }
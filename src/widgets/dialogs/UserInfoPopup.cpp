@@ -42,6 +42,9 @@
 #include <QNetworkReply>
 #include <QPointer>
 
+#include <algorithm>
+#include <unordered_set>
+
 const QString TEXT_FOLLOWERS("Followers: %1");
 const QString TEXT_CREATED("Created: %1");
 const QString TEXT_TITLE("%1's Usercard - #%2");
@@ -97,8 +100,19 @@ namespace {
 
     ChannelPtr filterMessages(const QString &userName, ChannelPtr channel)
     {
-        LimitedQueueSnapshot<MessagePtr> snapshot =
-            channel->getMessageSnapshot();
+        // The index has the user's own messages and the ones targeting them
+        // (timeouts, subscriptions), so the messages don't have to be checked
+        // one by one
+        const auto &index = channel->messageIndex();
+        std::unordered_set<const Message *> found;
+        for (const auto &message : index.findByAuthor(userName))
+        {
+            found.insert(message.get());
+        }
+        for (const auto &message : index.findByTarget(userName))
+        {
+            found.insert(message.get());
+        }
 
         ChannelPtr channelPtr;
         if (channel->isTwitchChannel())
@@ -111,16 +125,25 @@ namespace {
                                                    Channel::Type::None);
         }
 
-        for (size_t i = 0; i < snapshot.size(); i++)
+        // System messages don't have a received time, so the snapshot is the
+        // only thing that has the messages in order
+        if (!found.empty())
         {
-            MessagePtr message = snapshot[i];
+            for (const auto &message : channel->getMessageSnapshot())
+            {
+                if (!found.contains(message.get()))
+                {
+                    continue;
+                }
 
-            auto overrideFlags = std::optional<MessageFlags>(message->flags);
-            overrideFlags->set(MessageFlag::DoNotLog);
+                auto overrideFlags =
+                    std::optional<MessageFlags>(message->flags);
+                overrideFlags->set(MessageFlag::DoNotLog);
 
-            if (checkMessageUserName(userName, message))
-            {
-                channelPtr->addMessage(message, overrideFlags);
+                if (checkMessageUserName(userName, message))
+                {
+                    channelPtr->addMessage(message, overrideFlags);
+                }
             }
         }
 
@@ -1060,6 +1083,7 @@ void UserInfoPopup::loadSevenTVAvatar(const HelixUser &user)
 {
     NetworkRequest(SEVENTV_USER_API.arg(user.id))
         .timeout(20000)
+        .priority(QNetworkRequest::HighPriority)
         .onSuccess([this, hack = std::weak_ptr<bool>(this->lifetimeHack_)](
                        const NetworkResult &result) {
             if (!hack.lock())
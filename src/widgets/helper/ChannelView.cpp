@@ -13,6 +13,7 @@
 #include "messages/layouts/MessageLayout.hpp"
 #include "messages/layouts/MessageLayoutContext.hpp"
 #include "messages/layouts/MessageLayoutElement.hpp"
+#include "messages/layouts/MessageLayoutWorker.hpp"
 #include "messages/LimitedQueueSnapshot.hpp"
 #include "messages/Message.hpp"
 #include "messages/MessageBuilder.hpp"
@@ -30,6 +31,7 @@
 #include "singletons/Theme.hpp"
 #include "singletons/WindowManager.hpp"
 #include "util/Clipboard.hpp"
+#include "util/DebugCount.hpp"
 #include "util/DistanceBetweenPoints.hpp"
 #include "util/Helpers.hpp"
 #include "util/IncognitoBrowser.hpp"
@@ -53,11 +55,13 @@
 #include <QDate>
 #include <QDebug>
 #include <QDesktopServices>
+#include <QElapsedTimer>
 #include <QEasingCurve>
 #include <QGraphicsBlurEffect>
 #include <QJsonDocument>
 #include <QMessageBox>
 #include <QPainter>
+#include <QRegion>
 #include <QScreen>
 #include <QVariantAnimation>
 
@@ -65,6 +69,7 @@
 #include <chrono>
 #include <cmath>
 #include <functional>
+#include <limits>
 #include <memory>
 
 #define SELECTION_RESUME_SCROLLING_MSG_THRESHOLD 3
@@ -77,6 +82,11 @@ using namespace chatterino;
 
 constexpr int SCROLLBAR_PADDING = 8;
 
+/// Time a view may spend painting per GIF timer tick. Views that take
+/// longer skip ticks, so their animations run at a lower frame rate instead
+/// of starving the GUI thread.
+constexpr double ANIMATION_PAINT_BUDGET_MICROS = 4000;
+
 void addEmoteContextMenuItems(QMenu *menu, const Emote &emote,
                               MessageElementFlags creatorFlags)
 {
@@ -364,6 +374,14 @@ ChannelView::ChannelView(InternalCtor /*tag*/, QWidget *parent, Split *split,
     this->clickTimer_.setSingleShot(true);
     this->clickTimer_.setInterval(500);
 
+    // Messages arriving within one frame are added in a single batch
+    this->pendingMessagesTimer_.setSingleShot(true);
+    this->pendingMessagesTimer_.setInterval(PENDING_MESSAGES_INTERVAL);
+    QObject::connect(&this->pendingMessagesTimer_, &QTimer::timeout, this,
+                     [this] {
+                         this->flushPendingMessages();
+                     });
+
     this->scrollTimer_.setInterval(20);
     QObject::connect(&this->scrollTimer_, &QTimer::timeout, this, [this] {
         this->scrollUpdateRequested();
@@ -441,10 +459,7 @@ void ChannelView::initializeSignals()
 
     this->signalHolder_.managedConnect(
         getIApp()->getWindows()->gifRepaintRequested, [&] {
-            if (!this->animationArea_.isEmpty())
-            {
-                this->queueUpdate(this->animationArea_);
-            }
+            this->repaintAnimatedRegions();
         });
 
     this->signalHolder_.managedConnect(
@@ -457,6 +472,14 @@ void ChannelView::initializeSignals()
             }
         });
 
+    this->signalHolder_.managedConnect(
+        MessageLayoutWorker::instance().measured, [this] {
+            if (this->isVisible())
+            {
+                this->queueLayout();
+            }
+        });
+
     this->signalHolder_.managedConnect(
         getIApp()->getWindows()->invalidateBuffersRequested,
         [this](Channel *channel) {
@@ -734,6 +757,10 @@ void ChannelView::updateScrollbar(
     auto flags = this->getFlags();
     auto layoutWidth = this->getLayoutWidth();
     auto showScrollbar = false;
+    // The messages at the bottom are about to be shown if we're showing the
+    // latest messages, otherwise they're only needed for their height
+    auto measuring = this->showingLatestMessages_ ? TextMeasuring::Now
+                                                  : TextMeasuring::InBackground;
 
     // convert i to int since it checks >= 0
     for (auto i = int(messages.size()) - 1; i >= 0; i--)
@@ -743,7 +770,7 @@ void ChannelView::updateScrollbar(
         message->layout(
             layoutWidth, this->scale(),
             this->scale() * static_cast<float>(this->devicePixelRatio()), flags,
-            false);
+            false, measuring);
 
         h -= message->getHeight();
 
@@ -904,6 +931,8 @@ void ChannelView::setChannel(const ChannelPtr &underlyingChannel)
 {
     /// Clear connections from the last channel
     this->channelConnections_.clear();
+    this->pendingMessages_.clear();
+    this->pendingMessagesTimer_.stop();
 
     this->clearMessages();
     this->scrollBar_->clearHighlights();
@@ -921,36 +950,18 @@ void ChannelView::setChannel(const ChannelPtr &underlyingChannel)
         underlyingChannel->messageAppended,
         [this](MessagePtr &message,
                std::optional<MessageFlags> overridingFlags) {
-            if (this->shouldIncludeMessage(message))
+            this->pendingMessages_.push_back({message, overridingFlags});
+            if (!this->pendingMessagesTimer_.isActive())
             {
-                if (this->channel_->lastDate_ != QDate::currentDate())
-                {
-                    this->channel_->lastDate_ = QDate::currentDate();
-                    auto msg = makeSystemMessage(
-                        QLocale().toString(QDate::currentDate(),
-                                           QLocale::LongFormat),
-                        QTime(0, 0));
-                    this->channel_->addMessage(msg);
-                }
-                // When the message was received in the underlyingChannel,
-                // logging will be handled. Prevent duplications.
-                if (overridingFlags)
-                {
-                    overridingFlags->set(MessageFlag::DoNotLog);
-                }
-                else
-                {
-                    overridingFlags = MessageFlags(message->flags);
-                    overridingFlags->set(MessageFlag::DoNotLog);
-                }
-
-                this->channel_->addMessage(message, overridingFlags);
+                this->pendingMessagesTimer_.start();
             }
         });
 
     this->channelConnections_.managedConnect(
         underlyingChannel->messagesAddedAtStart,
         [this](std::vector<MessagePtr> &messages) {
+            this->flushPendingMessages();
+
             std::vector<MessagePtr> filtered;
             std::copy_if(messages.begin(), messages.end(),
                          std::back_inserter(filtered), [this](const auto &msg) {
@@ -966,6 +977,8 @@ void ChannelView::setChannel(const ChannelPtr &underlyingChannel)
     this->channelConnections_.managedConnect(
         underlyingChannel->messageReplaced,
         [this](auto index, const auto &replacement) {
+            this->flushPendingMessages();
+
             if (this->shouldIncludeMessage(replacement))
             {
                 this->channel_->replaceMessage(index, replacement);
@@ -974,6 +987,8 @@ void ChannelView::setChannel(const ChannelPtr &underlyingChannel)
 
     this->channelConnections_.managedConnect(
         underlyingChannel->filledInMessages, [this](const auto &messages) {
+            this->flushPendingMessages();
+
             std::vector<MessagePtr> filtered;
             filtered.reserve(messages.size());
             std::copy_if(messages.begin(), messages.end(),
@@ -1027,10 +1042,9 @@ void ChannelView::setChannel(const ChannelPtr &underlyingChannel)
 
     // on new message
     this->channelConnections_.managedConnect(
-        this->channel_->messageAppended,
-        [this](MessagePtr &message,
-               std::optional<MessageFlags> overridingFlags) {
-            this->messageAppended(message, overridingFlags);
+        this->channel_->messagesAppended,
+        [this](std::span<const AppendedMessage> messages) {
+            this->messagesAppended(messages);
         });
 
     this->channelConnections_.managedConnect(
@@ -1124,77 +1138,148 @@ bool ChannelView::hasSourceChannel() const
     return this->sourceChannel_ != nullptr;
 }
 
-void ChannelView::messageAppended(MessagePtr &message,
-                                  std::optional<MessageFlags> overridingFlags)
+void ChannelView::flushPendingMessages()
 {
-    auto *messageFlags = &message->flags;
-    if (overridingFlags)
+    this->pendingMessagesTimer_.stop();
+    if (this->pendingMessages_.empty())
     {
-        messageFlags = &*overridingFlags;
+        return;
     }
 
-    auto messageRef = std::make_shared<MessageLayout>(message);
+    std::vector<AppendedMessage> batch;
+    batch.reserve(this->pendingMessages_.size());
+    for (auto &[message, overridingFlags] : this->pendingMessages_)
+    {
+        if (!this->shouldIncludeMessage(message))
+        {
+            continue;
+        }
 
-    if (this->lastMessageHasAlternateBackground_)
+        if (this->channel_->lastDate_ != QDate::currentDate())
+        {
+            this->channel_->lastDate_ = QDate::currentDate();
+            auto msg = makeSystemMessage(
+                QLocale().toString(QDate::currentDate(), QLocale::LongFormat),
+                QTime(0, 0));
+            batch.push_back({std::move(msg), std::nullopt});
+        }
+        // When the message was received in the underlyingChannel,
+        // logging will be handled. Prevent duplications.
+        if (overridingFlags)
+        {
+            overridingFlags->set(MessageFlag::DoNotLog);
+        }
+        else
+        {
+            overridingFlags = MessageFlags(message->flags);
+            overridingFlags->set(MessageFlag::DoNotLog);
+        }
+
+        batch.push_back({std::move(message), overridingFlags});
+    }
+    this->pendingMessages_.clear();
+
+    this->channel_->addMessages(batch);
+}
+
+void ChannelView::messagesAppended(std::span<const AppendedMessage> messages)
+{
+    size_t nAdded = 0;
+    size_t nRemoved = 0;
+    std::optional<HighlightState> tabHighlight;
+
+    for (const auto &[message, overridingFlags] : messages)
     {
-        messageRef->flags.set(MessageLayoutFlag::AlternateBackground);
+        const auto &messageFlags =
+            overridingFlags ? *overridingFlags : message->flags;
+
+        auto messageRef = std::make_shared<MessageLayout>(message);
+        if (this->isVisible())
+        {
+            // Start measuring now so the text is ready by the time it's
+            // scrolled into view. Hidden views measure once they're shown.
+            MessageLayoutWorker::instance().measure(messageRef, this->scale());
+        }
+
+        if (this->lastMessageHasAlternateBackground_)
+        {
+            messageRef->flags.set(MessageLayoutFlag::AlternateBackground);
+        }
+        if (this->channel_->shouldIgnoreHighlights())
+        {
+            messageRef->flags.set(MessageLayoutFlag::IgnoreHighlights);
+        }
+        this->lastMessageHasAlternateBackground_ =
+            !this->lastMessageHasAlternateBackground_;
+
+        nAdded++;
+        if (this->messages_.pushBack(messageRef))
+        {
+            nRemoved++;
+        }
+
+        if (!messageFlags.has(MessageFlag::DoNotTriggerNotification))
+        {
+            if ((messageFlags.has(MessageFlag::Highlighted) &&
+                 messageFlags.has(MessageFlag::ShowInMentions) &&
+                 !messageFlags.has(MessageFlag::Subscription) &&
+                 (getSettings()->highlightMentions ||
+                  this->channel_->getType() !=
+                      Channel::Type::TwitchMentions)) ||
+                (this->channel_->getType() == Channel::Type::TwitchAutomod &&
+                 getSettings()->enableAutomodHighlight))
+            {
+                tabHighlight = HighlightState::Highlighted;
+            }
+            else if (!tabHighlight)
+            {
+                tabHighlight = HighlightState::NewMessage;
+            }
+        }
+
+        if (this->showScrollbarHighlights())
+        {
+            this->scrollBar_->addHighlight(message->getScrollBarHighlight());
+        }
     }
-    if (this->channel_->shouldIgnoreHighlights())
+
+    if (nAdded == 0)
     {
-        messageRef->flags.set(MessageLayoutFlag::IgnoreHighlights);
+        return;
     }
-    this->lastMessageHasAlternateBackground_ =
-        !this->lastMessageHasAlternateBackground_;
 
+    // Update the scrollbar once for the whole batch
     if (this->paused())
     {
-        this->pauseScrollMaximumOffset_++;
+        this->pauseScrollMaximumOffset_ += int(nAdded);
     }
     else
     {
-        this->scrollBar_->offsetMaximum(1);
+        this->scrollBar_->offsetMaximum(qreal(nAdded));
     }
 
-    if (this->messages_.pushBack(messageRef))
+    if (nRemoved > 0)
     {
         if (this->paused())
         {
-            this->pauseScrollMinimumOffset_++;
-            this->pauseSelectionOffset_++;
+            this->pauseScrollMinimumOffset_ += int(nRemoved);
+            this->pauseSelectionOffset_ += uint32_t(nRemoved);
         }
         else
         {
-            this->scrollBar_->offsetMinimum(1);
+            this->scrollBar_->offsetMinimum(qreal(nRemoved));
             if (this->showingLatestMessages_ && !this->isVisible())
             {
                 this->scrollBar_->scrollToBottom(false);
             }
-            this->selection_.shiftMessageIndex(1);
-            this->doubleClickSelection_.shiftMessageIndex(1);
-        }
-    }
-
-    if (!messageFlags->has(MessageFlag::DoNotTriggerNotification))
-    {
-        if ((messageFlags->has(MessageFlag::Highlighted) &&
-             messageFlags->has(MessageFlag::ShowInMentions) &&
-             !messageFlags->has(MessageFlag::Subscription) &&
-             (getSettings()->highlightMentions ||
-              this->channel_->getType() != Channel::Type::TwitchMentions)) ||
-            (this->channel_->getType() == Channel::Type::TwitchAutomod &&
-             getSettings()->enableAutomodHighlight))
-        {
-            this->tabHighlightRequested.invoke(HighlightState::Highlighted);
-        }
-        else
-        {
-            this->tabHighlightRequested.invoke(HighlightState::NewMessage);
+            this->selection_.shiftMessageIndex(nRemoved);
+            this->doubleClickSelection_.shiftMessageIndex(nRemoved);
         }
     }
 
-    if (this->showScrollbarHighlights())
+    if (tabHighlight)
     {
-        this->scrollBar_->addHighlight(message->getScrollBarHighlight());
+        this->tabHighlightRequested.invoke(*tabHighlight);
     }
 
     this->queueLayout();
@@ -1505,6 +1590,9 @@ void ChannelView::paintEvent(QPaintEvent *event)
 {
     //    BenchmarkGuard benchmark("paint");
 
+    QElapsedTimer paintTimer;
+    paintTimer.start();
+
     QPainter painter(this);
 
     painter.fillRect(rect(), this->theme->splits.background);
@@ -1520,6 +1608,73 @@ void ChannelView::paintEvent(QPaintEvent *event)
         painter.fillRect(QRectF(5, a / 4, a / 4, a), brush);
         painter.fillRect(QRectF(15, a / 4, a / 4, a), brush);
     }
+
+    auto micros = double(paintTimer.nsecsElapsed()) / 1000.0;
+    this->averagePaintMicros_ = this->averagePaintMicros_ == 0
+                                    ? micros
+                                    : this->averagePaintMicros_ * 0.8 +
+                                          micros * 0.2;
+    DebugCount::increase("channel view paints");
+    DebugCount::increase("channel view paint time (us)", int64_t(micros));
+
+    if (getSettings()->showPaintTimes)
+    {
+        this->drawPaintTimes(painter);
+    }
+}
+
+void ChannelView::repaintAnimatedRegions()
+{
+    if (this->animationTicksToSkip_ > 0)
+    {
+        // The frames keep advancing, the next tick catches up on them
+        this->animationTicksToSkip_--;
+        this->skippedAnimationTicks_++;
+        DebugCount::increase("skipped animation ticks");
+        return;
+    }
+
+    QRegion damage;
+    for (const auto &region : this->animatedRegions_)
+    {
+        if (region.advanced())
+        {
+            damage += region.rect;
+        }
+    }
+
+    if (damage.isEmpty())
+    {
+        return;
+    }
+
+    if (getSettings()->showPaintTimes)
+    {
+        damage += this->paintTimesRect();
+    }
+
+    this->update(damage);
+    this->animationTicksToSkip_ =
+        int(this->averagePaintMicros_ / ANIMATION_PAINT_BUDGET_MICROS);
+}
+
+QRect ChannelView::paintTimesRect() const
+{
+    auto width = int(160 * this->scale());
+    auto height = int(20 * this->scale());
+    return {this->width() - width - int(SCROLLBAR_PADDING * this->scale()), 0,
+            width, height};
+}
+
+void ChannelView::drawPaintTimes(QPainter &painter)
+{
+    auto rect = this->paintTimesRect();
+    painter.fillRect(rect, QColor(0, 0, 0, 160));
+    painter.setPen(Qt::white);
+    painter.drawText(rect, Qt::AlignCenter,
+                     QString("%1 ms/paint, %2 ticks skipped")
+                         .arg(this->averagePaintMicros_ / 1000.0, 0, 'f', 2)
+                         .arg(this->skippedAnimationTicks_));
 }
 
 // if overlays is false then it draws the message, if true then it draws things
@@ -1532,10 +1687,12 @@ void ChannelView::drawMessages(QPainter &painter, const QRect &area)
 
     if (start >= messagesSnapshot.size())
     {
+        this->animatedRegions_.clear();
         return;
     }
 
     MessageLayout *end = nullptr;
+    std::vector<AnimatedRegion> animatedRegions;
 
     MessagePaintContext ctx = {
         .painter = painter,
@@ -1553,11 +1710,13 @@ void ChannelView::drawMessages(QPainter &painter, const QRect &area)
                    (fmod(this->scrollBar_->getRelativeCurrentValue(), 1)))),
         .messageIndex = start,
         .isLastReadMessage = false,
-
+        .animatedRegions = &animatedRegions,
     };
     bool showLastMessageIndicator = getSettings()->showLastMessageIndicator;
 
-    QRect animationArea;
+    // vertical span of the messages painted in this pass
+    int paintedTop = std::numeric_limits<int>::max();
+    int paintedBottom = std::numeric_limits<int>::min();
     auto areaContainsY = [&area](auto y) {
         return y >= area.y() && y < area.y() + area.height();
     };
@@ -1579,21 +1738,10 @@ void ChannelView::drawMessages(QPainter &painter, const QRect &area)
             areaContainsY(ctx.y + layout->getHeight()) ||
             (ctx.y < area.y() && layout->getHeight() > area.height()))
         {
-            auto paintResult = layout->paint(ctx);
-            if (paintResult.hasAnimatedElements)
-            {
-                if (animationArea.isNull())
-                {
-                    animationArea = QRect{0, ctx.y, layout->getWidth(),
-                                          layout->getHeight()};
-                }
-                else
-                {
-                    animationArea.setBottom(ctx.y + layout->getHeight());
-                    animationArea.setWidth(
-                        std::max(layout->getWidth(), animationArea.width()));
-                }
-            }
+            layout->paint(ctx);
+            paintedTop = std::min(paintedTop, ctx.y);
+            paintedBottom =
+                std::max(paintedBottom, ctx.y + layout->getHeight());
 
             if (this->highlightedMessage_ == layout)
             {
@@ -1617,12 +1765,23 @@ void ChannelView::drawMessages(QPainter &painter, const QRect &area)
         }
     }
 
-    // Only update on a full repaint as some messages with animated elements
-    // might get left out in partial repaints.
-    // This happens for example when hovering over the go-to-bottom button.
     if (this->height() <= area.height())
     {
-        this->animationArea_ = animationArea;
+        this->animatedRegions_ = std::move(animatedRegions);
+    }
+    else if (paintedTop < paintedBottom)
+    {
+        // Partial repaints (e.g. hovering over the go-to-bottom button or
+        // animation ticks) only replace the regions of the messages that
+        // were painted again.
+        std::erase_if(this->animatedRegions_, [&](const auto &region) {
+            return region.rect.top() < paintedBottom &&
+                   region.rect.bottom() >= paintedTop;
+        });
+        this->animatedRegions_.insert(
+            this->animatedRegions_.end(),
+            std::make_move_iterator(animatedRegions.begin()),
+            std::make_move_iterator(animatedRegions.end()));
     }
 #ifdef FOURTF
     else
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "common/Channel.hpp"
 #include "common/FlagsEnum.hpp"
 #include "messages/layouts/MessageLayoutContext.hpp"
 #include "messages/LimitedQueue.hpp"
@@ -19,6 +20,7 @@
 #include <QWheelEvent>
 #include <QWidget>
 
+#include <chrono>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -78,6 +80,10 @@ public:
         Search,
     };
 
+    /// Messages appended to the underlying channel within this interval are
+    /// added to the view in one batch
+    static constexpr std::chrono::milliseconds PENDING_MESSAGES_INTERVAL{16};
+
     /// Creates a channel view without a split.
     /// In such a view, usercards and reply-threads can't be opened.
     ///
@@ -241,8 +247,9 @@ private:
     void initializeScrollbar();
     void initializeSignals();
 
-    void messageAppended(MessagePtr &message,
-                         std::optional<MessageFlags> overridingFlags);
+    void messagesAppended(std::span<const AppendedMessage> messages);
+    /// Adds the messages queued from the underlying channel to channel_
+    void flushPendingMessages();
     void messageAddedAtStart(std::vector<MessagePtr> &messages);
     void messageRemoveFromStart(MessagePtr &message);
     void messageReplaced(size_t index, MessagePtr &replacement);
@@ -256,6 +263,10 @@ private:
                          bool causedByScrollbar, bool causedByShow);
 
     void drawMessages(QPainter &painter, const QRect &area);
+    /// Repaints the animated elements that advanced to another frame
+    void repaintAnimatedRegions();
+    void drawPaintTimes(QPainter &painter);
+    QRect paintTimesRect() const;
     void setSelection(const SelectionItem &start, const SelectionItem &end);
     void setSelection(const Selection &newSelection);
     void selectWholeMessage(MessageLayout *layout, int &messageIndex);
@@ -297,9 +308,20 @@ private:
     bool lastMessageHasAlternateBackground_ = false;
     bool lastMessageHasAlternateBackgroundReverse_ = true;
 
-    /// Tracks the area of animated elements in the last full repaint.
-    /// If this is empty (QRect::isEmpty()), no animated element is shown.
-    QRect animationArea_;
+    /// The animated elements shown in the view as of the last repaints.
+    /// GIF timer ticks only repaint the ones that advanced.
+    std::vector<AnimatedRegion> animatedRegions_;
+
+    /// Moving average of the time a paint takes in microseconds
+    double averagePaintMicros_ = 0;
+    /// GIF timer ticks to skip because painting exceeded the budget
+    int animationTicksToSkip_ = 0;
+    size_t skippedAnimationTicks_ = 0;
+
+    /// Messages from the underlying channel that arrived since the last frame.
+    /// They're filtered and added in one batch by flushPendingMessages.
+    std::vector<AppendedMessage> pendingMessages_;
+    QTimer pendingMessagesTimer_;
 
     bool pausable_ = false;
     QTimer pauseTimer_;
@@ -22,43 +22,142 @@
 #include <QLineEdit>
 #include <QPushButton>
 
+#include <algorithm>
+
 namespace chatterino {
 
-ChannelPtr SearchPopup::filter(const QString &text, const QString &channelName,
-                               const LimitedQueueSnapshot<MessagePtr> &snapshot)
+namespace {
+
+bool matchesAll(
+    const std::vector<std::unique_ptr<MessagePredicate>> &predicates,
+    const Message &message)
 {
-    ChannelPtr channel(new Channel(channelName, Channel::Type::None));
+    // Discard the message as soon as one predicate fails
+    return std::all_of(predicates.begin(), predicates.end(),
+                       [&](const auto &pred) {
+                           return pred->appliesTo(message);
+                       });
+}
+
+/// Removes duplicate messages from splits showing the same channel and sorts
+/// the rest by time
+void mergeChannels(std::vector<MessagePtr> &messages)
+{
+    std::sort(messages.begin(), messages.end(),
+              [](const MessagePtr &a, const MessagePtr &b) {
+                  return a->id > b->id;
+              });
+
+    auto uniqueIterator =
+        std::unique(messages.begin(), messages.end(),
+                    [](const MessagePtr &a, const MessagePtr &b) {
+                        // nullptr check prevents system messages from being dropped
+                        return (a->id != nullptr) && a->id == b->id;
+                    });
+
+    messages.erase(uniqueIterator, messages.end());
+
+    // resort by time for presentation
+    std::sort(messages.begin(), messages.end(),
+              [](const MessagePtr &a, const MessagePtr &b) {
+                  return a->serverReceivedTime < b->serverReceivedTime;
+              });
+}
+
+void addResult(Channel &channel, const MessagePtr &message)
+{
+    auto overrideFlags = std::optional<MessageFlags>(message->flags);
+    overrideFlags->set(MessageFlag::DoNotLog);
+
+    channel.addMessage(message, overrideFlags);
+}
 
-    // Parse predicates from tags in "text"
-    auto predicates = parsePredicates(text);
+}  // namespace
+
+ChannelPtr SearchPopup::filter(
+    const std::vector<std::unique_ptr<MessagePredicate>> &predicates,
+    const QString &channelName,
+    const LimitedQueueSnapshot<MessagePtr> &snapshot)
+{
+    ChannelPtr channel(new Channel(channelName, Channel::Type::None));
 
     // Check for every message whether it fulfills all predicates that have
     // been registered
     for (size_t i = 0; i < snapshot.size(); ++i)
     {
-        MessagePtr message = snapshot[i];
+        const MessagePtr &message = snapshot[i];
+
+        // If all predicates match, add the message to the channel
+        if (matchesAll(predicates, *message))
+        {
+            addResult(*channel, message);
+        }
+    }
+
+    return channel;
+}
+
+ChannelPtr SearchPopup::filterIndexed(
+    const std::vector<std::unique_ptr<MessagePredicate>> &predicates) const
+{
+    if (this->searchChannels_.empty())
+    {
+        return nullptr;
+    }
 
-        bool accept = true;
+    const bool multipleChannels = this->searchChannels_.size() > 1;
+    std::vector<MessagePtr> results;
+    for (const auto &view : this->searchChannels_)
+    {
+        const auto sourceChannel = view.get().channel();
+
+        // Only the most selective predicate is looked up, the others are
+        // checked on its candidates below
+        std::optional<std::vector<MessagePtr>> smallest;
         for (const auto &pred : predicates)
         {
-            // Discard the message as soon as one predicate fails
-            if (!pred->appliesTo(*message))
+            auto candidates = pred->candidates(sourceChannel->messageIndex());
+            if (candidates &&
+                (!smallest || candidates->size() < smallest->size()))
             {
-                accept = false;
-                break;
+                smallest = std::move(candidates);
             }
         }
 
-        // If all predicates match, add the message to the channel
-        if (accept)
+        if (!smallest)
+        {
+            return nullptr;
+        }
+
+        // Like in buildSnapshot, the filters of the splits only apply when
+        // searching multiple channels
+        const FilterSetPtr filterSet = view.get().getFilterSet();
+        for (const auto &message : *smallest)
         {
-            auto overrideFlags = std::optional<MessageFlags>(message->flags);
-            overrideFlags->set(MessageFlag::DoNotLog);
+            if (multipleChannels && filterSet &&
+                !filterSet->filter(message, sourceChannel))
+            {
+                continue;
+            }
 
-            channel->addMessage(message, overrideFlags);
+            if (matchesAll(predicates, *message))
+            {
+                results.push_back(message);
+            }
         }
     }
 
+    if (multipleChannels)
+    {
+        mergeChannels(results);
+    }
+
+    ChannelPtr channel(new Channel(this->channelName_, Channel::Type::None));
+    for (const auto &message : results)
+    {
+        addResult(*channel, message);
+    }
+
     return channel;
 }
 
@@ -214,13 +313,20 @@ bool SearchPopup::eventFilter(QObject *object, QEvent *event)
 
 void SearchPopup::search()
 {
-    if (this->snapshot_.size() == 0)
+    // Parse predicates from tags in the search input
+    auto predicates = parsePredicates(this->searchInput_->text());
+
+    auto channel = this->filterIndexed(predicates);
+    if (!channel)
     {
-        this->snapshot_ = this->buildSnapshot();
+        if (this->snapshot_.size() == 0)
+        {
+            this->snapshot_ = this->buildSnapshot();
+        }
+        channel = filter(predicates, this->channelName_, this->snapshot_);
     }
 
-    this->channelView_->setChannel(filter(this->searchInput_->text(),
-                                          this->channelName_, this->snapshot_));
+    this->channelView_->setChannel(channel);
 }
 
 LimitedQueueSnapshot<MessagePtr> SearchPopup::buildSnapshot()
@@ -254,26 +360,7 @@ LimitedQueueSnapshot<MessagePtr> SearchPopup::buildSnapshot()
         }
     }
 
-    // remove any duplicate messages from splits containing the same channel
-    std::sort(combinedSnapshot.begin(), combinedSnapshot.end(),
-              [](MessagePtr &a, MessagePtr &b) {
-                  return a->id > b->id;
-              });
-
-    auto uniqueIterator =
-        std::unique(combinedSnapshot.begin(), combinedSnapshot.end(),
-                    [](MessagePtr &a, MessagePtr &b) {
-                        // nullptr check prevents system messages from being dropped
-                        return (a->id != nullptr) && a->id == b->id;
-                    });
-
-    combinedSnapshot.erase(uniqueIterator, combinedSnapshot.end());
-
-    // resort by time for presentation
-    std::sort(combinedSnapshot.begin(), combinedSnapshot.end(),
-              [](MessagePtr &a, MessagePtr &b) {
-                  return a->serverReceivedTime < b->serverReceivedTime;
-              });
+    mergeChannels(combinedSnapshot);
 
     auto queue = LimitedQueue<MessagePtr>(combinedSnapshot.size());
     queue.pushFront(combinedSnapshot);
@@ -43,16 +43,29 @@ private:
      * @brief Only retains those message from a list of messages that satisfy a
      *        search query.
      *
-     * @param text          the search query -- will be parsed for MessagePredicates
+     * @param predicates    the predicates parsed from the search query
      * @param channelName   name of the channel to be returned
      * @param snapshot      list of messages to filter
-     * @param filterSet     channel filter to apply
      *
      * @return a ChannelPtr with "channelName" and the filtered messages from
      *         "snapshot"
      */
-    static ChannelPtr filter(const QString &text, const QString &channelName,
-                             const LimitedQueueSnapshot<MessagePtr> &snapshot);
+    static ChannelPtr filter(
+        const std::vector<std::unique_ptr<MessagePredicate>> &predicates,
+        const QString &channelName,
+        const LimitedQueueSnapshot<MessagePtr> &snapshot);
+
+    /**
+     * @brief Answers a search query from the message indices of the searched
+     *        channels instead of scanning their messages.
+     *
+     * The messages are returned in the same order as from filter().
+     *
+     * @return a ChannelPtr with "channelName" and the matching messages, or
+     *         nullptr if none of the predicates can use the index
+     */
+    ChannelPtr filterIndexed(
+        const std::vector<std::unique_ptr<MessagePredicate>> &predicates) const;
 
     /**
      * @brief Checks the input for tags and registers their corresponding
@@ -64,6 +77,7 @@ private:
     static std::vector<std::unique_ptr<MessagePredicate>> parsePredicates(
         const QString &input);
 
+    /// Only built for searches that can't use the message indices
     LimitedQueueSnapshot<MessagePtr> snapshot_;
     QLineEdit *searchInput_{};
     ChannelView *channelView_{};
@@ -6,6 +6,7 @@
 #include "controllers/hotkeys/HotkeyCategory.hpp"
 #include "controllers/hotkeys/HotkeyController.hpp"
 #include "controllers/sound/ISoundController.hpp"
+#include "messages/ImageCache.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
 #include "providers/twitch/TwitchIrcServer.hpp"
 #include "singletons/CrashHandler.hpp"
@@ -872,6 +873,7 @@ void GeneralPage::initLayout(GeneralPageView &layout)
 
             if (reply == QMessageBox::Yes)
             {
+                ImageCache::instance().unload();
                 auto cacheDir = QDir(getIApp()->getPaths().cacheDirectory());
                 cacheDir.removeRecursively();
                 cacheDir.mkdir(getIApp()->getPaths().cacheDirectory());
@@ -882,6 +884,12 @@ void GeneralPage::initLayout(GeneralPageView &layout)
         layout.addLayout(box);
     }
 
+    layout.addIntInput(
+        "Image cache size (MiB)", s.imageCacheBudgetMb, 0, 16384, 64,
+        "Decoded emotes and badges are stored on disk so they don't have to "
+        "be downloaded and decoded again. The least recently used images are "
+        "removed once this size is reached. Set to 0 to disable.");
+
     layout.addTitle("Advanced");
 
     layout.addSubtitle("Chat title");
@@ -1150,6 +1158,23 @@ void GeneralPage::initLayout(GeneralPageView &layout)
                        "connect to an IRC server outside of Twitch ");
     layout.addCheckbox("Show unhandled IRC messages",
                        s.showUnhandledIrcMessages);
+    layout.addCheckbox(
+        "Show paint times in chats", s.showPaintTimes, false,
+        "Shows how long painting each chat takes on average and how many "
+        "animation frames were skipped to stay within the paint budget.");
+    layout.addCheckbox(
+        "Pack emote frames into shared textures (experimental)",
+        s.useImageAtlas, false,
+        "Stores frames of 28x28, 56x56 and 112x112 emotes in large shared "
+        "pixmaps instead of one pixmap per frame, reducing memory usage when "
+        "many emotes are loaded. Only applies to newly loaded emotes.");
+    layout.addCheckbox(
+        "Keep a binary copy of settings for faster startup",
+        s.binarySettingsSnapshot, false,
+        "Saves the settings and window layout in a binary format as well, "
+        "which is loaded at startup as long as the JSON files weren't "
+        "changed. The JSON files are still written and can be edited, "
+        "imported and exported as before.");
     layout.addDropdown<int>(
         "Stack timeouts", {"Stack", "Stack until timeout", "Don't stack"},
         s.timeoutStackStyle,
@@ -0,0 +1,136 @@
+#include "util/BinarySnapshot.hpp"
+
+#include "Test.hpp"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+using namespace chatterino;
+
+namespace {
+
+const char *SETTINGS = R"({
+    "appearance": {"uiScale2": 1.25, "theme": "Dark"},
+    "highlighting": {
+        "highlights": [
+            {"pattern": "forsen", "regex": false, "color": "#ff0000"},
+            {"pattern": "ü😂\n\"", "regex": true}
+        ]
+    },
+    "misc": {"startUpNotification": 3, "big": 18446744073709551615,
+             "negative": -5, "nothing": null, "enabled": true}
+})";
+
+const SnapshotSource SOURCE{.size = 1234, .modified = 1700000000000};
+
+}  // namespace
+
+TEST(BinarySnapshot, RapidJsonRoundTrip)
+{
+    rapidjson::Document input;
+    input.Parse(SETTINGS);
+    ASSERT_FALSE(input.HasParseError());
+
+    auto data = encodeBinarySnapshot(input, SOURCE);
+
+    rapidjson::Document output;
+    ASSERT_TRUE(decodeBinarySnapshot(data.constData(), size_t(data.size()),
+                                     SOURCE, output));
+    ASSERT_EQ(input, output);
+    ASSERT_TRUE(output["misc"]["big"].IsUint64());
+    ASSERT_TRUE(output["misc"]["negative"].IsInt());
+    ASSERT_TRUE(output["appearance"]["uiScale2"].IsDouble());
+}
+
+TEST(BinarySnapshot, QJsonRoundTrip)
+{
+    auto input = QJsonDocument::fromJson(SETTINGS).object();
+    input.remove("misc");  // QJsonValue can't represent the big integer
+
+    auto data = encodeBinarySnapshot(QJsonValue(input), SOURCE);
+
+    QJsonValue output;
+    ASSERT_TRUE(decodeBinarySnapshot(data.constData(), size_t(data.size()),
+                                     SOURCE, output));
+    ASSERT_EQ(QJsonValue(input), output);
+}
+
+TEST(BinarySnapshot, RejectsOtherSource)
+{
+    rapidjson::Document input;
+    input.Parse(SETTINGS);
+    auto data = encodeBinarySnapshot(input, SOURCE);
+
+    rapidjson::Document output;
+    auto modified = SOURCE;
+    modified.modified++;
+    ASSERT_FALSE(decodeBinarySnapshot(data.constData(), size_t(data.size()),
+                                      modified, output));
+
+    auto resized = SOURCE;
+    resized.size++;
+    ASSERT_FALSE(decodeBinarySnapshot(data.constData(), size_t(data.size()),
+                                      resized, output));
+
+    // A missing JSON file never matches
+    ASSERT_FALSE(decodeBinarySnapshot(data.constData(), size_t(data.size()),
+                                      SnapshotSource{}, output));
+}
+
+TEST(BinarySnapshot, RejectsCorruptData)
+{
+    rapidjson::Document input;
+    input.Parse(SETTINGS);
+    auto data = encodeBinarySnapshot(input, SOURCE);
+
+    rapidjson::Document output;
+    for (qsizetype size = 0; size < data.size(); size++)
+    {
+        ASSERT_FALSE(
+            decodeBinarySnapshot(data.constData(), size_t(size), SOURCE, output))
+            << size;
+    }
+
+    // an unknown type tag in place of the root object
+    auto garbage = data;
+    garbage[32] = char(0xff);
+    ASSERT_FALSE(decodeBinarySnapshot(garbage.constData(),
+                                      size_t(garbage.size()), SOURCE, output));
+
+    auto otherMagic = data;
+    otherMagic[0] = 'X';
+    ASSERT_FALSE(decodeBinarySnapshot(otherMagic.constData(),
+                                      size_t(otherMagic.size()), SOURCE,
+                                      output));
+}
+
+TEST(BinarySnapshot, ReadsFile)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    auto jsonPath = dir.filePath("settings.json");
+    auto binaryPath = dir.filePath("settings.bin");
+
+    ASSERT_TRUE(writeFileAtomically(jsonPath, SETTINGS));
+    rapidjson::Document input;
+    input.Parse(SETTINGS);
+    ASSERT_TRUE(writeFileAtomically(
+        binaryPath,
+        encodeBinarySnapshot(input, SnapshotSource::of(jsonPath))));
+
+    rapidjson::Document output;
+    ASSERT_TRUE(
+        readBinarySnapshot(binaryPath, SnapshotSource::of(jsonPath), output));
+    ASSERT_EQ(input, output);
+
+    // Editing the JSON file invalidates the snapshot
+    ASSERT_TRUE(writeFileAtomically(jsonPath, "{}"));
+    ASSERT_FALSE(
+        readBinarySnapshot(binaryPath, SnapshotSource::of(jsonPath), output));
+
+    ASSERT_FALSE(readBinarySnapshot(dir.filePath("missing.bin"),
+                                    SnapshotSource::of(jsonPath), output));
+}
@@ -0,0 +1,92 @@
+#include "common/Channel.hpp"
+
+#include "messages/Message.hpp"
+#include "mocks/Channel.hpp"
+#include "singletons/Settings.hpp"
+#include "Test.hpp"
+
+#include <QDateTime>
+
+#include <algorithm>
+#include <unordered_set>
+
+using namespace chatterino;
+using chatterino::mock::MockChannel;
+
+namespace {
+
+MessagePtr makeMessage(int n)
+{
+    auto message = std::make_shared<Message>();
+    message->id = QString("msg-%1").arg(n);
+    message->loginName = QString("user%1").arg(std::abs(n) % 3);
+    message->serverReceivedTime =
+        QDateTime::fromSecsSinceEpoch(1700000000 + n);
+    return message;
+}
+
+}  // namespace
+
+TEST(Channel, FillInMissingMessagesWhenFull)
+{
+    MockChannel channel("forsen");
+    const auto limit = size_t(getSettings()->scrollbackSplitLimit.getValue());
+
+    // The channel is full of the even messages, the odd ones are filled in
+    std::vector<MessagePtr> existing;
+    for (size_t i = 0; i < limit; i++)
+    {
+        existing.push_back(makeMessage(int(i * 2)));
+    }
+    channel.addMessagesAtStart(existing);
+    ASSERT_EQ(channel.getMessageSnapshot().size(), limit);
+
+    // The first one is older than everything in the channel and doesn't fit
+    std::vector<MessagePtr> missing{makeMessage(-1)};
+    for (size_t i = 0; i < limit; i++)
+    {
+        missing.push_back(makeMessage(int(i * 2 + 1)));
+    }
+    channel.fillInMissingMessages(missing);
+
+    auto snapshot = channel.getMessageSnapshot();
+    ASSERT_EQ(snapshot.size(), limit);
+
+    std::unordered_set<MessagePtr> buffered;
+    for (const auto &message : snapshot)
+    {
+        buffered.insert(message);
+        ASSERT_EQ(channel.findMessage(message->id), message);
+    }
+
+    // Evicted messages and the ones that didn't fit aren't indexed
+    for (const auto *messages : {&existing, &missing})
+    {
+        for (const auto &message : *messages)
+        {
+            if (!buffered.contains(message))
+            {
+                ASSERT_EQ(channel.findMessage(message->id), nullptr)
+                    << message->id.toStdString();
+            }
+        }
+    }
+    ASSERT_EQ(channel.findMessage("msg--1"), nullptr);
+
+    size_t indexed = 0;
+    for (const auto *login : {"user0", "user1", "user2"})
+    {
+        auto byAuthor = channel.messageIndex().findByAuthor(login);
+        for (const auto &message : byAuthor)
+        {
+            ASSERT_TRUE(buffered.contains(message));
+        }
+        ASSERT_TRUE(std::is_sorted(byAuthor.begin(), byAuthor.end(),
+                                   [](const auto &a, const auto &b) {
+                                       return a->serverReceivedTime <
+                                              b->serverReceivedTime;
+                                   }));
+        indexed += byAuthor.size();
+    }
+    ASSERT_EQ(indexed, limit);
+}
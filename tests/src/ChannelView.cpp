@@ -0,0 +1,177 @@
+#include "widgets/helper/ChannelView.hpp"
+
+#include "common/Channel.hpp"
+#include "controllers/accounts/AccountController.hpp"
+#include "controllers/hotkeys/HotkeyController.hpp"
+#include "messages/Message.hpp"
+#include "mocks/EmptyApplication.hpp"
+#include "singletons/Emotes.hpp"
+#include "singletons/Fonts.hpp"
+#include "singletons/Paths.hpp"
+#include "singletons/Settings.hpp"
+#include "singletons/Theme.hpp"
+#include "singletons/WindowManager.hpp"
+#include "Test.hpp"
+
+#include <pajlada/signals/signalholder.hpp>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+
+#include <algorithm>
+#include <span>
+#include <vector>
+
+using namespace chatterino;
+
+namespace {
+
+class MockApplication : mock::EmptyApplication
+{
+public:
+    MockApplication()
+        : settings(this->settingsDir.filePath("settings.json"))
+        , fonts(this->settings)
+        , windowManager(this->paths)
+    {
+    }
+
+    Theme *getThemes() override
+    {
+        return &this->theme;
+    }
+
+    HotkeyController *getHotkeys() override
+    {
+        return &this->hotkeys;
+    }
+
+    Fonts *getFonts() override
+    {
+        return &this->fonts;
+    }
+
+    WindowManager *getWindows() override
+    {
+        return &this->windowManager;
+    }
+
+    AccountController *getAccounts() override
+    {
+        return &this->accounts;
+    }
+
+    IEmotes *getEmotes() override
+    {
+        return &this->emotes;
+    }
+
+    Settings settings;
+    Theme theme;
+    HotkeyController hotkeys;
+    Fonts fonts;
+    Paths paths;
+    WindowManager windowManager;
+    AccountController accounts;
+    Emotes emotes;
+};
+
+class ChannelViewTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        this->view.setChannel(this->channel);
+        this->connections.managedConnect(
+            this->view.channel()->messagesAppended,
+            [this](std::span<const AppendedMessage> messages) {
+                this->batches.push_back(messages.size());
+                this->flushedAfter.push_back(this->timer.elapsed());
+            });
+    }
+
+    /// Adds a message to the underlying channel without logging it
+    void addMessage(int n)
+    {
+        auto message = std::make_shared<Message>();
+        message->id = QString("msg-%1").arg(n);
+        this->channel->addMessage(message, MessageFlags(MessageFlag::DoNotLog));
+    }
+
+    /// Runs the event loop until `count` batches were added to the view
+    bool waitForBatches(size_t count)
+    {
+        QElapsedTimer waited;
+        waited.start();
+        while (this->batches.size() < count)
+        {
+            if (waited.hasExpired(1000))
+            {
+                return false;
+            }
+            QCoreApplication::processEvents(QEventLoop::AllEvents, 1);
+        }
+        return true;
+    }
+
+    MockApplication app;
+    ChannelPtr channel =
+        std::make_shared<Channel>("forsen", Channel::Type::Misc);
+    ChannelView view{nullptr};
+
+    pajlada::Signals::SignalHolder connections;
+    QElapsedTimer timer;
+    std::vector<size_t> batches;
+    std::vector<qint64> flushedAfter;
+};
+
+}  // namespace
+
+TEST_F(ChannelViewTest, FlushesOncePerFrame)
+{
+    this->timer.start();
+    for (int i = 0; i < 5; i++)
+    {
+        this->addMessage(i);
+    }
+
+    // Nothing is added before the event loop runs the flush
+    ASSERT_TRUE(this->batches.empty());
+    ASSERT_EQ(this->view.channel()->getMessageSnapshot().size(), 0);
+
+    ASSERT_TRUE(this->waitForBatches(1));
+    // The date separator is added in front of the first message
+    EXPECT_EQ(this->batches[0], 6);
+    EXPECT_GE(this->flushedAfter[0],
+              ChannelView::PENDING_MESSAGES_INTERVAL.count() - 1);
+
+    // A message after the flush waits for the next frame
+    this->timer.restart();
+    this->addMessage(5);
+    ASSERT_EQ(this->batches.size(), 1);
+
+    ASSERT_TRUE(this->waitForBatches(2));
+    EXPECT_EQ(this->batches[1], 1);
+    EXPECT_GE(this->flushedAfter[1],
+              ChannelView::PENDING_MESSAGES_INTERVAL.count() - 1);
+    EXPECT_EQ(this->view.channel()->getMessageSnapshot().size(), 7);
+}
+
+TEST_F(ChannelViewTest, FlushesBeforeReplacing)
+{
+    this->addMessage(0);
+    this->addMessage(1);
+    ASSERT_TRUE(this->batches.empty());
+
+    // Replacing forwards the pending messages first so indices line up
+    auto replacement = std::make_shared<Message>();
+    replacement->id = "replacement";
+    this->channel->replaceMessage(1, replacement);
+
+    ASSERT_EQ(this->batches.size(), 1);
+    auto snapshot = this->view.channel()->getMessageSnapshot();
+    ASSERT_EQ(snapshot.size(), 3);
+    EXPECT_TRUE(std::any_of(snapshot.begin(), snapshot.end(),
+                            [](const auto &message) {
+                                return message->id == "replacement";
+                            }));
+}
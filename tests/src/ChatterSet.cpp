@@ -4,6 +4,8 @@
 
 #include <QStringList>
 
+#include <algorithm>
+
 TEST(ChatterSet, insert)
 {
     chatterino::ChatterSet set;
@@ -83,3 +85,28 @@ TEST(ChatterSet, MaxSizeLastUsed)
     EXPECT_TRUE(set.contains("pajlada"));
     EXPECT_TRUE(set.contains("Pajlada"));
 }
+
+TEST(ChatterSet, FilterByPrefix)
+{
+    chatterino::ChatterSet set;
+
+    set.addRecentChatter("pajlada");
+    set.addRecentChatter("Pajbot");
+    set.addRecentChatter("forsen");
+    set.addRecentChatter("PAJLADA");
+
+    auto paj = set.filterByPrefix("PAJ");
+    std::sort(paj.begin(), paj.end());
+    EXPECT_EQ(paj, (std::vector<QString>{"PAJLADA", "Pajbot"}));
+    EXPECT_EQ(set.filterByPrefix("f"), (std::vector<QString>{"forsen"}));
+    EXPECT_TRUE(set.filterByPrefix("x").empty());
+
+    // Evicted chatters aren't found anymore
+    for (auto i = 0; i < chatterino::ChatterSet::chatterLimit; ++i)
+    {
+        set.addRecentChatter(QString("new-%1").arg(i));
+    }
+    EXPECT_TRUE(set.filterByPrefix("paj").empty());
+    EXPECT_EQ(set.filterByPrefix("new-").size(),
+              chatterino::ChatterSet::chatterLimit);
+}
@@ -285,6 +285,72 @@ TEST_F(FiltersF, TypingContextChecks)
     delete privmsg;
 }
 
+TEST_F(FiltersF, CompiledEvaluation)
+{
+    MockChannel channel("pajlada");
+
+    QByteArray message =
+        R"(@badge-info=subscriber/80;badges=broadcaster/1,subscriber/3072,partner/1;color=#CC44FF;display-name=pajlada;emote-only=1;emotes=25:0-4;first-msg=0;flags=;id=90ef1e46-8baa-4bf2-9c54-272f39d6fa11;mod=0;returning-chatter=0;room-id=11148817;subscriber=1;tmi-sent-ts=1662206235860;turbo=0;user-id=11148817;user-type= :pajlada!pajlada@pajlada.tmi.twitch.tv PRIVMSG #pajlada :Kappa 2022-09-03 hello)";
+
+    auto *privmsg = dynamic_cast<Communi::IrcPrivateMessage *>(
+        Communi::IrcPrivateMessage::fromData(message, nullptr));
+    ASSERT_NE(privmsg, nullptr);
+
+    TwitchMessageBuilder builder(&channel, privmsg, MessageParseArgs{});
+    auto msg = builder.build();
+    ASSERT_NE(msg.get(), nullptr);
+
+    auto contextMap = buildContextMap(msg, &channel);
+    MessageContext context{*msg, &channel};
+
+    // clang-format off
+    std::vector<QString> tests{
+        R".(1 + 1).",
+        R".("abc" + 123).",
+        R".(5 == "5").",
+        R".(author.name).",
+        R".(author.name == "PAJLADA").",
+        R".(author.name != "forsen").",
+        R".(author.name + "!").",
+        R".(author.color == "#cc44ff").",
+        R".(author.no_color).",
+        R".(author.subbed && author.sub_length > 12).",
+        R".(author.sub_length * 2 - 1).",
+        R".(author.badges contains "BROADCASTER").",
+        R".(author.badges startswith "broadcaster").",
+        R".({"forsen", "pajlada"} contains channel.name).",
+        R".({channel.name, "forsen"} contains "pajlada").",
+        R".(channel.name startswith "paj" || channel.live).",
+        R".(!channel.watching).",
+        R".(flags.highlighted || flags.reply || !flags.action).",
+        R".(message.content contains "HELLO").",
+        R".(message.content endswith "hello").",
+        R".(message.length >= 10 && message.length < 100).",
+        R".(message.content match r"\d{4}").",
+        R".(message.content match {r"(\d\d\d\d)\-(\d\d)\-(\d\d)", 2}).",
+        R".(message.content match {r"nope(\d)", 1}).",
+        R".(reward.cost == -1 && reward.title == "").",
+    };
+    // clang-format on
+
+    for (const auto &input : tests)
+    {
+        auto filterResult = Filter::fromString(input);
+        const auto *filter = std::get_if<Filter>(&filterResult);
+        ASSERT_NE(filter, nullptr) << "Filter::fromString( " << input
+                                   << " ) is invalid";
+
+        auto expected = filter->execute(contextMap);
+        auto actual = filter->execute(context);
+        EXPECT_EQ(actual, expected)
+            << "Compiled filter{ " << input << " } evaluated to "
+            << actual.toString() << " instead of " << expected.toString();
+        EXPECT_EQ(filter->matches(context), expected.toBool()) << input;
+    }
+
+    delete privmsg;
+}
+
 TEST_F(FiltersF, ExpressionDebug)
 {
     struct TestCase {
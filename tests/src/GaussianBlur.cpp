@@ -0,0 +1,76 @@
+#include "util/GaussianBlur.hpp"
+
+#include "Test.hpp"
+
+#include <QImage>
+
+using namespace chatterino;
+
+namespace {
+
+QImage dot(int size)
+{
+    QImage mask(size, size, QImage::Format_Alpha8);
+    mask.fill(0);
+    mask.scanLine(size / 2)[size / 2] = 255;
+    return mask;
+}
+
+int total(const QImage &mask)
+{
+    int sum = 0;
+    for (int y = 0; y < mask.height(); y++)
+    {
+        for (int x = 0; x < mask.width(); x++)
+        {
+            sum += mask.constScanLine(y)[x];
+        }
+    }
+    return sum;
+}
+
+}  // namespace
+
+TEST(GaussianBlur, ZeroSigmaKeepsImage)
+{
+    auto mask = dot(9);
+    auto original = mask;
+
+    gaussianBlurAlpha(mask, 0);
+
+    ASSERT_EQ(mask, original);
+}
+
+TEST(GaussianBlur, SpreadsSymmetrically)
+{
+    QImage mask(41, 41, QImage::Format_Alpha8);
+    mask.fill(0);
+    for (int y = 15; y < 26; y++)
+    {
+        for (int x = 15; x < 26; x++)
+        {
+            mask.scanLine(y)[x] = 255;
+        }
+    }
+    auto before = total(mask);
+
+    gaussianBlurAlpha(mask, 3);
+
+    const auto at = [&](int x, int y) {
+        return int(mask.constScanLine(y)[x]);
+    };
+
+    // the center stays opaque-ish, the edges are softened
+    ASSERT_GT(at(20, 20), 200);
+    ASSERT_LT(at(15, 20), 255);
+    ASSERT_GT(at(13, 20), 0);
+    ASSERT_EQ(at(0, 0), 0);
+
+    // the blur is symmetric
+    ASSERT_EQ(at(13, 20), at(27, 20));
+    ASSERT_EQ(at(20, 13), at(20, 27));
+    ASSERT_EQ(at(13, 20), at(20, 13));
+
+    // nothing reached the edges, so the coverage is roughly kept
+    ASSERT_NEAR(total(mask), before, before / 50);
+}
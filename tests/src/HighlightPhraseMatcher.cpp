@@ -0,0 +1,114 @@
+#include "controllers/highlights/HighlightPhraseMatcher.hpp"
+
+#include "controllers/highlights/HighlightPhrase.hpp"
+#include "Test.hpp"
+
+#include <vector>
+
+using namespace chatterino;
+
+namespace {
+
+HighlightPhrase buildHighlightPhrase(const QString &phrase, bool isRegex,
+                                     bool isCaseSensitive)
+{
+    return HighlightPhrase(phrase,           // pattern
+                           false,            // showInMentions
+                           false,            // hasAlert
+                           false,            // hasSound
+                           isRegex,          // isRegex
+                           isCaseSensitive,  // isCaseSensitive
+                           "",               // soundURL
+                           QColor()          // color
+    );
+}
+
+}  // namespace
+
+TEST(HighlightPhraseMatcher, SameAsIsMatch)
+{
+    std::vector<HighlightPhrase> phrases{
+        buildHighlightPhrase("test", false, false),
+        buildHighlightPhrase("!test", false, false),
+        buildHighlightPhrase("test!", false, false),
+        buildHighlightPhrase("Test", false, true),
+        buildHighlightPhrase("foo bar", false, false),
+        buildHighlightPhrase("st", false, false),
+        buildHighlightPhrase("testing", false, false),
+        buildHighlightPhrase(R"(te\w+)", true, false),
+        buildHighlightPhrase("ÄÖÜ", false, false),
+        buildHighlightPhrase("ΣΟΦΙΑ", false, false),
+        buildHighlightPhrase("🐱cat", false, false),
+        buildHighlightPhrase("_under", false, false),
+        buildHighlightPhrase("", false, false),
+        buildHighlightPhrase("test", false, false),
+    };
+
+    std::vector<QString> subjects{
+        "test",
+        "TEst",
+        "foo tEst",
+        "foo teSt bar",
+        "testbar",
+        "footest",
+        "!test",
+        "foo!test",
+        "!testbar",
+        "test!",
+        "test!bar",
+        "test! bar",
+        "Test",
+        "a Test b",
+        "foo bar",
+        "foo  bar",
+        "xfoo bar",
+        "foo barx",
+        "st",
+        "testing",
+        "testing test",
+        "tests",
+        "äöü",
+        "xäöü",
+        "σοφια",
+        "σοφιας",
+        "🐱cat",
+        "a🐱cat",
+        "x🐱catx",
+        "_under",
+        "x_under",
+        "",
+        " ",
+        "te",
+    };
+
+    HighlightPhraseMatcher matcher(phrases);
+
+    for (const auto &subject : subjects)
+    {
+        std::vector<const HighlightPhrase *> expected;
+        for (const auto &phrase : matcher.phrases())
+        {
+            if (phrase.isMatch(subject))
+            {
+                expected.push_back(&phrase);
+            }
+        }
+
+        auto actual = matcher.match(subject);
+        ASSERT_EQ(actual.size(), expected.size()) << subject;
+        for (size_t i = 0; i < actual.size(); ++i)
+        {
+            EXPECT_EQ(actual[i], expected[i])
+                << subject << ": " << actual[i]->getPattern()
+                << " != " << expected[i]->getPattern();
+        }
+    }
+}
+
+TEST(HighlightPhraseMatcher, Empty)
+{
+    HighlightPhraseMatcher matcher({});
+
+    EXPECT_TRUE(matcher.match("").empty());
+    EXPECT_TRUE(matcher.match("test").empty());
+}
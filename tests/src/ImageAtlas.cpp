@@ -0,0 +1,79 @@
+#include "messages/ImageAtlas.hpp"
+
+#include "messages/Image.hpp"
+#include "singletons/Settings.hpp"
+#include "Test.hpp"
+
+#include <QColor>
+#include <QPixmap>
+
+using namespace chatterino;
+
+namespace {
+
+QPixmap makePixmap(int size, QColor color)
+{
+    QPixmap pixmap(size, size);
+    pixmap.fill(color);
+    return pixmap;
+}
+
+QColor centerColor(const QPixmap &pixmap)
+{
+    return pixmap.toImage().pixelColor(pixmap.width() / 2,
+                                       pixmap.height() / 2);
+}
+
+}  // namespace
+
+TEST(ImageAtlas, StandaloneIsCached)
+{
+    auto red = ImageAtlas::instance().insert(makePixmap(28, Qt::red));
+    auto blue = ImageAtlas::instance().insert(makePixmap(28, Qt::blue));
+    ASSERT_NE(red, nullptr);
+    ASSERT_NE(blue, nullptr);
+
+    // The first call copies the region out of the page
+    const auto &first = red->standalone();
+    EXPECT_EQ(first.size(), QSize(28, 28));
+    EXPECT_EQ(centerColor(first), QColor(Qt::red));
+    EXPECT_NE(first.cacheKey(), red->pixmap().cacheKey());
+
+    // Later calls return the same pixmap
+    EXPECT_EQ(red->standalone().cacheKey(), first.cacheKey());
+
+    // Other regions of the same page have their own copy
+    EXPECT_NE(blue->standalone().cacheKey(), first.cacheKey());
+    EXPECT_EQ(centerColor(blue->standalone()), QColor(Qt::blue));
+}
+
+TEST(ImageAtlas, FramesReturnCachedPixmap)
+{
+    getSettings()->useImageAtlas = true;
+
+    {
+        QVector<detail::Frame<QPixmap>> items{{makePixmap(56, Qt::green), 0}};
+        detail::Frames frames(std::move(items));
+
+        auto current = frames.current();
+        ASSERT_TRUE(current.has_value());
+        EXPECT_EQ(current->size(), QSize(56, 56));
+        EXPECT_EQ(centerColor(*current), QColor(Qt::green));
+
+        auto again = frames.current();
+        ASSERT_TRUE(again.has_value());
+        EXPECT_EQ(again->cacheKey(), current->cacheKey());
+        EXPECT_EQ(frames.first()->cacheKey(), current->cacheKey());
+    }
+
+    // Frames that don't fit the atlas keep their own pixmap
+    {
+        auto pixmap = makePixmap(30, Qt::green);
+        QVector<detail::Frame<QPixmap>> items{{pixmap, 0}};
+        detail::Frames frames(std::move(items));
+
+        EXPECT_EQ(frames.current()->cacheKey(), pixmap.cacheKey());
+    }
+
+    getSettings()->useImageAtlas = false;
+}
@@ -0,0 +1,190 @@
+#include "messages/ImageCache.hpp"
+
+#include "mocks/EmptyApplication.hpp"
+#include "singletons/Settings.hpp"
+#include "Test.hpp"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+#include <cstring>
+
+using namespace chatterino;
+
+namespace {
+
+class ImageCacheTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(this->cacheDir.isValid());
+        getSettings()->cachePath = this->cacheDir.path();
+        getSettings()->imageCacheBudgetMb = 1;
+        ImageCache::instance().unload();
+    }
+
+    void TearDown() override
+    {
+        ImageCache::instance().unload();
+        getSettings()->cachePath = QString();
+        getSettings()->imageCacheBudgetMb =
+            getSettings()->imageCacheBudgetMb.getDefaultValue();
+    }
+
+    QStringList frameFiles() const
+    {
+        QDir dir(this->cacheDir.filePath("images"));
+        QStringList paths;
+        for (const auto &name : dir.entryList({"*.frames"}, QDir::Files))
+        {
+            paths.append(dir.filePath(name));
+        }
+        return paths;
+    }
+
+    mock::EmptyApplication app;
+    QTemporaryDir cacheDir;
+};
+
+QImage makeImage(int width, int height, QColor color)
+{
+    QImage image(width, height, QImage::Format_ARGB32_Premultiplied);
+    image.fill(color);
+    return image;
+}
+
+}  // namespace
+
+TEST_F(ImageCacheTest, RoundTrip)
+{
+    auto &cache = ImageCache::instance();
+    const Url url{"https://example.com/emote.gif"};
+
+    ASSERT_FALSE(cache.load(url).has_value());
+
+    // Frames in other formats are converted
+    cache.store(url, {
+                         {makeImage(3, 2, Qt::red), 20},
+                         {makeImage(3, 2, Qt::green)
+                              .convertToFormat(QImage::Format_RGB32),
+                          30},
+                     });
+
+    auto frames = cache.load(url);
+    ASSERT_TRUE(frames.has_value());
+    ASSERT_EQ(frames->size(), 2);
+    EXPECT_EQ(frames->at(0).duration, 20);
+    EXPECT_EQ(frames->at(1).duration, 30);
+    EXPECT_EQ(frames->at(0).image.size(), QSize(3, 2));
+    EXPECT_EQ(frames->at(0).image.format(),
+              QImage::Format_ARGB32_Premultiplied);
+    EXPECT_EQ(frames->at(0).image.pixelColor(2, 1), QColor(Qt::red));
+    EXPECT_EQ(frames->at(1).image.pixelColor(2, 1), QColor(Qt::green));
+
+    // The index survives reopening the cache
+    cache.unload();
+    ASSERT_TRUE(cache.load(url).has_value());
+    ASSERT_FALSE(cache.load(Url{"https://example.com/other.gif"}).has_value());
+}
+
+TEST_F(ImageCacheTest, DropsHugeFrameCount)
+{
+    auto &cache = ImageCache::instance();
+    const Url url{"https://example.com/emote.png"};
+    cache.store(url, {{makeImage(4, 4, Qt::blue), 0}});
+
+    auto files = this->frameFiles();
+    ASSERT_EQ(files.size(), 1);
+    {
+        // The frame count follows the magic, version and URL length
+        QFile file(files.front());
+        ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+        const uint32_t frameCount = 0xFFFFFFFF;
+        file.seek(3 * sizeof(uint32_t));
+        file.write(reinterpret_cast<const char *>(&frameCount),
+                   sizeof(frameCount));
+    }
+
+    ASSERT_FALSE(cache.load(url).has_value());
+    ASSERT_TRUE(this->frameFiles().isEmpty());
+}
+
+TEST_F(ImageCacheTest, DropsTruncatedFile)
+{
+    auto &cache = ImageCache::instance();
+    const Url url{"https://example.com/emote.png"};
+    cache.store(url, {{makeImage(16, 16, Qt::blue), 0}});
+
+    auto files = this->frameFiles();
+    ASSERT_EQ(files.size(), 1);
+    {
+        QFile file(files.front());
+        ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+        ASSERT_TRUE(file.resize(file.size() - 10));
+    }
+
+    ASSERT_FALSE(cache.load(url).has_value());
+    ASSERT_TRUE(this->frameFiles().isEmpty());
+}
+
+TEST_F(ImageCacheTest, DropsTrailingData)
+{
+    auto &cache = ImageCache::instance();
+    const Url url{"https://example.com/emote.png"};
+    cache.store(url, {{makeImage(4, 4, Qt::blue), 0}});
+
+    auto files = this->frameFiles();
+    ASSERT_EQ(files.size(), 1);
+    {
+        QFile file(files.front());
+        ASSERT_TRUE(file.open(QIODevice::Append));
+        file.write("garbage");
+    }
+
+    ASSERT_FALSE(cache.load(url).has_value());
+    ASSERT_TRUE(this->frameFiles().isEmpty());
+}
+
+TEST_F(ImageCacheTest, SkipsHugeFrames)
+{
+    auto &cache = ImageCache::instance();
+    const Url url{"https://example.com/huge.png"};
+    cache.store(url, {
+                         {makeImage(4, 4, Qt::blue), 0},
+                         {makeImage(4097, 1, Qt::blue), 0},
+                     });
+
+    ASSERT_TRUE(this->frameFiles().isEmpty());
+    ASSERT_FALSE(cache.load(url).has_value());
+}
+
+TEST_F(ImageCacheTest, EvictsOverBudget)
+{
+    auto &cache = ImageCache::instance();
+    const qint64 budget = 1024 * 1024;
+
+    // Each image takes a bit more than a quarter of the budget
+    for (int i = 0; i < 4; i++)
+    {
+        cache.store(Url{QString("https://example.com/%1.png").arg(i)},
+                    {{makeImage(256, 256, Qt::blue), 0}});
+    }
+
+    // The cache was trimmed below 90% of the budget
+    auto files = this->frameFiles();
+    ASSERT_EQ(files.size(), 3);
+    qint64 total = 0;
+    for (const auto &path : files)
+    {
+        total += QFileInfo(path).size();
+    }
+    ASSERT_LE(total, budget * 9 / 10);
+
+    // A budget of 0 disables the cache
+    getSettings()->imageCacheBudgetMb = 0;
+    ASSERT_FALSE(cache.enabled());
+    ASSERT_FALSE(cache.load(Url{"https://example.com/3.png"}).has_value());
+}
@@ -0,0 +1,167 @@
+#include "providers/irc/IrcLine.hpp"
+
+#include "providers/irc/IrcTags.hpp"
+#include "Test.hpp"
+
+#include <IrcMessage>
+
+#include <memory>
+
+using namespace chatterino;
+
+namespace {
+
+QString toQString(std::string_view view)
+{
+    return QString::fromUtf8(view.data(), static_cast<qsizetype>(view.size()));
+}
+
+}  // namespace
+
+TEST(IrcLine, Privmsg)
+{
+    auto line = IrcLine::parse(
+        "@badge-info=;color=#FF0000;display-name=Pajlada;emotes=;id=1234 "
+        ":pajlada!pajlada@pajlada.tmi.twitch.tv PRIVMSG #pajlada :hello world");
+    ASSERT_TRUE(line.has_value());
+
+    EXPECT_EQ(line->prefix(), "pajlada!pajlada@pajlada.tmi.twitch.tv");
+    EXPECT_EQ(line->nick(), "pajlada");
+    EXPECT_EQ(line->command(), "PRIVMSG");
+    ASSERT_EQ(line->parameterCount(), 2U);
+    EXPECT_EQ(line->parameter(0), "#pajlada");
+    EXPECT_EQ(line->parameter(1), "hello world");
+    EXPECT_EQ(line->parameter(2), "");
+
+    EXPECT_TRUE(line->hasTag("badge-info"));
+    EXPECT_EQ(line->rawTag("badge-info").value_or("missing"), "");
+    EXPECT_EQ(line->rawTag("color").value_or("missing"), "#FF0000");
+    EXPECT_EQ(line->tag("display-name"), "Pajlada");
+    EXPECT_FALSE(line->hasTag("bits"));
+    EXPECT_FALSE(line->rawTag("bits").has_value());
+    EXPECT_EQ(line->tag("bits"), "");
+}
+
+TEST(IrcLine, NoTagsOrPrefix)
+{
+    auto line = IrcLine::parse("PING :tmi.twitch.tv\r\n");
+    ASSERT_TRUE(line.has_value());
+
+    EXPECT_EQ(line->prefix(), "");
+    EXPECT_EQ(line->nick(), "");
+    EXPECT_EQ(line->command(), "PING");
+    ASSERT_EQ(line->parameterCount(), 1U);
+    EXPECT_EQ(line->parameter(0), "tmi.twitch.tv");
+    EXPECT_TRUE(line->tags().isEmpty());
+}
+
+TEST(IrcLine, Parameters)
+{
+    auto line = IrcLine::parse(":tmi.twitch.tv  CAP  *   ACK :");
+    ASSERT_TRUE(line.has_value());
+
+    EXPECT_EQ(line->nick(), "tmi.twitch.tv");
+    EXPECT_EQ(line->command(), "CAP");
+    ASSERT_EQ(line->parameterCount(), 3U);
+    EXPECT_EQ(line->parameter(0), "*");
+    EXPECT_EQ(line->parameter(1), "ACK");
+    EXPECT_EQ(line->parameter(2), "");
+}
+
+TEST(IrcLine, TagWithoutValue)
+{
+    auto line =
+        IrcLine::parse("@emote-only;slow=0 :tmi.twitch.tv ROOMSTATE #pajlada");
+    ASSERT_TRUE(line.has_value());
+
+    EXPECT_TRUE(line->hasTag("emote-only"));
+    EXPECT_EQ(line->tag("emote-only"), "");
+    EXPECT_EQ(line->tag("slow"), "0");
+}
+
+TEST(IrcLine, Invalid)
+{
+    EXPECT_FALSE(IrcLine::parse("").has_value());
+    EXPECT_FALSE(IrcLine::parse("@a=b :prefix").has_value());
+    EXPECT_FALSE(IrcLine::parse("   ").has_value());
+}
+
+TEST(IrcLine, UnescapeTagValue)
+{
+    struct TestCase {
+        std::string_view input;
+        QString expected;
+    };
+
+    std::vector<TestCase> tests{
+        {"plain", "plain"},
+        {R"(a\sb)", "a b"},
+        {R"(a\:b)", "a;b"},
+        {R"(a\\b)", R"(a\b)"},
+        {R"(a\r\nb)", "a\r\nb"},
+        {R"(a\xb)", "axb"},
+        {R"(trailing\)", "trailing"},
+        {R"(\s\s)", "  "},
+        {"\xF0\x9F\x98\x80\\s", QString::fromUtf8("\xF0\x9F\x98\x80 ")},
+    };
+
+    for (const auto &[input, expected] : tests)
+    {
+        EXPECT_EQ(IrcLine::unescapeTagValue(input), expected)
+            << "input: " << input;
+    }
+}
+
+TEST(IrcLine, MatchesCommuni)
+{
+    const QList<QByteArray> lines{
+        R"(@badge-info=subscriber/80;badges=broadcaster/1,subscriber/3072;color=#CC44FF;display-name=pajlada;emotes=25:6-10;first-msg=0;flags=;id=e2e2b2b1-1f0a-4b2c-9b8d-8bd1e1f3f3d8;mod=0;room-id=11148817;subscriber=1;tmi-sent-ts=1700000000000;turbo=0;user-id=11148817;user-type= :pajlada!pajlada@pajlada.tmi.twitch.tv PRIVMSG #pajlada :hello Kappa)",
+        R"(@msg-id=subgift;msg-param-recipient-display-name=Someone;system-msg=An\sanonymous\suser\sgifted\sa\sTier\s1\ssub\sto\sSomeone!\:\\ :tmi.twitch.tv USERNOTICE #pajlada)",
+        R"(@ban-duration=600;room-id=11148817;target-user-id=1234;tmi-sent-ts=1700000000000 :tmi.twitch.tv CLEARCHAT #pajlada :someone)",
+        R"(@rm-received-ts=1700000000000;historical=1;slow=0 :tmi.twitch.tv ROOMSTATE #pajlada)",
+    };
+
+    for (const auto &data : lines)
+    {
+        auto line = IrcLine::parse(data);
+        ASSERT_TRUE(line.has_value()) << data.toStdString();
+
+        std::unique_ptr<Communi::IrcMessage> message(
+            Communi::IrcMessage::fromData(data, nullptr));
+
+        EXPECT_EQ(toQString(line->command()), message->command());
+        EXPECT_EQ(toQString(line->nick()), message->nick());
+        EXPECT_EQ(line->tags(), message->tags()) << data.toStdString();
+
+        ASSERT_EQ(static_cast<qsizetype>(line->parameterCount()),
+                  message->parameters().size());
+        for (size_t i = 0; i < line->parameterCount(); i++)
+        {
+            EXPECT_EQ(toQString(line->parameter(i)),
+                      message->parameters().at(static_cast<qsizetype>(i)));
+        }
+    }
+}
+
+TEST(IrcLine, TagsView)
+{
+    const QByteArray data =
+        R"(@badges=broadcaster/1;color=;display-name=pajlada;system-msg=a\sb\:c;flag :pajlada!pajlada@pajlada.tmi.twitch.tv PRIVMSG #pajlada :hello)";
+    auto line = IrcLine::parse(data);
+    ASSERT_TRUE(line.has_value());
+    std::unique_ptr<Communi::IrcMessage> message(
+        Communi::IrcMessage::fromData(data, nullptr));
+
+    IrcTags fromLine(*line);
+    IrcTags fromMap(message->tags());
+
+    for (const auto *key : {"badges", "color", "display-name", "system-msg",
+                            "flag", "bits"})
+    {
+        EXPECT_EQ(fromLine.contains(key), fromMap.contains(key)) << key;
+        EXPECT_EQ(fromLine.value(key), fromMap.value(key)) << key;
+    }
+
+    EXPECT_EQ(fromLine.value("system-msg").toString(), "a b;c");
+    EXPECT_FALSE(fromLine.value("bits").isValid());
+}
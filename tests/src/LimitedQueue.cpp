@@ -2,6 +2,9 @@
 
 #include "Test.hpp"
 
+#include <atomic>
+#include <memory>
+#include <thread>
 #include <vector>
 
 using namespace chatterino;
@@ -131,3 +134,128 @@ TEST(LimitedQueue, ReplaceItem)
 
     SNAPSHOT_EQUALS(queue.getSnapshot(), {9, 10, 3}, "first snapshot");
 }
+
+TEST(LimitedQueue, ChunkBoundaries)
+{
+    // More items than fit in a single chunk, so eviction drops whole chunks
+    LimitedQueue<int> queue(200);
+    std::vector<int> expected;
+    int d = 0;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        bool flag = queue.pushBack(i, d);
+        EXPECT_EQ(flag, i >= 200);
+        if (flag)
+        {
+            EXPECT_EQ(d, i - 200);
+        }
+    }
+
+    for (int i = 800; i < 1000; ++i)
+    {
+        expected.push_back(i);
+    }
+
+    SNAPSHOT_EQUALS(queue.getSnapshot(), expected, "after eviction");
+    EXPECT_EQ(queue.first(), 800);
+    EXPECT_EQ(queue.last(), 999);
+    EXPECT_EQ(queue.get(100), 900);
+    EXPECT_EQ(queue.get(200), std::nullopt);
+}
+
+TEST(LimitedQueue, SnapshotIsolation)
+{
+    LimitedQueue<int> queue(100);
+    for (int i = 0; i < 100; ++i)
+    {
+        queue.pushBack(i);
+    }
+
+    auto before = queue.getSnapshot();
+
+    queue.replaceItem(std::size_t(70), -1);
+    for (int i = 100; i < 150; ++i)
+    {
+        queue.pushBack(i);
+    }
+
+    EXPECT_EQ(before.size(), 100);
+    EXPECT_EQ(before[0], 0);
+    EXPECT_EQ(before[70], 70);
+    EXPECT_EQ(before[99], 99);
+
+    auto after = queue.getSnapshot();
+    EXPECT_EQ(after.size(), 100);
+    EXPECT_EQ(after[0], 50);
+    EXPECT_EQ(after[20], -1);
+    EXPECT_EQ(after[99], 149);
+
+    std::vector<int> reversed(after.rbegin(), after.rend());
+    EXPECT_EQ(reversed.front(), 149);
+    EXPECT_EQ(reversed.back(), 50);
+}
+
+TEST(LimitedQueue, Insert)
+{
+    LimitedQueue<int> queue(4);
+    queue.pushBack(1);
+    queue.pushBack(3);
+
+    EXPECT_TRUE(queue.insertBefore(3, 2));
+    EXPECT_TRUE(queue.insertAfter(3, 4));
+    EXPECT_FALSE(queue.insertAfter(10, 5));
+    SNAPSHOT_EQUALS(queue.getSnapshot(), {1, 2, 3, 4}, "inserted");
+
+    // full: the first element gets overwritten
+    EXPECT_TRUE(queue.insertAfter(2, 5));
+    SNAPSHOT_EQUALS(queue.getSnapshot(), {2, 5, 3, 4}, "inserted when full");
+
+    std::optional<int> deleted;
+    EXPECT_TRUE(queue.insertAfter(3, 6, deleted));
+    EXPECT_EQ(deleted, 2);
+    SNAPSHOT_EQUALS(queue.getSnapshot(), {5, 3, 6, 4}, "deleted the first");
+
+    // Nothing fits before the first element of a full queue
+    deleted.reset();
+    EXPECT_FALSE(queue.insertBefore(5, 7, deleted));
+    EXPECT_EQ(deleted, std::nullopt);
+    SNAPSHOT_EQUALS(queue.getSnapshot(), {5, 3, 6, 4}, "nothing inserted");
+}
+
+TEST(LimitedQueue, ConcurrentReaders)
+{
+    LimitedQueue<std::shared_ptr<int>> queue(300);
+    std::atomic<bool> done = false;
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; ++r)
+    {
+        readers.emplace_back([&] {
+            while (!done)
+            {
+                auto snapshot = queue.getSnapshot();
+                int prev = -1;
+                for (const auto &item : snapshot)
+                {
+                    ASSERT_NE(item, nullptr);
+                    ASSERT_GT(*item, prev);
+                    prev = *item;
+                }
+            }
+        });
+    }
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        queue.pushBack(std::make_shared<int>(i));
+    }
+    done = true;
+
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+
+    EXPECT_EQ(*queue.last().value(), 19999);
+}
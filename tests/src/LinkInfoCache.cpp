@@ -0,0 +1,108 @@
+#include "providers/links/LinkInfoCache.hpp"
+
+#include "common/Literals.hpp"
+#include "Test.hpp"
+
+using namespace chatterino;
+using namespace literals;
+
+namespace {
+
+const QDateTime NOW = QDateTime::fromMSecsSinceEpoch(1700000000000);
+
+ResolvedLinkInfo makeInfo(const QString &tooltip, int ttlSeconds = 60)
+{
+    return {
+        .tooltip = tooltip,
+        .resolvedUrl = {},
+        .thumbnailUrl = {},
+        .thumbnail = nullptr,
+        .expiresAt = NOW.addSecs(ttlSeconds),
+    };
+}
+
+}  // namespace
+
+TEST(LinkInfoCache, NormalizeUrl)
+{
+    ASSERT_EQ(LinkInfoCache::normalizeUrl(u"https://Chatterino.COM/"_s),
+              u"https://chatterino.com"_s);
+    ASSERT_EQ(LinkInfoCache::normalizeUrl(u"https://chatterino.com"_s),
+              u"https://chatterino.com"_s);
+    ASSERT_EQ(LinkInfoCache::normalizeUrl(u"https://chatterino.com/?a=b"_s),
+              u"https://chatterino.com?a=b"_s);
+    ASSERT_EQ(LinkInfoCache::normalizeUrl(u"https://chatterino.com/a/"_s),
+              u"https://chatterino.com/a"_s);
+    ASSERT_EQ(LinkInfoCache::normalizeUrl(u"chatterino.com/a/../b"_s),
+              u"http://chatterino.com/b"_s);
+    // the query and fragment are kept
+    ASSERT_EQ(LinkInfoCache::normalizeUrl(u"https://youtu.be/xd?t=10#x"_s),
+              u"https://youtu.be/xd?t=10#x"_s);
+}
+
+TEST(LinkInfoCache, Expires)
+{
+    LinkInfoCache cache(1024 * 1024);
+    cache.insert(u"a"_s, makeInfo(u"A"_s, 10));
+
+    auto *info = cache.find(u"a"_s, NOW);
+    ASSERT_NE(info, nullptr);
+    ASSERT_EQ(info->tooltip, u"A"_s);
+
+    ASSERT_EQ(cache.find(u"a"_s, NOW.addSecs(10)), nullptr);
+    ASSERT_EQ(cache.size(), 0);
+}
+
+TEST(LinkInfoCache, EvictsLeastRecentlyUsed)
+{
+    LinkInfoCache cache(1024 * 1024);
+    cache.insert(u"a"_s, makeInfo(u"A"_s));
+    cache.insert(u"b"_s, makeInfo(u"B"_s));
+    auto entryUsage = cache.memoryUsage() / 2;
+
+    LinkInfoCache small(entryUsage * 2);
+    small.insert(u"a"_s, makeInfo(u"A"_s));
+    small.insert(u"b"_s, makeInfo(u"B"_s));
+    ASSERT_NE(small.find(u"a"_s, NOW), nullptr);  // a is now the most recent
+
+    small.insert(u"c"_s, makeInfo(u"C"_s));
+    ASSERT_EQ(small.size(), 2);
+    ASSERT_NE(small.find(u"a"_s, NOW), nullptr);
+    ASSERT_EQ(small.find(u"b"_s, NOW), nullptr);
+    ASSERT_NE(small.find(u"c"_s, NOW), nullptr);
+    ASSERT_LE(small.memoryUsage(), entryUsage * 2);
+}
+
+TEST(LinkInfoCache, Serialize)
+{
+    LinkInfoCache cache(1024 * 1024);
+    cache.insert(u"old"_s, makeInfo(u"Old"_s, 5));
+    auto info = makeInfo(u"<b>Title</b>"_s);
+    info.resolvedUrl = u"https://example.com/full"_s;
+    info.thumbnailUrl = u"https://example.com/thumb.png"_s;
+    cache.insert(u"new"_s, info);
+    cache.insert(u"third"_s, makeInfo(u"Third"_s));
+
+    // only the two most recent entries
+    auto data = cache.serialize(2);
+
+    LinkInfoCache loaded(1024 * 1024);
+    loaded.insert(u"third"_s, makeInfo(u"Resolved meanwhile"_s));
+    loaded.deserialize(data, NOW);
+
+    ASSERT_EQ(loaded.size(), 2);
+    ASSERT_EQ(loaded.find(u"old"_s, NOW), nullptr);
+    ASSERT_EQ(loaded.find(u"third"_s, NOW)->tooltip, u"Resolved meanwhile"_s);
+
+    auto *restored = loaded.find(u"new"_s, NOW);
+    ASSERT_NE(restored, nullptr);
+    ASSERT_EQ(restored->tooltip, info.tooltip);
+    ASSERT_EQ(restored->resolvedUrl, info.resolvedUrl);
+    ASSERT_EQ(restored->thumbnailUrl, info.thumbnailUrl);
+    ASSERT_EQ(restored->expiresAt, info.expiresAt);
+
+    // expired entries aren't loaded
+    LinkInfoCache later(1024 * 1024);
+    later.deserialize(data, NOW.addSecs(3600));
+    ASSERT_EQ(later.size(), 0);
+}
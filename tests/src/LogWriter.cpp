@@ -0,0 +1,156 @@
+#include "singletons/helper/LogWriter.hpp"
+
+#include "Test.hpp"
+
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <thread>
+#include <vector>
+
+using namespace chatterino;
+using namespace std::chrono_literals;
+
+namespace {
+
+QByteArray readFile(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return {};
+    }
+    return file.readAll();
+}
+
+}  // namespace
+
+TEST(LogWriter, WritesOnDestruction)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    auto first = dir.filePath("Twitch/Channels/forsen/forsen.log");
+    auto second = dir.filePath("Twitch/Channels/pajlada/pajlada.log");
+
+    {
+        LogWriter writer;
+        writer.setFlushInterval(1h);
+        writer.write(first, "a\n");
+        writer.write(second, "b\n");
+        writer.write(first, "c\n");
+        writer.write(first, {});
+    }
+
+    EXPECT_EQ(readFile(first), "a\nc\n");
+    EXPECT_EQ(readFile(second), "b\n");
+}
+
+TEST(LogWriter, WritesOnStop)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    auto fileName = dir.filePath("log.log");
+
+    // On exit the writer is stopped but never destroyed
+    LogWriter writer;
+    writer.setFlushInterval(1h);
+    writer.write(fileName, "a\n");
+    writer.write(fileName, "b\n");
+    writer.stop();
+
+    EXPECT_EQ(readFile(fileName), "a\nb\n");
+
+    // Anything written later is dropped
+    writer.write(fileName, "c\n");
+    writer.stop();
+    EXPECT_EQ(readFile(fileName), "a\nb\n");
+}
+
+TEST(LogWriter, Reopen)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    auto fileName = dir.filePath("log.log");
+
+    {
+        LogWriter writer;
+        writer.write(fileName, "a\n");
+        writer.close(fileName);
+        writer.write(fileName, "b\n");
+    }
+    {
+        // Files are opened in append mode
+        LogWriter writer;
+        writer.write(fileName, "c\n");
+        writer.close(fileName);
+    }
+
+    EXPECT_EQ(readFile(fileName), "a\nb\nc\n");
+}
+
+TEST(LogWriter, Threshold)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    auto fileName = dir.filePath("log.log");
+
+    LogWriter writer;
+    writer.setFlushInterval(1h);
+    writer.setFlushThreshold(4);
+    writer.write(fileName, "ab\n");
+    writer.write(fileName, "cd\n");
+
+    // The second write crosses the threshold and wakes the writer
+    QByteArray contents;
+    for (int i = 0; i < 500 && contents.isEmpty(); i++)
+    {
+        std::this_thread::sleep_for(10ms);
+        contents = readFile(fileName);
+    }
+    EXPECT_EQ(contents, "ab\ncd\n");
+}
+
+TEST(LogWriter, ConcurrentWriters)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    auto fileName = dir.filePath("log.log");
+
+    constexpr int threadCount = 4;
+    constexpr int linesPerThread = 1000;
+
+    {
+        LogWriter writer;
+        writer.setFlushInterval(1ms);
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < threadCount; t++)
+        {
+            threads.emplace_back([&writer, &fileName, t] {
+                for (int i = 0; i < linesPerThread; i++)
+                {
+                    writer.write(fileName, QByteArray::number(t) + '\n');
+                }
+            });
+        }
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    auto lines = readFile(fileName).split('\n');
+    ASSERT_EQ(lines.size(), threadCount * linesPerThread + 1);
+    std::vector<int> counts(threadCount);
+    for (const auto &line : lines)
+    {
+        if (!line.isEmpty())
+        {
+            counts.at(line.toInt())++;
+        }
+    }
+    for (auto count : counts)
+    {
+        EXPECT_EQ(count, linesPerThread);
+    }
+}
@@ -0,0 +1,194 @@
+#include "messages/MergedEmoteMap.hpp"
+
+#include "messages/Emote.hpp"
+#include "Test.hpp"
+
+using namespace chatterino;
+
+namespace {
+
+EmotePtr makeEmote(const QString &name)
+{
+    return std::make_shared<const Emote>(Emote{
+        .name = {name},
+    });
+}
+
+std::shared_ptr<const EmoteMap> makeMap(
+    std::initializer_list<std::pair<QString, EmotePtr>> emotes)
+{
+    auto map = std::make_shared<EmoteMap>();
+    for (const auto &[name, emote] : emotes)
+    {
+        map->emplace(EmoteName{name}, emote);
+    }
+    return map;
+}
+
+}  // namespace
+
+TEST(MergedEmoteMap, Empty)
+{
+    MergedEmoteMap merged;
+    EXPECT_EQ(merged.find({"Kappa"}), nullptr);
+    EXPECT_EQ(merged.size(), 0);
+    EXPECT_EQ(merged.layer(EmoteLayer::FfzChannel), EMPTY_EMOTE_MAP);
+}
+
+TEST(MergedEmoteMap, Precedence)
+{
+    auto ffzChannel = makeEmote("ffzChannel");
+    auto bttvChannel = makeEmote("bttvChannel");
+    auto seventvChannel = makeEmote("seventvChannel");
+    auto ffzGlobal = makeEmote("ffzGlobal");
+    auto bttvGlobal = makeEmote("bttvGlobal");
+    auto seventvGlobal = makeEmote("seventvGlobal");
+
+    auto merged = std::make_shared<const MergedEmoteMap>()->withLayers({
+        {EmoteLayer::SeventvGlobal,
+         makeMap({{"a", seventvGlobal},
+                  {"b", seventvGlobal},
+                  {"c", seventvGlobal},
+                  {"d", seventvGlobal},
+                  {"e", seventvGlobal},
+                  {"f", seventvGlobal}})},
+        {EmoteLayer::BttvGlobal, makeMap({{"a", bttvGlobal},
+                                          {"b", bttvGlobal},
+                                          {"c", bttvGlobal},
+                                          {"d", bttvGlobal},
+                                          {"e", bttvGlobal}})},
+        {EmoteLayer::FfzGlobal, makeMap({{"a", ffzGlobal},
+                                         {"b", ffzGlobal},
+                                         {"c", ffzGlobal},
+                                         {"d", ffzGlobal}})},
+        {EmoteLayer::SeventvChannel,
+         makeMap({{"a", seventvChannel},
+                  {"b", seventvChannel},
+                  {"c", seventvChannel}})},
+        {EmoteLayer::BttvChannel,
+         makeMap({{"a", bttvChannel}, {"b", bttvChannel}})},
+        {EmoteLayer::FfzChannel, makeMap({{"a", ffzChannel}})},
+    });
+
+    struct TestCase {
+        QString name;
+        EmotePtr emote;
+        EmoteLayer layer;
+    };
+    std::vector<TestCase> tests{
+        {"a", ffzChannel, EmoteLayer::FfzChannel},
+        {"b", bttvChannel, EmoteLayer::BttvChannel},
+        {"c", seventvChannel, EmoteLayer::SeventvChannel},
+        {"d", ffzGlobal, EmoteLayer::FfzGlobal},
+        {"e", bttvGlobal, EmoteLayer::BttvGlobal},
+        {"f", seventvGlobal, EmoteLayer::SeventvGlobal},
+    };
+
+    EXPECT_EQ(merged->size(), tests.size());
+    for (const auto &test : tests)
+    {
+        const auto *entry = merged->find({test.name});
+        ASSERT_NE(entry, nullptr) << test.name;
+        EXPECT_EQ(entry->emote, test.emote) << test.name;
+        EXPECT_EQ(entry->layer, test.layer) << test.name;
+    }
+    EXPECT_EQ(merged->find({"g"}), nullptr);
+}
+
+TEST(MergedEmoteMap, UpdateLayer)
+{
+    auto global = makeEmote("global");
+    auto channel = makeEmote("channel");
+    auto renamed = makeEmote("renamed");
+
+    auto original = std::make_shared<const MergedEmoteMap>()->withLayers({
+        {EmoteLayer::BttvGlobal, makeMap({{"a", global}, {"b", global}})},
+        {EmoteLayer::SeventvChannel, makeMap({{"a", channel}})},
+    });
+    ASSERT_EQ(original->find({"a"})->emote, channel);
+
+    // Removing the channel emote falls back to the global one
+    auto removed = original->withLayers({
+        {EmoteLayer::SeventvChannel, EMPTY_EMOTE_MAP},
+    });
+    ASSERT_NE(removed->find({"a"}), nullptr);
+    EXPECT_EQ(removed->find({"a"})->emote, global);
+    EXPECT_EQ(removed->find({"a"})->layer, EmoteLayer::BttvGlobal);
+
+    // The original table isn't modified
+    EXPECT_EQ(original->find({"a"})->emote, channel);
+
+    // Changing an emote with the same name replaces it
+    auto changed = original->withLayers({
+        {EmoteLayer::SeventvChannel, makeMap({{"a", renamed}, {"c", channel}})},
+    });
+    EXPECT_EQ(changed->find({"a"})->emote, renamed);
+    EXPECT_EQ(changed->find({"b"})->emote, global);
+    EXPECT_EQ(changed->find({"c"})->emote, channel);
+    EXPECT_EQ(changed->size(), 3);
+
+    // A null map is treated like an empty one
+    auto cleared = changed->withLayers({
+        {EmoteLayer::SeventvChannel, nullptr},
+        {EmoteLayer::BttvGlobal, nullptr},
+    });
+    EXPECT_EQ(cleared->size(), 0);
+}
+
+TEST(MergedEmoteMap, UpdateEmotes)
+{
+    auto global = makeEmote("global");
+    auto channel = makeEmote("channel");
+    auto added = makeEmote("added");
+
+    auto globals = makeMap({{"a", global}, {"b", global}});
+    auto original = std::make_shared<const MergedEmoteMap>()->withLayers({
+        {EmoteLayer::BttvGlobal, globals},
+        {EmoteLayer::SeventvChannel, makeMap({{"a", channel}})},
+    });
+
+    // Only the given names are resolved again
+    auto updated = original->withEmotes(EmoteLayer::SeventvChannel,
+                                        makeMap({{"b", added}, {"c", added}}),
+                                        {EmoteName{"a"}, EmoteName{"b"}});
+    EXPECT_EQ(updated->find({"a"})->emote, global);
+    EXPECT_EQ(updated->find({"b"})->emote, added);
+    EXPECT_EQ(updated->find({"b"})->layer, EmoteLayer::SeventvChannel);
+    EXPECT_EQ(updated->find({"c"}), nullptr);
+    EXPECT_EQ(updated->size(), 2);
+
+    // The original table isn't modified
+    EXPECT_EQ(original->find({"a"})->emote, channel);
+    EXPECT_EQ(original->find({"b"})->emote, global);
+
+    // Names are resolved even if the layer already is the given map
+    auto layer = updated->layer(EmoteLayer::SeventvChannel);
+    auto again =
+        updated->withEmotes(EmoteLayer::SeventvChannel, layer, {EmoteName{"c"}});
+    EXPECT_EQ(again->find({"c"})->emote, added);
+    EXPECT_EQ(again->size(), 3);
+
+    // Full layer changes still compare the maps
+    auto removed = again->withLayers({{EmoteLayer::SeventvChannel, nullptr}});
+    EXPECT_EQ(removed->find({"b"})->emote, global);
+    EXPECT_EQ(removed->find({"c"}), nullptr);
+    EXPECT_EQ(removed->size(), 2);
+}
+
+TEST(MergedEmoteMap, Globals)
+{
+    auto before = MergedEmoteMap::globalGeneration();
+    MergedEmoteMap::globalsChanged();
+    auto after = MergedEmoteMap::globalGeneration();
+    EXPECT_GT(after, before);
+
+    auto merged = std::make_shared<const MergedEmoteMap>()->withGlobals(
+        {{EmoteLayer::FfzGlobal, makeMap({{"a", makeEmote("a")}})}}, after);
+    EXPECT_EQ(merged->globalsGeneration(), after);
+    EXPECT_NE(merged->find({"a"}), nullptr);
+
+    // Channel layer updates keep the generation
+    EXPECT_EQ(merged->withLayers({{EmoteLayer::FfzChannel, EMPTY_EMOTE_MAP}})
+                  ->globalsGeneration(),
+              after);
+}
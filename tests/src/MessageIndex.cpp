@@ -0,0 +1,248 @@
+#include "messages/MessageIndex.hpp"
+
+#include "messages/Message.hpp"
+#include "Test.hpp"
+
+using namespace chatterino;
+
+namespace {
+
+std::shared_ptr<Message> makeMessage(const QString &id, const QString &login)
+{
+    auto message = std::make_shared<Message>();
+    message->id = id;
+    message->loginName = login;
+    return message;
+}
+
+}  // namespace
+
+TEST(MessageIndex, FindByID)
+{
+    MessageIndex index;
+    auto a = makeMessage("a", "forsen");
+    auto b = makeMessage("b", "pajlada");
+    index.add(a);
+    index.add(b);
+
+    EXPECT_EQ(index.findByID("a"), a);
+    EXPECT_EQ(index.findByID("b"), b);
+    EXPECT_EQ(index.findByID("c"), nullptr);
+    EXPECT_EQ(index.findByID(""), nullptr);
+
+    index.remove(a);
+    EXPECT_EQ(index.findByID("a"), nullptr);
+    EXPECT_EQ(index.findByID("b"), b);
+}
+
+TEST(MessageIndex, DuplicateIDs)
+{
+    MessageIndex index;
+    auto first = makeMessage("a", "forsen");
+    auto second = makeMessage("a", "forsen");
+    index.add(first);
+    index.add(second);
+
+    // The most recent one is returned
+    EXPECT_EQ(index.findByID("a"), second);
+
+    // Evicting the older one keeps the newer one
+    index.remove(first);
+    EXPECT_EQ(index.findByID("a"), second);
+
+    index.remove(second);
+    EXPECT_EQ(index.findByID("a"), nullptr);
+}
+
+TEST(MessageIndex, FindByAuthor)
+{
+    MessageIndex index;
+    auto a = makeMessage("a", "forsen");
+    auto b = makeMessage("b", "pajlada");
+    auto c = makeMessage("c", "forsen");
+    auto older = makeMessage("d", "forsen");
+    auto system = makeMessage("", "");
+    index.add(a);
+    index.add(b);
+    index.add(c);
+    index.addAtStart(older);
+    index.add(system);
+
+    EXPECT_EQ(index.findByAuthor("forsen"),
+              (std::vector<MessagePtr>{older, a, c}));
+    EXPECT_EQ(index.findByAuthor("pajlada"), (std::vector<MessagePtr>{b}));
+    EXPECT_TRUE(index.findByAuthor("").empty());
+    EXPECT_TRUE(index.findByAuthor("nobody").empty());
+
+    index.remove(older);
+    index.remove(a);
+    EXPECT_EQ(index.findByAuthor("forsen"), (std::vector<MessagePtr>{c}));
+}
+
+TEST(MessageIndex, RemoveOutOfOrder)
+{
+    MessageIndex index;
+    auto a = makeMessage("a", "forsen");
+    auto b = makeMessage("b", "forsen");
+    auto c = makeMessage("c", "forsen");
+    index.add(a);
+    index.add(b);
+    index.add(c);
+
+    // Not the oldest message
+    index.remove(b);
+    EXPECT_EQ(index.findByAuthor("forsen"), (std::vector<MessagePtr>{a, c}));
+
+    // Not indexed anymore
+    index.remove(b);
+    EXPECT_EQ(index.findByAuthor("forsen"), (std::vector<MessagePtr>{a, c}));
+
+    index.remove(a);
+    index.remove(c);
+    EXPECT_TRUE(index.findByAuthor("forsen").empty());
+}
+
+TEST(MessageIndex, FindByAuthorIgnoresCase)
+{
+    MessageIndex index;
+    auto a = makeMessage("a", "Forsen");
+    auto b = makeMessage("b", "forsen");
+    index.add(a);
+    index.add(b);
+
+    EXPECT_EQ(index.findByAuthor("forsen"), (std::vector<MessagePtr>{a, b}));
+    EXPECT_EQ(index.findByAuthor("FORSEN"), (std::vector<MessagePtr>{a, b}));
+    EXPECT_EQ(index.findByAuthorName("forsen"),
+              (std::vector<MessagePtr>{a, b}));
+
+    index.remove(a);
+    EXPECT_EQ(index.findByAuthor("forsen"), (std::vector<MessagePtr>{b}));
+}
+
+TEST(MessageIndex, Replace)
+{
+    MessageIndex index;
+    auto original = makeMessage("a", "forsen");
+    auto replacement = makeMessage("b", "pajlada");
+    index.add(original);
+    index.replace(original, replacement);
+
+    EXPECT_EQ(index.findByID("a"), nullptr);
+    EXPECT_EQ(index.findByID("b"), replacement);
+    EXPECT_TRUE(index.findByAuthor("forsen").empty());
+    EXPECT_EQ(index.findByAuthor("pajlada"),
+              (std::vector<MessagePtr>{replacement}));
+
+    index.clear();
+    EXPECT_EQ(index.findByID("b"), nullptr);
+    EXPECT_TRUE(index.findByAuthor("pajlada").empty());
+}
+
+TEST(MessageIndex, ReplaceKeepsPosition)
+{
+    MessageIndex index;
+    auto a = makeMessage("a", "forsen");
+    auto b = makeMessage("b", "forsen");
+    auto c = makeMessage("c", "forsen");
+    auto replacement = makeMessage("b", "forsen");
+    index.add(a);
+    index.add(b);
+    index.add(c);
+    index.replace(b, replacement);
+
+    EXPECT_EQ(index.findByAuthor("forsen"),
+              (std::vector<MessagePtr>{a, replacement, c}));
+    EXPECT_EQ(index.findByID("b"), replacement);
+}
+
+TEST(MessageIndex, FindByAuthorName)
+{
+    MessageIndex index;
+    auto a = makeMessage("a", "forsen");
+    a->displayName = "Forsen";
+    auto b = makeMessage("b", "kim");
+    b->displayName = "김";
+    index.add(a);
+    index.add(b);
+
+    EXPECT_EQ(index.findByAuthorName("FORSEN"), (std::vector<MessagePtr>{a}));
+    EXPECT_EQ(index.findByAuthorName("김"), (std::vector<MessagePtr>{b}));
+    EXPECT_EQ(index.findByAuthorName("kim"), (std::vector<MessagePtr>{b}));
+    EXPECT_TRUE(index.findByAuthorName("pajlada").empty());
+}
+
+TEST(MessageIndex, FindByAuthorNameKeepsOrder)
+{
+    MessageIndex index;
+    // "kim" is the login of one user and the display name of another
+    auto a = makeMessage("a", "kim");
+    a->serverReceivedTime = QDateTime::fromSecsSinceEpoch(1);
+    auto b = makeMessage("b", "other");
+    b->displayName = "Kim";
+    b->serverReceivedTime = QDateTime::fromSecsSinceEpoch(2);
+    auto c = makeMessage("c", "kim");
+    c->serverReceivedTime = QDateTime::fromSecsSinceEpoch(3);
+    index.add(a);
+    index.add(b);
+    index.add(c);
+
+    EXPECT_EQ(index.findByAuthorName("kim"), (std::vector<MessagePtr>{a, b, c}));
+}
+
+TEST(MessageIndex, FindByBadge)
+{
+    MessageIndex index;
+    auto a = makeMessage("a", "forsen");
+    a->badges.emplace_back("moderator", "1");
+    a->badges.emplace_back("subscriber", "12");
+    auto b = makeMessage("b", "pajlada");
+    b->badges.emplace_back("subscriber", "3");
+    index.add(a);
+    index.add(b);
+
+    EXPECT_EQ(index.findByBadge("Moderator"), (std::vector<MessagePtr>{a}));
+    EXPECT_EQ(index.findByBadge("subscriber"),
+              (std::vector<MessagePtr>{a, b}));
+    EXPECT_TRUE(index.findByBadge("vip").empty());
+
+    index.remove(a);
+    EXPECT_TRUE(index.findByBadge("moderator").empty());
+    EXPECT_EQ(index.findByBadge("subscriber"), (std::vector<MessagePtr>{b}));
+}
+
+TEST(MessageIndex, FindWithLinks)
+{
+    MessageIndex index;
+    // MessageBuilder::addLink sets the flag, the text isn't parsed again
+    auto a = makeMessage("a", "forsen");
+    a->messageText = "check out https://chatterino.com";
+    a->flags.set(MessageFlag::HasLink);
+    auto b = makeMessage("b", "pajlada");
+    b->messageText = "https://chatterino.com";
+    index.add(a);
+    index.add(b);
+
+    EXPECT_EQ(index.findWithLinks(), (std::vector<MessagePtr>{a}));
+
+    index.remove(a);
+    EXPECT_TRUE(index.findWithLinks().empty());
+}
+
+TEST(MessageIndex, FindByTarget)
+{
+    MessageIndex index;
+    auto timeout = makeMessage("", "");
+    timeout->timeoutUser = "Forsen";
+    auto sub = makeMessage("", "");
+    sub->flags.set(MessageFlag::Subscription);
+    sub->messageText = "forsen subscribed at Tier 1.";
+    auto chat = makeMessage("c", "pajlada");
+    chat->messageText = "forsen hi";
+    index.add(timeout);
+    index.add(sub);
+    index.add(chat);
+
+    EXPECT_EQ(index.findByTarget("forsen"),
+              (std::vector<MessagePtr>{timeout, sub}));
+    EXPECT_TRUE(index.findByTarget("pajlada").empty());
+}
@@ -2,17 +2,26 @@
 
 #include "Application.hpp"
 #include "controllers/accounts/AccountController.hpp"
+#include "messages/layouts/MessageLayoutContext.hpp"
+#include "messages/layouts/MessageLayoutWorker.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "messages/MessageElement.hpp"
+#include "messages/Selection.hpp"
 #include "mocks/EmptyApplication.hpp"
+#include "providers/colors/ColorProvider.hpp"
 #include "singletons/Emotes.hpp"
 #include "singletons/Fonts.hpp"
 #include "singletons/Settings.hpp"
 #include "singletons/Theme.hpp"
 #include "singletons/WindowManager.hpp"
 #include "Test.hpp"
+#include "util/DebugCount.hpp"
 
+#include <QCoreApplication>
 #include <QDebug>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QPainter>
 #include <QString>
 
 #include <memory>
@@ -88,3 +97,149 @@ TEST(TextElement, BasicCase)
     EXPECT_EQ(wordStart, 0);
     EXPECT_EQ(wordEnd, 3);
 }
+
+TEST(MessageLayout, SharedBetweenViews)
+{
+    MockApplication mockApplication;
+
+    MessageBuilder builder;
+    builder.append(
+        std::make_unique<TextElement>("abc def", MessageElementFlag::Text));
+    auto message = builder.release();
+
+    MessageLayout first(message);
+    MessageLayout second(message);
+    first.layout(WIDTH, 1, 1, MessageElementFlag::Text, false);
+    second.layout(WIDTH, 1, 1, MessageElementFlag::Text, false);
+
+    // Both views use the same laid out elements
+    auto point = QPoint(WIDTH / 20, first.getHeight() / 2);
+    const auto *element = first.getElementAt(point);
+    ASSERT_NE(element, nullptr);
+    EXPECT_EQ(second.getElementAt(point), element);
+
+    // A different width diverges from the shared layout without changing it
+    second.layout(WIDTH / 2, 1, 1, MessageElementFlag::Text, false);
+    EXPECT_NE(second.getElementAt(point), element);
+    EXPECT_EQ(first.getElementAt(point), element);
+
+    // Layouts with different flags aren't shared
+    MessageLayout alternate(message);
+    alternate.flags.set(MessageLayoutFlag::AlternateBackground);
+    alternate.layout(WIDTH, 1, 1, MessageElementFlag::Text, false);
+    EXPECT_NE(alternate.getElementAt(point), element);
+}
+
+TEST(MessageLayout, KeepsSharedBufferForDifferentCanvasWidths)
+{
+    MockApplication mockApplication;
+
+    MessageBuilder builder;
+    builder.append(
+        std::make_unique<TextElement>("abc def", MessageElementFlag::Text));
+    auto message = builder.release();
+
+    // Same layout width, but only one view shows a scrollbar
+    MessageLayout first(message);
+    MessageLayout second(message);
+    first.layout(WIDTH, 1, 1, MessageElementFlag::Text, false);
+    second.layout(WIDTH, 1, 1, MessageElementFlag::Text, false);
+
+    QImage image(WIDTH + 20, 100, QImage::Format_ARGB32_Premultiplied);
+    QPainter painter(&image);
+    Selection selection;
+    MessageColors colors;
+    MessagePreferences preferences;
+    auto paint = [&](MessageLayout &layout, int canvasWidth) {
+        layout.paint({
+            .painter = painter,
+            .selection = selection,
+            .colorProvider = ColorProvider::instance(),
+            .messageColors = colors,
+            .preferences = preferences,
+            .canvasWidth = canvasWidth,
+        });
+    };
+
+    auto buffers = DebugCount::get("message drawing buffers");
+    paint(first, WIDTH);
+    paint(second, WIDTH + 20);
+    EXPECT_EQ(DebugCount::get("message drawing buffers"), buffers + 2);
+
+    // Painting again reuses both buffers instead of recreating the shared one
+    paint(first, WIDTH);
+    paint(second, WIDTH + 20);
+    EXPECT_EQ(DebugCount::get("message drawing buffers"), buffers + 2);
+
+    // Once the other view is gone, the shared buffer is used again
+    first.deleteBuffer();
+    paint(second, WIDTH + 20);
+    EXPECT_EQ(DebugCount::get("message drawing buffers"), buffers + 1);
+
+    second.deleteBuffer();
+    EXPECT_EQ(DebugCount::get("message drawing buffers"), buffers);
+}
+
+TEST(MessageLayout, MeasuresInBackground)
+{
+    MockApplication mockApplication;
+
+    MessageBuilder builder;
+    builder.append(
+        std::make_unique<TextElement>("abc def", MessageElementFlag::Text));
+    auto message = builder.release();
+
+    bool measured = false;
+    pajlada::Signals::ScopedConnection connection(
+        MessageLayoutWorker::instance().measured.connect([&] {
+            measured = true;
+        }));
+    auto measurements = DebugCount::get("text measurements");
+
+    // Two views with different widths, so they don't share the layout
+    auto first = std::make_shared<MessageLayout>(message);
+    auto second = std::make_shared<MessageLayout>(message);
+    EXPECT_FALSE(first->layout(WIDTH, 1, 1, MessageElementFlag::Text, false,
+                               TextMeasuring::InBackground));
+    EXPECT_FALSE(second->layout(WIDTH / 2, 1, 1, MessageElementFlag::Text,
+                                false, TextMeasuring::InBackground));
+
+    // Both wait for the same measurement with a placeholder height
+    EXPECT_GT(first->getHeight(), 0);
+    EXPECT_EQ(first->getElementAt({WIDTH / 20, first->getHeight() / 2}),
+              nullptr);
+    EXPECT_EQ(DebugCount::get("text measurements"), measurements + 1);
+
+    QElapsedTimer timer;
+    timer.start();
+    while (!measured && !timer.hasExpired(5000))
+    {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+    ASSERT_TRUE(measured);
+
+    EXPECT_TRUE(first->flags.has(MessageLayoutFlag::RequiresLayout));
+    EXPECT_TRUE(second->flags.has(MessageLayoutFlag::RequiresLayout));
+    EXPECT_TRUE(first->layout(WIDTH, 1, 1, MessageElementFlag::Text, false,
+                              TextMeasuring::InBackground));
+    EXPECT_TRUE(second->layout(WIDTH / 2, 1, 1, MessageElementFlag::Text,
+                               false, TextMeasuring::InBackground));
+    auto point = QPoint(WIDTH / 20, first->getHeight() / 2);
+    EXPECT_NE(first->getElementAt(point), nullptr);
+    EXPECT_NE(second->getElementAt(point), nullptr);
+
+    // A third view reuses the metrics instead of measuring again
+    auto third = std::make_shared<MessageLayout>(message);
+    EXPECT_TRUE(third->layout(WIDTH / 3, 1, 1, MessageElementFlag::Text,
+                              false, TextMeasuring::InBackground));
+    EXPECT_EQ(DebugCount::get("text measurements"), measurements + 1);
+
+    // Messages in the viewport are measured right away
+    MessageBuilder otherBuilder;
+    otherBuilder.append(
+        std::make_unique<TextElement>("ghi jkl", MessageElementFlag::Text));
+    auto visible = std::make_shared<MessageLayout>(otherBuilder.release());
+    EXPECT_TRUE(visible->layout(WIDTH, 1, 1, MessageElementFlag::Text, false));
+    EXPECT_NE(visible->getElementAt(point), nullptr);
+    EXPECT_EQ(DebugCount::get("text measurements"), measurements + 2);
+}
@@ -0,0 +1,393 @@
+#include "providers/twitch/ModerationQueue.hpp"
+
+#include "mocks/Helix.hpp"
+#include "providers/twitch/api/Helix.hpp"
+#include "Test.hpp"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonObject>
+#include <QTimer>
+
+#include <chrono>
+#include <thread>
+
+using namespace chatterino;
+using namespace std::chrono_literals;
+using ::testing::NiceMock;
+
+namespace {
+
+/**
+ * Pretends to be the moderation endpoints of Helix. Each request takes a
+ * point out of a bucket of `points` which is refilled every `refill`. Once
+ * it's empty, requests fail with a 429 like on Twitch.
+ */
+class ModerationServer
+{
+public:
+    ModerationServer(int points, std::chrono::milliseconds refill)
+        : points_(points)
+        , refill_(refill)
+        , bucket_(points)
+        , reset_(QDateTime::currentDateTime().addMSecs(refill.count()))
+    {
+        initializeHelix(&this->helix);
+
+        ON_CALL(this->helix, ratelimit).WillByDefault([this] {
+            return HelixRatelimit{this->remaining_, this->reset_};
+        });
+        ON_CALL(this->helix, banUser)
+            .WillByDefault(
+                [this](QString, QString, QString userID, std::optional<int>,
+                       QString, ResultCallback<> successCallback,
+                       IHelix::FailureCallback<HelixBanUserError, QString>
+                           failureCallback) {
+                    this->handle(
+                        userID, successCallback,
+                        [=, this] {
+                            failureCallback(this->banErrors.value(userID),
+                                            "Forwarded error");
+                        },
+                        [=] {
+                            failureCallback(HelixBanUserError::Ratelimited,
+                                            "Too Many Requests");
+                        });
+                });
+        ON_CALL(this->helix, deleteChatMessages)
+            .WillByDefault(
+                [this](QString, QString, QString messageID,
+                       ResultCallback<> successCallback,
+                       IHelix::FailureCallback<HelixDeleteChatMessagesError,
+                                               QString>
+                           failureCallback) {
+                    this->handle(
+                        messageID, successCallback,
+                        [=] {
+                            failureCallback(HelixDeleteChatMessagesError::
+                                                MessageUnavailable,
+                                            {});
+                        },
+                        [=] {
+                            failureCallback(
+                                HelixDeleteChatMessagesError::Ratelimited,
+                                "Too Many Requests");
+                        });
+                });
+    }
+
+    NiceMock<mock::Helix> helix;
+
+    /// Bans of these users fail with the given error
+    QHash<QString, HelixBanUserError> banErrors;
+
+    QStringList requests;
+    int maxInFlight = 0;
+    int ratelimited = 0;
+
+private:
+    void handle(const QString &target, const ResultCallback<> &success,
+                const std::function<void()> &failure,
+                const std::function<void()> &onRatelimited)
+    {
+        this->requests.append(target);
+        this->inFlight_++;
+        this->maxInFlight = std::max(this->maxInFlight, this->inFlight_);
+
+        QTimer::singleShot(5ms, [=, this] {
+            this->inFlight_--;
+
+            auto now = QDateTime::currentDateTime();
+            if (now >= this->reset_)
+            {
+                this->bucket_ = this->points_;
+                this->reset_ = now.addMSecs(this->refill_.count());
+            }
+
+            if (this->bucket_ == 0)
+            {
+                this->remaining_ = 0;
+                this->ratelimited++;
+                onRatelimited();
+                return;
+            }
+            this->bucket_--;
+            this->remaining_ = this->bucket_;
+
+            if (this->banErrors.contains(target) ||
+                target.startsWith("deleted-"))
+            {
+                failure();
+                return;
+            }
+            success();
+        });
+    }
+
+    const int points_;
+    const std::chrono::milliseconds refill_;
+    int bucket_;
+    QDateTime reset_;
+    std::optional<int> remaining_;
+    int inFlight_ = 0;
+};
+
+std::vector<ModerationRequest> makeBans(int count)
+{
+    std::vector<ModerationRequest> requests;
+    for (int i = 0; i < count; i++)
+    {
+        auto name = QString("user%1").arg(i);
+        requests.push_back({
+            .type = ModerationRequest::Type::Ban,
+            .broadcasterID = "11148817",
+            .moderatorID = "117166826",
+            .targetID = name,
+            .targetName = name,
+        });
+    }
+    return requests;
+}
+
+/// Runs the event loop until the last report is a summary
+bool waitForSummary(const QStringList &reports)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (reports.isEmpty() || !reports.last().startsWith("Finished"))
+    {
+        if (timer.hasExpired(10000))
+        {
+            return false;
+        }
+        QCoreApplication::processEvents(QEventLoop::AllEvents);
+        std::this_thread::sleep_for(1ms);
+    }
+    return true;
+}
+
+}  // namespace
+
+TEST(ModerationQueue, LimitsConcurrency)
+{
+    ModerationServer server(800, 60s);
+    ModerationQueue queue(10ms);
+    QStringList reports;
+
+    queue.enqueue(makeBans(30), [&](const auto &text) {
+        reports.append(text);
+    });
+    ASSERT_EQ(reports.first(), "Queued 30 bans.");
+    ASSERT_TRUE(waitForSummary(reports));
+
+    ASSERT_EQ(reports.last(), "Finished 30 bans: 30 succeeded, 0 failed.");
+    ASSERT_EQ(server.requests.size(), 30);
+    ASSERT_EQ(server.maxInFlight, ModerationQueue::MAX_IN_FLIGHT);
+    ASSERT_EQ(queue.pending(), 0);
+}
+
+TEST(ModerationQueue, WaitsForRatelimitReset)
+{
+    // The queue leaves RESERVED_POINTS in the bucket, so only a few requests
+    // fit in each window
+    ModerationServer server(ModerationQueue::RESERVED_POINTS + 6, 100ms);
+    ModerationQueue queue(10ms);
+    QStringList reports;
+
+    QElapsedTimer timer;
+    timer.start();
+    queue.enqueue(makeBans(20), [&](const auto &text) {
+        reports.append(text);
+    });
+    ASSERT_TRUE(waitForSummary(reports));
+
+    ASSERT_EQ(reports.last(), "Finished 20 bans: 20 succeeded, 0 failed.");
+    ASSERT_EQ(server.ratelimited, 0);
+    ASSERT_GE(timer.elapsed(), 200);
+}
+
+TEST(ModerationQueue, RetriesRatelimitedRequests)
+{
+    // Smaller than the requests in flight, some of them will get a 429
+    ModerationServer server(2, 50ms);
+    ModerationQueue queue(10ms);
+    QStringList reports;
+
+    queue.enqueue(makeBans(10), [&](const auto &text) {
+        reports.append(text);
+    });
+    ASSERT_TRUE(waitForSummary(reports));
+
+    ASSERT_EQ(reports.last(), "Finished 10 bans: 10 succeeded, 0 failed.");
+    ASSERT_GT(server.ratelimited, 0);
+    ASSERT_EQ(server.requests.size(), 10 + server.ratelimited);
+}
+
+TEST(ModerationQueue, GivesUpAfterMaxAttempts)
+{
+    ModerationServer server(800, 60s);
+    server.banErrors["user1"] = HelixBanUserError::ConflictingOperation;
+    ModerationQueue queue(1ms);
+    QStringList reports;
+
+    queue.enqueue(makeBans(3), [&](const auto &text) {
+        reports.append(text);
+    });
+    ASSERT_TRUE(waitForSummary(reports));
+
+    ASSERT_EQ(reports.last(),
+              "Finished 3 bans: 2 succeeded, 1 failed. Failed: user1 "
+              "(conflicting ban operation)");
+    ASSERT_EQ(server.requests.count("user1"), ModerationQueue::MAX_ATTEMPTS);
+}
+
+TEST(ModerationQueue, ReportsFailures)
+{
+    ModerationServer server(800, 60s);
+    server.banErrors["user0"] = HelixBanUserError::CannotBanUser;
+    server.banErrors["user1"] = HelixBanUserError::TargetBanned;
+    server.banErrors["user2"] = HelixBanUserError::Forwarded;
+    ModerationQueue queue(10ms);
+    QStringList reports;
+
+    queue.enqueue(makeBans(4), [&](const auto &text) {
+        reports.append(text);
+    });
+    ASSERT_TRUE(waitForSummary(reports));
+
+    // Users that are already banned count as done
+    ASSERT_EQ(reports.last(),
+              "Finished 4 bans: 2 succeeded, 2 failed. Failed: user0 (can't "
+              "be banned), user2 (Forwarded error)");
+}
+
+TEST(ModerationQueue, StopsBatchWithoutPermission)
+{
+    ModerationServer server(800, 60s);
+    for (int i = 0; i < 100; i++)
+    {
+        server.banErrors[QString("user%1").arg(i)] =
+            HelixBanUserError::UserNotAuthorized;
+    }
+    ModerationQueue queue(10ms);
+    QStringList reports;
+
+    queue.enqueue(makeBans(100), [&](const auto &text) {
+        reports.append(text);
+    });
+    ASSERT_TRUE(waitForSummary(reports));
+
+    ASSERT_EQ(reports.last(),
+              "Finished 100 bans: 0 succeeded, 100 failed. Stopped early: you "
+              "don't have permission to perform that action.");
+    ASSERT_LE(server.requests.size(), ModerationQueue::MAX_IN_FLIGHT);
+    ASSERT_EQ(queue.pending(), 0);
+}
+
+TEST(ModerationQueue, ReportsProgress)
+{
+    ModerationServer server(800, 60s);
+    ModerationQueue queue(10ms);
+    QStringList reports;
+
+    queue.enqueue(makeBans(120), [&](const auto &text) {
+        reports.append(text);
+    });
+    ASSERT_TRUE(waitForSummary(reports));
+
+    ASSERT_EQ(reports, QStringList({
+                           "Queued 120 bans.",
+                           "50/120 bans done.",
+                           "100/120 bans done.",
+                           "Finished 120 bans: 120 succeeded, 0 failed.",
+                       }));
+}
+
+TEST(ModerationQueue, DeletesMessages)
+{
+    ModerationServer server(800, 60s);
+    ModerationQueue queue(10ms);
+    QStringList reports;
+
+    std::vector<ModerationRequest> requests;
+    for (const auto *id : {"a", "deleted-b", "c"})
+    {
+        requests.push_back({
+            .type = ModerationRequest::Type::DeleteMessage,
+            .broadcasterID = "11148817",
+            .moderatorID = "117166826",
+            .targetID = id,
+            .targetName = "forsen",
+        });
+    }
+    queue.enqueue(std::move(requests), [&](const auto &text) {
+        reports.append(text);
+    });
+    ASSERT_TRUE(waitForSummary(reports));
+
+    // Messages that are already gone count as deleted
+    ASSERT_EQ(reports.first(), "Queued 3 message deletions.");
+    ASSERT_EQ(reports.last(),
+              "Finished 3 message deletions: 3 succeeded, 0 failed.");
+}
+
+TEST(ModerationQueue, SplitsTargets)
+{
+    ASSERT_EQ(splitModerationTargets({"forsen,pajlada", "@nymn\nzneix", ","}),
+              QStringList({"forsen", "pajlada", "@nymn", "zneix"}));
+}
+
+TEST(ModerationQueue, ResolvesTargetsInBatches)
+{
+    NiceMock<mock::Helix> helix;
+    initializeHelix(&helix);
+
+    int lookups = 0;
+    ON_CALL(helix, fetchUsers)
+        .WillByDefault([&](QStringList, QStringList userLogins,
+                           ResultCallback<std::vector<HelixUser>> success,
+                           HelixFailureCallback) {
+            lookups++;
+            ASSERT_LE(userLogins.size(), 100);
+
+            std::vector<HelixUser> users;
+            for (const auto &login : userLogins)
+            {
+                if (login.startsWith("unknown"))
+                {
+                    continue;
+                }
+                users.emplace_back(QJsonObject{
+                    {"id", "id-" + login.toLower()},
+                    {"login", login.toLower()},
+                    {"display_name", login},
+                });
+            }
+            success(users);
+        });
+
+    QStringList targets{"id:123", "Bot0", "bot0", "@unknown1"};
+    for (int i = 1; i < 250; i++)
+    {
+        targets.append(QString("bot%1").arg(i));
+    }
+
+    std::vector<ModerationTarget> found;
+    QStringList missing;
+    bool done = false;
+    resolveModerationTargets(targets, [&](auto users, auto unknown) {
+        found = std::move(users);
+        missing = std::move(unknown);
+        done = true;
+    });
+
+    ASSERT_TRUE(done);
+    ASSERT_EQ(lookups, 3);
+    ASSERT_EQ(found.size(), 251);
+    ASSERT_EQ(found.front().id, "123");
+    ASSERT_EQ(found.at(1).id, "id-bot0");
+    ASSERT_EQ(found.at(1).name, "Bot0");
+    ASSERT_EQ(missing, QStringList{"unknown1"});
+}
@@ -1,10 +1,13 @@
 #include "common/network/NetworkRequest.hpp"
 
 #include "common/network/NetworkManager.hpp"
+#include "common/network/NetworkPrivate.hpp"
 #include "common/network/NetworkResult.hpp"
 #include "Test.hpp"
+#include "util/DebugCount.hpp"
 
 #include <QCoreApplication>
+#include <QElapsedTimer>
 
 using namespace chatterino;
 
@@ -278,3 +281,94 @@ TEST(NetworkRequest, FinallyCallbackOnTimeout)
     EXPECT_FALSE(onSuccessCalled);
     EXPECT_TRUE(NetworkManager::workerThread->isRunning());
 }
+
+TEST(NetworkRequest, IdenticalRequestsShareResults)
+{
+    EXPECT_TRUE(NetworkManager::workerThread->isRunning());
+
+    auto url = getDelayURL(1);
+    int successes = 0;
+    int finished = 0;
+    auto started = DebugCount::get("http request started");
+    auto coalesced = DebugCount::get("http request coalesced");
+
+    // The second and third request join the first one
+    for (int i = 0; i < 3; i++)
+    {
+        NetworkRequest(url)
+            .onSuccess([&](const NetworkResult &result) {
+                EXPECT_EQ(result.status(), 200);
+                successes++;
+            })
+            .finally([&] {
+                finished++;
+            })
+            .execute();
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    while (finished < 3 && timer.elapsed() < 10000)
+    {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    }
+
+    EXPECT_EQ(successes, 3);
+    EXPECT_EQ(finished, 3);
+    EXPECT_EQ(DebugCount::get("http request started"), started + 1);
+    EXPECT_EQ(DebugCount::get("http request coalesced"), coalesced + 2);
+
+    // Once it's done, the same request loads again
+    RequestWaiter waiter;
+    NetworkRequest(url)
+        .finally([&waiter] {
+            waiter.requestDone();
+        })
+        .execute();
+    waiter.waitForRequest();
+
+    EXPECT_EQ(DebugCount::get("http request started"), started + 2);
+    EXPECT_EQ(DebugCount::get("http request coalesced"), coalesced + 2);
+    EXPECT_TRUE(NetworkManager::workerThread->isRunning());
+}
+
+TEST(NetworkRequest, FollowersLoadOnTheirOwnIfCancelled)
+{
+    EXPECT_TRUE(NetworkManager::workerThread->isRunning());
+
+    QUrl url(getStatusURL(200));
+    auto started = DebugCount::get("http request started");
+
+    // Pretends to be a request that's loading
+    auto leader = std::make_shared<NetworkData>();
+    leader->request.setUrl(url);
+    auto registered = leader;
+    ASSERT_FALSE(joinInFlightRequest(registered));
+
+    RequestWaiter waiter;
+    bool onSuccessCalled = false;
+    auto follower = std::make_shared<NetworkData>();
+    follower->request.setUrl(url);
+    follower->onSuccess = [&](const NetworkResult &result) {
+        EXPECT_EQ(result.status(), 200);
+        onSuccessCalled = true;
+    };
+    follower->finally = [&waiter] {
+        waiter.requestDone();
+    };
+    load(std::move(follower));
+
+    ASSERT_EQ(leader->followers.size(), 1);
+    EXPECT_EQ(DebugCount::get("http request started"), started);
+
+    // This is what happens when the reply of the leader is cancelled
+    leader->reloadFollowers();
+    ASSERT_TRUE(leader->followers.empty());
+
+    waiter.waitForRequest();
+
+    EXPECT_TRUE(onSuccessCalled);
+    EXPECT_EQ(DebugCount::get("http request started"), started + 1);
+    EXPECT_TRUE(NetworkManager::workerThread->isRunning());
+}
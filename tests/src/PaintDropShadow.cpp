@@ -0,0 +1,34 @@
+#include "providers/seventv/paints/PaintDropShadow.hpp"
+
+#include "Test.hpp"
+
+#include <QColor>
+#include <QImage>
+
+using namespace chatterino;
+
+TEST(PaintDropShadow, ScalesByDevicePixelRatio)
+{
+    QImage image(16, 16, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    image.setDevicePixelRatio(2);
+    // One logical pixel in the top left
+    for (int y = 0; y < 2; y++)
+    {
+        for (int x = 0; x < 2; x++)
+        {
+            image.setPixelColor(x, y, Qt::white);
+        }
+    }
+
+    // A radius of 0 doesn't blur, so the shadow is an exact copy
+    PaintDropShadow(3, 1, 0, Qt::black).apply(image);
+
+    EXPECT_EQ(image.devicePixelRatio(), 2);
+    EXPECT_EQ(image.pixelColor(0, 0), QColor(Qt::white));
+    // The offset is in logical pixels
+    EXPECT_EQ(image.pixelColor(6, 2), QColor(Qt::black));
+    EXPECT_EQ(image.pixelColor(7, 3), QColor(Qt::black));
+    EXPECT_EQ(image.pixelColor(3, 1).alpha(), 0);
+    EXPECT_EQ(image.pixelColor(8, 4).alpha(), 0);
+}
@@ -0,0 +1,138 @@
+#include "providers/pronoundb/PronounDbApi.hpp"
+
+#include "mocks/Helix.hpp"
+#include "providers/twitch/api/Helix.hpp"
+#include "Test.hpp"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+
+#include <chrono>
+#include <vector>
+
+using namespace chatterino;
+using namespace std::chrono_literals;
+using ::testing::NiceMock;
+
+namespace {
+
+struct Lookup {
+    QStringList logins;
+    ResultCallback<std::vector<HelixUser>> success;
+    HelixFailureCallback failure;
+};
+
+/// Records the user lookups of the PronounDbApi without answering them
+class PronounDbApiTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        initializeHelix(&this->helix);
+        ON_CALL(this->helix, fetchUsers)
+            .WillByDefault(
+                [this](QStringList, QStringList userLogins,
+                       ResultCallback<std::vector<HelixUser>> success,
+                       HelixFailureCallback failure) {
+                    this->lookups.push_back({userLogins, success, failure});
+                });
+    }
+
+    /// Runs the event loop until `count` lookups were made
+    bool waitForLookups(size_t count)
+    {
+        QElapsedTimer timer;
+        timer.start();
+        while (this->lookups.size() < count)
+        {
+            if (timer.hasExpired(5000))
+            {
+                return false;
+            }
+            QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+        }
+        return true;
+    }
+
+    /// Runs the event loop for longer than a batch takes to be sent
+    void waitForBatch()
+    {
+        QElapsedTimer timer;
+        timer.start();
+        while (!timer.hasExpired(50))
+        {
+            QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+        }
+    }
+
+    NiceMock<mock::Helix> helix;
+    std::vector<Lookup> lookups;
+
+    std::chrono::steady_clock::time_point now{};
+    PronounDbApi api{1ms, [this] {
+                         return this->now;
+                     }};
+};
+
+}  // namespace
+
+TEST_F(PronounDbApiTest, BatchesLookups)
+{
+    QStringList usernames{"", "forsen", "forsen"};
+    for (int i = 0; i < 250; i++)
+    {
+        usernames.append(QString("user%1").arg(i));
+    }
+    this->api.getFromUsernames(usernames);
+
+    ASSERT_TRUE(this->waitForLookups(3));
+    this->waitForBatch();
+    ASSERT_EQ(this->lookups.size(), 3);
+
+    EXPECT_EQ(this->lookups[0].logins.size(), PronounDbApi::HELIX_BATCH_SIZE);
+    EXPECT_EQ(this->lookups[0].logins.first(), "forsen");
+    EXPECT_EQ(this->lookups[1].logins.size(), PronounDbApi::HELIX_BATCH_SIZE);
+    EXPECT_EQ(this->lookups[2].logins.size(), 51);
+    EXPECT_EQ(this->lookups[2].logins.last(), "user249");
+}
+
+TEST_F(PronounDbApiTest, SkipsPendingUsers)
+{
+    this->api.getFromUsernames({"forsen"});
+    this->api.getFromUsernames({"forsen"});
+    ASSERT_TRUE(this->waitForLookups(1));
+    EXPECT_EQ(this->lookups[0].logins, QStringList{"forsen"});
+
+    // Still being looked up
+    this->api.getFromUsernames({"forsen", "pajlada"});
+    ASSERT_TRUE(this->waitForLookups(2));
+    this->waitForBatch();
+    ASSERT_EQ(this->lookups.size(), 2);
+    EXPECT_EQ(this->lookups[1].logins, QStringList{"pajlada"});
+
+    // A failed lookup is cached like a user without pronouns
+    this->lookups[0].failure();
+    EXPECT_FALSE(this->api.getPronounsForUsername("forsen").has_value());
+    this->api.getFromUsernames({"forsen"});
+    this->waitForBatch();
+    ASSERT_EQ(this->lookups.size(), 2);
+}
+
+TEST_F(PronounDbApiTest, LooksUpExpiredUsers)
+{
+    this->api.getFromUsernames({"forsen"});
+    ASSERT_TRUE(this->waitForLookups(1));
+
+    // Unknown users are done without asking pronoundb.org
+    this->lookups[0].success({});
+
+    this->now += PronounDbApi::NO_PRONOUNS_TTL - 1min;
+    this->api.getFromUsernames({"forsen"});
+    this->waitForBatch();
+    ASSERT_EQ(this->lookups.size(), 1);
+
+    this->now += 2min;
+    this->api.getFromUsernames({"forsen"});
+    ASSERT_TRUE(this->waitForLookups(2));
+    EXPECT_EQ(this->lookups[1].logins, QStringList{"forsen"});
+}
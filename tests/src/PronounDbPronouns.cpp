@@ -0,0 +1,43 @@
+#include "providers/pronoundb/PronounDbPronouns.hpp"
+
+#include "Test.hpp"
+
+using namespace chatterino;
+
+TEST(PronounDbPronouns, FromSets)
+{
+    struct TestCase {
+        QStringList sets;
+        QString display;
+        bool specified = true;
+    };
+
+    std::vector<TestCase> tests{
+        {{}, "unspecified", false},
+        {{"he"}, "he/him"},
+        {{"she"}, "she/her"},
+        {{"they"}, "they/them"},
+        {{"it"}, "it/its"},
+        {{"she", "they"}, "she/they"},
+        {{"they", "they"}, "they"},
+        {{"he", "any"}, "any"},
+        {{"ask", "she"}, "ask"},
+        {{"avoid"}, "avoid"},
+        {{"other", "he"}, "other"},
+    };
+
+    for (const auto &test : tests)
+    {
+        auto pronouns = PronounDbPronouns::fromSets(test.sets);
+        EXPECT_EQ(pronouns.display, test.display) << test.sets.join(',');
+        EXPECT_EQ(pronouns.isSpecified(), test.specified)
+            << test.sets.join(',');
+    }
+}
+
+TEST(PronounDbPronouns, FromAlejo)
+{
+    EXPECT_EQ(PronounDbPronouns::fromAlejo("theythem").display, "they/them");
+    EXPECT_EQ(PronounDbPronouns::fromAlejo("shethem").display, "she/they");
+    EXPECT_FALSE(PronounDbPronouns::fromAlejo("forsen").isSpecified());
+}
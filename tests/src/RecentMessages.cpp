@@ -0,0 +1,183 @@
+#include "providers/recentmessages/Impl.hpp"
+
+#include "messages/Message.hpp"
+#include "mocks/Channel.hpp"
+#include "providers/twitch/TwitchChannel.hpp"
+#include "Test.hpp"
+
+#include <QDateTime>
+#include <QJsonArray>
+#include <QJsonObject>
+
+using namespace chatterino;
+using namespace chatterino::recentmessages::detail;
+using chatterino::mock::MockChannel;
+
+namespace {
+
+QString makeNotice(const QString &text, const QDateTime &received)
+{
+    return QString("@msg-id=;rm-received-ts=%1 :tmi.twitch.tv NOTICE #forsen "
+                   ":%2")
+        .arg(received.toMSecsSinceEpoch())
+        .arg(text);
+}
+
+QString toQString(std::string_view view)
+{
+    return QString::fromUtf8(view.data(), static_cast<qsizetype>(view.size()));
+}
+
+}  // namespace
+
+TEST(RecentMessages, ParseKeepsOrderAcrossChunks)
+{
+    QJsonArray messages;
+    int valid = 0;
+    for (int i = 0; i < 1000; i++)
+    {
+        // Lines without a command are skipped
+        if (i % 100 == 50)
+        {
+            messages.append("");
+            continue;
+        }
+        messages.append(
+            QString(":tmi.twitch.tv NOTICE #forsen :line %1").arg(i));
+        valid++;
+    }
+
+    auto lines = parseRecentMessages(QJsonObject{{"messages", messages}});
+
+    ASSERT_EQ(lines.size(), static_cast<size_t>(valid));
+    size_t next = 0;
+    for (int i = 0; i < 1000; i++)
+    {
+        if (i % 100 == 50)
+        {
+            continue;
+        }
+        ASSERT_EQ(toQString(lines[next].parameter(1)),
+                  QString("line %1").arg(i));
+        next++;
+    }
+}
+
+TEST(RecentMessages, ParseEmpty)
+{
+    EXPECT_TRUE(parseRecentMessages({}).empty());
+    EXPECT_TRUE(
+        parseRecentMessages(QJsonObject{{"messages", QJsonArray{}}}).empty());
+}
+
+TEST(RecentMessages, ParseFixesEscapeTag)
+{
+    auto text = QString("a") + ESCAPE_TAG + "b";
+    auto lines = parseRecentMessages(QJsonObject{
+        {"messages",
+         QJsonArray{":tmi.twitch.tv NOTICE #forsen :" + text}},
+    });
+
+    ASSERT_EQ(lines.size(), 1U);
+    EXPECT_EQ(toQString(lines[0].parameter(1)),
+              QString("a") + ZERO_WIDTH_JOINER + "b");
+}
+
+TEST(RecentMessages, BuildInsertsDaySeparators)
+{
+    MockChannel channel("forsen");
+    QDateTime first(QDate(2024, 3, 1), QTime(12, 0));
+    QDateTime second(QDate(2024, 3, 2), QTime(12, 0));
+
+    auto lines = parseRecentMessages(QJsonObject{
+        {"messages",
+         QJsonArray{
+             makeNotice("a", first),
+             makeNotice("b", first.addSecs(60)),
+             makeNotice("c", second),
+         }},
+    });
+    ASSERT_EQ(lines.size(), 3U);
+
+    auto messages = buildRecentMessages(lines, &channel);
+
+    std::vector<QString> texts;
+    for (const auto &message : messages)
+    {
+        EXPECT_TRUE(message->flags.has(MessageFlag::RecentMessage));
+        texts.push_back(message->messageText);
+    }
+    EXPECT_EQ(texts, (std::vector<QString>{
+                         QLocale().toString(first.date(), QLocale::LongFormat),
+                         "a",
+                         "b",
+                         QLocale().toString(second.date(), QLocale::LongFormat),
+                         "c",
+                     }));
+    EXPECT_EQ(channel.lastDate_, second.date());
+
+    // The day didn't change since the last batch
+    auto more = buildRecentMessages(
+        parseRecentMessages(QJsonObject{
+            {"messages", QJsonArray{makeNotice("d", second.addSecs(60))}},
+        }),
+        &channel);
+    ASSERT_EQ(more.size(), 1U);
+    EXPECT_EQ(more[0]->messageText, "d");
+}
+
+TEST(RecentMessages, PrebuildChunks)
+{
+    MockChannel channel("forsen");
+    QDateTime first(QDate(2024, 3, 1), QTime(12, 0));
+    QDateTime second(QDate(2024, 3, 2), QTime(12, 0));
+
+    auto lines = parseRecentMessages(QJsonObject{
+        {"messages",
+         QJsonArray{
+             makeNotice("a", first),
+             makeNotice("b", second),
+             ":tmi.twitch.tv CLEARCHAT #forsen",
+             makeNotice("c", second.addSecs(60)),
+         }},
+    });
+    ASSERT_EQ(lines.size(), 4U);
+    const auto lastDate = channel.lastDate_;
+
+    // The second chunk continues from the day of the line before it
+    auto secondChunk =
+        prebuildRecentMessages(lines, 2, 4, &channel, first.date());
+    ASSERT_EQ(secondChunk.size(), 2U);
+    EXPECT_EQ(secondChunk[0].daySeparator, nullptr);
+    // CLEARCHAT depends on the previous messages
+    EXPECT_FALSE(secondChunk[0].messages.has_value());
+    EXPECT_EQ(secondChunk[1].daySeparator, nullptr);
+    ASSERT_TRUE(secondChunk[1].messages.has_value());
+    ASSERT_EQ(secondChunk[1].messages->size(), 1U);
+    EXPECT_EQ(secondChunk[1].messages->front()->messageText, "c");
+
+    auto firstChunk =
+        prebuildRecentMessages(lines, 0, 2, &channel, first.date());
+    ASSERT_EQ(firstChunk.size(), 2U);
+    EXPECT_EQ(firstChunk[0].daySeparator, nullptr);
+    ASSERT_NE(firstChunk[1].daySeparator, nullptr);
+
+    // The channel is only updated when stitching
+    EXPECT_EQ(channel.lastDate_, lastDate);
+
+    std::vector<MessagePtr> messages;
+    stitchRecentMessages(lines, 0, std::move(firstChunk), &channel, messages);
+    EXPECT_EQ(channel.lastDate_, second.date());
+
+    std::vector<QString> texts;
+    for (const auto &message : messages)
+    {
+        EXPECT_TRUE(message->flags.has(MessageFlag::RecentMessage));
+        texts.push_back(message->messageText);
+    }
+    EXPECT_EQ(texts, (std::vector<QString>{
+                         "a",
+                         QLocale().toString(second.date(), QLocale::LongFormat),
+                         "b",
+                     }));
+}
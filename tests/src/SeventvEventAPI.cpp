@@ -8,6 +8,7 @@
 #include <QString>
 
 #include <optional>
+#include <string_view>
 
 using namespace chatterino;
 using namespace chatterino::seventv::eventapi;
@@ -107,3 +108,78 @@ TEST(SeventvEventAPI, NoHeartbeat)
 
     eventApi.stop();
 }
+
+
+namespace {
+
+std::optional<seventv::eventapi::Message> parse(std::string_view json)
+{
+    return parseBaseMessage(json);
+}
+
+}  // namespace
+
+TEST(SeventvEventAPI, ParseDispatch)
+{
+    auto message = parse(
+        R"({"op":0,"d":{"type":"emote_set.update","body":{"id":"a"}}})");
+    ASSERT_TRUE(message.has_value());
+    ASSERT_EQ(message->op, Opcode::Dispatch);
+    ASSERT_TRUE(message->dispatch.has_value());
+    ASSERT_EQ(message->dispatch->type, SubscriptionType::UpdateEmoteSet);
+    ASSERT_EQ(message->dispatch->body.value("id").toString(), "a");
+
+    ASSERT_FALSE(parse("not json").has_value());
+    ASSERT_FALSE(parse("[]").has_value());
+}
+
+TEST(SeventvEventAPI, ParseMessageWithoutOpcode)
+{
+    // A missing or invalid opcode is treated like a dispatch
+    auto message =
+        parse(R"({"d":{"type":"user.update","body":{}}})");
+    ASSERT_TRUE(message.has_value());
+    ASSERT_EQ(message->op, Opcode::Dispatch);
+    ASSERT_TRUE(message->dispatch.has_value());
+    ASSERT_EQ(message->dispatch->type, SubscriptionType::UpdateUser);
+
+    message = parse(R"({"op":"1","d":{"type":"user.update"}})");
+    ASSERT_TRUE(message.has_value());
+    ASSERT_EQ(message->op, Opcode::Dispatch);
+    ASSERT_TRUE(message->dispatch.has_value());
+    ASSERT_TRUE(message->dispatch->body.isEmpty());
+}
+
+TEST(SeventvEventAPI, ParseMessageWithoutData)
+{
+    auto message = parse(R"({"op":0})");
+    ASSERT_TRUE(message.has_value());
+    ASSERT_FALSE(message->dispatch.has_value());
+    ASSERT_TRUE(message->data.isEmpty());
+
+    message = parse(R"({"op":0,"d":"xd"})");
+    ASSERT_TRUE(message.has_value());
+    ASSERT_FALSE(message->dispatch.has_value());
+
+    message = parse(R"({"op":2,"d":[1]})");
+    ASSERT_TRUE(message.has_value());
+    ASSERT_EQ(message->op, Opcode::Heartbeat);
+    ASSERT_TRUE(message->data.isEmpty());
+
+    // Other opcodes keep their payload as is
+    message = parse(R"({"op":1,"d":{"session_id":"b"}})");
+    ASSERT_TRUE(message.has_value());
+    ASSERT_EQ(message->op, Opcode::Hello);
+    ASSERT_FALSE(message->dispatch.has_value());
+    ASSERT_EQ(message->data.value("session_id").toString(), "b");
+}
+
+TEST(SeventvEventAPI, ParseDispatchWithUnknownType)
+{
+    auto message =
+        parse(R"({"op":0,"d":{"type":"forsen","body":"xd"}})");
+    ASSERT_TRUE(message.has_value());
+    ASSERT_TRUE(message->dispatch.has_value());
+    ASSERT_EQ(message->dispatch->type, SubscriptionType::INVALID);
+    ASSERT_TRUE(message->dispatch->body.isEmpty());
+}
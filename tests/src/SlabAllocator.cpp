@@ -0,0 +1,110 @@
+#include "util/SlabAllocator.hpp"
+
+#include "Test.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace chatterino;
+
+TEST(SlabAllocator, ReusesFreedBlocks)
+{
+    SlabAllocator allocator;
+
+    auto *a = allocator.allocate(40);
+    EXPECT_EQ(allocator.allocatedBytes(), 48);
+    EXPECT_EQ(allocator.reservedBytes(), SlabAllocator::SLAB_SIZE);
+
+    allocator.deallocate(a, 40);
+    EXPECT_EQ(allocator.allocatedBytes(), 0);
+
+    // Same size class
+    auto *b = allocator.allocate(33);
+    EXPECT_EQ(a, b);
+    allocator.deallocate(b, 33);
+}
+
+TEST(SlabAllocator, Alignment)
+{
+    SlabAllocator allocator;
+
+    std::vector<std::pair<void *, size_t>> blocks;
+    for (size_t size = 1; size <= SlabAllocator::MAX_BLOCK_SIZE; size += 7)
+    {
+        auto *ptr = allocator.allocate(size);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % alignof(std::max_align_t),
+                  0);
+        blocks.emplace_back(ptr, size);
+    }
+
+    for (auto [ptr, size] : blocks)
+    {
+        allocator.deallocate(ptr, size);
+    }
+    EXPECT_EQ(allocator.allocatedBytes(), 0);
+}
+
+TEST(SlabAllocator, NewSlabs)
+{
+    SlabAllocator allocator;
+
+    constexpr size_t perSlab = SlabAllocator::SLAB_SIZE / 64;
+    std::vector<void *> blocks;
+    for (size_t i = 0; i < perSlab + 1; i++)
+    {
+        blocks.push_back(allocator.allocate(64));
+    }
+    EXPECT_EQ(allocator.reservedBytes(), 2 * SlabAllocator::SLAB_SIZE);
+    EXPECT_EQ(allocator.allocatedBytes(), (perSlab + 1) * 64);
+
+    for (auto *ptr : blocks)
+    {
+        allocator.deallocate(ptr, 64);
+    }
+}
+
+TEST(SlabAllocator, LargeAllocations)
+{
+    SlabAllocator allocator;
+
+    auto *ptr = allocator.allocate(SlabAllocator::MAX_BLOCK_SIZE + 1);
+    EXPECT_NE(ptr, nullptr);
+    EXPECT_EQ(allocator.allocatedBytes(), 0);
+    EXPECT_EQ(allocator.reservedBytes(), 0);
+    allocator.deallocate(ptr, SlabAllocator::MAX_BLOCK_SIZE + 1);
+}
+
+TEST(SlabAllocator, NullIsIgnored)
+{
+    SlabAllocator allocator;
+
+    allocator.deallocate(nullptr, 40);
+    allocator.deallocate(nullptr, SlabAllocator::MAX_BLOCK_SIZE + 1);
+    EXPECT_EQ(allocator.allocatedBytes(), 0);
+    EXPECT_EQ(allocator.reservedBytes(), 0);
+}
+
+TEST(SlabAllocator, ReservedIsBoundedByPeak)
+{
+    SlabAllocator allocator;
+
+    // Freeing and allocating the same number of blocks again doesn't need
+    // any new slabs
+    constexpr size_t peak = 3 * SlabAllocator::SLAB_SIZE / 64;
+    std::vector<void *> blocks;
+    for (int round = 0; round < 10; round++)
+    {
+        for (size_t i = 0; i < peak; i++)
+        {
+            blocks.push_back(allocator.allocate(64));
+        }
+        for (auto *ptr : blocks)
+        {
+            allocator.deallocate(ptr, 64);
+        }
+        blocks.clear();
+
+        EXPECT_EQ(allocator.reservedBytes(), 3 * SlabAllocator::SLAB_SIZE);
+    }
+    EXPECT_EQ(allocator.allocatedBytes(), 0);
+}
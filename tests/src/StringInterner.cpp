@@ -0,0 +1,53 @@
+#include "util/StringInterner.hpp"
+
+#include "Test.hpp"
+
+using namespace chatterino;
+
+TEST(StringInterner, SharesBuffers)
+{
+    auto &interner = StringInterner::instance();
+
+    // Built separately so they don't share a buffer to begin with
+    QString a = QString("for") + "sen";
+    QString b = QString("fo") + "rsen";
+    ASSERT_NE(a.constData(), b.constData());
+
+    auto internedA = interner.intern(a);
+    auto internedB = interner.intern(b);
+    EXPECT_EQ(internedA, "forsen");
+    EXPECT_EQ(internedB, "forsen");
+    EXPECT_EQ(internedA.constData(), internedB.constData());
+}
+
+TEST(StringInterner, NullAndEmpty)
+{
+    auto &interner = StringInterner::instance();
+    auto before = interner.size();
+
+    EXPECT_TRUE(interner.intern(QString()).isNull());
+    EXPECT_TRUE(interner.intern(QString("")).isNull());
+    EXPECT_EQ(interner.size(), before);
+}
+
+TEST(StringInterner, Bounded)
+{
+    auto &interner = StringInterner::instance();
+    constexpr auto limit =
+        StringInterner::SHARD_COUNT * StringInterner::MAX_SHARD_SIZE;
+
+    for (size_t i = 0; i < 2 * limit; i++)
+    {
+        interner.intern(QString("user%1").arg(i));
+    }
+    EXPECT_LE(interner.size(), limit);
+
+    // Strings handed out before a shard was cleared are still valid
+    auto name = interner.intern("pajlada");
+    for (size_t i = 0; i < 2 * limit; i++)
+    {
+        interner.intern(QString("other%1").arg(i));
+    }
+    EXPECT_EQ(name, "pajlada");
+    EXPECT_EQ(interner.intern("pajlada"), "pajlada");
+}
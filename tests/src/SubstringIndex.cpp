@@ -0,0 +1,47 @@
+#include "controllers/completion/sources/SubstringIndex.hpp"
+
+#include "Test.hpp"
+
+#include <QString>
+
+#include <vector>
+
+using namespace chatterino::completion;
+
+TEST(SubstringIndex, Empty)
+{
+    SubstringIndex index;
+    EXPECT_TRUE(index.find("a").empty());
+    EXPECT_TRUE(index.find("").empty());
+    EXPECT_EQ(index.size(), 0);
+}
+
+TEST(SubstringIndex, Find)
+{
+    SubstringIndex index({"Kappa", "KappaPride", "PogChamp", "pepeLaugh",
+                          "LUL", ":)", "ppHop"});
+
+    EXPECT_EQ(index.find("kappa"), (std::vector<size_t>{0, 1}));
+    EXPECT_EQ(index.find("PRIDE"), (std::vector<size_t>{1}));
+    EXPECT_EQ(index.find("p"), (std::vector<size_t>{0, 1, 2, 3, 6}));
+    EXPECT_EQ(index.find("pp"), (std::vector<size_t>{0, 1, 6}));
+    EXPECT_EQ(index.find(":"), (std::vector<size_t>{5}));
+    EXPECT_EQ(index.find("lul"), (std::vector<size_t>{4}));
+    EXPECT_EQ(index.find("Laughs"), (std::vector<size_t>{}));
+    EXPECT_EQ(index.find("x"), (std::vector<size_t>{}));
+}
+
+TEST(SubstringIndex, EmptyQueryMatchesAll)
+{
+    SubstringIndex index({"a", "b", "c"});
+    EXPECT_EQ(index.find(""), (std::vector<size_t>{0, 1, 2}));
+}
+
+TEST(SubstringIndex, RepeatedMatches)
+{
+    // Names containing the query multiple times are only returned once
+    SubstringIndex index({"aaaa", "abab", "b"});
+    EXPECT_EQ(index.find("a"), (std::vector<size_t>{0, 1}));
+    EXPECT_EQ(index.find("ab"), (std::vector<size_t>{1}));
+    EXPECT_EQ(index.find("aa"), (std::vector<size_t>{0}));
+}
@@ -2,6 +2,7 @@
 #include "providers/twitch/PubSubClient.hpp"
 #include "providers/twitch/PubSubManager.hpp"
 #include "providers/twitch/pubsubmessages/AutoMod.hpp"
+#include "providers/twitch/pubsubmessages/Base.hpp"
 #include "providers/twitch/pubsubmessages/Whisper.hpp"
 #include "providers/twitch/TwitchAccount.hpp"
 #include "Test.hpp"
@@ -11,6 +12,7 @@
 #include <chrono>
 #include <mutex>
 #include <optional>
+#include <string_view>
 
 using namespace chatterino;
 using namespace std::chrono_literals;
@@ -459,3 +461,75 @@ TEST(TwitchPubSubClient, AutoModMessageHeld)
 }
 
 #endif
+
+namespace {
+
+std::optional<PubSubMessage> parse(std::string_view json)
+{
+    return parsePubSubBaseMessage(json);
+}
+
+}  // namespace
+
+TEST(TwitchPubSubClient, ParseMessage)
+{
+    auto message = parse(R"({"type":"MESSAGE","data":{"topic":"whispers.123",)"
+                         R"("message":"{\"type\":\"whisper_received\"}"}})");
+    ASSERT_TRUE(message.has_value());
+    ASSERT_EQ(message->type, PubSubMessage::Type::Message);
+    ASSERT_TRUE(message->data.has_value());
+    ASSERT_EQ(message->data->topic, "whispers.123");
+    ASSERT_EQ(message->data->messageObject.value("type").toString(),
+              "whisper_received");
+
+    ASSERT_FALSE(parse("not json").has_value());
+    ASSERT_FALSE(parse("[]").has_value());
+}
+
+TEST(TwitchPubSubClient, ParseMessageWithoutData)
+{
+    auto message = parse(R"({"type":"PONG"})");
+    ASSERT_TRUE(message.has_value());
+    ASSERT_EQ(message->type, PubSubMessage::Type::Pong);
+    ASSERT_FALSE(message->data.has_value());
+
+    message = parse(R"({"type":"MESSAGE","data":"xd"})");
+    ASSERT_TRUE(message.has_value());
+    ASSERT_FALSE(message->data.has_value());
+
+    message = parse(R"({"type":"forsen"})");
+    ASSERT_TRUE(message.has_value());
+    ASSERT_EQ(message->type, PubSubMessage::Type::INVALID);
+    ASSERT_EQ(message->typeString, "forsen");
+}
+
+TEST(TwitchPubSubClient, ParseMessageWithBrokenPayload)
+{
+    // The inner message is a string, but not valid JSON
+    auto message = parse(
+        R"({"type":"MESSAGE","data":{"topic":"a","message":"{\"type\":"}})");
+    ASSERT_TRUE(message.has_value());
+    ASSERT_TRUE(message->data.has_value());
+    ASSERT_EQ(message->data->topic, "a");
+    ASSERT_TRUE(message->data->messageObject.isEmpty());
+
+    // The inner message isn't an object
+    message = parse(
+        R"({"type":"MESSAGE","data":{"topic":"a","message":"[1, 2]"}})");
+    ASSERT_TRUE(message.has_value());
+    ASSERT_TRUE(message->data.has_value());
+    ASSERT_TRUE(message->data->messageObject.isEmpty());
+
+    // The inner message isn't a string
+    message = parse(
+        R"({"type":"MESSAGE","data":{"topic":"a","message":{"type":"b"}}})");
+    ASSERT_TRUE(message.has_value());
+    ASSERT_TRUE(message->data.has_value());
+    ASSERT_TRUE(message->data->messageObject.isEmpty());
+
+    message = parse(R"({"type":"MESSAGE","data":{}})");
+    ASSERT_TRUE(message.has_value());
+    ASSERT_TRUE(message->data.has_value());
+    ASSERT_TRUE(message->data->topic.isEmpty());
+    ASSERT_TRUE(message->data->messageObject.isEmpty());
+}